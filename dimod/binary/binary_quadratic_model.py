@@ -62,6 +62,7 @@ from dimod.serialization.fileview import load, read_header, write_header
 from dimod.sym import Eq, Ge, Le
 from dimod.typing import (Bias, BQMVectors, LabelledBQMVectors, QuadraticVectors,
                           Variable, VartypeLike)
+from dimod.utilities import asintegerarrays
 from dimod.variables import Variables, iter_deserialize_variables
 from dimod.vartypes import as_vartype, Vartype
 from dimod.views.quadratic import QuadraticViewsMixin
@@ -79,6 +80,9 @@ __all__ = ['BinaryQuadraticModel',
 
 BQM_MAGIC_PREFIX = b'DIMODBQM'
 
+# each array in a version 3.0 file starts on a multiple of this many bytes
+_FILE_ALIGNMENT = 64
+
 
 class BinaryQuadraticModel(QuadraticViewsMixin):
     r"""Binary quadratic model.
@@ -653,6 +657,29 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         """
         return self.data.add_linear
 
+    def add_linear_from(self, linear: Union[Mapping[Variable, Bias],
+                                            Iterable[Tuple[Variable, Bias]]]):
+        """Add variables and linear biases to a binary quadratic model.
+
+        Args:
+            linear:
+                Variables and their associated linear biases, as either a dict of
+                form ``{v: bias, ...}`` or an iterable of ``(v, bias)`` pairs,
+                where ``v`` is a variable and ``bias`` is its associated linear
+                bias.
+
+        """
+        if isinstance(linear, abc.Mapping):
+            linear = linear.items()
+        elif not isinstance(linear, abc.Iterable):
+            raise TypeError(
+                "expected 'linear' to be a dict or an iterable of 2-tuples.")
+
+        self.data.add_linear_from_iterable(linear)
+
+    add_variables_from = add_linear_from
+    """Alias for :meth:`add_linear_from`."""
+
     def add_linear_equality_constraint(
             self, terms: Iterable[Tuple[Variable, Bias]],
             lagrange_multiplier: Bias, constant: Bias):
@@ -902,14 +929,10 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
                 If any self-loops are given. E.g. ``(u, u, bias)`` is not a valid
                 triplet.
         """
-        add_quadratic = self.data.add_quadratic
-
         if isinstance(quadratic, abc.Mapping):
-            for (u, v), bias in quadratic.items():
-                add_quadratic(u, v, bias)
-        else:
-            for u, v, bias in quadratic:
-                add_quadratic(u, v, bias)
+            quadratic = ((u, v, bias) for (u, v), bias in quadratic.items())
+
+        self.data.add_quadratic_from_iterable(quadratic)
 
     add_interactions_from = add_quadratic_from
     """Alias for :meth:`add_quadratic_from`."""
@@ -944,6 +967,47 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
 
         self.data.add_quadratic_from_dense(quadratic)
 
+    def add_quadratic_from_csr(self, indptr: ArrayLike, indices: ArrayLike, data: ArrayLike):
+        """Add quadratic biases from a matrix in compressed sparse row (CSR) format.
+
+        The biases of row ``i`` are ``data[indptr[i]:indptr[i+1]]`` and their
+        columns are ``indices[indptr[i]:indptr[i+1]]``. Rows and columns are
+        the indices of variables in :attr:`variables`, which must already
+        be in the binary quadratic model. Every entry of the matrix is added,
+        so for a symmetric matrix each interaction is added twice.
+
+        This matches the ``indptr``, ``indices`` and ``data`` attributes of
+        a SciPy ``csr_matrix``.
+
+        Args:
+            indptr: Offsets of the rows into ``indices`` and ``data``.
+            indices: Column indices.
+            data: Quadratic biases.
+
+        Raises:
+            ValueError:
+                If any row or column is not the index of a variable in the
+                model, or if any self-loops are given; i.e., the matrix contains
+                a non-zero value on its diagonal.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel(3, 'BINARY')
+            >>> bqm.add_quadratic_from_csr([0, 2, 3, 3], [1, 2, 2], [-1, 2, .5])
+            >>> bqm.quadratic == {(0, 1): -1, (0, 2): 2, (1, 2): .5}
+            True
+
+        See also:
+            :meth:`to_csr`
+
+        """
+        indptr, indices = asintegerarrays(indptr, indices, requirements='C')
+        data = np.asarray(data, dtype=self.dtype, order='C')
+
+        if indptr.ndim != 1 or indices.ndim != 1 or data.ndim != 1:
+            raise ValueError("indptr, indices and data must be 1-dimensional")
+
+        self.data.add_quadratic_from_csr(indptr, indices, data)
+
     @forwarding_method
     def add_variable(self, v: Optional[Variable] = None, bias: Bias = 0):
         """Add a variable to a binary quadratic model.
@@ -1229,10 +1293,13 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         version = header_info.version
         data = header_info.data
 
-        if version >= (3, 0):
+        if version >= (4, 0):
             raise ValueError("cannot load a BQM serialized with version "
                              f"{version!r}, try upgrading your dimod version")
 
+        if version >= (3, 0):
+            return cls._from_file_csr(file_like, data)
+
         num_variables, num_interactions = data['shape']
 
         dtype = np.dtype(data['dtype'])
@@ -1302,6 +1369,49 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
 
         return bqm
 
+    @classmethod
+    def _from_file_csr(cls, file_like: BinaryIO, data: Mapping) -> 'BinaryQuadraticModel':
+        """Read the body of a file serialized with format version 3.0."""
+        num_variables, num_interactions = data['shape']
+
+        dtype = np.dtype(data['dtype'])
+        itype = np.dtype(data['itype'])  # index of the variable
+        ntype = np.dtype(data['ntype'])  # index of the neighborhood
+
+        def read_array(dtype, length, name):
+            nbytes = length * dtype.itemsize
+            buff = file_like.read(nbytes)
+            if len(buff) < nbytes:
+                raise ValueError(f"given file is missing {name} data")
+            # skip the padding, the last array does not need to be padded
+            if nbytes % _FILE_ALIGNMENT:
+                file_like.read(_FILE_ALIGNMENT - nbytes % _FILE_ALIGNMENT)
+            return np.frombuffer(buff, dtype=dtype.newbyteorder('<'))
+
+        offset = read_array(dtype, 1, 'offset')
+        ldata = read_array(dtype, num_variables, 'linear')
+        starts = read_array(ntype, num_variables + 1, 'neighborhood')
+        neighbors = read_array(itype, 2*num_interactions, 'quadratic')
+        qdata = read_array(dtype, 2*num_interactions, 'quadratic')
+
+        # each interaction is stored in both neighborhoods, we only want the
+        # upper triangle
+        irow = np.repeat(np.arange(num_variables, dtype=itype), np.diff(starts))
+        upper = irow < neighbors
+
+        bqm = cls.from_numpy_vectors(
+            ldata,
+            (np.ascontiguousarray(irow[upper]),
+             np.ascontiguousarray(neighbors[upper]),
+             np.ascontiguousarray(qdata[upper])),
+            offset[0], data['vartype'], dtype=dtype)
+
+        # labels
+        if data['variables']:
+            bqm.relabel_variables(dict(enumerate(VariablesSection.load(file_like))))
+
+        return bqm
+
     @classmethod
     def from_ising(cls, h: Union[Mapping, Sequence],
                    J: Mapping,
@@ -1712,6 +1822,34 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         """
         return self.data.get_quadratic
 
+    def memory_usage(self, capacity: bool = False) -> Dict[str, int]:
+        """Get a breakdown of the memory used by the binary quadratic model.
+
+        Unlike :meth:`.nbytes`, this includes the vectors that hold the
+        neighborhoods and the variable labels.
+
+        Args:
+            capacity: If ``capacity`` is true, use the ``std::vector::capacity``
+                of the underlying vectors rather than their size.
+
+        Returns:
+            A dict with the bytes used by the ``linear`` biases and the offset,
+            the ``quadratic`` neighborhoods, the per-variable information in
+            ``variables``, the ``indices``, the ``labels`` and anything
+            ``other``, as well as the ``total``.
+
+        Raises:
+            TypeError: If :attr:`.dtype` is :class:`object`.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel({'a': 1}, {'ab': -1}, 0, 'SPIN')
+            >>> usage = bqm.memory_usage()
+            >>> usage['total'] >= bqm.nbytes()
+            True
+
+        """
+        return self.data.memory_usage(capacity)
+
     def nbytes(self, capacity: bool = False) -> int:
         """Get the total bytes consumed by the biases and indices.
 
@@ -1912,6 +2050,9 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         """Relabel to consecutive integers the variables of a binary quadratic
         model.
 
+        Models with integer labels that were added out of order, or that had
+        variables removed, are compacted and no longer store their labels.
+
         Args:
             inplace: If True, the binary quadratic model is updated in-place;
                 otherwise, a new binary quadratic model is returned.
@@ -2094,6 +2235,46 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         else:
             coo.dump(self, fp, vartype_header)
 
+    def to_csr(self, *, upper_triangular: bool = True,
+               ) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """Return the quadratic biases as a matrix in compressed sparse row (CSR) format.
+
+        The arrays are filled in a single pass over the interactions, without
+        iterating over them in Python.
+
+        Args:
+            upper_triangular:
+                If True, each interaction ``(u, v)`` appears once, in the
+                row of whichever of ``u`` and ``v`` is first in
+                :attr:`variables`. Otherwise the matrix is symmetric and each
+                interaction appears twice.
+
+        Returns:
+            A 3-tuple of NumPy arrays ``(indptr, indices, data)``. The biases
+            of row ``i`` are ``data[indptr[i]:indptr[i+1]]`` and their
+            columns ``indices[indptr[i]:indptr[i+1]]``, which are sorted.
+            ``indptr`` is ``int64``, ``indices`` has the model's index dtype.
+            Rows and columns are the indices of the variables in
+            :attr:`variables`. The linear biases and the offset are not
+            included.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel({}, {'ab': 1, 'bc': -1, 'ac': .5}, 'SPIN')
+            >>> indptr, indices, data = bqm.to_csr()
+            >>> print(indptr, indices, data)
+            [0 2 3 3] [1 2 2] [ 1.   0.5 -1. ]
+
+            The arrays can be passed to SciPy to construct a sparse matrix.
+
+            >>> from scipy.sparse import csr_array      # doctest: +SKIP
+            >>> csr_array((data, indices, indptr))      # doctest: +SKIP
+
+        See also:
+            :meth:`add_quadratic_from_csr`
+
+        """
+        return self.data.to_csr(upper_triangular=upper_triangular)
+
     def to_file(self, *,
                 ignore_labels: bool = False,
                 spool_size: int = int(1e9),
@@ -2186,6 +2367,30 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
             The next VARIABLES_LENGTH bytes are a json-serialized array. As
             constructed by `json.dumps(list(bqm.variables))`.
 
+        Format Specification (Version 3.0):
+
+            The header is the same as for version 2.0, except that ``ntype``
+            is always ``'int64'``.
+
+            The binary quadratic model data is stored as five arrays, each
+            starting on a multiple of 64 bytes from the start of the file and
+            padded with null bytes. In order:
+
+            * the offset, a single ``dtype``
+            * the linear biases, ``num_variables`` ``dtype``
+            * the start of each variable's neighborhood, ``num_variables + 1``
+              ``ntype``
+            * the neighbors of each variable, sorted,
+              2 * ``num_interactions`` ``itype``
+            * the quadratic biases, 2 * ``num_interactions`` ``dtype``
+
+            which is the compressed sparse row (CSR) format, so the model can
+            be used directly from a memory-mapped file. See
+            ``dimod/include/dimod/fileview.h`` for a C++ view of this format.
+
+            As in version 2.0, the labels follow in a "VARS" section if the
+            model is not index-labeled.
+
         .. _NPY format: https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
 
 
@@ -2198,9 +2403,12 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
 
         version_tpl: Tuple[int, int] = (version, 0) if isinstance(version, Integral) else version
 
-        if version_tpl not in [(1, 0), (2, 0)]:
+        if version_tpl not in [(1, 0), (2, 0), (3, 0)]:
             raise ValueError(f"Unsupported version: {version!r}")
 
+        if version_tpl >= (3, 0):
+            return self._to_file_csr(ignore_labels=ignore_labels, spool_size=spool_size)
+
         # the file we'll be writing to
         file = SpooledTemporaryFile(max_size=spool_size)
 
@@ -2243,6 +2451,62 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         file.seek(0)  # go back to the start
         return file
 
+    def _to_file_csr(self, *, ignore_labels: bool, spool_size: int,
+                     ) -> tempfile.SpooledTemporaryFile:
+        """Serialize the binary quadratic model using format version 3.0."""
+        file = SpooledTemporaryFile(max_size=spool_size)
+
+        data = dict(shape=self.shape,
+                    dtype=self.dtype.name,
+                    itype=self.data.index_dtype.name,
+                    ntype=np.dtype(np.int64).name,
+                    vartype=self.vartype.name,
+                    type=type(self).__name__,
+                    variables=not (ignore_labels or self.variables._is_range()),
+                    )
+
+        write_header(file, BQM_MAGIC_PREFIX, data, version=(3, 0))
+
+        def pad(nbytes):
+            if nbytes % _FILE_ALIGNMENT:
+                file.write(bytes(_FILE_ALIGNMENT - nbytes % _FILE_ALIGNMENT))
+
+        def write_array(arr):
+            arr = np.ascontiguousarray(arr, dtype=arr.dtype.newbyteorder('<'))
+            file.write(memoryview(arr).cast('B'))
+            pad(arr.nbytes)
+
+        num_variables = self.data.num_variables()
+
+        write_array(np.asarray([self.data.offset], dtype=self.dtype))
+
+        ldata = self.data._ilinear_and_degree()
+        write_array(ldata['b'])
+
+        # the neighborhood starts are stored as int32 and so might overflow,
+        # but the differences between them (the degrees) cannot
+        starts = np.empty(num_variables + 1, dtype=np.int64)
+        starts[0] = 0
+        starts[1:num_variables] = np.cumsum(np.diff(ldata['ni']), dtype=np.int64)
+        starts[num_variables] = 2*self.num_interactions
+        write_array(starts)
+
+        # write the neighbors and then the biases, one neighborhood at a time
+        # so we don't need a copy of the whole adjacency
+        for field in ['v', 'bias']:
+            nbytes = 0
+            for vi in range(num_variables):
+                neighborhood = np.ascontiguousarray(self.data._ineighborhood(vi)[field])
+                file.write(memoryview(neighborhood).cast('B'))
+                nbytes += neighborhood.nbytes
+            pad(nbytes)
+
+        if data['variables']:
+            file.write(VariablesSection(self.variables).dumps())
+
+        file.seek(0)  # go back to the start
+        return file
+
     def to_ising(self):
         """Convert a binary quadratic model to Ising format.
 
@@ -32,6 +32,7 @@ from libcpp.vector cimport vector
 from dimod.binary.cybqm cimport cyBQM
 from dimod.cyutilities cimport as_numpy_float
 from dimod.cyutilities import coo_sort
+from dimod.libcpp.instrumentation cimport counters_as_dict
 from dimod.libcpp.vartypes cimport Vartype as cppVartype
 from dimod.sampleset import as_samples
 from dimod.typing import BQMVectors, LabelledBQMVectors, QuadraticVectors
@@ -127,6 +128,31 @@ cdef class cyBQM_template(cyQMBase):
         cdef Py_ssize_t vi = self._index(v, permissive=True)
         self.cppbqm.add_linear(vi, bias)
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def add_linear_from_iterable(self, object iterable):
+        """Add linear biases from an iterable of ``(v, bias)`` pairs.
+
+        The variable labels are resolved in a single batch.
+        """
+        labels = []
+        biases = []
+        for v, bias in iterable:
+            labels.append(v)
+            biases.append(bias)
+
+        cdef Py_ssize_t[::1] vi
+        try:
+            vi = self.variables.index_array(labels, permissive=True)
+        finally:
+            # keep the model in sync with any variables that were added
+            self.cppbqm.resize(self.variables.size())
+
+        cdef bias_type[::1] bias_view = np.asarray(biases, dtype=BIAS_DTYPE)
+        cdef Py_ssize_t i
+        for i in range(vi.shape[0]):
+            self.cppbqm.add_linear(vi[i], bias_view[i])
+
     def add_linear_equality_constraint(self, object terms,
                                        bias_type lagrange_multiplier,
                                        bias_type constant):
@@ -205,6 +231,36 @@ cdef class cyBQM_template(cyQMBase):
         cdef Py_ssize_t vi = self._index(v, permissive=True)
         self.cppbqm.add_quadratic(ui, vi, bias)
 
+    def add_quadratic_from_iterable(self, object iterable):
+        """Add quadratic biases from an iterable of ``(u, v, bias)`` triplets.
+
+        The variable labels are resolved in a single batch and the biases are
+        then added as one COO block.
+        """
+        # interleave the labels so variables are added in the order they appear
+        labels = []
+        biases = []
+        for u, v, bias in iterable:
+            if u == v:
+                raise ValueError(f"{u!r} cannot have an interaction with itself")
+            labels.append(u)
+            labels.append(v)
+            biases.append(bias)
+
+        if not biases:
+            return
+
+        try:
+            indices = self.variables.index_array(labels, permissive=True)
+        finally:
+            # keep the model in sync with any variables that were added
+            self.cppbqm.resize(self.variables.size())
+
+        cdef Py_ssize_t[::1] irow = np.ascontiguousarray(indices[0::2])
+        cdef Py_ssize_t[::1] icol = np.ascontiguousarray(indices[1::2])
+        cdef bias_type[::1] qdata = np.asarray(biases, dtype=BIAS_DTYPE)
+        self.cppbqm.add_quadratic_coo(&irow[0], &icol[0], &qdata[0], qdata.shape[0], False)
+
     def add_quadratic_from_arrays(self,
                                   const Integer[::1] irow,
                                   const Integer[::1] icol,
@@ -216,12 +272,48 @@ cdef class cyBQM_template(cyQMBase):
 
         if length:
             if self.variables._is_range():
-                self.cppbqm.add_quadratic_from_coo(&irow[0], &icol[0], &qdata[0], length)
+                self.cppbqm.add_quadratic_coo(&irow[0], &icol[0], &qdata[0], length, False)
                 self.variables._stop = self.cppbqm.num_variables()
             else:
                 raise NotImplementedError
 
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def add_quadratic_from_csr(self,
+                               const Integer[::1] indptr,
+                               const Integer[::1] indices,
+                               const Numeric[::1] data):
+        if indptr.shape[0] < 1:
+            raise ValueError("indptr must have length at least 1")
+        cdef Py_ssize_t num_rows = indptr.shape[0] - 1
+        if num_rows > self.num_variables():
+            raise ValueError("the matrix has more rows than the model has variables")
+
+        if indptr[0] < 0 or <Py_ssize_t>indptr[num_rows] > indices.shape[0]:
+            raise ValueError("indptr does not match the length of indices")
+        if indices.shape[0] != data.shape[0]:
+            raise ValueError("indices and data should be equal length")
+
+        cdef Py_ssize_t num_variables = self.num_variables()
+        cdef Py_ssize_t ui, qi, vi
+        for ui in range(num_rows):
+            if indptr[ui] > indptr[ui + 1]:
+                raise ValueError("indptr must be non-decreasing")
+
+            for qi in range(<Py_ssize_t>indptr[ui], <Py_ssize_t>indptr[ui + 1]):
+                vi = indices[qi]
+                if not 0 <= vi < num_variables:
+                    raise ValueError(f"out of range variable index: {vi}")
+                if ui == vi and data[qi]:
+                    raise ValueError(
+                        f"{self.variables.at(ui)!r} cannot have an interaction with itself")
+
+        if indptr[0] == indptr[num_rows]:
+            return  # nothing to add
+
+        self.cppbqm.add_quadratic_csr(&indptr[0], &indices[0], &data[0], num_rows, False)
+
     @cython.boundscheck(False)
     @cython.wraparound(False)
     cpdef Py_ssize_t add_quadratic_from_dense(self, const Numeric[:, ::1] quadratic) except -1:
@@ -285,7 +377,7 @@ cdef class cyBQM_template(cyQMBase):
         cdef Py_ssize_t length = irow.shape[0]
 
         if length:
-            bqm.cppbqm.add_quadratic_from_coo(&irow[0], &icol[0], &qdata[0], length)
+            bqm.cppbqm.add_quadratic_coo(&irow[0], &icol[0], &qdata[0], length, False)
 
         bqm.variables._stop = bqm.cppbqm.num_variables()
 
@@ -301,6 +393,16 @@ cdef class cyBQM_template(cyQMBase):
 
         return bqm
 
+    @staticmethod
+    def counters(bint reset=False):
+        """Return the counts of events on the hot paths of the models.
+
+        See :meth:`cyQMBase.counters`.
+        """
+        # the methods of this class are compiled into this module and into the
+        # base class's module, which each have their own counters
+        return counters_as_dict(reset, cyQMBase.counters(reset))
+
     @classmethod
     def from_numpy_vectors(cls, linear, quadratic, offset, vartype,
                            variable_order=None):
@@ -17,7 +17,7 @@ import typing
 
 from collections.abc import Collection, KeysView, Callable
 from functools import reduce
-from typing import Any, Dict, Iterator, Optional, Tuple, Mapping
+from typing import Any, Dict, Iterable, Iterator, Optional, Tuple, Mapping
 
 import numpy as np
 
@@ -68,6 +68,10 @@ class pyBQM:
     def add_linear_equality_constraint(self, *args, **kwargs):
         raise NotImplementedError  # defer to caller
 
+    def add_linear_from_iterable(self, iterable: Iterable[Tuple[Variable, Any]]):
+        for v, bias in iterable:
+            self.add_linear(v, bias)
+
     def add_linear_from_array(self, linear: ArrayLike):
         for v, bias in enumerate(np.asarray(linear)):
             self.add_linear(v, bias)
@@ -90,6 +94,33 @@ class pyBQM:
 
         self._adj[u][v] = self._adj[v][u] = self._adj[v].get(u, zero) + bias
 
+    def add_quadratic_from_iterable(self, iterable: Iterable[Tuple[Variable, Variable, Any]]):
+        for u, v, bias in iterable:
+            self.add_quadratic(u, v, bias)
+
+    def add_quadratic_from_csr(self, indptr: np.ndarray, indices: np.ndarray,
+                               data: np.ndarray):
+        if len(indptr) < 1:
+            raise ValueError("indptr must have length at least 1")
+        if len(indptr) - 1 > self.num_variables():
+            raise ValueError("the matrix has more rows than the model has variables")
+
+        variables = list(self.variables)
+        terms = [(ui, indices[qi], data[qi])
+                 for ui in range(len(indptr) - 1)
+                 for qi in range(indptr[ui], indptr[ui + 1])]
+
+        # check everything before we add anything
+        for ui, vi, bias in terms:
+            if not 0 <= vi < len(variables):
+                raise ValueError(f"out of range variable index: {vi}")
+            if ui == vi and bias:
+                raise ValueError(f"{variables[ui]!r} cannot have an interaction with itself")
+
+        for ui, vi, bias in terms:
+            if ui != vi:
+                self.add_quadratic(variables[ui], variables[vi], bias)
+
     def add_quadratic_from_dense(self, quadratic: ArrayLike):
         quadratic = np.asarray(quadratic)
         if quadratic.shape[0] != quadratic.shape[1]:
@@ -254,6 +285,10 @@ class pyBQM:
                 if v not in seen:
                     yield u, v, bias
 
+    def memory_usage(self, *args, **kwargs) -> typing.NoReturn:
+        raise TypeError(
+            "cannot return the memory usage of a binary quadratic model with object dtype")
+
     def nbytes(self, *args, **kwargs) -> typing.NoReturn:
         raise TypeError(
             "cannot return the number of bytes for a binary quadratic model with object dtype")
@@ -357,6 +392,24 @@ class pyBQM:
         self.add_variable(v)
         self._adj[u][v] = self._adj[v][u] = bias
 
+    def to_csr(self, *, upper_triangular: bool = True,
+               ) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+        index = {v: vi for vi, v in enumerate(self.variables)}
+
+        indptr = [0]
+        indices = []
+        data = []
+        for ui, (u, neighborhood) in enumerate(self._adj.items()):
+            row = sorted((index[v], bias) for v, bias in neighborhood.items()
+                         if v != u and (not upper_triangular or index[v] > ui))
+            indices.extend(vi for vi, _ in row)
+            data.extend(bias for _, bias in row)
+            indptr.append(len(indices))
+
+        return (np.asarray(indptr, dtype=np.int64),
+                np.asarray(indices, dtype=np.int64),
+                np.asarray(data, dtype=object))
+
     def to_numpy_vectors(self, *args, **kwargs):
         raise NotImplementedError  # defer to the caller
 
@@ -17,7 +17,7 @@ import functools
 
 from collections.abc import Collection, Iterator, Callable, Sequence
 from operator import add
-from typing import Tuple, Iterator, Optional, Mapping, Any
+from typing import Any, Dict, Iterable, Iterator, Mapping, Optional, Tuple
 
 import numpy as np
 
@@ -117,6 +117,11 @@ class VartypeView:
     def add_linear_equality_constraint(self, *args, **kwargs):
         raise NotImplementedError  # defer to caller
 
+    @view_method
+    def add_linear_from_iterable(self, iterable: Iterable[Tuple[Variable, Bias]]):
+        for v, bias in iterable:
+            self.add_linear(v, bias)
+
     @view_method
     def add_quadratic(self, u: Variable, v: Variable, bias: Bias):
         if self._vartype is BINARY:  # binary -> spin
@@ -130,6 +135,37 @@ class VartypeView:
             self.data.add_linear(v, -2*bias)
             self.data.offset += bias
 
+    @view_method
+    def add_quadratic_from_csr(self, indptr: np.ndarray, indices: np.ndarray,
+                               data: np.ndarray):
+        # each interaction also changes the linear biases and the offset in
+        # the other vartype, so we add them one at a time
+        if len(indptr) < 1:
+            raise ValueError("indptr must have length at least 1")
+        if len(indptr) - 1 > self.num_variables():
+            raise ValueError("the matrix has more rows than the model has variables")
+
+        variables = self.variables
+        terms = [(ui, indices[qi], data[qi])
+                 for ui in range(len(indptr) - 1)
+                 for qi in range(indptr[ui], indptr[ui + 1])]
+
+        # check everything before we add anything
+        for ui, vi, bias in terms:
+            if not 0 <= vi < len(variables):
+                raise ValueError(f"out of range variable index: {vi}")
+            if ui == vi and bias:
+                raise ValueError(f"{variables[ui]!r} cannot have an interaction with itself")
+
+        for ui, vi, bias in terms:
+            if ui != vi:
+                self.add_quadratic(variables[ui], variables[vi], bias)
+
+    @view_method
+    def add_quadratic_from_iterable(self, iterable: Iterable[Tuple[Variable, Variable, Bias]]):
+        for u, v, bias in iterable:
+            self.add_quadratic(u, v, bias)
+
     def add_variable(self, v: Optional[Variable] = None,
                      bias: Bias = 0) -> Variable:
         v = self.data.add_variable(v)
@@ -205,6 +241,9 @@ class VartypeView:
             for u, v, bias in self.data.iter_quadratic():
                 yield u, v, bias / 4
 
+    def memory_usage(self, capacity: bool = False) -> Dict[str, int]:
+        return self.data.memory_usage(capacity=capacity)
+
     def nbytes(self, capacity: bool = False) -> int:
         return self.data.nbytes(capacity=capacity)
 
@@ -275,6 +314,16 @@ class VartypeView:
         self.add_quadratic(u, v, 0)  # make sure it exists
         self.add_quadratic(u, v, bias - self.get_quadratic(u, v))
 
+    def to_csr(self, *, upper_triangular: bool = True,
+               ) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+        indptr, indices, data = self.data.to_csr(upper_triangular=upper_triangular)
+        if self._vartype == self.data.vartype():
+            return indptr, indices, data
+        elif self._vartype is BINARY:  # binary <- spin
+            return indptr, indices, 4 * data
+        else:  # spin <- binary
+            return indptr, indices, data / 4
+
     def to_numpy_vectors(self, *args, **kwargs):
         raise NotImplementedError  # defer to the caller
 
@@ -800,8 +800,17 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
             Note that the :func:`next` function is used here because the model
             has just a single constraint.
         """
-        return all(datum.violation <= atol + rtol*abs(datum.rhs_energy)
-                   for datum in self.iter_constraint_data(sample_like))
+        sample, variable_labels = as_samples(sample_like, labels_type=Variables)
+
+        if sample.shape[0] != 1:
+            raise ValueError("sample_like should be a single sample, "
+                             f"received {sample.shape[0]} samples")
+
+        violations = self._violations((sample, variable_labels))[0]
+        rhs = np.fromiter((comparison.rhs for comparison in self.constraints.values()),
+                          dtype=np.float64, count=len(violations))
+
+        return bool((violations <= atol + rtol*np.abs(rhs)).all())
 
     def fix_variable(self, v: Variable, value: float, *,
                      cascade: Optional[bool] = None,
@@ -1057,6 +1066,8 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
         else:
             file_like = fp
 
+        start = file_like.tell()
+
         header_info = read_header(file_like, CQM_MAGIC_PREFIX)
 
         num_variables = header_info.data["num_variables"]
@@ -1064,13 +1075,21 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
         if header_info.version < (1, 0):
             raise ValueError("cannot load CQMs serialized with CQM serialization version "
                              f"{header_info.version!r}, try upgrading your dimod version")
-        elif header_info.version > (2, 0):
+        elif header_info.version >= (4, 0):
             raise ValueError("cannot load CQMs serialized with CQM serialization version "
                              f"{header_info.version!r}, try downgrading your dimod version")
 
         if header_info.version < (2, 0):
             return cls._from_file_legacy(file_like, header_info, check_header=check_header)
 
+        if header_info.version >= (3, 0):
+            # the native reader checks the file's own block table, so there is
+            # nothing for check_header to do. It seeks to each block in turn
+            # rather than reading the whole file
+            file_like.seek(0, io.SEEK_END)
+            length = file_like.tell() - start
+            return cls._from_file_native(file_like, start, length)
+
         cqm = cls()
 
         with zipfile.ZipFile(file_like, mode='r') as zf:
@@ -1560,8 +1579,7 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
         self.discrete.discard(label)
 
         if cascade and to_remove:
-            for v in to_remove:
-                self.remove_variable(v)
+            self.remove_variables(to_remove)
 
     def remove_variable(self, v: Variable):
         for label in self.discrete:
@@ -1571,6 +1589,37 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
 
         super().remove_variable(v)
 
+    def remove_variables(self, variables: Iterable[Variable]):
+        """Remove several variables from the model.
+
+        This is equivalent to calling :meth:`remove_variable` for each
+        variable, but is linear in the size of the model rather than in the
+        size of the model times the number of variables removed.
+
+        Args:
+            variables: Variable labels.
+
+        Raises:
+            ValueError: If any of the variables are in a discrete constraint.
+
+        Examples:
+            >>> i, j, k = dimod.Integers('ijk')
+            >>> cqm = dimod.ConstrainedQuadraticModel()
+            >>> cqm.set_objective(i + 2*j + 3*k)
+            >>> cqm.remove_variables(['i', 'k'])
+            >>> cqm.variables
+            Variables(['j'])
+
+        """
+        variables = list(variables)
+        for label in self.discrete:
+            constraint_variables = self.constraints[label].lhs.variables
+            if any(v in constraint_variables for v in variables):
+                # todo: support this
+                raise ValueError("cannot remove a variable used in a discrete constraint")
+
+        super().remove_variables(variables)
+
     def spin_to_binary(self, inplace: bool = False) -> ConstrainedQuadraticModel:
         """Convert any spin-valued variables to binary-valued.
 
@@ -1663,6 +1712,8 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
     def to_file(self, *,
                 spool_size: int = int(1e9),
                 compress: bool = False,
+                version: Tuple[int, int] = CQM_SERIALIZATION_VERSION,
+                num_threads: int = 1,
                 ) -> tempfile.SpooledTemporaryFile:
         """Serialize to a file-like object.
 
@@ -1673,7 +1724,13 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
                 memory.
 
             compress: If True, the data will be compressed with
-                :class:`zipfile.ZIP_DEFLATED`.
+                :class:`zipfile.ZIP_DEFLATED`. Only supported by version 2.0.
+
+            version: Serialization format version to use. Either ``(2, 0)``
+                or ``(3, 0)``.
+
+            num_threads: Number of threads used to encode the constraints.
+                Only used by version 3.0.
 
         Format Specification (Version 2.0):
 
@@ -1746,6 +1803,46 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
             The ``penalty`` and ``weight`` files, if present, encode the weight
             and penalty type for the constraint.
 
+        Format Specification (Version 3.0):
+
+            The header is the same as for version 2.0, except that the
+            dictionary is exactly:
+
+            .. code-block:: python
+
+                dict(compression="",
+                     dtype="float64",
+                     itype="int32",
+                     num_constraints=len(cqm.constraints),
+                     num_variables=len(cqm.variables),
+                     type="ConstrainedQuadraticModel",
+                     )
+
+            The header is followed by a sequence of blocks. The first block
+            encodes the number of variables as a little-endian 8-byte unsigned
+            int followed by the :class:`Vartype` of each variable as a signed
+            byte and then the lower and upper bounds of all of the variables.
+
+            The second block encodes the objective and the following
+            ``num_constraints`` blocks encode the constraints, in order.
+            Objectives and constraints are encoded as the number of variables
+            `n` and the number of interactions `m`, as little-endian 8-byte
+            unsigned ints, then the offset, then the `n` variable indices,
+            the `n` linear biases, and the `m` rows, `m` columns and `m`
+            biases of the interactions. Constraints are prefixed with their
+            sense, penalty and whether they are discrete as single bytes and
+            then their rhs and weight.
+
+            The last two blocks are the json-encoded variable labels and
+            constraint labels, or are empty if the labels are ``range(n)``.
+
+            The blocks are followed by the start of each block and the end of
+            the last one as little-endian 8-byte unsigned ints. The file ends
+            with the start of that table and the number of constraints, each
+            as a little-endian 8-byte unsigned int, and finally the magic string
+            "DIMODEND". This allows any single constraint to be read without
+            decoding the others.
+
         Expression Format Specification (Version 2.0):
 
             This format is inspired by the `NPY format`_
@@ -1790,6 +1887,15 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
         """
         file = SpooledTemporaryFile(max_size=spool_size)
 
+        if version == (3, 0):
+            if compress:
+                raise ValueError("compress is not supported by version 3.0")
+            self._to_file_native(file, num_threads)
+            file.seek(0)
+            return file
+        elif version != (2, 0):
+            raise ValueError(f"unsupported serialization version {version!r}")
+
         data = dict(num_variables=len(self.variables),
                     num_constraints=len(self.constraints),
                     num_biases=self.num_biases(),
@@ -15,6 +15,8 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+from libcpp.vector cimport vector
+
 from dimod.libcpp.constrained_quadratic_model cimport ConstrainedQuadraticModel as cppConstrainedQuadraticModel
 from dimod.constrained.cyexpression cimport cyObjectiveView, cyConstraintView
 from dimod.cyqmbase.cyqmbase_float64 cimport cyQMBase_float64, bias_type, index_type
@@ -47,4 +49,6 @@ cdef class cyConstrainedQuadraticModel:
     This dictionary and its contents should not be modified.
     """
 
+    cdef void _remove_variables_by_index(self, vector[index_type]&) except *
+
 cdef object make_cqm(cppConstrainedQuadraticModel[bias_type, index_type] cppcqm)
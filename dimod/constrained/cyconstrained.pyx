@@ -15,6 +15,7 @@
 import collections.abc
 import io
 import itertools
+import json
 import numbers
 import typing
 
@@ -25,7 +26,10 @@ import numpy as np
 
 from cython.operator cimport preincrement as inc, dereference as deref
 from libc.math cimport ceil, floor
+from libc.string cimport memcpy
+from libcpp cimport bool
 from libcpp.cast cimport reinterpret_cast
+from libcpp.string cimport string
 from libcpp.unordered_set cimport unordered_set
 from libcpp.utility cimport move
 from libcpp.vector cimport vector
@@ -40,15 +44,70 @@ from dimod.cyutilities cimport as_numpy_float
 from dimod.cyutilities cimport cppvartype
 from dimod.discrete.cydiscrete_quadratic_model cimport cyDiscreteQuadraticModel
 from dimod.libcpp.abc cimport QuadraticModelBase as cppQuadraticModelBase
-from dimod.libcpp.constrained_quadratic_model cimport Sense as cppSense, Penalty as cppPenalty, Constraint as cppConstraint
+from dimod.libcpp.constrained_quadratic_model cimport Sense as cppSense, Penalty as cppPenalty, Constraint as cppConstraint, Expression as cppExpression
+from dimod.libcpp.cqm_fileview cimport (
+    ConstrainedQuadraticModelReader as cppConstrainedQuadraticModelReader,
+    DumpOptions as cppDumpOptions,
+    dump as cppdump,
+    )
+from dimod.libcpp.instrumentation cimport counters_as_dict, memory_usage_as_dict
 from dimod.libcpp.vartypes cimport Vartype as cppVartype, vartype_info as cppvartype_info
 from dimod.sym import Sense, Eq, Ge, Le
-from dimod.typing cimport int8_t
-from dimod.variables import Variables
+from dimod.sampleset import as_samples
+from dimod.typing cimport int8_t, float64_t, uint64_t, Numeric
+from dimod.variables import Variables, deserialize_variable
 from dimod.vartypes import as_vartype, Vartype
 from dimod.views.quadratic import QuadraticViewsMixin
 
 
+# The file functions given to the native file format. Their context is a list
+# that holds the file object, and in which any exception raised is saved so that
+# it can be re-raised once the C++ function returns.
+
+cdef bool _write_file(void* context, const char* data, size_t n) noexcept with gil:
+    # context is [file, error]
+    state = <list>context
+    try:
+        state[0].write(data[:n])
+    except BaseException as err:
+        state[1] = err
+        return False
+    return True
+
+
+cdef bool _read_file(void* context, uint64_t offset, size_t n, char* out) noexcept with gil:
+    # context is [file, start, error]
+    state = <list>context
+    try:
+        file = state[0]
+        file.seek(state[1] + offset)
+        data = file.read(n)
+        if len(data) != n:
+            raise ValueError("file is truncated")
+        memcpy(out, <const char*>data, n)
+    except BaseException as err:
+        state[2] = err
+        return False
+    return True
+
+
+cdef bint _substitute_fixed(cppExpression[bias_type, index_type]& expression,
+                            const vector[char]& fixed,
+                            const vector[bias_type]& assignments) noexcept:
+    # Substitute each variable of the expression that is marked in `fixed` by
+    # its assignment. Return whether one of them was a BINARY variable fixed
+    # to a nonzero value. `fixed` is 0 for the other variables, 1 for
+    # the fixed variables and 2 for the BINARY variables fixed to nonzero.
+    cdef bint nonzero = False
+    cdef index_type v
+    for v in expression.variables():
+        if fixed[v]:
+            # a multiplier of 0 leaves the variables of the expression as they are
+            expression.substitute_variable(v, 0, assignments[v])
+            nonzero = nonzero or fixed[v] == 2
+    return nonzero
+
+
 # todo: move to cyutilities?
 cdef cppSense cppsense(object sense) except? cppSense.GE:
     if isinstance(sense, str):
@@ -332,6 +391,21 @@ cdef class cyConstrainedQuadraticModel:
         self.constraint_labels._clear()
         self.cppcqm.clear()
 
+    @staticmethod
+    def counters(bint reset=False):
+        """Return the counts of events on the hot paths of the model.
+
+        The counts cover the operations on the objective and the constraints,
+        including those made through :class:`cyQMBase` methods. They have the
+        same keys as the counts returned by
+        ``BinaryQuadraticModel.data.counters()``.
+
+        Args:
+            reset: If True, set the counts to 0 after reading them.
+        """
+        # this module and cyQMBase's module each have their own counters
+        return counters_as_dict(reset, cyQMBase.counters(reset))
+
     def fix_variable(self, v, bias_type assignment):
         cdef Py_ssize_t vi = self.variables.index(v)
 
@@ -350,15 +424,38 @@ cdef class cyConstrainedQuadraticModel:
         if isinstance(fixed, typing.Mapping):
             fixed = fixed.items()
 
-        if inplace:
-            for v, assignment in fixed:
-                self.fix_variable(v, assignment)
-            return self
-
         cdef vector[index_type] variables
         cdef vector[bias_type] assignments
         labels = set()
 
+        cdef vector[char] is_fixed
+        cdef cppConstraint[bias_type, index_type]* constraint
+        if inplace:
+            # mark the fixed variables, then substitute them and update the
+            # discrete markers in one pass over the constraints, and finally
+            # remove them all in one pass
+            is_fixed.resize(self.cppcqm.num_variables(), 0)
+            assignments.resize(self.cppcqm.num_variables(), 0)
+            for v, assignment in fixed:
+                vi = self.variables.index(v)
+                if is_fixed[vi]:
+                    continue  # the first assignment wins
+
+                # as in fix_variable(), constraints with BINARY variables fixed
+                # to nonzero values are no longer discrete
+                is_fixed[vi] = 2 if self.cppcqm.vartype(vi) == cppVartype.BINARY and assignment else 1
+                assignments[vi] = assignment
+                variables.push_back(vi)
+
+            _substitute_fixed(self.cppcqm.objective, is_fixed, assignments)
+            for i in range(self.cppcqm.num_constraints()):
+                constraint = &self.cppcqm.constraint_ref(i)
+                if _substitute_fixed(deref(constraint), is_fixed, assignments):
+                    constraint.mark_discrete(False)
+
+            self._remove_variables_by_index(variables)
+            return self
+
         for v, bias in fixed:
             variables.push_back(self.variables.index(v))
             assignments.push_back(bias)
@@ -432,6 +529,43 @@ cdef class cyConstrainedQuadraticModel:
 
         return cqm
 
+    @classmethod
+    def _from_file_native(cls, file, Py_ssize_t start, Py_ssize_t length, int num_threads = 1):
+        """Inverse of ._to_file_native().
+
+        The model is read from the ``length`` bytes of ``file`` following
+        ``start``. Each block is read as it is decoded, by up to
+        ``num_threads`` threads, so the whole file is never held in memory.
+        """
+        state = [file, start, None]
+
+        cdef cppConstrainedQuadraticModelReader[bias_type, index_type]* reader = NULL
+        cdef cppConstrainedQuadraticModel[bias_type, index_type] cppcqm
+        try:
+            reader = new cppConstrainedQuadraticModelReader[bias_type, index_type](
+                _read_file, <void*>state, length)
+            with nogil:
+                cppcqm = reader.load(num_threads)
+            variable_labels = reader.variable_labels()
+            constraint_labels = reader.constraint_labels()
+        except RuntimeError:
+            if state[2] is not None:
+                raise state[2]
+            raise
+        finally:
+            del reader
+
+        cqm = make_cqm(move(cppcqm))
+
+        if variable_labels:
+            cqm.relabel_variables(dict(enumerate(map(
+                deserialize_variable, json.loads(variable_labels)))))
+        if constraint_labels:
+            cqm.relabel_constraints(dict(enumerate(map(
+                deserialize_variable, json.loads(constraint_labels)))))
+
+        return cqm
+
     @cython.boundscheck(False)
     @cython.wraparound(False)
     def _ivarinfo(self):
@@ -494,6 +628,44 @@ cdef class cyConstrainedQuadraticModel:
         """
         return as_numpy_float(self.cppcqm.lower_bound(self.variables.index(v)))
 
+    def memory_usage(self, capacity=False):
+        """Get a breakdown of the memory used by the model.
+
+        Args:
+            capacity: If ``capacity`` is true, use the ``std::vector::capacity``
+                of the underlying vectors rather than their size.
+
+        Returns:
+            A dict with the memory used by the ``objective`` and by the
+            ``constraints``, each broken down as in
+            :meth:`.BinaryQuadraticModel.memory_usage`, as well as the bytes
+            used by the ``variables``' vartypes and bounds, the variable and
+            constraint ``labels``, and the ``total``. The constraints' count
+            of ``other`` bytes includes their senses, right-hand sides and
+            other metadata.
+
+        Examples:
+            >>> x, y = dimod.Binaries('xy')
+            >>> cqm = dimod.ConstrainedQuadraticModel()
+            >>> cqm.set_objective(x + y)
+            >>> cqm.add_constraint(x + y <= 1, label='c')
+            'c'
+            >>> usage = cqm.memory_usage()
+            >>> usage['total'] > usage['objective']['total'] + usage['constraints']['total']
+            True
+
+        """
+        cdef bint cap = capacity
+        total = memory_usage_as_dict(self.cppcqm.memory_usage(cap))
+        labels = self.variables._nbytes() + self.constraint_labels._nbytes()
+        return dict(
+            objective=memory_usage_as_dict(self.cppcqm.objective.memory_usage(cap)),
+            constraints=memory_usage_as_dict(self.cppcqm.constraints_memory_usage(cap)),
+            variables=total['variables'],
+            labels=labels,
+            total=total['total'] + labels,
+        )
+
     def num_constraints(self):
         return self.cppcqm.num_constraints()
 
@@ -517,6 +689,31 @@ cdef class cyConstrainedQuadraticModel:
         self.cppcqm.remove_variable(vi)
         self.variables._remove(v)
 
+    def remove_variables(self, variables):
+        """Remove several variables from the model.
+
+        This is faster than calling :meth:`remove_variable` for each variable.
+        """
+        cdef vector[index_type] indices
+        for v in variables:
+            indices.push_back(self.variables.index(v))
+        self._remove_variables_by_index(indices)
+
+    cdef void _remove_variables_by_index(self, vector[index_type]& indices) except *:
+        if indices.empty():
+            return
+
+        self.cppcqm.remove_variables(indices.begin(), indices.end())
+
+        # rebuild the labels in a single pass
+        cdef vector[bint] removed = vector[bint](self.variables.size(), False)
+        cdef index_type vi
+        for vi in indices:
+            removed[vi] = True
+        kept = [self.variables.at(vi) for vi in range(self.variables.size()) if not removed[vi]]
+        self.variables._clear()
+        self.variables._extend(kept)
+
     def set_lower_bound(self, v, bias_type lb):
         """Set the lower bound for a variable.
 
@@ -721,6 +918,104 @@ cdef class cyConstrainedQuadraticModel:
         """
         return as_numpy_float(self.cppcqm.upper_bound(self.variables.index(v)))
 
+    def _to_file_native(self, file, int num_threads = 1):
+        """Write the model to ``file`` using CQM file format version 3.0.
+
+        The constraints are encoded by up to ``num_threads`` threads and
+        written in bounded batches as they are encoded.
+        """
+        cdef cppDumpOptions options
+        options.num_threads = num_threads
+
+        if not self.variables._is_range():
+            options.variable_labels = json.dumps(self.variables.to_serializable()).encode()
+        if not self.constraint_labels._is_range():
+            options.constraint_labels = json.dumps(self.constraint_labels.to_serializable()).encode()
+
+        state = [file, None]
+        try:
+            with nogil:
+                cppdump(self.cppcqm, _write_file, <void*>state, options)
+        except RuntimeError:
+            if state[1] is not None:
+                raise state[1]
+            raise
+
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _violations_impl(self, const Numeric[:, ::1] samples, cyVariables labels):
+        cdef Py_ssize_t num_samples = samples.shape[0]
+        cdef Py_ssize_t num_variables = self.cppcqm.num_variables()
+
+        if samples.shape[1] != labels.size():
+            # as_samples should never return inconsistent sizes, but we do this
+            # check because the boundscheck is off and we otherwise might get
+            # segfaults
+            raise RuntimeError("as_samples returned an inconsistent samples/variables")
+
+        # get the indices of the CQM variables
+        cdef Py_ssize_t[::1] cqm_to_sample = labels.index_array(self.variables)
+        cdef Py_ssize_t vi
+
+        # if the CQM's variables are a prefix of the sample's we can use the
+        # samples directly, otherwise we make a copy in the CQM's order
+        cdef bint ordered = True
+        for vi in range(num_variables):
+            if cqm_to_sample[vi] != vi:
+                ordered = False
+                break
+
+        cdef const Numeric[:, ::1] cqm_samples
+        if ordered:
+            cqm_samples = samples
+        else:
+            cqm_samples = np.ascontiguousarray(np.asarray(samples)[:, np.asarray(cqm_to_sample)])
+
+        cdef float64_t[:, ::1] violations = np.empty(
+            (num_samples, self.cppcqm.num_constraints()), dtype=np.float64)
+
+        if num_samples == 0 or violations.shape[1] == 0:
+            return violations
+
+        cdef const Numeric* samples_ptr = NULL
+        if cqm_samples.shape[1]:
+            samples_ptr = &cqm_samples[0, 0]
+
+        with nogil:
+            self.cppcqm.violations(samples_ptr, num_samples, cqm_samples.shape[1],
+                                   &violations[0, 0], 0)
+
+        return violations
+
+    def _violations(self, samples_like):
+        """Return the violation of every constraint for every sample.
+
+        Args:
+            samples_like: A collection of samples. `samples-like` is an
+                extension of NumPy's array_like structure. See :func:`.as_samples`.
+
+        Returns:
+            A :class:`numpy.ndarray` of shape ``(num_samples, num_constraints)``.
+            The columns are in the same order as :attr:`.constraint_labels`.
+            See :meth:`.iter_constraint_data` for how the violation is defined.
+
+        """
+        samples, labels = as_samples(samples_like, labels_type=Variables)
+
+        # we need contiguous and unsigned. as_samples actually enforces contiguous
+        # but no harm in double checking for some future-proofness
+        samples = np.ascontiguousarray(
+                samples,
+                dtype=f'i{samples.dtype.itemsize}' if np.issubdtype(samples.dtype, np.unsignedinteger) else None,
+                )
+
+        try:
+            return np.asarray(self._violations_impl(samples, labels))
+        except TypeError as err:
+            if np.issubdtype(samples.dtype, np.floating) or np.issubdtype(samples.dtype, np.signedinteger):
+                raise err
+            raise ValueError(f"unsupported sample dtype: {samples.dtype.name}")
+
     def vartype(self, v):
         """Vartype of the given variable.
         
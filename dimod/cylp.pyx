@@ -1,6 +1,3 @@
-# distutils: include_dirs = extern/
-# distutils: sources = extern/filereaderlp/reader.cpp
-
 # Copyright 2022 D-Wave Systems Inc.
 #
 #    Licensed under the Apache License, Version 2.0 (the "License");
@@ -22,182 +19,81 @@ from libcpp.utility cimport move
 from libcpp.vector cimport vector
 
 from dimod.constrained.cyconstrained cimport cyConstrainedQuadraticModel, make_cqm
-from dimod.libcpp.constrained_quadratic_model cimport ConstrainedQuadraticModel as cppCQM
+from dimod.libcpp.lp cimport Format, LPModel, dump_file, dumps, read_file
+from dimod.libcpp.lp cimport LP as cppLP, MPS as cppMPS
 from dimod.quadratic.cyqm.cyqm_float64 cimport bias_type, index_type
 
 
-cdef extern from "filereaderlp/model.hpp":
-    cdef cppclass Variable:
-        string name
-
-    cdef cppclass Expression:
-        string name
-
-    cdef cppclass Constraint:
-        Expression* expr
-
-    cdef cppclass Model:
-        vector[Variable*] variables
-        vector[Constraint*] constraints
+def cyread_lp_file(object filename, int num_threads = 1):
+    """Create a constrained quadratic model from the given LP file.
 
-cdef extern from "filereaderlp/reader.hpp":
-    Model readinstance(string filename) except+
-
-
-# We do a funny there whereby we implement the C++ code here rather than in
-# a dedicated .cpp file.
-# The reason we use C++ rather than Cython is we do a lot of iterating over
-# vectors of pointers which is quite hard to read in Cython
-# The reason we do it here is because we're wrapping a library that has both
-# .h and .cpp files, so we would no longer be a header-only library if we
-# included that in dimod/include/
-# In the future, we should reconsider the requirement to be header-only but
-# for now this keeps things contained and on this side of the compilation
-# barrier.
-cdef extern from *: 
+    The constraints are parsed by up to ``num_threads`` threads. If
+    ``num_threads`` is less than 1, the number of concurrent threads supported
+    by the hardware is used.
     """
-    #include <limits>
-    #include <unordered_map>
-
-    #include "filereaderlp/model.hpp"
-    #include "dimod/constrained_quadratic_model.h"
-    #include "dimod/vartypes.h"
-
-    dimod::Vartype variable_type_to_vartype(VariableType type) {
-        switch (type) {
-            case VariableType::CONTINUOUS :
-                return dimod::Vartype::REAL;
-            case VariableType::BINARY :
-                return dimod::Vartype::BINARY;
-            case VariableType::GENERAL :
-                return dimod::Vartype::INTEGER;
-            default :
-                throw std::domain_error("unsupported vartype");
-        }
-    }
-
-    template<class bias_type, class index_type>
-    void copy_expression(const Expression& source, dimod::Expression<bias_type, index_type>& target,
-                         const std::unordered_map<Variable*, index_type>& variable_mapping,
-                         const bool is_objective = false) {
-
-        for (auto& term_ptr : source.linterms) {
-            const index_type v = variable_mapping.at(term_ptr->var.get());
-
-            target.add_linear(v, term_ptr->coef);
-        }
-
-        // need to correct for the LP file's stupid handling of quadratic terms in the objective
-        const bias_type mul = (is_objective) ? .5 : 1;
-
-        for (auto& term_ptr : source.quadterms) {
-            const index_type u = variable_mapping.at(term_ptr->var1.get());
-            const index_type v = variable_mapping.at(term_ptr->var2.get());
-
-            target.add_quadratic(u, v, mul * term_ptr->coef);
-        }
-
-        target.add_offset(source.offset);
-    }
-
-    template<class bias_type, class index_type>
-    dimod::ConstrainedQuadraticModel<bias_type, index_type> model_to_cqm(const Model& model) {
-        auto cqm = dimod::ConstrainedQuadraticModel<bias_type, index_type>();
-
-        // Copy the variables into the CQM, keeping track of the indices
-        std::unordered_map<Variable*, index_type> variable_mapping;
-
-        for (const auto& v : model.variables) {
-            auto vartype = variable_type_to_vartype(v->type);
-
-            bias_type lb = v->lowerbound;
-            bias_type ub = v->upperbound;
-
-            const bias_type min_bound = dimod::vartype_info<bias_type>::min(vartype);
-            const bias_type max_bound = dimod::vartype_info<bias_type>::max(vartype);
-
-            if (lb < min_bound) {
-                lb = min_bound;
-            } else if (lb > max_bound) {
-                lb = max_bound;
-            }
-
-            if (ub < min_bound) {
-                ub = min_bound;
-            } else if (ub > max_bound) {
-                ub = max_bound;
-            }
-
-            variable_mapping.emplace(v.get(), cqm.add_variable(vartype, lb, ub));
-        }
-
-        // Copy the objective
-        copy_expression(*(model.objective), cqm.objective, variable_mapping, true);
-
-        // Then the constraints
-        for (const auto& constraint_ptr : model.constraints) {
-            auto constraint = cqm.new_constraint();
-
-            copy_expression(*(constraint_ptr->expr), constraint, variable_mapping);
-
-            // handle the bounds
-            if (constraint_ptr->lowerbound == constraint_ptr->upperbound) {
-                // Equality
-                constraint.set_sense(dimod::Sense::EQ);
-                constraint.set_rhs(constraint_ptr->lowerbound);
-            } else if (constraint_ptr->lowerbound == -std::numeric_limits<double>::infinity()) {
-                // Less than or equal to
-                constraint.set_sense(dimod::Sense::LE);
-                constraint.set_rhs(constraint_ptr->upperbound);
-            } else if (constraint_ptr->upperbound == +std::numeric_limits<double>::infinity()) {
-                // Greater than or equal to
-                constraint.set_sense(dimod::Sense::GE);
-                constraint.set_rhs(constraint_ptr->lowerbound);
-            } else {
-                throw std::domain_error("unexpected constraint sense");
-            }
-
-            cqm.add_constraint(std::move(constraint));
-        }
-
-        // Handle maximization
-        if (model.sense == ObjectiveSense::MAX) {
-            cqm.objective.scale(-1);
-        }
-
-        return cqm;
-    }
-    """
-    cppCQM[bias_type, index_type] model_to_cqm[bias_type, index_type](const Model&) except+
-
-
-def cyread_lp_file(object filename):
-    """Create a constrained quadratic model from the given LP file."""
 
     if not os.path.isfile(filename):
         raise ValueError(f"no file named {filename}")
 
-    # A Model as returned by the LP-file reader
-    cdef Model model = readinstance(<string>(filename.encode()))
-
-    # Convert to a C++ CQM
-    cdef cppCQM[bias_type, index_type] cppcqm = model_to_cqm[bias_type, index_type](model)
+    # The CQM is built directly from the file, along with its labels
+    cdef LPModel[bias_type, index_type] lp
+    cdef string cppfilename = filename.encode()
+    with nogil:
+        lp = read_file[bias_type, index_type](cppfilename, num_threads)
 
     # Create the Python/Cython CQM, from the C++ one (using a move to avoid the copy)
-    cdef cyConstrainedQuadraticModel cqm = make_cqm(move(cppcqm))
+    cdef cyConstrainedQuadraticModel cqm = make_cqm(move(lp.model))
 
     # Relabel the variables
     variable_mapping = dict()
-    for i in range(model.variables.size()):
-        variable_mapping[i] = model.variables[i].name.decode()
+    for i in range(lp.variable_labels.size()):
+        variable_mapping[i] = lp.variable_labels[i].decode()
     assert(len(variable_mapping) == cqm.num_variables())
     cqm.relabel_variables(variable_mapping)
 
     # Relabel the constraints
     constraint_mapping = dict()
-    for i in range(model.constraints.size()):
-        if model.constraints[i].expr.name.size():
-            constraint_mapping[i] = model.constraints[i].expr.name.decode()
+    for i in range(lp.constraint_labels.size()):
+        if lp.constraint_labels[i].size():
+            constraint_mapping[i] = lp.constraint_labels[i].decode()
     cqm.relabel_constraints(constraint_mapping)
 
     return cqm
+
+
+cdef Format _format(str format) except *:
+    if format == 'lp':
+        return cppLP
+    elif format == 'mps':
+        return cppMPS
+    raise ValueError(f"unknown format {format!r}, expected 'lp' or 'mps'")
+
+
+def cywrite_lp_file(cyConstrainedQuadraticModel cqm, object filename = None, str format = 'lp'):
+    """Write the constrained quadratic model as an LP or MPS file.
+
+    If ``filename`` is not given, the contents are returned as :class:`bytes`.
+    The variable and constraint labels must already be valid for the format.
+    """
+    cdef Format cppformat = _format(format)
+
+    cdef vector[string] variable_labels
+    variable_labels.reserve(cqm.num_variables())
+    for v in cqm.variables:
+        variable_labels.push_back(v.encode())
+
+    cdef vector[string] constraint_labels
+    constraint_labels.reserve(cqm.num_constraints())
+    for c in cqm.constraint_labels:
+        constraint_labels.push_back(c.encode())
+
+    cdef string cppfilename
+    cdef string buff
+    if filename is None:
+        with nogil:
+            buff = dumps(cqm.cppcqm, variable_labels, constraint_labels, cppformat)
+        return buff
+
+    cppfilename = filename.encode()
+    with nogil:
+        dump_file(cqm.cppcqm, cppfilename, variable_labels, constraint_labels, cppformat)
@@ -17,6 +17,7 @@
 
 from dimod.cyvariables cimport cyVariables
 from dimod.libcpp.abc cimport QuadraticModelBase as cppQuadraticModelBase
+from dimod.libcpp.local_field_state cimport LocalFieldState as cppLocalFieldState
 
 
 cdef class cyQMBase_template:
@@ -30,3 +31,12 @@ cdef class cyQMBase_template:
     cpdef bint is_linear(self)
     cpdef Py_ssize_t num_interactions(self)
     cpdef Py_ssize_t num_variables(self)
+
+
+cdef class cyLocalFieldState_template:
+    cdef cppLocalFieldState[bias_type, index_type]* ptr
+
+    # we hold a reference to the model so it is not garbage collected
+    cdef readonly cyQMBase_template model
+
+    cdef Py_ssize_t _index(self, v) except -1
@@ -19,11 +19,12 @@ cimport cython
 from cython.operator cimport preincrement as inc, dereference as deref
 from libcpp.algorithm cimport lower_bound as cpplower_bound
 
+from dimod.libcpp.instrumentation cimport counters_as_dict, memory_usage_as_dict
 from dimod.libcpp.vartypes cimport Vartype as cppVartype
 
 from dimod.cyutilities cimport as_numpy_float
 from dimod.sampleset import as_samples
-from dimod.typing cimport Numeric, float64_t, int8_t
+from dimod.typing cimport Numeric, float64_t, int8_t, int64_t
 from dimod.variables import Variables
 from dimod.vartypes import Vartype
 
@@ -64,6 +65,25 @@ cdef class cyQMBase_template:
         self.base.clear()
         self.variables._clear()
 
+    @staticmethod
+    def counters(bint reset=False):
+        """Return the counts of events on the hot paths of the models.
+
+        The counts are only collected when dimod is compiled with
+        ``DIMOD_ENABLE_COUNTERS`` defined, see the ``enabled`` key. They are
+        shared by every model of the same class.
+
+        Args:
+            reset: If True, set the counts to 0 after reading them.
+
+        Returns:
+            A dict with the number of ``reallocations`` of the vectors of
+            biases, the number of ``quadratic_inserts`` of new interactions
+            and ``quadratic_hits`` on existing ones, and the number of
+            ``energy_calls``.
+        """
+        return counters_as_dict(reset)
+
     def degree(self, v):
         cdef Py_ssize_t vi = self.variables.index(v)
         return self.base.degree(vi)
@@ -81,31 +101,35 @@ cdef class cyQMBase_template:
             raise RuntimeError("as_samples returned an inconsistent samples/variables")
 
         # get the indices of the QM variables
-        cdef Py_ssize_t[::1] qm_to_sample = np.empty(self.num_variables(), dtype=np.intp)
+        cdef Py_ssize_t[::1] qm_to_sample = labels.index_array(self.variables)
         cdef Py_ssize_t si
-        for si in range(self.num_variables()):
-            qm_to_sample[si] = labels.index(self.variables.at(si))
 
-        cdef float64_t[::1] energies = np.empty(num_samples, dtype=np.float64)
+        # if the QM's variables are a prefix of the sample's we can use the
+        # samples directly, otherwise we make a copy in the QM's order
+        cdef bint ordered = True
+        for si in range(self.num_variables()):
+            if qm_to_sample[si] != si:
+                ordered = False
+                break
 
-        # alright, now let's calculate some energies!
-        cdef Py_ssize_t ui, vi
-        for si in range(num_samples):
-            # offset
-            energies[si] = self.base.offset()
+        cdef const Numeric[:, ::1] qm_samples
+        if ordered:
+            qm_samples = samples
+        else:
+            qm_samples = np.ascontiguousarray(np.asarray(samples)[:, np.asarray(qm_to_sample)])
 
-            for ui in range(self.num_variables()):
-                # linear
-                energies[si] += self.base.linear(ui) * samples[si, qm_to_sample[ui]];
+        cdef float64_t[::1] energies = np.empty(num_samples, dtype=np.float64)
 
-                it = self.base.cbegin_neighborhood(ui)
-                end = self.base.cend_neighborhood(ui)
-                while it != end and deref(it).v <= ui:
-                    vi = deref(it).v
+        if num_samples == 0:
+            return energies
 
-                    energies[si] += deref(it).bias * samples[si, qm_to_sample[ui]] * samples[si, qm_to_sample[vi]]
+        cdef const Numeric* samples_ptr = NULL
+        if qm_samples.shape[1]:
+            samples_ptr = &qm_samples[0, 0]
 
-                    inc(it)
+        # alright, now let's calculate some energies!
+        with nogil:
+            self.base.energies(samples_ptr, num_samples, qm_samples.shape[1], &energies[0], 0)
 
         return energies
 
@@ -251,6 +275,23 @@ cdef class cyQMBase_template:
         cdef bias_type lb = self.base.lower_bound(vi)
         return as_numpy_float(lb)
 
+    def local_field_state(self, sample_like):
+        """Return the local field state of the model at the given sample.
+
+        The model must not be modified while the returned state is in use.
+        """
+        return cyLocalFieldState_template(self, sample_like)
+
+    def memory_usage(self, bint capacity = False):
+        """Return a breakdown of the memory used by the model, in bytes.
+
+        See :meth:`.BinaryQuadraticModel.memory_usage`.
+        """
+        usage = memory_usage_as_dict(self.base.memory_usage(capacity))
+        usage['labels'] = self.variables._nbytes()
+        usage['total'] += usage['labels']
+        return usage
+
     def nbytes(self, bint capacity = False):
         return self.base.nbytes(capacity)
 
@@ -408,6 +449,39 @@ cdef class cyQMBase_template:
     def scale(self, bias_type scalar):
         self.base.scale(scalar)
 
+    def to_csr(self, *, bint upper_triangular=True):
+        """Return the quadratic biases as CSR-formatted arrays.
+
+        Returns a 3-tuple of NumPy arrays ``(indptr, indices, data)``, in
+        variable index order, with the columns of each row sorted. If
+        ``upper_triangular`` is true then each interaction appears once,
+        otherwise the matrix is symmetric. ``indptr`` is ``int64`` because
+        it counts the entries, which can exceed the range of the index dtype.
+        """
+        cdef Py_ssize_t num_variables = self.num_variables()
+        cdef Py_ssize_t capacity = self.num_interactions()
+        if not upper_triangular:
+            capacity *= 2
+
+        indptr = np.empty(num_variables + 1, dtype=np.int64)
+        indices = np.empty(capacity, dtype=self.index_dtype)
+        data = np.empty(capacity, dtype=self.dtype)
+
+        cdef int64_t[::1] indptr_view = indptr
+        cdef index_type[::1] indices_view = indices
+        cdef bias_type[::1] data_view = data
+
+        cdef index_type* indices_ptr = NULL
+        cdef bias_type* data_ptr = NULL
+        if capacity:
+            indices_ptr = &indices_view[0]
+            data_ptr = &data_view[0]
+
+        cdef Py_ssize_t nnz = self.base.to_csr(&indptr_view[0], indices_ptr, data_ptr,
+                                               upper_triangular)
+
+        return indptr, indices[:nnz], data[:nnz]
+
     def upper_bound(self, v):
         cdef Py_ssize_t vi = self.variables.index(v)
         return as_numpy_float(self.base.upper_bound(vi))
@@ -426,3 +500,76 @@ cdef class cyQMBase_template:
             return Vartype.REAL
         else:
             raise RuntimeError("unexpected vartype")
+
+
+cdef class cyLocalFieldState_template:
+    """A sample of a model together with the local field of each variable.
+
+    The energy change from setting a single variable to a new value is
+    calculated in constant time. Applying the change takes time linear in the
+    degree of the variable.
+
+    The model must not be modified while the state is in use.
+    """
+    def __cinit__(self):
+        self.ptr = NULL
+
+    def __init__(self, cyQMBase_template model, sample_like):
+        samples, labels = as_samples(sample_like, labels_type=Variables)
+
+        if samples.shape[0] != 1:
+            raise ValueError("sample_like must contain exactly one sample")
+
+        # put the sample into the model's variable order
+        cdef bias_type[::1] sample = np.ascontiguousarray(
+            samples[0, labels.index_array(model.variables)], dtype=BIAS_DTYPE)
+
+        cdef const bias_type* sample_ptr = NULL
+        if sample.shape[0]:
+            sample_ptr = &sample[0]
+
+        self.model = model
+        self.ptr = new cppLocalFieldState[bias_type, index_type](deref(model.base), sample_ptr)
+
+    def __dealloc__(self):
+        if self.ptr is not NULL:
+            del self.ptr
+
+    cdef Py_ssize_t _index(self, v) except -1:
+        if <size_t>self.model.num_variables() != self.ptr.num_variables():
+            raise RuntimeError("the model was modified after the state was created")
+        return self.model.variables.index(v)
+
+    def apply(self, v, bias_type value):
+        """Set variable ``v`` to ``value``."""
+        self.ptr.apply(self._index(v), value)
+
+    def delta(self, v, bias_type value):
+        """Return the energy change from setting variable ``v`` to ``value``."""
+        return as_numpy_float(self.ptr.delta(self._index(v), value))
+
+    def delta_flip(self, v):
+        """Return the energy change from flipping the binary or spin variable ``v``."""
+        return as_numpy_float(self.ptr.delta_flip(self._index(v)))
+
+    def energy(self):
+        """Return the energy of the current sample."""
+        return as_numpy_float(self.ptr.energy())
+
+    def flip(self, v):
+        """Flip the binary or spin variable ``v`` and return its new value."""
+        return as_numpy_float(self.ptr.flip(self._index(v)))
+
+    def local_field(self, v):
+        """Return the local field of variable ``v``."""
+        return as_numpy_float(self.ptr.local_field(self._index(v)))
+
+    def sample(self):
+        """Return the current sample as a dict."""
+        cdef const bias_type* values = self.ptr.sample().data()
+        return {self.model.variables.at(vi): as_numpy_float(values[vi])
+                for vi in range(self.ptr.num_variables())}
+
+    def value(self, v):
+        """Return the current value of variable ``v``."""
+        return as_numpy_float(self.ptr.value(self._index(v)))
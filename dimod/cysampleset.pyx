@@ -0,0 +1,95 @@
+# distutils: language = c++
+# cython: language_level=3
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+cimport cython
+
+from libcpp.vector cimport vector
+
+import numpy as np
+
+from dimod.libcpp.packed_samples cimport aggregate_samples as cppaggregate_samples
+from dimod.typing cimport Numeric
+
+__all__ = ['aggregate_samples']
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def aggregate_samples(const Numeric[:, :] samples, Numeric low, Numeric high):
+    """Find the distinct rows of an array of binary or spin samples.
+
+    The samples are packed one bit per value and deduplicated with a hash
+    table, in one pass and without sorting.
+
+    Args:
+        samples: A 2D array of samples. Every value must be ``low`` or ``high``.
+            Each row must be contiguous, but the rows can be strided, as they
+            are for the ``sample`` field of a :class:`~dimod.SampleSet` record.
+        low: The lower of the two values, 0 for binary samples and -1 for
+            spin samples.
+        high: The higher of the two values, 1 for binary and spin samples.
+
+    Returns:
+        A 2-tuple of the indices of the first occurrence of each distinct
+        sample, in the order they occur, and the index in the first array of
+        the distinct sample equal to each row.
+
+    Raises:
+        ValueError: If any value is not ``low`` or ``high``, or the rows are
+            not contiguous.
+    """
+    if low >= high:
+        raise ValueError("low must be less than high")
+
+    cdef Py_ssize_t num_samples = samples.shape[0]
+    cdef Py_ssize_t num_variables = samples.shape[1]
+    cdef Py_ssize_t itemsize = sizeof(Numeric)
+
+    if num_variables > 1 and samples.strides[1] != itemsize:
+        raise ValueError("the rows of samples must be contiguous")
+    if num_samples > 1 and samples.strides[0] % itemsize:
+        raise ValueError("the rows of samples must be aligned")
+
+    cdef Py_ssize_t si, vi
+    cdef bint valid = True
+    with nogil:
+        for si in range(num_samples):
+            for vi in range(num_variables):
+                if samples[si, vi] != low and samples[si, vi] != high:
+                    valid = False
+                    break
+            if not valid:
+                break
+    if not valid:
+        raise ValueError(f"every value of samples must be {low} or {high}")
+
+    inverse = np.empty(num_samples, dtype=np.uintp)
+    cdef size_t[::1] inverse_view = inverse
+
+    cdef const Numeric* ptr = &samples[0, 0] if num_samples and num_variables else NULL
+    cdef size_t stride = samples.strides[0] // itemsize if num_samples > 1 else num_variables
+    cdef vector[size_t] first
+    with nogil:
+        first = cppaggregate_samples(ptr, num_samples, stride, num_variables,
+                                     &inverse_view[0] if num_samples else NULL)
+
+    indices = np.empty(first.size(), dtype=np.intp)
+    cdef Py_ssize_t[::1] indices_view = indices
+    for si in range(indices_view.shape[0]):
+        indices_view[si] = first[si]
+
+    return indices, inverse.astype(np.intp, copy=False)
@@ -15,6 +15,8 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+from libcpp.vector cimport vector
+
 __all__ = ['cyVariables']
 
 cdef class cyVariables:
@@ -22,9 +24,23 @@ cdef class cyVariables:
     cdef object _label_to_index
     cdef Py_ssize_t _stop
 
+    # When every label is a small non-negative int we store them in
+    # vectors rather than in the dicts. See cyvariables.pyx for details.
+    cdef vector[Py_ssize_t] _dense_labels  # index -> label
+    cdef vector[Py_ssize_t] _dense_index  # label -> index, or -1
+    cdef Py_ssize_t _num_displaced  # number of labels that are not their index
+
     cdef object at(self, Py_ssize_t)
     cdef Py_ssize_t size(self)
 
+    cdef bint _is_dense(self)
+    cdef Py_ssize_t _dense_label(self, object) except -2
+    cdef void _dense_append(self, Py_ssize_t)
+    cdef void _dense_clear(self)
+    cdef void _dense_from_range(self)
+    cdef void _dense_to_dict(self)
+    cdef bint _dict_to_dense(self) except -1
+
     cpdef object _append(self, object v=*, bint permissive=*)
     cpdef void _clear(self)
     cpdef object _extend(self, object iterable, bint permissive=*)
@@ -34,4 +50,5 @@ cdef class cyVariables:
     cdef Py_ssize_t _count_int(self, object) except -1
     cpdef Py_ssize_t count(self, object) except -1
     cpdef Py_ssize_t index(self, object, bint permissive=*) except -1
+    cpdef object index_array(self, object labels, bint permissive=*)
     cpdef _remove(self, object)
\ No newline at end of file
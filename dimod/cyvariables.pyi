@@ -17,6 +17,8 @@
 
 import typing
 
+import numpy
+
 from dimod.typing import Variable
 
 T = typing.TypeVar('T')
@@ -35,6 +37,7 @@ class cyVariables:
     def _append(self, v: typing.Optional[Variable] = None, permissive: bool = False) -> Variable: ...
     def _clear(self) -> None: ...
     def _is_range(self) -> bool: ...
+    def _nbytes(self) -> int: ...
     def _extend(self, iterable: typing.Iterable[Variable], permissive: bool = False) -> None: ...
     def _pop(self) -> Variable: ...
     def _relabel(self, mapping: typing.Mapping[Variable, Variable]) -> None: ...
@@ -43,3 +46,4 @@ class cyVariables:
     def copy(self: T) -> T: ...
     def count(self, v: Variable) -> int: ...
     def index(self, v: Variable, permissive: bool = False) -> int: ...
+    def index_array(self, labels: typing.Iterable[Variable], permissive: bool = False) -> numpy.ndarray: ...
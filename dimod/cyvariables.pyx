@@ -17,12 +17,19 @@
 # As sphinx==5.0.2, Sphinx cannot read the .pyi file, so we still keep the
 # type information in the docstring.
 
+import sys
+
+from collections.abc import Sized
 from numbers import Number
 
+cimport cython
+
 from cpython.long cimport PyLong_Check
 from cpython.dict cimport PyDict_Size, PyDict_Contains
 from cpython.ref cimport PyObject
 
+import numpy as np
+
 from dimod.utilities import iter_safe_relabels
 
 cdef extern from "Python.h":
@@ -30,11 +37,27 @@ cdef extern from "Python.h":
     PyObject* PyDict_GetItemWithError(object p, object key) except? NULL
 
 
+# Dense labels may exceed the number of variables by this much, so that models
+# built out of order do not immediately fall back to the dicts.
+cdef enum:
+    DENSE_SLACK = 1024
+
+
+# The variables are stored in one of three ways:
+#   range: the labels are [0, n). Only ._stop is set.
+#   dense: every label is a non-negative int no greater than about 2n. The
+#          labels are stored in ._dense_labels and ._dense_index, and the dicts
+#          are empty.
+#   dict:  anything else. ._index_to_label and ._label_to_index hold the labels
+#          that differ from their index.
+# We move from range to dense to dict as labels are added, and back to dense
+# when a relabel leaves only integer labels.
 cdef class cyVariables:
     def __init__(self, object iterable=None):
         self._index_to_label = dict()
         self._label_to_index = dict()
         self._stop = 0
+        self._num_displaced = 0
 
         if iterable is not None:
             if isinstance(iterable, cyVariables):
@@ -46,11 +69,18 @@ cdef class cyVariables:
             else:
                 self._extend(iterable, permissive=True)
 
+                # we may have fallen off the dense representation part way
+                if PyDict_Size(self._label_to_index):
+                    self._dict_to_dense()
+
     def __init_cyvariables__(self, cyVariables iterable):
         # everything is hashable, and this is not a deep copy
         self._index_to_label.update(iterable._index_to_label)
         self._label_to_index.update(iterable._label_to_index)
         self._stop = iterable._stop
+        self._dense_labels = iterable._dense_labels
+        self._dense_index = iterable._dense_index
+        self._num_displaced = iterable._num_displaced
 
     def __contains__(self, v):
         return bool(self.count(v))
@@ -87,6 +117,9 @@ cdef class cyVariables:
 
         if self._is_range():
             yield from range(self._stop)
+        elif self._is_dense():
+            for i in range(self._stop):
+                yield self._dense_labels[i]
         else:
             for i in range(self._stop):
                 yield self.at(i)
@@ -139,6 +172,19 @@ cdef class cyVariables:
 
         idx = self._stop
 
+        cdef Py_ssize_t vi
+        if not PyDict_Size(self._label_to_index) and (idx != v or self._is_dense()):
+            # we're range or dense, see if we can stay that way
+            vi = self._dense_label(v)
+            if vi >= 0:
+                if not self._is_dense():
+                    self._dense_from_range()
+                self._dense_append(vi)
+                self._stop += 1
+                return v
+
+            self._dense_to_dict()
+
         if idx != v:
             self._label_to_index[v] = idx
             self._index_to_label[idx] = v
@@ -146,6 +192,84 @@ cdef class cyVariables:
         self._stop += 1
         return v
 
+    cdef bint _is_dense(self):
+        return not self._dense_labels.empty()
+
+    cdef Py_ssize_t _dense_label(self, object v) except -2:
+        """Return `v` as a dense label, or -1 if it cannot be stored as one."""
+        if not PyLong_Check(v):
+            return -1
+
+        cdef Py_ssize_t vi
+        try:
+            vi = v
+        except OverflowError:
+            return -1
+
+        if vi < 0 or vi > 2 * self._stop + DENSE_SLACK:
+            return -1
+        return vi
+
+    cdef void _dense_append(self, Py_ssize_t vi):
+        # assumes that vi is not already a label
+        cdef Py_ssize_t idx = self._dense_labels.size()
+        self._dense_labels.push_back(vi)
+        if <size_t>vi >= self._dense_index.size():
+            self._dense_index.resize(vi + 1, -1)
+        self._dense_index[vi] = idx
+        if vi != idx:
+            self._num_displaced += 1
+
+    cdef void _dense_clear(self):
+        # release the memory rather than just clearing
+        vector[Py_ssize_t]().swap(self._dense_labels)
+        vector[Py_ssize_t]().swap(self._dense_index)
+        self._num_displaced = 0
+
+    cdef void _dense_from_range(self):
+        cdef Py_ssize_t i
+        self._dense_labels.resize(self._stop)
+        self._dense_index.resize(self._stop)
+        for i in range(self._stop):
+            self._dense_labels[i] = i
+            self._dense_index[i] = i
+        self._num_displaced = 0
+
+    cdef void _dense_to_dict(self):
+        # no-op if we're range
+        cdef Py_ssize_t i
+        for i in range(<Py_ssize_t>self._dense_labels.size()):
+            if self._dense_labels[i] != i:
+                self._label_to_index[self._dense_labels[i]] = i
+                self._index_to_label[i] = self._dense_labels[i]
+        self._dense_clear()
+
+    cdef bint _dict_to_dense(self) except -1:
+        """Move to the dense representation if all of the labels allow it.
+
+        Returns True if the representation was changed.
+        """
+        cdef Py_ssize_t vi
+        for v in self._label_to_index:
+            if self._dense_label(v) < 0:
+                return False
+
+        self._dense_from_range()
+        cdef Py_ssize_t idx
+        for idx, v in self._index_to_label.items():
+            self._dense_labels[idx] = v
+        self._dense_index.assign(self._dense_index.size(), -1)
+        for idx in range(self._stop):
+            vi = self._dense_labels[idx]
+            if <size_t>vi >= self._dense_index.size():
+                self._dense_index.resize(vi + 1, -1)
+            self._dense_index[vi] = idx
+        self._num_displaced = PyDict_Size(self._index_to_label)
+
+        self._label_to_index.clear()
+        self._index_to_label.clear()
+        return True
+
     cpdef void _clear(self):
         """Remove all variables.
 
@@ -157,11 +281,23 @@ cdef class cyVariables:
         """
         self._label_to_index.clear()
         self._index_to_label.clear()
+        self._dense_clear()
         self._stop = 0
 
     cpdef bint _is_range(self):
         """Return whether the variables are currently labelled [0, n)."""
-        return not PyDict_Size(self._label_to_index)
+        return not PyDict_Size(self._label_to_index) and not self._is_dense()
+
+    def _nbytes(self):
+        """Return an estimate of the bytes used to store the labels.
+
+        The dicts and vectors are counted but the labels themselves are not,
+        because they are usually shared with the caller.
+        """
+        return (sys.getsizeof(self._index_to_label)
+                + sys.getsizeof(self._label_to_index)
+                + self._dense_labels.capacity() * sizeof(Py_ssize_t)
+                + self._dense_index.capacity() * sizeof(Py_ssize_t))
 
     cpdef object _extend(self, object iterable, bint permissive=False):
         """Add new variables.
@@ -213,6 +349,19 @@ cdef class cyVariables:
 
         self._stop = idx = self._stop - 1
 
+        cdef Py_ssize_t vi
+        if self._is_dense():
+            vi = self._dense_labels.back()
+            self._dense_labels.pop_back()
+            self._dense_index[vi] = -1
+            while not self._dense_index.empty() and self._dense_index.back() < 0:
+                self._dense_index.pop_back()
+            if vi != idx:
+                self._num_displaced -= 1
+            if not self._num_displaced:
+                self._dense_clear()  # back to range
+            return vi
+
         label = self._index_to_label.pop(idx, idx)
         self._label_to_index.pop(label, None)
         return label
@@ -233,6 +382,17 @@ cdef class cyVariables:
             the user.
 
         """
+        # relabel using the dicts, and then try to compact afterwards
+        self._dense_to_dict()
+
+        # whether all of the new labels could be dense, we check the mapping
+        # itself because the submaps may contain placeholder labels
+        cdef bint dense = True
+        for new in mapping.values():
+            if self._dense_label(new) < 0:
+                dense = False
+                break
+
         for submap in iter_safe_relabels(mapping, self):
             for old, new in submap.items():
                 if old == new:
@@ -246,6 +406,9 @@ cdef class cyVariables:
                 else:
                     self._index_to_label.pop(idx, None)
 
+        if dense and PyDict_Size(self._label_to_index):
+            self._dict_to_dense()
+
     def _relabel_as_integers(self):
         """Relabel the variables as integers in-place.
 
@@ -265,6 +428,9 @@ cdef class cyVariables:
             >>> print(variables)
             Variables(['a', 'b', 'c', 'd'])
 
+        If the variables are all integers, this compacts them to ``[0, n)``
+        and releases the storage used for the labels.
+
         .. Caution::
 
             This method is semi-public. It is intended to be used by
@@ -272,6 +438,15 @@ cdef class cyVariables:
             the user.
 
         """
+        cdef Py_ssize_t i
+        if self._is_dense():
+            mapping = dict()
+            for i in range(self._stop):
+                if self._dense_labels[i] != i:
+                    mapping[i] = self._dense_labels[i]
+            self._dense_clear()
+            return mapping
+
         mapping = self._index_to_label.copy()
         self._index_to_label.clear()
         self._label_to_index.clear()
@@ -292,11 +467,35 @@ cdef class cyVariables:
         """
         cdef Py_ssize_t vi = self.index(v)  # raises error if not present
 
+        if vi == self._stop - 1:
+            self._pop()
+            return
+
+        cdef Py_ssize_t i
+        if not PyDict_Size(self._label_to_index):
+            # range or dense, either way the result is dense so we can just
+            # shift the later labels down without touching the dicts
+            if not self._is_dense():
+                self._dense_from_range()
+
+            self._dense_index[self._dense_labels[vi]] = -1
+            self._dense_labels.erase(self._dense_labels.begin() + vi)
+            self._stop -= 1
+
+            self._num_displaced = 0
+            for i in range(self._stop):
+                if i >= vi:
+                    self._dense_index[self._dense_labels[i]] = i
+                if self._dense_labels[i] != i:
+                    self._num_displaced += 1
+            if not self._num_displaced:
+                self._dense_clear()
+            return
+
         # we can do better in terms of performance, but this is easy so until
         # we have reason to believe it's a bottleneck, let's just keep
         # the easy approach
         mapping = dict()
-        cdef Py_ssize_t i
         for i in range(vi, self.size() - 1):
             mapping[self.at(i)] = self.at(i+1)
         self._pop()
@@ -319,6 +518,8 @@ cdef class cyVariables:
         cdef PyObject* obj
         if self._is_range():
             v = pyidx
+        elif self._is_dense():
+            v = self._dense_labels[idx]
         else:
             # faster than self._index_to_label.get
             obj = PyDict_GetItemWithError(self._index_to_label, pyidx)
@@ -335,6 +536,9 @@ cdef class cyVariables:
         new._index_to_label = dict(self._index_to_label)
         new._label_to_index = dict(self._label_to_index)
         new._stop = self._stop
+        new._dense_labels = self._dense_labels
+        new._dense_index = self._dense_index
+        new._num_displaced = self._num_displaced
         return new
 
     cdef Py_ssize_t _count_int(self, object v) except -1:
@@ -344,6 +548,9 @@ cdef class cyVariables:
         if self._is_range():
             return 0 <= vi < self._stop
 
+        if self._is_dense():
+            return 0 <= vi < <Py_ssize_t>self._dense_index.size() and self._dense_index[vi] >= 0
+
         # need to make sure that we're not using the integer elsewhere
         return (0 <= vi < self._stop
                 and not PyDict_Contains(self._index_to_label, v)
@@ -396,6 +603,9 @@ cdef class cyVariables:
         if self._is_range():
             return v if PyLong_Check(v) else int(v)
 
+        if self._is_dense():
+            return self._dense_index[<Py_ssize_t>(v if PyLong_Check(v) else int(v))]
+
         # faster than self._label_to_index.get
         cdef PyObject* obj = PyDict_GetItemWithError(self._label_to_index, v)
         if obj == NULL:
@@ -405,6 +615,73 @@ cdef class cyVariables:
 
         return pyobj if PyLong_Check(pyobj) else int(pyobj)
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    cpdef object index_array(self, object labels, bint permissive=False):
+        """Return the indices of many variables.
+
+        Args:
+            labels (iterable[:class:`~dimod.typing.Variable`]):
+                The variables. A :class:`~numpy.ndarray` of integers, a
+                :class:`range` or another :class:`.Variables` is handled
+                in bulk when all of the variables are labelled with integers.
+
+            permissive (bool, optional, default=False):
+                If True, any missing variables will be inserted, in the order
+                they appear in ``labels``.
+
+        Returns:
+            :class:`~numpy.ndarray`: The index of each of the given
+            variables, as a 1D array of dtype :class:`~numpy.intp`.
+
+        Raises:
+            :exc:`ValueError`: If a variable is not present and ``permissive``
+                is ``False``.
+
+        """
+        cdef cyVariables other
+        if isinstance(labels, cyVariables):
+            other = labels
+            if other._is_range():
+                labels = range(other._stop)
+            elif other._is_dense():
+                labels = np.array(<Py_ssize_t[:other._stop]>other._dense_labels.data())
+
+        # for range and dense labels we can do the lookup with NumPy
+        cdef object arr = None
+        if PyDict_Size(self._label_to_index) == 0:
+            if isinstance(labels, range):
+                arr = np.arange(labels.start, labels.stop, labels.step, dtype=np.intp)
+            elif isinstance(labels, np.ndarray) and labels.dtype.kind in 'iu':
+                if labels.ndim != 1:
+                    raise ValueError("labels must be a 1D array")
+                arr = np.array(labels, dtype=np.intp)
+
+        if arr is not None and not arr.shape[0]:
+            return arr
+        elif arr is not None and self._is_range():
+            # when range-labelled, the labels are the indices
+            if arr.min() >= 0 and arr.max() < self._stop:
+                return arr
+        elif arr is not None:
+            if arr.min() >= 0 and arr.max() < <Py_ssize_t>self._dense_index.size():
+                arr = np.asarray(
+                    <Py_ssize_t[:self._dense_index.size()]>self._dense_index.data())[arr]
+                if arr.min() >= 0:
+                    return arr
+        # otherwise something is missing so we handle them one-by-one
+
+        if not isinstance(labels, Sized):
+            labels = list(labels)
+
+        out = np.empty(len(labels), dtype=np.intp)
+        cdef Py_ssize_t[::1] out_view = out
+        cdef Py_ssize_t i = 0
+        for v in labels:
+            out_view[i] = self.index(v, permissive=permissive)
+            i += 1
+        return out
+
     cdef Py_ssize_t size(self):
         """The number of variables.
 
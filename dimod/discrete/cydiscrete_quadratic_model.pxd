@@ -19,6 +19,7 @@
 from libcpp.vector cimport vector
 
 from dimod.libcpp.binary_quadratic_model cimport BinaryQuadraticModel as cppBinaryQuadraticModel
+from dimod.libcpp.discrete_quadratic_model cimport DiscreteQuadraticModel as cppDiscreteQuadraticModel
 from dimod.typing cimport float64_t, int32_t, Numeric, Integer
 
 ctypedef float64_t bias_type
@@ -29,6 +30,11 @@ cdef class cyDiscreteQuadraticModel:
     cdef vector[index_type] case_starts_  # len(adj_) + 1
     cdef vector[vector[index_type]] adj_
 
+    # a copy of the model with dense interaction blocks, used to calculate
+    # energies. It is rebuilt on demand after the model is changed
+    cdef cppDiscreteQuadraticModel[bias_type, index_type] dense_
+    cdef bint dense_current_
+
     cdef readonly object dtype
     cdef readonly object case_dtype
 
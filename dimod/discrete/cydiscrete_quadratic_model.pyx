@@ -25,6 +25,7 @@ import numpy as np
 
 from dimod.utilities import asintegerarrays, asnumericarrays
 from dimod.cyutilities cimport as_numpy_float
+from dimod.libcpp.instrumentation cimport MemoryUsage, memory_usage_as_dict
 from dimod.typing cimport Integer, int64_t, uint16_t, uint32_t, uint64_t
 
 BIAS_DTYPE = np.float64
@@ -78,12 +79,14 @@ cdef class cyDiscreteQuadraticModel:
 
     @offset.setter
     def offset(self, bias_type offset):
+        self.dense_current_ = False
         self.cppbqm.set_offset(offset)
 
     @cython.boundscheck(False)
     @cython.wraparound(False)
     def add_linear_equality_constraint(self, object terms,
                                        bias_type lagrange_multiplier, bias_type constant):
+        self.dense_current_ = False
         # adjust energy offset
         self.cppbqm.add_offset(lagrange_multiplier * constant * constant)
 
@@ -209,6 +212,8 @@ cdef class cyDiscreteQuadraticModel:
         if num_cases <= 0:
             raise ValueError("num_cases must be a positive integer")
 
+        self.dense_current_ = False
+
         cdef index_type v = self.adj_.size()  # index of new variable
 
         self.adj_.resize(v+1)
@@ -244,36 +249,31 @@ cdef class cyDiscreteQuadraticModel:
             raise ValueError("Given sample(s) have incorrect number of variables")
 
         cdef Py_ssize_t num_samples = samples.shape[0]
-        cdef index_type num_variables = samples.shape[1]
-
-        cdef bias_type[:] energies = np.full(num_samples, self.offset, dtype=self.dtype)
-
-        cdef Py_ssize_t si, vi
-        cdef index_type cu, case_u, cv, case_v
-        cdef index_type u, v
-        for si in range(num_samples):  # this could be parallelized
-            for u in range(num_variables):
-                case_u = samples[si, u]
-
-                if case_u >= self.num_cases(u):
-                    raise ValueError("invalid case")
+        cdef Py_ssize_t num_variables = samples.shape[1]
 
-                cu = self.case_starts_[u] + case_u
-
-                energies[si] += self.cppbqm.linear(cu)
+        cdef bias_type[::1] energies = np.empty(num_samples, dtype=self.dtype)
 
-                for vi in range(self.adj_[u].size()):
-                    v = self.adj_[u][vi]
+        if num_samples == 0:
+            return energies
 
-                    # we only care about the lower triangle
-                    if v > u:
-                        break
+        if num_variables == 0:
+            energies[:] = self.offset
+            return energies
 
-                    case_v = samples[si, v]
+        # each interaction is a lookup into a dense block rather than a search
+        # of the case neighborhoods, build the blocks if they are out of date
+        if not self.dense_current_:
+            self.dense_ = cppDiscreteQuadraticModel[bias_type, index_type](
+                self.cppbqm, self.case_starts_)
+            self.dense_current_ = True
 
-                    cv = self.case_starts_[v] + case_v
+        cdef const index_type[:, ::1] csamples = np.ascontiguousarray(samples)
 
-                    energies[si] += self.cppbqm.quadratic(cu, cv)
+        try:
+            with nogil:
+                self.dense_.energies(&csamples[0, 0], num_samples, num_variables, &energies[0], 0)
+        except IndexError:
+            raise ValueError("invalid case") from None
 
         return energies
 
@@ -511,6 +511,31 @@ cdef class cyDiscreteQuadraticModel:
 
     @cython.boundscheck(False)
     @cython.wraparound(False)
+    def memory_usage(self, bint capacity=False):
+        """Return a breakdown of the memory used by the model, in bytes.
+
+        The cases are stored as a binary quadratic model, whose breakdown is
+        extended with the case starts in ``variables`` and the interactions
+        between variables in ``quadratic``. The cache used to calculate
+        energies, if any, is counted in ``other``.
+        """
+        cdef MemoryUsage usage = self.cppbqm.memory_usage(capacity)
+
+        usage.variables += ((self.case_starts_.capacity() if capacity else self.case_starts_.size())
+                            * sizeof(index_type))
+
+        usage.quadratic += ((self.adj_.capacity() if capacity else self.adj_.size())
+                            * sizeof(vector[index_type]))
+        cdef Py_ssize_t vi
+        for vi in range(self.adj_.size()):
+            usage.quadratic += ((self.adj_[vi].capacity() if capacity else self.adj_[vi].size())
+                                * sizeof(index_type))
+
+        if self.dense_current_:
+            usage.other += self.dense_.memory_usage(capacity).total()
+
+        return memory_usage_as_dict(usage)
+
     cpdef Py_ssize_t num_cases(self, Py_ssize_t v=-1) except -1:
         """If v is provided, the number of cases associated with v, otherwise
         the total number of cases in the DQM.
@@ -544,6 +569,7 @@ cdef class cyDiscreteQuadraticModel:
     @cython.boundscheck(False)
     @cython.wraparound(False)
     cpdef Py_ssize_t set_linear(self, index_type v, Numeric[:] biases) except -1:
+        self.dense_current_ = False
 
         # self.num_cases checks that the variable is valid
 
@@ -558,6 +584,7 @@ cdef class cyDiscreteQuadraticModel:
     @cython.boundscheck(False)
     @cython.wraparound(False)
     cpdef Py_ssize_t set_linear_case(self, index_type v, index_type case, bias_type b) except -1:
+        self.dense_current_ = False
         
         # self.num_cases checks that the variable is valid
 
@@ -570,6 +597,7 @@ cdef class cyDiscreteQuadraticModel:
         self.cppbqm.set_linear(self.case_starts_[v] + case, b)
 
     def set_quadratic(self, index_type u, index_type v, biases):
+        self.dense_current_ = False
 
         # check that the interaction does in fact exist
         if u < 0 or u >= self.adj_.size():
@@ -630,6 +658,7 @@ cdef class cyDiscreteQuadraticModel:
                                         index_type u, index_type case_u,
                                         index_type v, index_type case_v,
                                         bias_type bias) except -1:
+        self.dense_current_ = False
 
         # self.num_cases checks that the variables are valid
 
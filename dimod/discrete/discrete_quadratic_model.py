@@ -620,6 +620,25 @@ class DiscreteQuadraticModel:
         return self._cydqm.get_quadratic_case(
             self.variables.index(u), u_case, self.variables.index(v), v_case)
 
+    def memory_usage(self, capacity=False):
+        """Get a breakdown of the memory used by the discrete quadratic model.
+
+        Args:
+            capacity: If ``capacity`` is true, use the ``std::vector::capacity``
+                of the underlying vectors rather than their size.
+
+        Returns:
+            A dict with the bytes used by the ``linear`` biases of the cases
+            and the offset, the ``quadratic`` interactions, the case starts in
+            ``variables``, the ``labels``, anything ``other`` and the
+            ``total``.
+
+        """
+        usage = self._cydqm.memory_usage(capacity)
+        usage['labels'] = self.variables._nbytes()
+        usage['total'] += usage['labels']
+        return usage
+
     def num_cases(self, v=None):
         """If v is provided, the number of cases associated with v, otherwise
         the total number of cases in the DQM.
@@ -0,0 +1,73 @@
+# distutils: language = c++
+# cython: language_level=3
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from cython.operator cimport dereference as deref
+
+from dimod.cyqmbase.cyqmbase_float64 cimport cyQMBase_float64, bias_type
+from dimod.libcpp.generators cimport Uniform, set_random_linear
+from dimod.libcpp.generators cimport add_gnm_interactions, add_gnp_interactions
+from dimod.typing cimport uint64_t
+
+__all__ = ['gnm_random', 'gnp_random']
+
+
+def gnm_random(cyQMBase_float64 model, uint64_t num_interactions, *,
+               uint64_t seed, bias_type low = 0, bias_type high = 1, int num_threads = 1):
+    """Set the biases of a model and add random interactions to it.
+
+    The linear biases, the offset and the biases of ``num_interactions``
+    interactions between distinct, uniformly random pairs of variables are
+    drawn uniformly from ``[low, high)``.
+
+    Args:
+        model: A model, usually without any interactions.
+        num_interactions: The number of interactions to add. At most the
+            number of pairs of variables.
+        seed: Seed of the random number streams.
+        low: Lower bound of the biases.
+        high: Upper bound of the biases.
+        num_threads: The maximum number of threads to use. All of the
+            available ones if less than 1. The model does not depend on it.
+    """
+    cdef Uniform[bias_type] uniform = Uniform[bias_type](low, high)
+    with nogil:
+        set_random_linear(deref(model.base), uniform, seed, num_threads)
+        add_gnm_interactions(deref(model.base), num_interactions, uniform, seed, num_threads)
+
+
+def gnp_random(cyQMBase_float64 model, double p, *,
+               uint64_t seed, bias_type low = 0, bias_type high = 1, int num_threads = 1):
+    """Set the biases of a model and add random interactions to it.
+
+    The linear biases, the offset and the biases of an interaction between
+    each pair of variables with probability ``p`` are drawn uniformly from
+    ``[low, high)``.
+
+    Args:
+        model: A model, usually without any interactions.
+        p: The probability of each interaction. Values outside of ``[0, 1]``
+            are clipped.
+        seed: Seed of the random number streams.
+        low: Lower bound of the biases.
+        high: Upper bound of the biases.
+        num_threads: The maximum number of threads to use. All of the
+            available ones if less than 1. The model does not depend on it.
+    """
+    cdef Uniform[bias_type] uniform = Uniform[bias_type](low, high)
+    with nogil:
+        set_random_linear(deref(model.base), uniform, seed, num_threads)
+        add_gnp_interactions(deref(model.base), p, uniform, seed, num_threads)
@@ -17,18 +17,66 @@ import collections.abc as abc
 
 import numbers
 
-from typing import Callable, Optional, Sequence, Union
+from typing import Callable, Optional, Sequence, Tuple, Union
 
 import numpy as np
 
 from dimod.binary_quadratic_model import BinaryQuadraticModel
 from dimod.decorators import graph_argument
+from dimod.generators.cyrandom import gnm_random, gnp_random
 from dimod.typing import Bias, GraphLike, Variable, VartypeLike
 from dimod.vartypes import Vartype
 
 __all__ = ['gnm_random_bqm', 'gnp_random_bqm', 'uniform', 'ran_r', 'randint', 'doped', "power_r"]
 
 
+def _native_seed(random_state: Optional[Union[np.random.RandomState, int]]) -> int:
+    """Draw a seed for the native generators from a random state or a seed."""
+    if not isinstance(random_state, np.random.RandomState):
+        random_state = np.random.RandomState(random_state)
+    high, low = random_state.randint(2**32, size=2, dtype=np.uint64)
+    return int(high) << 32 | int(low)
+
+
+def _finish_native(bqm: BinaryQuadraticModel,
+                   labels: Optional[Sequence[Variable]],
+                   bias_generator: Optional[Callable[[int], Sequence[Bias]]],
+                   ) -> BinaryQuadraticModel:
+    """Relabel a BQM built by the native generators and, if a bias generator
+    is given, replace its biases."""
+    if bias_generator is not None:
+        _, (irow, icol, _), _ = bqm.to_numpy_vectors(sort_indices=True)
+        ldata = bias_generator(bqm.num_variables)
+        qdata = bias_generator(len(irow))
+        offset, = bias_generator(1)
+        return BinaryQuadraticModel.from_numpy_vectors(ldata, (irow, icol, qdata),
+                                                       offset, bqm.vartype,
+                                                       variable_order=labels)
+
+    if labels is not None:
+        bqm.relabel_variables(dict(zip(range(bqm.num_variables), labels)))
+    return bqm
+
+
+def _edge_indices(variables: Sequence[Variable],
+                  edges: Sequence[Tuple[Variable, Variable]],
+                  ) -> Tuple[np.ndarray, np.ndarray]:
+    """Return the indices of the ends of each edge in ``variables`` as arrays."""
+    if not edges:
+        return np.empty(0, dtype=np.intp), np.empty(0, dtype=np.intp)
+
+    # the common case of a graph over range(n), no need to look up the labels
+    if list(variables) == list(range(len(variables))):
+        ends = np.asarray(edges)
+        if ends.ndim == 2 and ends.shape[1] == 2 and ends.dtype.kind in 'iu':
+            return ends[:, 0], ends[:, 1]
+
+    index = {v: idx for idx, v in enumerate(variables)}
+    irow = np.fromiter((index[u] for u, _ in edges), dtype=np.intp, count=len(edges))
+    icol = np.fromiter((index[v] for _, v in edges), dtype=np.intp, count=len(edges))
+    return irow, icol
+
+
 def gnm_random_bqm(variables: Union[int, Sequence[Variable]],
                    num_interactions: int,
                    vartype: VartypeLike,
@@ -55,17 +103,16 @@ def gnm_random_bqm(variables: Union[int, Sequence[Variable]],
         cls: Deprecated. Does nothing.
 
         random_state:
-            Random seed or a random state generator. Used for generating
-            the structure of the BQM and, if ``bias_generator`` is not given, for
-            the bias generation.
+            Random seed or a random state generator. Used to seed the
+            generator of the structure of the BQM and, if ``bias_generator``
+            is not given, of the biases.
 
         bias_generator:
             Bias generating function.
             Should accept a single argument `n` and return an
             :class:`~numpy.ndarray` of biases of length `n`.
             May be called multiple times.
-            If not provided, :meth:`~numpy.random.RandomState.uniform` is used by
-            default.
+            If not provided, the biases are drawn uniformly from `[0, 1)`.
 
     Returns:
         A binary quadratic model.
@@ -85,7 +132,7 @@ def gnm_random_bqm(variables: Union[int, Sequence[Variable]],
         labels = variables
         num_variables = len(labels)
     else:
-        labels = range(variables)
+        labels = None
         num_variables = variables
 
     if num_variables < 0:
@@ -97,41 +144,11 @@ def gnm_random_bqm(variables: Union[int, Sequence[Variable]],
     num_interactions = min(num_variables*(num_variables-1)//2,
                            num_interactions)
 
-    if not isinstance(random_state, np.random.RandomState):
-        random_state = np.random.RandomState(random_state)
-
-    if bias_generator is None:
-        def bias_generator(n):
-            return random_state.uniform(size=n)
-
-    bqm = BinaryQuadraticModel(vartype=vartype)
-
-    for vi, bias in enumerate(bias_generator(num_variables)):
-        bqm.set_linear(labels[vi], bias)
-
-    qbias = bias_generator(num_interactions)
-
-    if num_interactions:
-        ui = 0
-        vi = 1
-        k = 0
-        for t in range(num_interactions):
-            # this randint one-at-a-time actually dominates the runtime, there
-            # is some stuff we can do to imporve performance but it gets into
-            # cython territory quickly so I think this is fine for now
-            if random_state.randint(num_interactions - t) < num_interactions - k:
-                bqm.set_quadratic(labels[ui], labels[vi], qbias[k])
-                k += 1
-                if k == num_interactions:
-                    break
-            vi += 1
-            if vi == num_variables:  # go to next row of adjacency matrix
-                ui += 1
-                vi = ui + 1
-
-    bqm.offset, = bias_generator(1)
+    # the model is the same for any number of threads
+    bqm = BinaryQuadraticModel(num_variables, vartype, dtype=np.float64)
+    gnm_random(bqm.data, num_interactions, seed=_native_seed(random_state), num_threads=0)
 
-    return bqm
+    return _finish_native(bqm, labels, bias_generator)
 
 
 def gnp_random_bqm(n: Union[int, Sequence[Variable]],
@@ -157,23 +174,23 @@ def gnp_random_bqm(n: Union[int, Sequence[Variable]],
         cls: Deprecated. Does nothing.
 
         random_state:
-            Random seed or a random state generator. Used for generating
-            the structure of the BQM and, if ``bias_generator`` is not given, for
-            the bias generation.
+            Random seed or a random state generator. Used to seed the
+            generator of the structure of the BQM and, if ``bias_generator``
+            is not given, of the biases.
 
         bias_generator:
             Bias generating function.
             Should accept a single argument `n` and return an
             :class:`~numpy.ndarray` of biases of length `n`.
             May be called multiple times.
-            If not provided, :meth:`~numpy.random.RandomState.uniform` is used by
-            default.
+            If not provided, the biases are drawn uniformly from `[0, 1)`.
 
     Returns:
         A binary quadratic model.
 
     Notes:
-        This algorithm runs in O(n^2) time and space.
+        This algorithm runs in time and space linear in the number of variables
+        and interactions, rather than in the number of pairs of variables.
 
     .. deprecated:: 0.10.13
 
@@ -192,40 +209,11 @@ def gnp_random_bqm(n: Union[int, Sequence[Variable]],
     else:
         labels = None
 
-    if not isinstance(random_state, np.random.RandomState):
-        random_state = np.random.RandomState(random_state)
-
-    neighborhoods = []
-    num_interactions = 0
-    for v in range(n):
-        # determine what variables are connected
-        exists = random_state.uniform(size=(n - v - 1)) < p
-        neighbors = np.arange(v+1, n)[exists]
+    # the model is the same for any number of threads
+    bqm = BinaryQuadraticModel(n, vartype, dtype=np.float64)
+    gnp_random(bqm.data, p, seed=_native_seed(random_state), num_threads=0)
 
-        neighborhoods.append(neighbors)
-        num_interactions += len(neighbors)
-
-    # construct irow, icol
-    irow = np.empty(num_interactions, dtype=int)
-    icol = np.empty(num_interactions, dtype=int)
-
-    q = 0
-    for v, neighbors in enumerate(neighborhoods):
-        irow[q:q+len(neighbors)] = v
-        icol[q:q+len(neighbors)] = neighbors
-        q += len(neighbors)
-
-    # calculate the biases
-    if bias_generator is None:
-        def bias_generator(n):
-            return random_state.uniform(size=n)
-
-    ldata = bias_generator(n)
-    qdata = bias_generator(num_interactions)
-    offset, = bias_generator(1)
-
-    return BinaryQuadraticModel.from_numpy_vectors(ldata, (irow, icol, qdata),
-                                offset, vartype, variable_order=labels)
+    return _finish_native(bqm, labels, bias_generator)
 
 
 @graph_argument('graph')
@@ -277,12 +265,7 @@ def uniform(graph: GraphLike, vartype: VartypeLike,
 
     variables, edges = graph
 
-    index = {v: idx for idx, v in enumerate(variables)}
-
-    if edges:
-        irow, icol = zip(*((index[u], index[v]) for u, v in edges))
-    else:
-        irow = icol = tuple()
+    irow, icol = _edge_indices(variables, edges)
 
     ldata = r.uniform(low, high, size=len(variables))
     qdata = r.uniform(low, high, size=len(irow))
@@ -341,12 +324,7 @@ def randint(graph: GraphLike, vartype: VartypeLike,
 
     variables, edges = graph
 
-    index = {v: idx for idx, v in enumerate(variables)}
-
-    if edges:
-        irow, icol = zip(*((index[u], index[v]) for u, v in edges))
-    else:
-        irow = icol = tuple()
+    irow, icol = _edge_indices(variables, edges)
 
     # high+1 for inclusive range
     ldata = r.randint(low, high+1, size=len(variables))
@@ -419,12 +397,7 @@ def ran_r(r: int, graph: GraphLike,
 
     variables, edges = graph
 
-    index = {v: idx for idx, v in enumerate(variables)}
-
-    if edges:
-        irow, icol = zip(*((index[u], index[v]) for u, v in edges))
-    else:
-        irow = icol = tuple()
+    irow, icol = _edge_indices(variables, edges)
 
     ldata = np.zeros(len(variables))
 
@@ -492,16 +465,16 @@ def doped(p: float, graph: GraphLike,
     if not fm:
         p = 1 - p
 
-    bqm = BinaryQuadraticModel(Vartype.SPIN)
+    # the variables in the order that they first appear in the edges
+    variables = list(dict.fromkeys(v for edge in edges for v in edge))
+    irow, icol = _edge_indices(variables, edges)
 
-    for u, v in edges:
-        bqm.set_linear(u, 0)
-        bqm.set_linear(v, 0)
+    # drawing all of the couplings at once uses the same random numbers as
+    # drawing them one at a time
+    qdata = rnd.choice([1, -1], p=[p, 1 - p], size=len(irow))
 
-        J = rnd.choice([1, -1], p=[p, 1 - p])
-        bqm.add_interaction(u, v, J)
-
-    return bqm
+    return BinaryQuadraticModel.from_numpy_vectors(np.zeros(len(variables)), (irow, icol, qdata),
+                                                   0, Vartype.SPIN, variable_order=variables)
 
 
 @graph_argument("graph")
@@ -548,12 +521,7 @@ def power_r(
 
     variables, edges = graph
 
-    index = {v: idx for idx, v in enumerate(variables)}
-
-    if edges:
-        irow, icol = zip(*((index[u], index[v]) for u, v in edges))
-    else:
-        irow = icol = tuple()
+    irow, icol = _edge_indices(variables, edges)
 
     ldata = np.zeros(len(variables))
 
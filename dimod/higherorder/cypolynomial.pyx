@@ -0,0 +1,176 @@
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+
+cimport cython
+
+from cython.operator cimport dereference as deref
+from libcpp.vector cimport vector
+
+import numpy as np
+
+from dimod.binary.cybqm.cybqm_float64 cimport cyBQM_float64, bias_type, index_type
+from dimod.cyvariables cimport cyVariables
+from dimod.libcpp.binary_polynomial cimport BinaryPolynomial as cppBinaryPolynomial
+from dimod.libcpp.binary_polynomial cimport ProductReduction
+from dimod.libcpp.vartypes cimport Vartype as cppVartype
+from dimod.typing cimport Numeric, float64_t
+
+from dimod.sampleset import as_samples
+from dimod.variables import Variables
+from dimod.vartypes import Vartype, as_vartype
+
+__all__ = ['cyBinaryPolynomial']
+
+
+cdef class cyBinaryPolynomial:
+    """A binary polynomial backed by the C++ ``dimod::BinaryPolynomial``.
+
+    Args:
+        poly: A mapping or iterable of ``(term, bias)`` pairs, for instance a
+            :class:`.BinaryPolynomial`.
+        vartype: The variable type of the polynomial.
+
+    The label of each variable index is kept in :attr:`variables`, in the
+    order the variables are first seen in ``poly``.
+    """
+    cdef cppBinaryPolynomial[bias_type, index_type]* cpppoly
+    cdef readonly cyVariables variables
+
+    def __cinit__(self):
+        self.cpppoly = NULL
+
+    def __dealloc__(self):
+        if self.cpppoly is not NULL:
+            del self.cpppoly
+
+    def __init__(self, poly, vartype):
+        vartype = as_vartype(vartype)
+        if vartype is Vartype.SPIN:
+            self.cpppoly = new cppBinaryPolynomial[bias_type, index_type](cppVartype.SPIN)
+        elif vartype is Vartype.BINARY:
+            self.cpppoly = new cppBinaryPolynomial[bias_type, index_type](cppVartype.BINARY)
+        else:
+            raise ValueError(f"unsupported vartype: {vartype!r}")
+
+        self.variables = Variables()
+
+        if hasattr(poly, 'items'):
+            poly = poly.items()
+
+        cdef vector[index_type] term
+        for labels, bias in poly:
+            term.clear()
+            for v in labels:
+                self.variables._append(v, permissive=True)
+                term.push_back(self.variables.index(v))
+            self.cpppoly.add_term(term.begin(), term.end(), bias)
+
+        # terms that cancel still keep their variables
+        assert self.cpppoly.num_variables() == <size_t>self.variables.size()
+
+    @property
+    def degree(self):
+        """Number of variables in the largest term."""
+        return self.cpppoly.degree()
+
+    @property
+    def num_terms(self):
+        """Number of terms, not counting the offset."""
+        return self.cpppoly.num_terms()
+
+    @property
+    def offset(self):
+        """Constant energy offset."""
+        return self.cpppoly.offset()
+
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _energies(self, const Numeric[:, ::1] samples, cyVariables labels):
+        cdef Py_ssize_t num_samples = samples.shape[0]
+
+        if samples.shape[1] != labels.size():
+            raise RuntimeError("as_samples returned an inconsistent samples/variables")
+
+        # get the indices of the polynomial's variables in the samples, making
+        # a copy in the polynomial's order if they are not a prefix
+        cdef Py_ssize_t[::1] poly_to_sample = labels.index_array(self.variables)
+        cdef Py_ssize_t vi
+        cdef bint ordered = True
+        for vi in range(poly_to_sample.shape[0]):
+            if poly_to_sample[vi] != vi:
+                ordered = False
+                break
+
+        cdef const Numeric[:, ::1] poly_samples
+        if ordered:
+            poly_samples = samples
+        else:
+            poly_samples = np.ascontiguousarray(np.asarray(samples)[:, np.asarray(poly_to_sample)])
+
+        cdef float64_t[::1] energies = np.empty(num_samples, dtype=np.float64)
+
+        if num_samples == 0:
+            return energies
+
+        cdef const Numeric* samples_ptr = NULL
+        if poly_samples.shape[1]:
+            samples_ptr = &poly_samples[0, 0]
+
+        with nogil:
+            self.cpppoly.energies(samples_ptr, num_samples, poly_samples.shape[1], &energies[0], 0)
+
+        return energies
+
+    def energies(self, samples_like):
+        """Energies of the given samples, as a :class:`numpy.ndarray` of floats."""
+        samples, labels = as_samples(samples_like, labels_type=Variables)
+
+        # the fused types are signed
+        samples = np.ascontiguousarray(
+                samples,
+                dtype=f'i{samples.dtype.itemsize}' if np.issubdtype(samples.dtype, np.unsignedinteger) else None,
+                )
+
+        try:
+            return np.asarray(self._energies(samples, labels))
+        except TypeError as err:
+            if np.issubdtype(samples.dtype, np.floating) or np.issubdtype(samples.dtype, np.signedinteger):
+                raise err
+            raise ValueError(f"unsupported sample dtype: {samples.dtype.name}")
+
+    def make_quadratic(self, bias_type strength):
+        """Reduce the polynomial to a binary quadratic model.
+
+        Returns:
+            A 2-tuple of a :class:`.cyBQM_float64` and a list of
+            ``(u, v, product, auxiliary)`` index tuples, one per reduction
+            and in the order they were made. The variables of the BQM are
+            labelled by index, with the polynomial's variables first and the
+            product and auxiliary variables after them. ``auxiliary`` is
+            ``None`` for BINARY polynomials.
+        """
+        vartype = Vartype.SPIN if self.cpppoly.vartype() == cppVartype.SPIN else Vartype.BINARY
+        cdef cyBQM_float64 bqm = cyBQM_float64(vartype)
+
+        cdef vector[ProductReduction[index_type]] reductions
+        with nogil:
+            reductions = self.cpppoly.make_quadratic(deref(bqm.cppbqm), strength)
+        bqm.variables._stop = bqm.cppbqm.num_variables()
+
+        out = []
+        cdef ProductReduction[index_type] r
+        for r in reductions:
+            out.append((r.u, r.v, r.product, r.auxiliary if r.auxiliary >= 0 else None))
+        return bqm, out
@@ -22,6 +22,7 @@ from numbers import Number
 import numpy as np
 
 from dimod.decorators import vartype_argument
+from dimod.higherorder.cypolynomial import cyBinaryPolynomial
 from dimod.sampleset import as_samples
 from dimod.utilities import iter_safe_relabels
 from dimod.vartypes import Vartype
@@ -223,6 +224,11 @@ class BinaryPolynomial(abc.MutableMapping):
             >>> poly.energies(samples)
             array([-1. , -0.5])
         """
+        if np.dtype(dtype).kind == 'f':
+            # the native engine calculates the energies in double precision
+            return np.asarray(cyBinaryPolynomial(self, self.vartype).energies(samples_like),
+                              dtype=dtype)
+
         samples, labels = as_samples(samples_like)
         if labels:
             idx, label = zip(*enumerate(labels))
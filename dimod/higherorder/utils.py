@@ -28,6 +28,7 @@ import numpy as np
 import dimod
 from dimod.binary_quadratic_model import BinaryQuadraticModel
 from dimod.constrained import ConstrainedQuadraticModel
+from dimod.higherorder.cypolynomial import cyBinaryPolynomial
 from dimod.higherorder.polynomial import BinaryPolynomial
 from dimod.sampleset import as_samples
 from dimod.typing import Bias, Polynomial, SamplesLike, Variable
@@ -303,36 +304,39 @@ def make_quadratic(poly: Union[Polynomial, BinaryPolynomial], strength: float,
         >>> bqm = dimod.make_quadratic(poly, 5.0, dimod.SPIN)
 
     """
-    from dimod.generators import and_gate
-
     bqm, vartype = _init_quadratic_model(bqm, vartype, BinaryQuadraticModel)
     poly = _init_binary_polynomial(poly, vartype)
 
-    variables = set().union(*poly)
-    reduced_terms, constraints = reduce_binary_polynomial(poly)
+    # the reduction itself, including the product constraints, is done by
+    # the C++ polynomial on a BQM labelled by index
+    cypoly = cyBinaryPolynomial(poly, vartype)
+    reduced, reductions = cypoly.make_quadratic(strength)
 
-    for (u, v), p in constraints:
+    # now derive labels for the product and auxiliary variables in the order
+    # they were created
+    labels = list(cypoly.variables)
+    variables = set(labels)
+    for ui, vi, pi, auxi in reductions:
+        u = labels[ui]
+        v = labels[vi]
 
-        # add a constraint enforcing the relationship between p == u*v
-        if vartype is Vartype.BINARY:
-            constraint = and_gate(u, v, p)
+        assert pi == len(labels)
+        p = _new_product(variables, u, v)
+        labels.append(p)
+
+        if auxi is None:
             bqm.info['reduction'][(u, v)] = {'product': p}
-        elif vartype is Vartype.SPIN:
-            aux = _new_aux(variables, u, v)  # need an aux in SPIN-space
-            constraint = _spin_product([u, v, p, aux])
-            bqm.info['reduction'][(u, v)] = {'product': p, 'auxiliary': aux}
         else:
-            raise RuntimeError("unknown vartype: {!r}".format(vartype))
+            assert auxi == len(labels)
+            aux = _new_aux(variables, u, v)
+            labels.append(aux)
+            bqm.info['reduction'][(u, v)] = {'product': p, 'auxiliary': aux}
 
-        # scale constraint and update the polynomial with it
-        constraint.scale(strength)
-        for v, bias in constraint.linear.items():
-            bqm.add_variable(v, bias)
-        for uv, bias in constraint.quadratic.items():
-            bqm.add_interaction(*uv, bias)
-        bqm.offset += constraint.offset
+    reduced.relabel_variables(dict(enumerate(labels)))
 
-    _init_objective(bqm, reduced_terms)
+    other = BinaryQuadraticModel.__new__(BinaryQuadraticModel)
+    other.data = reduced
+    bqm.update(other)
 
     return bqm
 
@@ -19,9 +19,11 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "dimod/instrumentation.h"
 #include "dimod/utils.h"
 #include "dimod/vartypes.h"
 
@@ -55,6 +57,10 @@ struct TwoVarTerm {
     friend bool operator!=(const TwoVarTerm& a, const TwoVarTerm& b) { return !(a == b); }
 };
 
+// forward declaration
+template <class Bias, class Index>
+class QuadraticModelBase;
+
 template <class bias_type, class index_type>
 class ConstQuadraticIterator {
  public:
@@ -64,22 +70,21 @@ class ConstQuadraticIterator {
     using difference_type = std::ptrdiff_t;
     using iterator_category = std::forward_iterator_tag;
 
-    ConstQuadraticIterator() : adj_ptr_(nullptr), term_(0) {}
+    ConstQuadraticIterator() : model_(nullptr), term_(0) {}
 
-    ConstQuadraticIterator(
-            const std::vector<std::vector<OneVarTerm<bias_type, index_type>>>* adj_ptr,
-            index_type u)
-            : adj_ptr_(adj_ptr), term_(u), vi_(0) {
-        if (adj_ptr_ != nullptr) {
+    ConstQuadraticIterator(const QuadraticModelBase<bias_type, index_type>* model, index_type u)
+            : model_(model), term_(u), vi_(0) {
+        if (model_ != nullptr) {
             // advance through the neighborhoods until we find one on the
             // lower triangle
-            for (index_type& u = term_.u; static_cast<std::size_t>(u) < adj_ptr_->size(); ++u) {
-                auto& neighborhood = (*adj_ptr_)[u];
+            for (index_type& u = term_.u; static_cast<std::size_t>(u) < model_->num_variables();
+                 ++u) {
+                auto it = model_->cbegin_neighborhood(u);
 
-                if (neighborhood.size() && neighborhood.cbegin()->v <= u) {
+                if (it != model_->cend_neighborhood(u) && it->v <= u) {
                     // we found one
-                    term_.v = neighborhood.cbegin()->v;
-                    term_.bias = neighborhood.cbegin()->bias;
+                    term_.v = it->v;
+                    term_.bias = it->bias;
                     return;
                 }
             }
@@ -95,12 +100,10 @@ class ConstQuadraticIterator {
 
         ++vi;  // advance to the next
 
-        for (index_type& u = term_.u; static_cast<std::size_t>(u) < adj_ptr_->size(); ++u) {
-            auto& neighborhood = (*adj_ptr_)[u];
-
-            auto it = neighborhood.cbegin() + vi;
+        for (index_type& u = term_.u; static_cast<std::size_t>(u) < model_->num_variables(); ++u) {
+            auto it = model_->cbegin_neighborhood(u) + vi;
 
-            if (it != neighborhood.cend() && it->v <= u) {
+            if (it != model_->cend_neighborhood(u) && it->v <= u) {
                 // we found one
                 term_.v = it->v;
                 term_.bias = it->bias;
@@ -120,8 +123,8 @@ class ConstQuadraticIterator {
     }
 
     friend bool operator==(const ConstQuadraticIterator& a, const ConstQuadraticIterator& b) {
-        return (a.adj_ptr_ == nullptr && b.adj_ptr_ == nullptr) ||
-               (a.adj_ptr_ == b.adj_ptr_ && a.term_.u == b.term_.u && a.vi_ == b.vi_);
+        return (a.model_ == nullptr && b.model_ == nullptr) ||
+               (a.model_ == b.model_ && a.term_.u == b.term_.u && a.vi_ == b.vi_);
     }
 
     friend bool operator!=(const ConstQuadraticIterator& a, const ConstQuadraticIterator& b) {
@@ -130,14 +133,26 @@ class ConstQuadraticIterator {
 
  private:
     // note that unlike QuandraticModelBase, we use a regular pointer
-    // because the QuadraticModelBase owns the adjacency structure
-    const std::vector<std::vector<OneVarTerm<bias_type, index_type>>>* adj_ptr_;
+    // because the iterator does not own the model. The model is nullptr
+    // when it has no adjacency structure.
+    const QuadraticModelBase<bias_type, index_type>* model_;
 
     value_type term_;  // the current term
 
     index_type vi_;  // term_.v's location in the neighborhood of term_.u
 };
 
+/// @private  <- don't doc
+/// The adjacency of a frozen model, packed in compressed sparse row (CSR) format.
+template <class bias_type, class index_type>
+struct PackedAdjacency {
+    /// The neighborhood of `v` is `terms[row_ptr[v]:row_ptr[v + 1]]`.
+    std::vector<std::size_t> row_ptr;
+
+    /// All of the neighborhoods, stored contiguously and in order.
+    std::vector<OneVarTerm<bias_type, index_type>> terms;
+};
+
 template <class Bias, class Index>
 class QuadraticModelBase {
  public:
@@ -204,6 +219,55 @@ class QuadraticModelBase {
      */
     void add_quadratic_back(index_type u, index_type v, bias_type bias);
 
+    /**
+     * Add quadratic biases from COO-formatted arrays.
+     *
+     * `row_iterator`, `col_iterator` and `bias_iterator` must be random
+     * access iterators pointing to the beginning of `length` rows, columns
+     * and biases respectively. Duplicate (row, column) pairs are added
+     * together, and terms on the diagonal are handled as in
+     * `add_quadratic()`.
+     *
+     * Unlike calling `add_quadratic()` once per term, this sorts all of the
+     * terms into their neighborhoods with two counting-sort passes and then
+     * merges each neighborhood once, so it runs in time linear in `length`,
+     * `num_variables()` and the existing number of interactions.
+     *
+     * If `assume_sorted` is true, the terms must already be sorted by row and
+     * then by column, and with every row less than or equal to its column.
+     * The first sorting pass is then skipped.
+     *
+     * # Exceptions
+     * The behavior of this method is undefined when any row or column is not
+     * a variable in the model.
+     */
+    template <class ItRow, class ItCol, class ItBias>
+    void add_quadratic_coo(ItRow row_iterator, ItCol col_iterator, ItBias bias_iterator,
+                           size_type length, bool assume_sorted = false);
+
+    /**
+     * Add quadratic biases from CSR-formatted arrays.
+     *
+     * `row_ptr` must be a random access iterator pointing to the beginning of
+     * `num_rows + 1` offsets into the columns and biases. `col_iterator` and
+     * `bias_iterator` must be random access iterators pointing to the
+     * beginning of the columns and biases respectively.
+     *
+     * Every entry of the matrix is added, so a symmetric matrix will have
+     * each of its interactions added twice. Duplicates and terms on the
+     * diagonal are handled as in `add_quadratic_coo()`.
+     *
+     * If `assume_sorted` is true, the matrix must be upper triangular and the
+     * columns within each row must be sorted. See `add_quadratic_coo()`.
+     *
+     * # Exceptions
+     * The behavior of this method is undefined when `num_rows` is greater
+     * than `num_variables()` or when any column is not a variable in the model.
+     */
+    template <class ItPtr, class ItCol, class ItBias>
+    void add_quadratic_csr(ItPtr row_ptr, ItCol col_iterator, ItBias bias_iterator,
+                           index_type num_rows, bool assume_sorted = false);
+
     /*
      * Add quadratic biases from a dense matrix.
      *
@@ -246,6 +310,40 @@ class QuadraticModelBase {
     template <class Iter>  // todo: allow different return types
     bias_type energy(Iter sample_start) const;
 
+    /**
+     * Return the energy of the given sample of a model whose variables are
+     * all of type `VT`.
+     *
+     * The vartype is fixed at compile time, so it is not looked up per
+     * variable. For `Vartype::BINARY` the large neighborhoods of the
+     * variables that are 0 in the sample are skipped, typically half of
+     * them. For other vartypes this is the same as `energy(sample_start)`.
+     *
+     * The behavior of this function is undefined when the model has a
+     * variable of another type or the sample is not `num_variables()` long.
+     */
+    template <Vartype VT, class Iter>
+    bias_type energy(Iter sample_start) const;
+
+    /**
+     * Calculate the energies of a batch of samples.
+     *
+     * `samples` must point to the beginning of a row-major array with
+     * `num_samples` rows. Each row is a sample in the variable order of the
+     * model and consecutive rows are `stride` elements apart. `stride` must
+     * be at least `num_variables()`. The energies are written to `out`, which
+     * must have room for `num_samples` values. The energies are accumulated
+     * in the value type of `out`, so a model with `float` biases can still
+     * calculate its energies in `double`.
+     *
+     * The samples are divided between up to `num_threads` threads. If
+     * `num_threads` is less than 1, `std::thread::hardware_concurrency()`
+     * threads are used.
+     */
+    template <class T, class R>
+    void energies(const T* samples, size_type num_samples, size_type stride, R* out,
+                  int num_threads = 1) const;
+
     /**
      * Remove variable `v` from the model by fixing its value.
      *
@@ -255,6 +353,21 @@ class QuadraticModelBase {
     template <class T>
     void fix_variable(index_type v, T assignment);
 
+    /**
+     * Pack the quadratic interactions into a single contiguous array.
+     *
+     * The neighborhoods of a frozen model are stored in compressed sparse
+     * row (CSR) format, which makes reading the model, e.g. `energy()`,
+     * `quadratic()` or iterating over the neighborhoods, more cache friendly.
+     *
+     * Changing the linear biases, the offset, scaling or substituting
+     * variables and adding new variables does not thaw the model. Any
+     * other method that changes the quadratic structure, for instance
+     * `add_quadratic()` or `remove_variable()`, first calls `thaw()` and
+     * therefore costs O(`num_interactions()`) the first time it is called.
+     */
+    void freeze();
+
     /// Check whether `u` and `v` have an interaction.
     bool has_interaction(index_type u, index_type v) const;
 
@@ -262,6 +375,9 @@ class QuadraticModelBase {
     template <class B, class I>
     bool is_equal(const QuadraticModelBase<B, I>& other) const;
 
+    /// Test whether the quadratic interactions are packed. See `freeze()`.
+    bool is_frozen() const { return static_cast<bool>(packed_ptr_); }
+
     /// Test whether the model has no quadratic biases.
     bool is_linear() const;
 
@@ -271,6 +387,16 @@ class QuadraticModelBase {
     /// Return the lower bound on variable ``v``.
     virtual bias_type lower_bound(index_type v) const = 0;
 
+    /**
+     * Return a breakdown of the heap memory used by the model.
+     *
+     * Unlike `nbytes()`, this includes the vectors that hold the
+     * neighborhoods, and the information that subclasses store about the
+     * variables. If `capacity` is true, use the capacity of the underlying
+     * vectors rather than the size.
+     */
+    virtual MemoryUsage memory_usage(bool capacity = false) const;
+
     [[deprecated]] std::pair<const_neighborhood_iterator, const_neighborhood_iterator> neighborhood(
             index_type v) const {
         return std::make_pair(cbegin_neighborhood(v), cend_neighborhood(v));
@@ -278,12 +404,8 @@ class QuadraticModelBase {
 
     [[deprecated]] std::pair<const_neighborhood_iterator, const_neighborhood_iterator> neighborhood(
             index_type u, index_type start) const {
-        if (has_adj()) {
-            const auto& n = (*adj_ptr_)[u];
-            return std::make_pair(std::lower_bound(n.cbegin(), n.cend(), start), n.cend());
-        } else {
-            return neighborhood(u);
-        }
+        auto end = cend_neighborhood(u);
+        return std::make_pair(std::lower_bound(cbegin_neighborhood(u), end, start), end);
     }
 
     /**
@@ -348,6 +470,22 @@ class QuadraticModelBase {
     /// Remove multiple variables from the model and reindex accordingly.
     virtual void remove_variables(const std::vector<index_type>& variables);
 
+    /// Make room for at least `num_variables` variables without reallocating.
+    /// Does not change the number of variables in the model.
+    void reserve(size_type num_variables);
+
+    /**
+     * Make room for at least `n` interactions in the neighborhood of `v`
+     * without reallocating.
+     *
+     * Builders that know the degree of each variable ahead of time can use
+     * this so that each neighborhood is allocated once rather than grown one
+     * interaction at a time. Thaws a frozen model, see `freeze()`. Does
+     * nothing if `n` is 0, so models without interactions stay without an
+     * adjacency.
+     */
+    void reserve_interactions(index_type v, size_type n);
+
     /// Multiply all biases by the value of `scalar`.
     void scale(bias_type scalar);
 
@@ -367,6 +505,31 @@ class QuadraticModelBase {
 
     void substitute_variables(bias_type multiplier, bias_type offset);
 
+    /// Unpack the quadratic interactions so that they can be modified. See `freeze()`.
+    void thaw();
+
+    /**
+     * Write the quadratic biases as a CSR-formatted matrix.
+     *
+     * `row_ptr` must have room for `num_variables() + 1` offsets. `col` and
+     * `data` must have room for `num_interactions()` entries if
+     * `upper_triangular` is true, and `2 * num_interactions()` otherwise.
+     * The offsets count entries rather than variables, so `P` may need to be
+     * wider than `I`.
+     *
+     * If `upper_triangular` is true, each interaction, including any
+     * self-loops, is written once with its row less than or equal to its
+     * column. Otherwise each interaction `(u, v)` with `u != v` is written
+     * twice, once in each row, and the matrix is symmetric. In either case
+     * the columns within each row are sorted.
+     *
+     * Returns the number of entries written. Each neighborhood is read once
+     * so this runs in time linear in `num_variables()` and
+     * `num_interactions()`.
+     */
+    template <class P, class I, class B>
+    size_type to_csr(P* row_ptr, I* col, B* data, bool upper_triangular = true) const;
+
     /// Return the upper bound on variable ``v``.
     virtual bias_type upper_bound(index_type v) const = 0;
 
@@ -375,9 +538,10 @@ class QuadraticModelBase {
 
  protected:
     explicit QuadraticModelBase(std::vector<bias_type>&& linear_biases)
-            : linear_biases_(linear_biases), adj_ptr_(), offset_(0) {}
+            : linear_biases_(linear_biases), adj_ptr_(), packed_ptr_(), offset_(0) {}
 
-    explicit QuadraticModelBase(index_type n) : linear_biases_(n), adj_ptr_(), offset_(0) {}
+    explicit QuadraticModelBase(index_type n)
+            : linear_biases_(n), adj_ptr_(), packed_ptr_(), offset_(0) {}
 
     /// Increase the size of the model by one. Returns the index of the new variable.
     index_type add_variable();
@@ -404,6 +568,9 @@ class QuadraticModelBase {
 
     std::unique_ptr<std::vector<std::vector<OneVarTerm<bias_type, index_type>>>> adj_ptr_;
 
+    // Only present when the model is frozen, in which case adj_ptr_ is not.
+    std::unique_ptr<PackedAdjacency<bias_type, index_type>> packed_ptr_;
+
     bias_type offset_;
 
     // Assumes adj exists!
@@ -418,13 +585,19 @@ class QuadraticModelBase {
         if (it == neighborhood.end() || it->v != v) {
             // we could make a bunch individual functions to avoid needing to
             // default to 0, but this is a lot simpler.
+            const size_type capacity = neighborhood.capacity();
             it = neighborhood.emplace(it, v, 0);
+            detail::count(Counter::QUADRATIC_INSERTS);
+            detail::count_reallocation(neighborhood, capacity);
+        } else {
+            detail::count(Counter::QUADRATIC_HITS);
         }
         return it->bias;
     }
 
     /// Create the adjacency structure if it doesn't already exist.
     void enforce_adj() {
+        thaw();
         if (!adj_ptr_) {
             adj_ptr_ = std::unique_ptr<std::vector<std::vector<OneVarTerm<bias_type, index_type>>>>(
                     new std::vector<std::vector<OneVarTerm<bias_type, index_type>>>(
@@ -432,19 +605,46 @@ class QuadraticModelBase {
         }
     }
 
-    /// Return true if the model's adjacency structure exists
+    /// Return true if the model's (unpacked) adjacency structure exists
     bool has_adj() const { return static_cast<bool>(adj_ptr_); }
+
+    /// Return the neighborhood of `v` in a frozen model.
+    std::pair<OneVarTerm<bias_type, index_type>*, OneVarTerm<bias_type, index_type>*>
+    packed_neighborhood(index_type v) {
+        assert(is_frozen());
+        OneVarTerm<bias_type, index_type>* terms = packed_ptr_->terms.data();
+        return std::make_pair(terms + packed_ptr_->row_ptr[v], terms + packed_ptr_->row_ptr[v + 1]);
+    }
+
+    /// Return the energy of the sample. If `skip_zeros` is true, the
+    /// variables with large neighborhoods that are 0 in the sample are
+    /// skipped. Small ones are not worth the unpredictable branch.
+    template <bool skip_zeros, class Iter>
+    bias_type energy_(Iter sample_start) const;
+
+    /// Return the sum of `bias * sample[v]` over the terms of the neighborhood
+    /// `[first, last)` of `u` with `v <= u`.
+    template <class Iter>
+    static bias_type lower_neighborhood_dot(const OneVarTerm<bias_type, index_type>* first,
+                                            const OneVarTerm<bias_type, index_type>* last,
+                                            index_type u, Iter sample_start);
 };
 
 template <class bias_type, class index_type>
 QuadraticModelBase<bias_type, index_type>::QuadraticModelBase()
-        : linear_biases_(), adj_ptr_(), offset_(0) {}
+        : linear_biases_(), adj_ptr_(), packed_ptr_(), offset_(0) {}
 
 template <class bias_type, class index_type>
 QuadraticModelBase<bias_type, index_type>::QuadraticModelBase(const QuadraticModelBase& other)
-        : linear_biases_(other.linear_biases_), adj_ptr_(), offset_(other.offset_) {
+        : linear_biases_(other.linear_biases_),
+          adj_ptr_(),
+          packed_ptr_(),
+          offset_(other.offset_) {
     // need to handle the adj if present
-    if (!other.is_linear()) {
+    if (other.is_frozen()) {
+        packed_ptr_ = std::unique_ptr<PackedAdjacency<bias_type, index_type>>(
+                new PackedAdjacency<bias_type, index_type>(*other.packed_ptr_));
+    } else if (!other.is_linear()) {
         adj_ptr_ = std::unique_ptr<std::vector<std::vector<OneVarTerm<bias_type, index_type>>>>(
                 new std::vector<std::vector<OneVarTerm<bias_type, index_type>>>(*other.adj_ptr_));
     }
@@ -455,12 +655,18 @@ QuadraticModelBase<bias_type, index_type>& QuadraticModelBase<bias_type, index_t
         const QuadraticModelBase& other) {
     if (this != &other) {
         linear_biases_ = other.linear_biases_;
-        if (!other.is_linear()) {
+        if (other.is_frozen()) {
+            adj_ptr_.reset(nullptr);
+            packed_ptr_ = std::unique_ptr<PackedAdjacency<bias_type, index_type>>(
+                    new PackedAdjacency<bias_type, index_type>(*other.packed_ptr_));
+        } else if (!other.is_linear()) {
             adj_ptr_ = std::unique_ptr<std::vector<std::vector<OneVarTerm<bias_type, index_type>>>>(
                     new std::vector<std::vector<OneVarTerm<bias_type, index_type>>>(
                             *other.adj_ptr_));
+            packed_ptr_.reset(nullptr);
         } else {
             adj_ptr_.reset(nullptr);
+            packed_ptr_.reset(nullptr);
         }
         offset_ = other.offset_;
     }
@@ -528,10 +734,8 @@ void QuadraticModelBase<bias_type, index_type>::add_quadratic(ItRow row_iterator
                                                               ItCol col_iterator,
                                                               ItBias bias_iterator,
                                                               index_type length) {
-    // todo: performance testing of adding and then sorting later
-    for (index_type i = 0; i < length; ++i, ++row_iterator, ++col_iterator, ++bias_iterator) {
-        add_quadratic(*row_iterator, *col_iterator, *bias_iterator);
-    }
+    assert(length >= 0);
+    add_quadratic_coo(row_iterator, col_iterator, bias_iterator, length);
 }
 
 template <class bias_type, class index_type>
@@ -560,16 +764,173 @@ void QuadraticModelBase<bias_type, index_type>::add_quadratic_back(index_type u,
             }
             default: {
                 // self-loop
+                const size_type capacity = (*adj_ptr_)[u].capacity();
                 (*adj_ptr_)[u].emplace_back(v, bias);
+                detail::count_reallocation((*adj_ptr_)[u], capacity);
                 break;
             }
         }
     } else {
+        const size_type u_capacity = (*adj_ptr_)[u].capacity();
+        const size_type v_capacity = (*adj_ptr_)[v].capacity();
         (*adj_ptr_)[u].emplace_back(v, bias);
         (*adj_ptr_)[v].emplace_back(u, bias);
+        detail::count_reallocation((*adj_ptr_)[u], u_capacity);
+        detail::count_reallocation((*adj_ptr_)[v], v_capacity);
     }
 }
 
+template <class bias_type, class index_type>
+template <class ItRow, class ItCol, class ItBias>
+void QuadraticModelBase<bias_type, index_type>::add_quadratic_coo(ItRow row_iterator,
+                                                                  ItCol col_iterator,
+                                                                  ItBias bias_iterator,
+                                                                  size_type length,
+                                                                  bool assume_sorted) {
+    using term_type = OneVarTerm<bias_type, index_type>;
+
+    if (!length) return;
+
+    enforce_adj();
+
+    const size_type n = num_variables();
+
+    // Each term is stored twice, once in the neighborhood of each of its
+    // variables, except for self-loops which are stored once. Terms on the
+    // diagonal of BINARY and SPIN variables do not get stored at all.
+    // We use (row, term) pairs so that we can sort by either.
+    std::vector<std::pair<index_type, term_type>> halves;
+    halves.reserve(2 * length);
+    for (size_type i = 0; i < length; ++i) {
+        const index_type u = row_iterator[i];
+        const index_type v = col_iterator[i];
+        const bias_type bias = bias_iterator[i];
+
+        assert(0 <= u && static_cast<size_type>(u) < n);
+        assert(0 <= v && static_cast<size_type>(v) < n);
+
+        if (u != v) {
+            halves.emplace_back(u, term_type(v, bias));
+            halves.emplace_back(v, term_type(u, bias));
+            continue;
+        }
+
+        switch (this->vartype_(u)) {
+            case Vartype::BINARY: {
+                // 1*1 == 1 and 0*0 == 0 so this is linear
+                linear_biases_[u] += bias;
+                break;
+            }
+            case Vartype::SPIN: {
+                // -1*-1 == +1*+1 == 1 so this is a constant offset
+                offset_ += bias;
+                break;
+            }
+            default: {
+                // self-loop
+                halves.emplace_back(u, term_type(u, bias));
+                break;
+            }
+        }
+    }
+
+    // Stable counting sort of the halves into buckets by `key`, written to `out`.
+    // Returns the start of each bucket.
+    auto counting_sort = [n](const std::vector<std::pair<index_type, term_type>>& in,
+                             std::vector<std::pair<index_type, term_type>>& out,
+                             bool by_row) {
+        std::vector<size_type> starts(n + 1, 0);
+        for (const auto& half : in) ++starts[(by_row ? half.first : half.second.v) + 1];
+        for (size_type v = 0; v < n; ++v) starts[v + 1] += starts[v];
+
+        out.resize(in.size(), std::make_pair(0, term_type(0, 0)));
+        std::vector<size_type> next(starts.begin(), starts.end() - 1);
+        for (const auto& half : in) out[next[by_row ? half.first : half.second.v]++] = half;
+
+        return starts;
+    };
+
+    std::vector<std::pair<index_type, term_type>> buffer;
+    std::vector<size_type> starts;
+    if (assume_sorted) {
+        // for (row, col) sorted input with row <= col, a stable sort by row
+        // already leaves each neighborhood sorted
+        starts = counting_sort(halves, buffer, true);
+    } else {
+        // sort by neighbor and then (stably) by row, so that each
+        // neighborhood's new terms are sorted
+        counting_sort(halves, buffer, false);
+        starts = counting_sort(buffer, halves, true);
+        std::swap(halves, buffer);
+    }
+    halves.clear();
+    halves.shrink_to_fit();
+
+    std::vector<term_type> merged;
+    for (size_type u = 0; u < n; ++u) {
+        auto first = buffer.begin() + starts[u];
+        auto last = buffer.begin() + starts[u + 1];
+        if (first == last) continue;
+
+        assert(std::is_sorted(first, last,
+                              [](const std::pair<index_type, term_type>& a,
+                                 const std::pair<index_type, term_type>& b) {
+                                  return a.second < b.second;
+                              }));
+
+        auto& neighborhood = (*adj_ptr_)[u];
+
+        // merge the existing neighborhood with the new terms, adding duplicates together
+        merged.clear();
+        merged.reserve(neighborhood.size() + (last - first));
+        auto it = neighborhood.begin();
+        for (; first != last; ++first) {
+            const term_type& term = first->second;
+            for (; it != neighborhood.end() && it->v < term.v; ++it) merged.push_back(*it);
+
+            if (!merged.empty() && merged.back().v == term.v) {
+                merged.back().bias += term.bias;
+            } else if (it != neighborhood.end() && it->v == term.v) {
+                merged.push_back(*it);
+                merged.back().bias += term.bias;
+                ++it;
+            } else {
+                merged.push_back(term);
+            }
+        }
+        merged.insert(merged.end(), it, neighborhood.end());
+
+        neighborhood.swap(merged);
+    }
+}
+
+template <class bias_type, class index_type>
+template <class ItPtr, class ItCol, class ItBias>
+void QuadraticModelBase<bias_type, index_type>::add_quadratic_csr(ItPtr row_ptr,
+                                                                  ItCol col_iterator,
+                                                                  ItBias bias_iterator,
+                                                                  index_type num_rows,
+                                                                  bool assume_sorted) {
+    assert(num_rows >= 0 && static_cast<size_type>(num_rows) <= num_variables());
+
+    if (num_rows <= 0) return;
+
+    const auto first = row_ptr[0];
+    const size_type length = row_ptr[num_rows] - first;
+
+    // expand the row offsets into one row per entry, the columns and biases
+    // can be used as-is
+    std::vector<index_type> rows;
+    rows.reserve(length);
+    for (index_type u = 0; u < num_rows; ++u) {
+        assert(row_ptr[u] <= row_ptr[u + 1]);
+        rows.insert(rows.end(), static_cast<size_type>(row_ptr[u + 1] - row_ptr[u]), u);
+    }
+
+    add_quadratic_coo(rows.begin(), col_iterator + first, bias_iterator + first, length,
+                      assume_sorted);
+}
+
 template <class bias_type, class index_type>
 template <class T>
 void QuadraticModelBase<bias_type, index_type>::add_quadratic_from_dense(const T dense[],
@@ -580,6 +941,24 @@ void QuadraticModelBase<bias_type, index_type>::add_quadratic_from_dense(const T
 
     enforce_adj();
 
+    // Count the new interactions of each variable so that every neighborhood
+    // is allocated once. The extra one is for a possible self-loop.
+    {
+        std::vector<size_type> degrees(num_variables, 1);
+        for (index_type u = 0; u < num_variables; ++u) {
+            for (index_type v = u + 1; v < num_variables; ++v) {
+                bias_type qbias = dense[u * num_variables + v] + dense[v * num_variables + u];
+                if (qbias) {
+                    ++degrees[u];
+                    ++degrees[v];
+                }
+            }
+        }
+        for (index_type u = 0; u < num_variables; ++u) {
+            reserve_interactions(u, (*adj_ptr_)[u].size() + degrees[u]);
+        }
+    }
+
     if (is_linear()) {
         for (index_type u = 0; u < num_variables; ++u) {
             // diagonal
@@ -622,9 +1001,14 @@ index_type QuadraticModelBase<bias_type, index_type>::add_variables(index_type n
     assert(n >= 0);
     index_type size = num_variables();
 
+    const size_type capacity = linear_biases_.capacity();
     linear_biases_.resize(size + n);
+    detail::count_reallocation(linear_biases_, capacity);
     if (has_adj()) {
         adj_ptr_->resize(size + n);
+    } else if (is_frozen()) {
+        // the new variables have empty neighborhoods
+        packed_ptr_->row_ptr.resize(size + n + 1, packed_ptr_->row_ptr.back());
     }
 
     return size;
@@ -636,6 +1020,8 @@ QuadraticModelBase<bias_type, index_type>::cbegin_neighborhood(index_type v) con
     assert(0 <= v && static_cast<size_t>(v) <= num_variables());
     if (has_adj()) {
         return (*adj_ptr_)[v].begin();
+    } else if (is_frozen()) {
+        return packed_ptr_->terms.cbegin() + packed_ptr_->row_ptr[v];
     } else {
         return empty_neighborhood().begin();
     }
@@ -647,6 +1033,8 @@ QuadraticModelBase<bias_type, index_type>::cend_neighborhood(index_type v) const
     assert(0 <= v && static_cast<size_t>(v) <= num_variables());
     if (has_adj()) {
         return (*adj_ptr_)[v].end();
+    } else if (is_frozen()) {
+        return packed_ptr_->terms.cbegin() + packed_ptr_->row_ptr[v + 1];
     } else {
         return empty_neighborhood().end();
     }
@@ -655,18 +1043,19 @@ QuadraticModelBase<bias_type, index_type>::cend_neighborhood(index_type v) const
 template <class bias_type, class index_type>
 ConstQuadraticIterator<bias_type, index_type>
 QuadraticModelBase<bias_type, index_type>::cbegin_quadratic() const {
-    return const_quadratic_iterator(adj_ptr_.get(), 0);
+    return const_quadratic_iterator((has_adj() || is_frozen()) ? this : nullptr, 0);
 }
 
 template <class bias_type, class index_type>
 ConstQuadraticIterator<bias_type, index_type>
 QuadraticModelBase<bias_type, index_type>::cend_quadratic() const {
-    return const_quadratic_iterator(adj_ptr_.get(), num_variables());
+    return const_quadratic_iterator((has_adj() || is_frozen()) ? this : nullptr, num_variables());
 }
 
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::clear() {
     adj_ptr_.reset(nullptr);
+    packed_ptr_.reset(nullptr);
     linear_biases_.clear();
     offset_ = 0;
 }
@@ -674,22 +1063,53 @@ void QuadraticModelBase<bias_type, index_type>::clear() {
 template <class bias_type, class index_type>
 template <class Iter>
 bias_type QuadraticModelBase<bias_type, index_type>::energy(Iter sample_start) const {
+    return energy_<false>(sample_start);
+}
+
+template <class bias_type, class index_type>
+template <Vartype VT, class Iter>
+bias_type QuadraticModelBase<bias_type, index_type>::energy(Iter sample_start) const {
+    // a 0 contributes nothing whatever the vartype, but it is only worth the
+    // branch when most values are expected to be 0
+    return energy_<VT == Vartype::BINARY>(sample_start);
+}
+
+template <class bias_type, class index_type>
+template <bool skip_zeros, class Iter>
+bias_type QuadraticModelBase<bias_type, index_type>::energy_(Iter sample_start) const {
     static_assert(std::is_same<std::random_access_iterator_tag,
                                typename std::iterator_traits<Iter>::iterator_category>::value,
                   "iterators must be random access");
 
+    detail::count(Counter::ENERGY_CALLS);
+
     bias_type en = offset();
 
     if (has_adj()) {
         for (index_type u = 0; static_cast<size_type>(u) < num_variables(); ++u) {
             auto u_val = *(sample_start + u);
 
+            const auto& neighborhood = (*adj_ptr_)[u];
+            if (skip_zeros && neighborhood.size() > 32 && !u_val) continue;
+
             en += u_val * linear(u);
 
-            for (auto& term : (*adj_ptr_)[u]) {
-                if (term.v > u) break;
-                en += term.bias * u_val * *(sample_start + term.v);
-            }
+            en += u_val * lower_neighborhood_dot(neighborhood.data(),
+                                                 neighborhood.data() + neighborhood.size(), u,
+                                                 sample_start);
+        }
+    } else if (is_frozen()) {
+        const std::size_t* row_ptr = packed_ptr_->row_ptr.data();
+        const OneVarTerm<bias_type, index_type>* terms = packed_ptr_->terms.data();
+
+        for (index_type u = 0; static_cast<size_type>(u) < num_variables(); ++u) {
+            auto u_val = *(sample_start + u);
+            if (skip_zeros && row_ptr[u + 1] - row_ptr[u] > 32 && !u_val) continue;
+
+            en += u_val * linear_biases_[u];
+
+            en += u_val * lower_neighborhood_dot(terms + row_ptr[u], terms + row_ptr[u + 1], u,
+                                                 sample_start);
         }
     } else {
         for (auto it = linear_biases_.begin(); it != linear_biases_.end(); ++it, ++sample_start) {
@@ -700,16 +1120,109 @@ bias_type QuadraticModelBase<bias_type, index_type>::energy(Iter sample_start) c
     return en;
 }
 
+template <class bias_type, class index_type>
+template <class Iter>
+bias_type QuadraticModelBase<bias_type, index_type>::lower_neighborhood_dot(
+        const OneVarTerm<bias_type, index_type>* first,
+        const OneVarTerm<bias_type, index_type>* last, index_type u, Iter sample_start) {
+    bias_type total = 0;
+
+    // Neighborhoods are sorted and unique, so if the u-th term is v=u-1 then
+    // the neighborhood contains every v < u. In that case we don't need to
+    // gather the sample values, and we can split the sum over several
+    // independent accumulators so the compiler is able to vectorize it.
+    if (u > 0 && last - first >= u && first[u - 1].v == u - 1) {
+        bias_type acc[4] = {0, 0, 0, 0};
+
+        index_type v = 0;
+        for (; v + 4 <= u; v += 4) {
+            acc[0] += first[v].bias * *(sample_start + v);
+            acc[1] += first[v + 1].bias * *(sample_start + v + 1);
+            acc[2] += first[v + 2].bias * *(sample_start + v + 2);
+            acc[3] += first[v + 3].bias * *(sample_start + v + 3);
+        }
+        for (; v < u; ++v) {
+            total += first[v].bias * *(sample_start + v);
+        }
+        total += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+
+        first += u;
+    }
+
+    for (; first != last && first->v <= u; ++first) {
+        total += first->bias * *(sample_start + first->v);
+    }
+
+    return total;
+}
+
+template <class bias_type, class index_type>
+template <class T, class R>
+void QuadraticModelBase<bias_type, index_type>::energies(const T* samples, size_type num_samples,
+                                                        size_type stride, R* out,
+                                                        int num_threads) const {
+    static_assert(std::is_arithmetic<T>::value, "T must be numeric");
+    static_assert(std::is_floating_point<R>::value, "R must be a floating point type");
+    assert(stride >= num_variables());
+
+    detail::count(Counter::ENERGY_CALLS);
+
+    // We process the samples in blocks. Each block is transposed into a
+    // variable-major buffer so that every neighborhood is read once per block
+    // rather than once per sample, and so that the innermost loop, over the
+    // samples in the block, is contiguous. Fewer samples than fit in a block
+    // get a narrower buffer.
+    const size_type block_size = 64;
+    const size_type width = std::min(block_size, num_samples);
+    const size_type num_blocks = (num_samples + block_size - 1) / block_size;
+    const size_type n = num_variables();
+
+    utils::parallel_for(num_blocks, num_threads, [&](size_type first, size_type last) {
+        std::vector<R> buffer(n * width);
+        R acc[block_size];
+
+        for (size_type block = first; block < last; ++block) {
+            const size_type start = block * block_size;
+            const size_type length = std::min(block_size, num_samples - start);
+
+            // the unused tail of the last block (if any) is left as 0
+            utils::transpose_samples(samples + start * stride, length, stride, n, width,
+                                     buffer.data());
+
+            std::fill(acc, acc + width, offset_);
+
+            for (index_type u = 0; static_cast<size_type>(u) < n; ++u) {
+                const R* u_vals = buffer.data() + u * width;
+
+                const R lbias = linear_biases_[u];
+                for (size_type si = 0; si < width; ++si) {
+                    acc[si] += u_vals[si] * lbias;
+                }
+
+                for (auto it = cbegin_neighborhood(u), end = cend_neighborhood(u);
+                     it != end && it->v <= u; ++it) {
+                    const R* v_vals = buffer.data() + it->v * width;
+
+                    const R qbias = it->bias;
+                    for (size_type si = 0; si < width; ++si) {
+                        acc[si] += qbias * u_vals[si] * v_vals[si];
+                    }
+                }
+            }
+
+            std::copy(acc, acc + length, out + start);
+        }
+    });
+}
+
 template <class bias_type, class index_type>
 template <class T>
 void QuadraticModelBase<bias_type, index_type>::fix_variable(index_type v, T assignment) {
     static_assert(std::is_arithmetic<T>::value, "T must be numeric");
     assert(v >= 0 && static_cast<size_type>(v) < num_variables());
     // associated quadratic biases become linear
-    if (has_adj()) {
-        for (auto it = cbegin_neighborhood(v); it != cend_neighborhood(v); ++it) {
-            add_linear(it->v, it->bias * assignment);
-        }
+    for (auto it = cbegin_neighborhood(v); it != cend_neighborhood(v); ++it) {
+        add_linear(it->v, it->bias * assignment);
     }
 
     // linear gets added to the offset
@@ -720,18 +1233,44 @@ void QuadraticModelBase<bias_type, index_type>::fix_variable(index_type v, T ass
     QuadraticModelBase<bias_type, index_type>::remove_variable(v);
 }
 
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::freeze() {
+    if (is_frozen()) return;  // nothing to do
+
+    auto packed = std::unique_ptr<PackedAdjacency<bias_type, index_type>>(
+            new PackedAdjacency<bias_type, index_type>());
+
+    packed->row_ptr.reserve(num_variables() + 1);
+    packed->row_ptr.push_back(0);
+    if (has_adj()) {
+        size_type num_terms = 0;
+        for (const auto& n : *adj_ptr_) {
+            num_terms += n.size();
+        }
+        packed->terms.reserve(num_terms);
+
+        for (const auto& n : *adj_ptr_) {
+            packed->terms.insert(packed->terms.end(), n.begin(), n.end());
+            packed->row_ptr.push_back(packed->terms.size());
+        }
+    } else {
+        packed->row_ptr.resize(num_variables() + 1, 0);
+    }
+
+    adj_ptr_.reset(nullptr);
+    packed_ptr_ = std::move(packed);
+
+    assert(packed_ptr_->row_ptr.size() == num_variables() + 1);
+}
+
 template <class bias_type, class index_type>
 bool QuadraticModelBase<bias_type, index_type>::has_interaction(index_type u, index_type v) const {
     assert(0 <= u && static_cast<size_type>(u) < num_variables());
     assert(0 <= v && static_cast<size_type>(v) < num_variables());
 
-    if (!adj_ptr_) {
-        return false;
-    }
-
-    const auto& n = (*adj_ptr_)[u];
-    auto it = std::lower_bound(n.cbegin(), n.cend(), v);
-    if (it == n.cend() || it->v != v) {
+    auto end = cend_neighborhood(u);
+    auto it = std::lower_bound(cbegin_neighborhood(u), end, v);
+    if (it == end || it->v != v) {
         return false;
     }
 
@@ -758,15 +1297,12 @@ bool QuadraticModelBase<bias_type, index_type>::is_equal(
     }
 
     // check quadratic. We already checked the number of interactions so
-    // if one is present we can assume it's empty
-    if (this->has_adj() && other.has_adj()) {
-        // check that the neighborhoods are equal
-        auto it1 = this->cbegin_quadratic();
-        auto it2 = other.cbegin_quadratic();
-        for (; it1 != this->cend_quadratic(); ++it1, ++it2) {
-            if (*it1 != *it2) {
-                return false;
-            }
+    // we can walk them in lockstep
+    auto it1 = this->cbegin_quadratic();
+    auto it2 = other.cbegin_quadratic();
+    for (; it1 != this->cend_quadratic(); ++it1, ++it2) {
+        if (*it1 != *it2) {
+            return false;
         }
     }
 
@@ -779,6 +1315,8 @@ bool QuadraticModelBase<bias_type, index_type>::is_linear() const {
         for (const auto& n : *adj_ptr_) {
             if (n.size()) return false;
         }
+    } else if (is_frozen()) {
+        return packed_ptr_->terms.empty();
     }
     return true;
 }
@@ -789,6 +1327,35 @@ bias_type QuadraticModelBase<bias_type, index_type>::linear(index_type v) const
     return linear_biases_[v];
 }
 
+template <class bias_type, class index_type>
+MemoryUsage QuadraticModelBase<bias_type, index_type>::memory_usage(bool capacity) const {
+    using term_type = OneVarTerm<bias_type, index_type>;
+    using neighborhood_type = std::vector<term_type>;
+
+    MemoryUsage usage;
+
+    usage.linear = sizeof(bias_type);  // offset
+    usage.linear += (capacity ? linear_biases_.capacity() : linear_biases_.size()) *
+                    sizeof(bias_type);
+
+    if (has_adj()) {
+        usage.other += sizeof(std::vector<neighborhood_type>);  // owned by adj_ptr_
+        usage.quadratic +=
+                (capacity ? adj_ptr_->capacity() : adj_ptr_->size()) * sizeof(neighborhood_type);
+        for (const auto& n : (*adj_ptr_)) {
+            usage.quadratic += (capacity ? n.capacity() : n.size()) * sizeof(term_type);
+        }
+    } else if (is_frozen()) {
+        usage.other += sizeof(PackedAdjacency<bias_type, index_type>);  // owned by packed_ptr_
+        const auto& row_ptr = packed_ptr_->row_ptr;
+        const auto& terms = packed_ptr_->terms;
+        usage.quadratic += (capacity ? row_ptr.capacity() : row_ptr.size()) * sizeof(std::size_t);
+        usage.quadratic += (capacity ? terms.capacity() : terms.size()) * sizeof(term_type);
+    }
+
+    return usage;
+}
+
 template <class bias_type, class index_type>
 std::size_t QuadraticModelBase<bias_type, index_type>::nbytes(bool capacity) const {
     size_type count = sizeof(bias_type);  // offset
@@ -807,6 +1374,14 @@ std::size_t QuadraticModelBase<bias_type, index_type>::nbytes(bool capacity) con
                 count += n.size() * sizeof(OneVarTerm<bias_type, index_type>);
             }
         }
+    } else if (is_frozen()) {
+        if (capacity) {
+            count += packed_ptr_->row_ptr.capacity() * sizeof(std::size_t);
+            count += packed_ptr_->terms.capacity() * sizeof(OneVarTerm<bias_type, index_type>);
+        } else {
+            count += packed_ptr_->row_ptr.size() * sizeof(std::size_t);
+            count += packed_ptr_->terms.size() * sizeof(OneVarTerm<bias_type, index_type>);
+        }
     }
     return count;
 }
@@ -814,18 +1389,18 @@ std::size_t QuadraticModelBase<bias_type, index_type>::nbytes(bool capacity) con
 template <class bias_type, class index_type>
 std::size_t QuadraticModelBase<bias_type, index_type>::num_interactions() const {
     size_type count = 0;
-    if (has_adj()) {
-        index_type v = 0;
-        for (auto& n : *(adj_ptr_)) {
-            count += n.size();
+    if (has_adj() || is_frozen()) {
+        for (index_type v = 0; static_cast<size_type>(v) < num_variables(); ++v) {
+            auto begin = cbegin_neighborhood(v);
+            auto end = cend_neighborhood(v);
+
+            count += end - begin;
 
             // account for self-loops
-            auto lb = std::lower_bound(n.cbegin(), n.cend(), v);
-            if (lb != n.cend() && lb->v == v) {
+            auto lb = std::lower_bound(begin, end, v);
+            if (lb != end && lb->v == v) {
                 count += 1;
             }
-
-            ++v;
         }
     }
     return count / 2;
@@ -833,11 +1408,7 @@ std::size_t QuadraticModelBase<bias_type, index_type>::num_interactions() const
 
 template <class bias_type, class index_type>
 std::size_t QuadraticModelBase<bias_type, index_type>::num_interactions(index_type v) const {
-    if (has_adj()) {
-        return (*adj_ptr_)[v].size();
-    } else {
-        return 0;
-    }
+    return cend_neighborhood(v) - cbegin_neighborhood(v);
 }
 
 template <class bias_type, class index_type>
@@ -847,13 +1418,9 @@ bias_type QuadraticModelBase<bias_type, index_type>::offset() const {
 
 template <class bias_type, class index_type>
 bias_type QuadraticModelBase<bias_type, index_type>::quadratic(index_type u, index_type v) const {
-    if (!adj_ptr_) {
-        return 0;
-    }
-
-    const auto& n = (*adj_ptr_)[u];
-    auto it = std::lower_bound(n.cbegin(), n.cend(), v);
-    if (it == n.cend() || it->v != v) {
+    auto end = cend_neighborhood(u);
+    auto it = std::lower_bound(cbegin_neighborhood(u), end, v);
+    if (it == end || it->v != v) {
         return 0;
     }
 
@@ -863,13 +1430,9 @@ bias_type QuadraticModelBase<bias_type, index_type>::quadratic(index_type u, ind
 template <class bias_type, class index_type>
 bias_type QuadraticModelBase<bias_type, index_type>::quadratic_at(index_type u,
                                                                   index_type v) const {
-    if (!adj_ptr_) {
-        throw std::out_of_range("given variables have no interaction");
-    }
-
-    const auto& n = (*adj_ptr_)[u];
-    auto it = std::lower_bound(n.cbegin(), n.cend(), v);
-    if (it == n.cend() || it->v != v) {
+    auto end = cend_neighborhood(u);
+    auto it = std::lower_bound(cbegin_neighborhood(u), end, v);
+    if (it == end || it->v != v) {
         throw std::out_of_range("given variables have no interaction");
     }
 
@@ -878,6 +1441,10 @@ bias_type QuadraticModelBase<bias_type, index_type>::quadratic_at(index_type u,
 
 template <class bias_type, class index_type>
 bool QuadraticModelBase<bias_type, index_type>::remove_interaction(index_type u, index_type v) {
+    if (is_frozen() && !has_interaction(u, v)) return false;  // don't thaw unnecessarily
+
+    thaw();
+
     if (!has_adj()) return false;  // no quadratic to remove
 
     auto& Nu = (*adj_ptr_)[u];
@@ -898,6 +1465,8 @@ bool QuadraticModelBase<bias_type, index_type>::remove_interaction(index_type u,
 template <class bias_type, class index_type>
 template <class Filter>
 std::size_t QuadraticModelBase<bias_type, index_type>::remove_interactions(Filter filter) {
+    thaw();
+
     if (!has_adj()) return 0;  // nothing to filter
 
     std::size_t num_removed = 0;
@@ -928,6 +1497,8 @@ template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::remove_variable(index_type v) {
     assert(0 <= v && static_cast<size_type>(v) < num_variables());
 
+    thaw();
+
     linear_biases_.erase(linear_biases_.cbegin() + v);
 
     if (has_adj()) {
@@ -970,6 +1541,8 @@ void QuadraticModelBase<bias_type, index_type>::remove_variables(
         return;
     }
 
+    thaw();
+
     linear_biases_.erase(utils::remove_by_index(linear_biases_.begin(), linear_biases_.end(),
                                                 variables.begin(), variables.end()),
                          linear_biases_.end());
@@ -1009,10 +1582,37 @@ void QuadraticModelBase<bias_type, index_type>::remove_variables(
     }
 }
 
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::reserve(size_type num_variables) {
+    linear_biases_.reserve(num_variables);
+    if (has_adj()) {
+        adj_ptr_->reserve(num_variables);
+    } else if (is_frozen()) {
+        packed_ptr_->row_ptr.reserve(num_variables + 1);
+    }
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::reserve_interactions(index_type v, size_type n) {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    if (!n) return;
+    enforce_adj();
+    (*adj_ptr_)[v].reserve(n);
+}
+
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::resize(index_type n) {
     assert(n >= 0);
 
+    if (is_frozen()) {
+        if (static_cast<size_type>(n) >= num_variables()) {
+            // growing a frozen model is cheap
+            add_variables(n - num_variables());
+            return;
+        }
+        thaw();
+    }
+
     if (has_adj()) {
         if (static_cast<size_type>(n) < num_variables()) {
             // Clean out any of the to-be-deleted variables from the
@@ -1028,7 +1628,9 @@ void QuadraticModelBase<bias_type, index_type>::resize(index_type n) {
         adj_ptr_->resize(n);
     }
 
+    const size_type capacity = linear_biases_.capacity();
     linear_biases_.resize(n);
+    detail::count_reallocation(linear_biases_, capacity);
 
     assert(!has_adj() || linear_biases_.size() == adj_ptr_->size());
 }
@@ -1049,6 +1651,10 @@ void QuadraticModelBase<bias_type, index_type>::scale(bias_type scalar) {
                 term.bias *= scalar;
             }
         }
+    } else if (is_frozen()) {
+        for (auto& term : packed_ptr_->terms) {
+            term.bias *= scalar;
+        }
     }
 }
 
@@ -1120,6 +1726,23 @@ void QuadraticModelBase<bias_type, index_type>::substitute_variable(index_type v
             asymmetric_quadratic_ref(term.v, v) *= multiplier;
             term.bias *= multiplier;
         }
+    } else if (is_frozen()) {
+        // the structure does not change, so we can work on the packed form
+        auto span = packed_neighborhood(v);
+        for (auto it = span.first; it != span.second; ++it) {
+            linear_biases_[it->v] += it->bias * offset;
+
+            if (it->v != v) {
+                auto other = packed_neighborhood(it->v);
+                auto oit = std::lower_bound(other.first, other.second, v);
+                assert(oit != other.second && oit->v == v);  // symmetric
+                oit->bias *= multiplier;
+            } else {
+                // self-loop, stored once
+                it->bias *= multiplier;
+            }
+            it->bias *= multiplier;
+        }
     }
 }
 
@@ -1144,8 +1767,62 @@ void QuadraticModelBase<bias_type, index_type>::substitute_variables(bias_type m
                 term.bias *= quad_mp;
             }
         }
+    } else if (is_frozen()) {
+        for (size_type v = 0; v < num_variables(); ++v) {
+            auto span = packed_neighborhood(v);
+            for (auto it = span.first; it != span.second; ++it) {
+                offset_ += quad_offset_mp * it->bias;
+                linear_biases_[v] += lin_quad_mp * it->bias;
+                it->bias *= quad_mp;
+            }
+        }
     }
 }
 
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::thaw() {
+    if (!is_frozen()) return;  // nothing to do
+
+    // we leave linear models without an adjacency
+    if (!packed_ptr_->terms.empty()) {
+        adj_ptr_ = std::unique_ptr<std::vector<std::vector<OneVarTerm<bias_type, index_type>>>>(
+                new std::vector<std::vector<OneVarTerm<bias_type, index_type>>>());
+        adj_ptr_->reserve(num_variables());
+
+        auto first = packed_ptr_->terms.cbegin();
+        for (size_type v = 0; v < num_variables(); ++v) {
+            adj_ptr_->emplace_back(first + packed_ptr_->row_ptr[v],
+                                   first + packed_ptr_->row_ptr[v + 1]);
+        }
+    }
+
+    packed_ptr_.reset(nullptr);
+}
+
+template <class bias_type, class index_type>
+template <class P, class I, class B>
+typename QuadraticModelBase<bias_type, index_type>::size_type
+QuadraticModelBase<bias_type, index_type>::to_csr(P* row_ptr, I* col, B* data,
+                                                  bool upper_triangular) const {
+    const size_type n = num_variables();
+
+    size_type nnz = 0;
+    row_ptr[0] = 0;
+    for (size_type u = 0; u < n; ++u) {
+        auto it = cbegin_neighborhood(u);
+        auto end = cend_neighborhood(u);
+        if (upper_triangular) it = std::lower_bound(it, end, static_cast<index_type>(u));
+
+        for (; it != end; ++it, ++nnz) {
+            col[nnz] = it->v;
+            data[nnz] = it->bias;
+        }
+        row_ptr[u + 1] = nnz;
+    }
+
+    assert(!upper_triangular || nnz == num_interactions());
+    return nnz;
+}
+
 }  // namespace abc
 }  // namespace dimod
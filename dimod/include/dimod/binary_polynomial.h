@@ -0,0 +1,625 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <initializer_list>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/utils.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+
+/// A pair of variables replaced by their product during `BinaryPolynomial::make_quadratic()`.
+template <class Index>
+struct ProductReduction {
+    /// The first variable of the pair, `u < v`.
+    Index u;
+
+    /// The second variable of the pair.
+    Index v;
+
+    /// The variable that replaced `u*v` in the reduced model.
+    Index product;
+
+    /// The auxiliary variable of the SPIN product gadget, -1 for BINARY models.
+    Index auxiliary;
+};
+
+/**
+ * A binary polynomial is a polynomial of any degree over binary-valued variables.
+ *
+ * Each term is stored as a sorted tuple of distinct variable indices. The
+ * tuples live in one flat pool so that a polynomial with many terms makes
+ * only a handful of allocations and every term can be scanned contiguously.
+ * Adding a term that is already present adds to its bias.
+ */
+template <class Bias, class Index = int>
+class BinaryPolynomial {
+ public:
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Empty constructor. The variable type defaults to `Vartype::BINARY`.
+    BinaryPolynomial();
+
+    /// Create a polynomial of the given `vartype`.
+    explicit BinaryPolynomial(Vartype vartype);
+
+    /// Add `bias` to the offset of the polynomial.
+    void add_offset(bias_type bias);
+
+    /**
+     * Add `bias` to the term made from the variables in `[first, last)`.
+     *
+     * The variables may be given in any order and may repeat. Repeated
+     * variables are collapsed using `x*x == x` for BINARY polynomials and
+     * `s*s == 1` for SPIN polynomials. A term that collapses to no variables
+     * is added to the offset. The polynomial is resized to fit the largest
+     * variable, even if it cancels out.
+     */
+    template <class Iter>
+    void add_term(Iter first, Iter last, bias_type bias);
+
+    /// Add `bias` to the term made from `variables`. See `add_term(first, last, bias)`.
+    void add_term(std::initializer_list<index_type> variables, bias_type bias);
+
+    /// Return the bias of term `t`.
+    bias_type bias(size_type t) const;
+
+    /// Remove all terms and variables and set the offset to 0.
+    void clear();
+
+    /// Return the number of variables in the largest term.
+    size_type degree() const;
+
+    /**
+     * Return the energy of the given sample.
+     *
+     * `sample` must point to at least `num_variables()` values in the
+     * variable order of the polynomial.
+     */
+    template <class T>
+    bias_type energy(const T* sample) const;
+
+    /**
+     * Calculate the energies of a batch of samples.
+     *
+     * `samples` must point to the beginning of a row-major array with
+     * `num_samples` rows. Each row is a sample in the variable order of the
+     * polynomial and consecutive rows are `stride` elements apart. `stride`
+     * must be at least `num_variables()`. The energies are written to `out`,
+     * which must have room for `num_samples` values.
+     *
+     * The samples are divided between up to `num_threads` threads. If
+     * `num_threads` is less than 1, `std::thread::hardware_concurrency()`
+     * threads are used.
+     */
+    template <class T, class R>
+    void energies(const T* samples, size_type num_samples, size_type stride, R* out,
+                  int num_threads = 1) const;
+
+    /**
+     * Return the index of the term made from the variables in `[first, last)`,
+     * or `num_terms()` if there is no such term.
+     *
+     * The variables are normalized as in `add_term()`, so a term that
+     * collapses to no variables is never found.
+     */
+    template <class Iter>
+    size_type find_term(Iter first, Iter last) const;
+
+    /**
+     * Reduce the polynomial to a quadratic model and add it to `bqm`.
+     *
+     * Pairs of variables in terms of degree three or more are repeatedly
+     * replaced by a new product variable, picking the pair that appears in
+     * the most terms each time, until every term is at most quadratic. A
+     * penalty of magnitude `strength` enforces each product: an AND gate
+     * for BINARY polynomials and a four-variable gadget with one auxiliary
+     * variable for SPIN polynomials. The ground states of `bqm` restricted
+     * to the original variables are the ground states of the polynomial
+     * when `strength` is large enough.
+     *
+     * `bqm` must have the same vartype as the polynomial. It is resized to
+     * fit the polynomial's variables and the product and auxiliary variables
+     * are appended after them, in the order they are returned.
+     */
+    template <class B, class I>
+    std::vector<ProductReduction<I>> make_quadratic(BinaryQuadraticModel<B, I>& bqm,
+                                                    bias_type strength) const;
+
+    /// Return the number of terms, including any whose bias is 0.
+    size_type num_terms() const;
+
+    /// Return the number of variables.
+    size_type num_variables() const;
+
+    /// Return the offset.
+    bias_type offset() const;
+
+    /// Increase the number of variables to `n`. Polynomials cannot be shrunk.
+    void resize(index_type n);
+
+    /// Set the offset.
+    void set_offset(bias_type offset);
+
+    /// Return a pointer to the first variable of term `t`.
+    const index_type* term_begin(size_type t) const;
+
+    /// Return a pointer past the last variable of term `t`.
+    const index_type* term_end(size_type t) const;
+
+    /// Return the variable type of the polynomial.
+    Vartype vartype() const;
+
+ private:
+    // Return the index of the normalized `term` with hash `key`, or `num_terms()`.
+    size_type find_normalized(const std::vector<index_type>& term, std::size_t key) const;
+
+    // Sort the variables in `term` and collapse any repeats according to the vartype.
+    void normalize(std::vector<index_type>& term) const;
+
+    // Return the hash of the sorted term in `[first, last)`.
+    static std::size_t hash_term(const index_type* first, const index_type* last);
+
+    Vartype vartype_;
+    size_type num_variables_;
+    bias_type offset_;
+
+    // Term t is term_variables_[term_ptr_[t]:term_ptr_[t+1]] with bias biases_[t].
+    std::vector<size_type> term_ptr_;
+    std::vector<index_type> term_variables_;
+    std::vector<bias_type> biases_;
+
+    // Terms by hash, so that duplicate terms can be found in constant time.
+    std::unordered_multimap<std::size_t, size_type> lookup_;
+
+    // Scratch space for normalizing terms in add_term().
+    std::vector<index_type> buffer_;
+};
+
+template <class bias_type, class index_type>
+BinaryPolynomial<bias_type, index_type>::BinaryPolynomial() : BinaryPolynomial(Vartype::BINARY) {}
+
+template <class bias_type, class index_type>
+BinaryPolynomial<bias_type, index_type>::BinaryPolynomial(Vartype vartype)
+        : vartype_(vartype), num_variables_(0), offset_(0), term_ptr_(1, 0) {
+    if (vartype != Vartype::BINARY && vartype != Vartype::SPIN) {
+        throw std::invalid_argument("vartype must be SPIN or BINARY");
+    }
+}
+
+template <class bias_type, class index_type>
+void BinaryPolynomial<bias_type, index_type>::add_offset(bias_type bias) {
+    offset_ += bias;
+}
+
+template <class bias_type, class index_type>
+template <class Iter>
+void BinaryPolynomial<bias_type, index_type>::add_term(Iter first, Iter last, bias_type bias) {
+    buffer_.assign(first, last);
+    normalize(buffer_);
+
+    // resize before checking for cancellation so that every given variable
+    // is in the polynomial
+    for (; first != last; ++first) {
+        assert(*first >= 0);
+        if (static_cast<size_type>(*first) >= num_variables_) resize(*first + 1);
+    }
+
+    if (buffer_.empty()) {
+        offset_ += bias;
+        return;
+    }
+
+    std::size_t key = hash_term(buffer_.data(), buffer_.data() + buffer_.size());
+    size_type t = find_normalized(buffer_, key);
+    if (t < num_terms()) {
+        biases_[t] += bias;
+        return;
+    }
+
+    lookup_.emplace(key, biases_.size());
+    term_variables_.insert(term_variables_.end(), buffer_.begin(), buffer_.end());
+    term_ptr_.push_back(term_variables_.size());
+    biases_.push_back(bias);
+}
+
+template <class bias_type, class index_type>
+void BinaryPolynomial<bias_type, index_type>::add_term(std::initializer_list<index_type> variables,
+                                                       bias_type bias) {
+    add_term(variables.begin(), variables.end(), bias);
+}
+
+template <class bias_type, class index_type>
+bias_type BinaryPolynomial<bias_type, index_type>::bias(size_type t) const {
+    assert(t < num_terms());
+    return biases_[t];
+}
+
+template <class bias_type, class index_type>
+void BinaryPolynomial<bias_type, index_type>::clear() {
+    num_variables_ = 0;
+    offset_ = 0;
+    term_ptr_.assign(1, 0);
+    term_variables_.clear();
+    biases_.clear();
+    lookup_.clear();
+}
+
+template <class bias_type, class index_type>
+typename BinaryPolynomial<bias_type, index_type>::size_type
+BinaryPolynomial<bias_type, index_type>::degree() const {
+    size_type deg = 0;
+    for (size_type t = 0; t < num_terms(); ++t) {
+        deg = std::max(deg, term_ptr_[t + 1] - term_ptr_[t]);
+    }
+    return deg;
+}
+
+template <class bias_type, class index_type>
+template <class T>
+bias_type BinaryPolynomial<bias_type, index_type>::energy(const T* sample) const {
+    static_assert(std::is_arithmetic<T>::value, "T must be numeric");
+
+    bias_type total = offset_;
+    for (size_type t = 0; t < num_terms(); ++t) {
+        bias_type value = biases_[t];
+        for (auto it = term_begin(t), end = term_end(t); it != end && value; ++it) {
+            value *= sample[*it];
+        }
+        total += value;
+    }
+    return total;
+}
+
+template <class bias_type, class index_type>
+template <class T, class R>
+void BinaryPolynomial<bias_type, index_type>::energies(const T* samples, size_type num_samples,
+                                                       size_type stride, R* out,
+                                                       int num_threads) const {
+    static_assert(std::is_arithmetic<T>::value, "T must be numeric");
+    static_assert(std::is_floating_point<R>::value, "R must be a floating point type");
+    assert(stride >= num_variables());
+
+    // As in QuadraticModelBase::energies(), each block of samples is
+    // transposed into a variable-major buffer so that the term pool is read
+    // once per block and the innermost loop runs over contiguous values.
+    const size_type block_size = 64;
+    const size_type width = std::min(block_size, num_samples);
+    const size_type num_blocks = (num_samples + block_size - 1) / block_size;
+    const size_type n = num_variables();
+
+    utils::parallel_for(num_blocks, num_threads, [&](size_type first, size_type last) {
+        std::vector<R> buffer(n * width);
+        R acc[block_size];
+        R product[block_size];
+
+        for (size_type block = first; block < last; ++block) {
+            const size_type start = block * block_size;
+            const size_type length = std::min(block_size, num_samples - start);
+
+            utils::transpose_samples(samples + start * stride, length, stride, n, width,
+                                     buffer.data());
+
+            std::fill(acc, acc + width, offset_);
+
+            for (size_type t = 0; t < num_terms(); ++t) {
+                if (!biases_[t]) continue;
+
+                std::fill(product, product + width, biases_[t]);
+                for (auto it = term_begin(t), end = term_end(t); it != end; ++it) {
+                    const R* vals = buffer.data() + *it * width;
+                    for (size_type si = 0; si < width; ++si) {
+                        product[si] *= vals[si];
+                    }
+                }
+                for (size_type si = 0; si < width; ++si) {
+                    acc[si] += product[si];
+                }
+            }
+
+            std::copy(acc, acc + length, out + start);
+        }
+    });
+}
+
+template <class bias_type, class index_type>
+template <class Iter>
+typename BinaryPolynomial<bias_type, index_type>::size_type
+BinaryPolynomial<bias_type, index_type>::find_term(Iter first, Iter last) const {
+    std::vector<index_type> term(first, last);
+    normalize(term);
+
+    if (term.empty()) return num_terms();
+
+    return find_normalized(term, hash_term(term.data(), term.data() + term.size()));
+}
+
+template <class bias_type, class index_type>
+typename BinaryPolynomial<bias_type, index_type>::size_type
+BinaryPolynomial<bias_type, index_type>::find_normalized(const std::vector<index_type>& term,
+                                                         std::size_t key) const {
+    auto range = lookup_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (term.size() ==
+                    static_cast<size_type>(term_end(it->second) - term_begin(it->second)) &&
+            std::equal(term.begin(), term.end(), term_begin(it->second))) {
+            return it->second;
+        }
+    }
+    return num_terms();
+}
+
+template <class bias_type, class index_type>
+std::size_t BinaryPolynomial<bias_type, index_type>::hash_term(const index_type* first,
+                                                               const index_type* last) {
+    // boost::hash_combine
+    std::size_t seed = last - first;
+    for (; first != last; ++first) {
+        seed ^= std::hash<index_type>()(*first) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+template <class bias_type, class index_type>
+template <class B, class I>
+std::vector<ProductReduction<I>> BinaryPolynomial<bias_type, index_type>::make_quadratic(
+        BinaryQuadraticModel<B, I>& bqm, bias_type strength) const {
+    if (bqm.vartype() != vartype_) {
+        throw std::invalid_argument("bqm must have the same vartype as the polynomial");
+    }
+
+    if (bqm.num_variables() < num_variables_) bqm.resize(num_variables_);
+
+    bqm.add_offset(offset_);
+
+    // Terms of degree three or more are copied out, everything else goes
+    // straight into the BQM.
+    std::vector<std::vector<I>> terms;
+    std::vector<bias_type> term_biases;
+    for (size_type t = 0; t < num_terms(); ++t) {
+        auto begin = term_begin(t);
+        auto end = term_end(t);
+        switch (end - begin) {
+            case 1:
+                bqm.add_linear(begin[0], biases_[t]);
+                break;
+            case 2:
+                bqm.add_quadratic(begin[0], begin[1], biases_[t]);
+                break;
+            default:
+                terms.emplace_back(begin, end);
+                term_biases.push_back(biases_[t]);
+        }
+    }
+
+    // For every pair of variables that share a term, the number of terms
+    // containing the pair and the indices of those terms. The term lists may
+    // hold terms that have since lost the pair, those are skipped when the
+    // pair is reduced.
+    struct PairInfo {
+        size_type count = 0;
+        std::vector<size_type> terms;
+    };
+    struct PairHash {
+        std::size_t operator()(const std::pair<I, I>& p) const {
+            std::size_t seed = std::hash<I>()(p.first);
+            return seed ^ (std::hash<I>()(p.second) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+        }
+    };
+    std::unordered_map<std::pair<I, I>, PairInfo, PairHash> pairs;
+
+    for (size_type t = 0; t < terms.size(); ++t) {
+        const auto& term = terms[t];
+        for (size_type i = 0; i < term.size(); ++i) {
+            for (size_type j = i + 1; j < term.size(); ++j) {
+                auto& info = pairs[std::make_pair(term[i], term[j])];
+                ++info.count;
+                info.terms.push_back(t);
+            }
+        }
+    }
+
+    // A max-heap on the pair counts. Counts change as pairs are reduced, so
+    // entries whose count no longer matches the pair are discarded when popped.
+    using HeapEntry = std::pair<size_type, std::pair<I, I>>;
+    std::priority_queue<HeapEntry> heap;
+    for (const auto& kv : pairs) heap.emplace(kv.second.count, kv.first);
+
+    auto decrement = [&](I a, I b) {
+        auto it = pairs.find(a < b ? std::make_pair(a, b) : std::make_pair(b, a));
+        assert(it != pairs.end() && it->second.count > 0);
+        if (--it->second.count) {
+            heap.emplace(it->second.count, it->first);
+        } else {
+            pairs.erase(it);
+        }
+    };
+
+    std::vector<ProductReduction<I>> reductions;
+    std::vector<I> new_pairs;
+    while (!heap.empty()) {
+        HeapEntry top = heap.top();
+        heap.pop();
+
+        auto pit = pairs.find(top.second);
+        if (pit == pairs.end() || pit->second.count != top.first) continue;  // stale
+
+        const I u = top.second.first;
+        const I v = top.second.second;
+        std::vector<size_type> pair_terms = std::move(pit->second.terms);
+        pairs.erase(pit);
+
+        // the product is always the largest variable, so appending it keeps
+        // the terms sorted
+        ProductReduction<I> reduction;
+        reduction.u = u;
+        reduction.v = v;
+        reduction.product = bqm.add_variable();
+        reduction.auxiliary = -1;
+
+        const B s = strength;
+        const I p = reduction.product;
+        if (vartype_ == Vartype::BINARY) {
+            // AND gate, p == u*v
+            bqm.add_linear(p, 3 * s);
+            bqm.add_quadratic(u, v, s);
+            bqm.add_quadratic(u, p, -2 * s);
+            bqm.add_quadratic(v, p, -2 * s);
+        } else {
+            // p == u*v at the ground states for some value of aux
+            const I aux = reduction.auxiliary = bqm.add_variable();
+            bqm.add_linear(u, -.5 * s);
+            bqm.add_linear(v, -.5 * s);
+            bqm.add_linear(p, -.5 * s);
+            bqm.add_linear(aux, -s);
+            bqm.add_quadratic(u, v, .5 * s);
+            bqm.add_quadratic(u, p, .5 * s);
+            bqm.add_quadratic(u, aux, s);
+            bqm.add_quadratic(v, p, .5 * s);
+            bqm.add_quadratic(v, aux, s);
+            bqm.add_quadratic(p, aux, s);
+            bqm.add_offset(2 * s);
+        }
+        reductions.push_back(reduction);
+
+        new_pairs.clear();
+        for (size_type t : pair_terms) {
+            auto& term = terms[t];
+            if (!std::binary_search(term.begin(), term.end(), u) ||
+                !std::binary_search(term.begin(), term.end(), v)) {
+                continue;  // the term lost u or v to an earlier product
+            }
+
+            // every other pair involving u or v in this term loses a term
+            for (I w : term) {
+                if (w == u || w == v) continue;
+                decrement(u, w);
+                decrement(v, w);
+            }
+
+            term.erase(std::remove_if(term.begin(), term.end(),
+                                      [u, v](I w) { return w == u || w == v; }),
+                       term.end());
+            term.push_back(p);
+
+            if (term.size() == 2) {
+                bqm.add_quadratic(term[0], term[1], term_biases[t]);
+                std::vector<I>().swap(term);
+                continue;
+            }
+
+            for (size_type i = 0; i + 1 < term.size(); ++i) {
+                auto& info = pairs[std::make_pair(term[i], p)];
+                if (!info.count) new_pairs.push_back(term[i]);
+                ++info.count;
+                info.terms.push_back(t);
+            }
+        }
+
+        for (I w : new_pairs) {
+            auto key = std::make_pair(w, p);
+            heap.emplace(pairs[key].count, key);
+        }
+    }
+
+    return reductions;
+}
+
+template <class bias_type, class index_type>
+void BinaryPolynomial<bias_type, index_type>::normalize(std::vector<index_type>& term) const {
+    std::sort(term.begin(), term.end());
+
+    if (vartype_ == Vartype::BINARY) {
+        term.erase(std::unique(term.begin(), term.end()), term.end());
+        return;
+    }
+
+    // SPIN, keep the variables that appear an odd number of times
+    auto out = term.begin();
+    for (auto it = term.begin(); it != term.end();) {
+        auto next = std::upper_bound(it, term.end(), *it);
+        if ((next - it) % 2) *out++ = *it;
+        it = next;
+    }
+    term.erase(out, term.end());
+}
+
+template <class bias_type, class index_type>
+typename BinaryPolynomial<bias_type, index_type>::size_type
+BinaryPolynomial<bias_type, index_type>::num_terms() const {
+    return biases_.size();
+}
+
+template <class bias_type, class index_type>
+typename BinaryPolynomial<bias_type, index_type>::size_type
+BinaryPolynomial<bias_type, index_type>::num_variables() const {
+    return num_variables_;
+}
+
+template <class bias_type, class index_type>
+bias_type BinaryPolynomial<bias_type, index_type>::offset() const {
+    return offset_;
+}
+
+template <class bias_type, class index_type>
+void BinaryPolynomial<bias_type, index_type>::resize(index_type n) {
+    assert(n >= 0);
+    if (static_cast<size_type>(n) < num_variables_) {
+        throw std::logic_error("polynomials cannot be shrunk");
+    }
+    num_variables_ = n;
+}
+
+template <class bias_type, class index_type>
+void BinaryPolynomial<bias_type, index_type>::set_offset(bias_type offset) {
+    offset_ = offset;
+}
+
+template <class bias_type, class index_type>
+const index_type* BinaryPolynomial<bias_type, index_type>::term_begin(size_type t) const {
+    assert(t < num_terms());
+    return term_variables_.data() + term_ptr_[t];
+}
+
+template <class bias_type, class index_type>
+const index_type* BinaryPolynomial<bias_type, index_type>::term_end(size_type t) const {
+    assert(t < num_terms());
+    return term_variables_.data() + term_ptr_[t + 1];
+}
+
+template <class bias_type, class index_type>
+Vartype BinaryPolynomial<bias_type, index_type>::vartype() const {
+    return vartype_;
+}
+
+}  // namespace dimod
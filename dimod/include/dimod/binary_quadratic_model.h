@@ -80,6 +80,16 @@ class BinaryQuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
     void add_quadratic(ItRow row_iterator, ItCol col_iterator, ItBias bias_iterator,
                        index_type length);
 
+    /**
+     * Construct a BQM from COO-formated iterators in linear time.
+     *
+     * The BQM is resized to fit the largest row or column.
+     * See `QuadraticModelBase::add_quadratic_coo()`.
+     */
+    template <class ItRow, class ItCol, class ItBias>
+    void add_quadratic_coo(ItRow row_iterator, ItCol col_iterator, ItBias bias_iterator,
+                           size_type length, bool assume_sorted = false);
+
     /// Add one (disconnected) variable to the BQM and return its index.
     index_type add_variable();
 
@@ -136,6 +146,17 @@ void BinaryQuadraticModel<bias_type, index_type>::add_quadratic(ItRow row_iterat
                                                                 ItCol col_iterator,
                                                                 ItBias bias_iterator,
                                                                 index_type length) {
+    assert(length >= 0);
+    add_quadratic_coo(row_iterator, col_iterator, bias_iterator, length);
+}
+
+template <class bias_type, class index_type>
+template <class ItRow, class ItCol, class ItBias>
+void BinaryQuadraticModel<bias_type, index_type>::add_quadratic_coo(ItRow row_iterator,
+                                                                    ItCol col_iterator,
+                                                                    ItBias bias_iterator,
+                                                                    size_type length,
+                                                                    bool assume_sorted) {
     // we can resize ourself because we know the vartype
     if (length > 0) {
         index_type max_label = std::max(*std::max_element(row_iterator, row_iterator + length),
@@ -145,7 +166,8 @@ void BinaryQuadraticModel<bias_type, index_type>::add_quadratic(ItRow row_iterat
         }
     }
 
-    base_type::add_quadratic(row_iterator, col_iterator, bias_iterator, length);
+    base_type::add_quadratic_coo(row_iterator, col_iterator, bias_iterator, length,
+                                 assume_sorted);
 }
 
 template <class bias_type, class index_type>
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <unordered_set>
 #include <utility>
@@ -23,6 +26,7 @@
 #include "dimod/constraint.h"
 #include "dimod/iterators.h"
 #include "dimod/expression.h"
+#include "dimod/utils.h"
 #include "dimod/vartypes.h"
 
 namespace dimod {
@@ -136,7 +140,8 @@ class ConstrainedQuadraticModel {
     index_type add_variables(Vartype vartype, index_type n, bias_type lb, bias_type ub);
 
     /// Change the variable type of variable `v` to `vartype`, updating the biases appropriately.
-    void change_vartype(Vartype vartype, index_type v);
+    /// The constraints are divided between up to `num_threads` threads, see utils::parallel_for().
+    void change_vartype(Vartype vartype, index_type v, int num_threads = 1);
 
     void clear();
 
@@ -156,22 +161,57 @@ class ConstrainedQuadraticModel {
     std::weak_ptr<const Constraint<bias_type, index_type>> constraint_weak_ptr(index_type c) const;
 
     /// Fix variable `v` in the model to value `assignment`.
+    /// The constraints are divided between up to `num_threads` threads, see utils::parallel_for().
     template <class T>
-    void fix_variable(index_type v, T assignment);
+    void fix_variable(index_type v, T assignment, int num_threads = 1);
 
     /// Create a new model by fixing many variables.
+    /// The constraints are divided between up to `num_threads` threads, see utils::parallel_for().
     template <class VarIter, class AssignmentIter>
-    ConstrainedQuadraticModel fix_variables(VarIter first, VarIter last,
-                                            AssignmentIter assignment) const;
+    ConstrainedQuadraticModel fix_variables(VarIter first, VarIter last, AssignmentIter assignment,
+                                            int num_threads = 1) const;
 
     /// Create a new model by fixing many variables.
     template <class T>
     ConstrainedQuadraticModel fix_variables(std::initializer_list<index_type> variables,
                                             std::initializer_list<T> assignments) const;
 
+    /**
+     * Determine which of a batch of samples satisfy all of the hard constraints.
+     *
+     * A constraint is satisfied when its violation is at most
+     * `atol + rtol * |rhs|`. Soft constraints are ignored, see penalties().
+     *
+     * `samples`, `num_samples` and `stride` are as for violations(). The
+     * results are written to `out`, which must have room for `num_samples`
+     * values.
+     */
+    template <class T>
+    void feasible(const T* samples, size_type num_samples, size_type stride, bool* out,
+                  bias_type rtol = 1e-6, bias_type atol = 1e-8, int num_threads = 1) const;
+
     /// Return the lower bound on variable ``v``.
     bias_type lower_bound(index_type v) const;
 
+    /**
+     * Return a breakdown of the heap memory used by the model: the objective,
+     * the constraints and the `vartype` info and bounds of the variables.
+     *
+     * If `capacity` is true, use the capacity of the underlying vectors rather
+     * than the size.
+     */
+    MemoryUsage memory_usage(bool capacity = false) const;
+
+    /**
+     * Return a breakdown of the heap memory used by the constraints.
+     *
+     * Each constraint is allocated individually, so this includes the
+     * constraint objects, with their sense, right-hand side and other
+     * metadata, as well as an estimate of the reference counts of the shared
+     * pointers that own them.
+     */
+    MemoryUsage constraints_memory_usage(bool capacity = false) const;
+
     /// Return a new constraint without adding it to the model.
     Constraint<bias_type, index_type> new_constraint() const;
 
@@ -181,6 +221,22 @@ class ConstrainedQuadraticModel {
     /// Return the number of variables in the model.
     size_type num_variables() const;
 
+    /**
+     * Calculate the penalties from the soft constraints for a batch of samples.
+     *
+     * Each soft constraint that is not satisfied, as defined by feasible(),
+     * contributes `weight * violation` for Penalty::LINEAR,
+     * `weight * violation^2` for Penalty::QUADRATIC and `weight` for
+     * Penalty::CONSTANT.
+     *
+     * `samples`, `num_samples` and `stride` are as for violations(). The
+     * penalties are written to `out`, which must have room for `num_samples`
+     * values.
+     */
+    template <class T, class R>
+    void penalties(const T* samples, size_type num_samples, size_type stride, R* out,
+                   bias_type rtol = 1e-6, bias_type atol = 1e-8, int num_threads = 1) const;
+
     /// Remove a constraint from the model.
     void remove_constraint(index_type c);
 
@@ -191,7 +247,26 @@ class ConstrainedQuadraticModel {
     void remove_constraints_if(UnaryPredicate p);
 
     /// Remove variable `v` from the model.
-    void remove_variable(index_type v);
+    /// The constraints are divided between up to `num_threads` threads, see utils::parallel_for().
+    void remove_variable(index_type v, int num_threads = 1);
+
+    /**
+     * Remove several variables from the model.
+     *
+     * The remaining variables are reindexed, preserving their relative order.
+     * Each constraint is rebuilt at most once, so removing many variables
+     * takes time linear in the size of the model rather than quadratic.
+     * Duplicate variables are ignored.
+     *
+     * The constraints are divided between up to `num_threads` threads, see
+     * utils::parallel_for().
+     */
+    template <class Iter>
+    void remove_variables(Iter first, Iter last, int num_threads = 1);
+
+    void remove_variables(const std::vector<index_type>& variables, int num_threads = 1) {
+        return remove_variables(variables.begin(), variables.end(), num_threads);
+    }
 
     /// Set a lower bound of `lb` on variable `v`.
     void set_lower_bound(index_type v, bias_type lb);
@@ -209,7 +284,10 @@ class ConstrainedQuadraticModel {
     void set_upper_bound(index_type v, bias_type ub);
     void set_vartype(index_type v, Vartype vartype);
 
-    void substitute_variable(index_type v, bias_type multiplier, bias_type offset);
+    /// Substitute `v` with `multiplier * v + offset` in the objective and every constraint.
+    /// The constraints are divided between up to `num_threads` threads, see utils::parallel_for().
+    void substitute_variable(index_type v, bias_type multiplier, bias_type offset,
+                             int num_threads = 1);
 
     /// Return the upper bound on variable ``v``.
     bias_type upper_bound(index_type v) const;
@@ -217,6 +295,22 @@ class ConstrainedQuadraticModel {
     /// Return the variable type of variable ``v``.
     Vartype vartype(index_type v) const;
 
+    /**
+     * Calculate the violation of every constraint for a batch of samples.
+     *
+     * `samples` must point to a row-major array of `num_samples` samples.
+     * Consecutive samples are `stride` elements apart, and `stride` must be
+     * at least `num_variables()`. The violations are written as a row-major
+     * `num_samples` by `num_constraints()` array to `out`. See
+     * Constraint::violation().
+     *
+     * The work is divided between up to `num_threads` threads, see
+     * utils::parallel_for().
+     */
+    template <class T, class R>
+    void violations(const T* samples, size_type num_samples, size_type stride, R* out,
+                    int num_threads = 1) const;
+
     friend void swap(ConstrainedQuadraticModel& first, ConstrainedQuadraticModel& second) {
         first.myswap(second);
     }
@@ -247,11 +341,28 @@ class ConstrainedQuadraticModel {
         swap(this->varinfo_, other.varinfo_);
     }
 
+    // Call f(constraint) on every constraint, dividing them between up to num_threads threads
+    template <class Function>
+    void for_each_constraint(Function f, int num_threads) {
+        utils::parallel_for(constraints_.size(), num_threads, [&](size_type first, size_type last) {
+            for (size_type c = first; c < last; ++c) f(*constraints_[c]);
+        });
+    }
+
     static void fix_variables_expr(const Expression<bias_type, index_type>& src,
                                    Expression<bias_type, index_type>& dst,
                                    const std::vector<index_type>& old_to_new,
                                    const std::vector<bias_type>& assignments);
 
+    // Return true if `expr` has a variable `v` with `old_to_new[v] < 0`.
+    static bool has_fixed_variable(const Expression<bias_type, index_type>& expr,
+                                   const std::vector<index_type>& old_to_new) {
+        for (const index_type& v : expr.variables()) {
+            if (old_to_new[v] < 0) return true;
+        }
+        return false;
+    }
+
     std::vector<std::shared_ptr<Constraint<bias_type, index_type>>> constraints_;
 
     struct varinfo_type {
@@ -449,7 +560,8 @@ index_type ConstrainedQuadraticModel<bias_type, index_type>::add_variables(Varty
 
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::change_vartype(Vartype vartype,
-                                                                      index_type v) {
+                                                                      index_type v,
+                                                                      int num_threads) {
     const Vartype& source = this->vartype(v);
     const Vartype& target = vartype;
 
@@ -459,24 +571,24 @@ void ConstrainedQuadraticModel<bias_type, index_type>::change_vartype(Vartype va
         return;
     } else if (source == Vartype::SPIN && target == Vartype::BINARY) {
         objective.substitute_variable(v, 2, -1);
-        for (auto& c_ptr : constraints_) {
-            c_ptr->substitute_variable(v, 2, -1);
-        }
+        for_each_constraint(
+                [&](Constraint<bias_type, index_type>& c) { c.substitute_variable(v, 2, -1); },
+                num_threads);
         varinfo_[v].lb = 0;
         varinfo_[v].ub = 1;
         varinfo_[v].vartype = Vartype::BINARY;
     } else if (source == Vartype::BINARY && target == Vartype::SPIN) {
         objective.substitute_variable(v, .5, .5);
-        for (auto& c_ptr : constraints_) {
-            c_ptr->substitute_variable(v, .5, .5);
-        }
+        for_each_constraint(
+                [&](Constraint<bias_type, index_type>& c) { c.substitute_variable(v, .5, .5); },
+                num_threads);
         varinfo_[v].lb = -1;
         varinfo_[v].ub = +1;
         varinfo_[v].vartype = Vartype::SPIN;
     } else if (source == Vartype::SPIN && target == Vartype::INTEGER) {
         // first go to BINARY, then INTEGER
-        change_vartype(Vartype::BINARY, v);
-        change_vartype(Vartype::INTEGER, v);
+        change_vartype(Vartype::BINARY, v, num_threads);
+        change_vartype(Vartype::INTEGER, v, num_threads);
     } else if (source == Vartype::BINARY && target == Vartype::INTEGER) {
         // nothing need to change except the vartype itself
         varinfo_[v].vartype = Vartype::INTEGER;
@@ -535,10 +647,11 @@ ConstrainedQuadraticModel<bias_type, index_type>::constraint_weak_ptr(index_type
 
 template <class bias_type, class index_type>
 template <class T>
-void ConstrainedQuadraticModel<bias_type, index_type>::fix_variable(index_type v, T assignment) {
+void ConstrainedQuadraticModel<bias_type, index_type>::fix_variable(index_type v, T assignment,
+                                                                    int num_threads) {
     assert(v >= 0 && static_cast<size_type>(v) < num_variables());
-    substitute_variable(v, 0, assignment);
-    remove_variable(v);
+    substitute_variable(v, 0, assignment, num_threads);
+    remove_variable(v, num_threads);
 }
 
 template <class bias_type, class index_type>
@@ -548,6 +661,9 @@ void ConstrainedQuadraticModel<bias_type, index_type>::fix_variables_expr(
     // We'll want to access the source expression by index for speed
     const abc::QuadraticModelBase<bias_type, index_type>& isrc = src;
 
+    // at most every source variable is kept
+    dst.reserve(src.num_variables());
+
     // offset
     dst.add_offset(src.offset());
 
@@ -561,6 +677,7 @@ void ConstrainedQuadraticModel<bias_type, index_type>::fix_variables_expr(
         } else {
             // not fixed
             dst.add_linear(old_to_new[v], isrc.linear(i));
+            dst.reserve_interactions(old_to_new[v], isrc.num_interactions(i));
         }
     }
 
@@ -593,7 +710,8 @@ template <class bias_type, class index_type>
 template <class VarIter, class AssignmentIter>
 ConstrainedQuadraticModel<bias_type, index_type>
 ConstrainedQuadraticModel<bias_type, index_type>::fix_variables(VarIter first, VarIter last,
-                                                                AssignmentIter assignment) const {
+                                                                AssignmentIter assignment,
+                                                                int num_threads) const {
     // We're going to make a new CQM
     auto cqm = ConstrainedQuadraticModel<bias_type, index_type>();
 
@@ -619,27 +737,51 @@ ConstrainedQuadraticModel<bias_type, index_type>::fix_variables(VarIter first, V
                 cqm.add_variable(this->vartype(i), this->lower_bound(i), this->upper_bound(i));
     }
 
-    // Objective
-    fix_variables_expr(this->objective, cqm.objective, old_to_new, assignments);
-
-    // Constraints
-    for (auto& old_constraint_ptr : constraints_) {
-        auto new_constraint = cqm.new_constraint();
-
-        fix_variables_expr(*old_constraint_ptr, new_constraint, old_to_new, assignments);
-
-        // dev note: this is kind of a maintenance mess. If we find ourselves doing this again
-        // we should make a method for copying attributes etc
-        new_constraint.set_rhs(old_constraint_ptr->rhs());
-        new_constraint.set_sense(old_constraint_ptr->sense());
-        new_constraint.set_weight(old_constraint_ptr->weight());
-        new_constraint.set_penalty(old_constraint_ptr->penalty());
-        new_constraint.mark_discrete(old_constraint_ptr->marked_discrete() &&
-                                     new_constraint.is_onehot());
-
-        cqm.add_constraint(std::move(new_constraint));
+    // Objective. Expressions without a fixed variable keep their biases and
+    // structure, so they are copied and relabelled rather than rebuilt.
+    if (has_fixed_variable(this->objective, old_to_new)) {
+        fix_variables_expr(this->objective, cqm.objective, old_to_new, assignments);
+    } else {
+        cqm.objective = this->objective;
+        cqm.objective.parent_ = &cqm;
+        cqm.objective.reindex_variables(old_to_new);
     }
 
+    // Constraints. Each new constraint only reads from its old one and from the
+    // (now fixed) variables of the new model, so we can build them independently.
+    cqm.constraints_.resize(constraints_.size());
+    utils::parallel_for(constraints_.size(), num_threads, [&](size_type first, size_type last) {
+        for (size_type c = first; c < last; ++c) {
+            const auto& old_constraint = *constraints_[c];
+
+            if (!has_fixed_variable(old_constraint, old_to_new)) {
+                auto new_constraint_ptr =
+                        std::make_shared<Constraint<bias_type, index_type>>(old_constraint);
+                new_constraint_ptr->parent_ = &cqm;
+                new_constraint_ptr->reindex_variables(old_to_new);
+
+                cqm.constraints_[c] = std::move(new_constraint_ptr);
+                continue;
+            }
+
+            auto new_constraint_ptr = std::make_shared<Constraint<bias_type, index_type>>(&cqm);
+            auto& new_constraint = *new_constraint_ptr;
+
+            fix_variables_expr(old_constraint, new_constraint, old_to_new, assignments);
+
+            // dev note: this is kind of a maintenance mess. If we find ourselves doing this again
+            // we should make a method for copying attributes etc
+            new_constraint.set_rhs(old_constraint.rhs());
+            new_constraint.set_sense(old_constraint.sense());
+            new_constraint.set_weight(old_constraint.weight());
+            new_constraint.set_penalty(old_constraint.penalty());
+            new_constraint.mark_discrete(old_constraint.marked_discrete() &&
+                                         new_constraint.is_onehot());
+
+            cqm.constraints_[c] = std::move(new_constraint_ptr);
+        }
+    });
+
     return cqm;
 }
 
@@ -651,11 +793,71 @@ ConstrainedQuadraticModel<bias_type, index_type>::fix_variables(
     return fix_variables(variables.begin(), variables.end(), assignments.begin());
 }
 
+template <class bias_type, class index_type>
+template <class T>
+void ConstrainedQuadraticModel<bias_type, index_type>::feasible(const T* samples,
+                                                                size_type num_samples,
+                                                                size_type stride, bool* out,
+                                                                bias_type rtol, bias_type atol,
+                                                                int num_threads) const {
+    const size_type nc = num_constraints();
+
+    std::vector<bias_type> violations(num_samples * nc);
+    this->violations(samples, num_samples, stride, violations.data(), num_threads);
+
+    // the largest violation that still satisfies each constraint, soft constraints
+    // can be violated by any amount
+    std::vector<bias_type> tolerances(nc);
+    for (size_type c = 0; c < nc; ++c) {
+        tolerances[c] = constraints_[c]->is_soft()
+                                ? std::numeric_limits<bias_type>::infinity()
+                                : atol + rtol * std::abs(constraints_[c]->rhs());
+    }
+
+    utils::parallel_for(num_samples, num_threads, [&](size_type first, size_type last) {
+        for (size_type si = first; si < last; ++si) {
+            const bias_type* row = violations.data() + si * nc;
+
+            bool is_feasible = true;
+            for (size_type c = 0; c < nc && is_feasible; ++c) {
+                is_feasible = row[c] <= tolerances[c];
+            }
+            out[si] = is_feasible;
+        }
+    });
+}
+
 template <class bias_type, class index_type>
 bias_type ConstrainedQuadraticModel<bias_type, index_type>::lower_bound(index_type v) const {
     return varinfo_[v].lb;
 }
 
+template <class bias_type, class index_type>
+MemoryUsage ConstrainedQuadraticModel<bias_type, index_type>::memory_usage(bool capacity) const {
+    MemoryUsage usage = objective.memory_usage(capacity);
+    usage += constraints_memory_usage(capacity);
+    usage.variables += (capacity ? varinfo_.capacity() : varinfo_.size()) * sizeof(varinfo_type);
+    return usage;
+}
+
+template <class bias_type, class index_type>
+MemoryUsage ConstrainedQuadraticModel<bias_type, index_type>::constraints_memory_usage(
+        bool capacity) const {
+    // The constraints are created with std::make_shared, so each one shares
+    // an allocation with a control block. Its layout is unspecified, but the
+    // common implementations hold a vtable pointer and two reference counts.
+    const size_type control_block = sizeof(void*) + 2 * sizeof(long);
+
+    MemoryUsage usage;
+    usage.other += (capacity ? constraints_.capacity() : constraints_.size()) *
+                   sizeof(std::shared_ptr<Constraint<bias_type, index_type>>);
+    for (const auto& c_ptr : constraints_) {
+        usage += c_ptr->memory_usage(capacity);
+        usage.other += sizeof(Constraint<bias_type, index_type>) + control_block;
+    }
+    return usage;
+}
+
 template <class bias_type, class index_type>
 Constraint<bias_type, index_type> ConstrainedQuadraticModel<bias_type, index_type>::new_constraint()
         const {
@@ -672,6 +874,60 @@ std::size_t ConstrainedQuadraticModel<bias_type, index_type>::num_variables() co
     return varinfo_.size();
 }
 
+template <class bias_type, class index_type>
+template <class T, class R>
+void ConstrainedQuadraticModel<bias_type, index_type>::penalties(const T* samples,
+                                                                 size_type num_samples,
+                                                                 size_type stride, R* out,
+                                                                 bias_type rtol, bias_type atol,
+                                                                 int num_threads) const {
+    // only the soft constraints contribute, so we only evaluate those
+    std::vector<const Constraint<bias_type, index_type>*> soft;
+    for (const auto& c_ptr : constraints_) {
+        if (c_ptr->is_soft()) soft.push_back(c_ptr.get());
+    }
+
+    std::fill(out, out + num_samples, 0);
+    if (soft.empty()) return;
+
+    const size_type chunk_size = 256;
+    const size_type num_chunks = (num_samples + chunk_size - 1) / chunk_size;
+
+    // each chunk of samples accumulates its own penalties
+    utils::parallel_for(num_chunks, num_threads, [&](size_type first, size_type last) {
+        std::vector<R> lhs(chunk_size);
+
+        for (size_type chunk = first; chunk < last; ++chunk) {
+            const size_type start = chunk * chunk_size;
+            const size_type length = std::min(chunk_size, num_samples - start);
+
+            for (const auto c_ptr : soft) {
+                c_ptr->energies(samples + start * stride, length, stride, lhs.data());
+
+                const bias_type tolerance = atol + rtol * std::abs(c_ptr->rhs());
+                const bias_type weight = c_ptr->weight();
+
+                for (size_type si = 0; si < length; ++si) {
+                    const bias_type violation = c_ptr->violation(lhs[si]);
+                    if (violation <= tolerance) continue;
+
+                    switch (c_ptr->penalty()) {
+                        case Penalty::LINEAR:
+                            out[start + si] += weight * violation;
+                            break;
+                        case Penalty::QUADRATIC:
+                            out[start + si] += weight * violation * violation;
+                            break;
+                        case Penalty::CONSTANT:
+                            out[start + si] += weight;
+                            break;
+                    }
+                }
+            }
+        }
+    });
+}
+
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::remove_constraint(index_type c) {
     constraints_.erase(constraints_.begin() + c, constraints_.begin() + c + 1);
@@ -690,13 +946,48 @@ void ConstrainedQuadraticModel<bias_type, index_type>::remove_constraints_if(Una
 }
 
 template <class bias_type, class index_type>
-void ConstrainedQuadraticModel<bias_type, index_type>::remove_variable(index_type v) {
+void ConstrainedQuadraticModel<bias_type, index_type>::remove_variable(index_type v,
+                                                                       int num_threads) {
     assert(v >= 0 && static_cast<size_type>(v) < num_variables());
-    for (auto& c_ptr : constraints_) c_ptr->reindex_variables(v);
+    for_each_constraint([&](Constraint<bias_type, index_type>& c) { c.reindex_variables(v); },
+                        num_threads);
     objective.reindex_variables(v);
     varinfo_.erase(varinfo_.begin() + v);
 }
 
+template <class bias_type, class index_type>
+template <class Iter>
+void ConstrainedQuadraticModel<bias_type, index_type>::remove_variables(Iter first, Iter last,
+                                                                        int num_threads) {
+    // Map from the old indices to the new ones, -1 for the removed variables.
+    std::vector<index_type> old_to_new(num_variables(), 0);
+    for (auto it = first; it != last; ++it) {
+        assert(*it >= 0 && static_cast<size_type>(*it) < num_variables());
+        old_to_new[*it] = -1;
+    }
+
+    std::vector<index_type> removed;
+    index_type label = 0;
+    for (size_type v = 0; v < old_to_new.size(); ++v) {
+        if (old_to_new[v] < 0) {
+            removed.emplace_back(v);
+        } else {
+            old_to_new[v] = label++;
+        }
+    }
+
+    if (removed.empty()) return;
+
+    for_each_constraint(
+            [&](Constraint<bias_type, index_type>& c) { c.reindex_variables(old_to_new); },
+            num_threads);
+    objective.reindex_variables(old_to_new);
+
+    varinfo_.erase(utils::remove_by_index(varinfo_.begin(), varinfo_.end(), removed.begin(),
+                                          removed.end()),
+                   varinfo_.end());
+}
+
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::set_lower_bound(index_type v, bias_type lb) {
     varinfo_[v].lb = lb;
@@ -775,11 +1066,14 @@ void ConstrainedQuadraticModel<bias_type, index_type>::set_vartype(index_type v,
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::substitute_variable(index_type v,
                                                                            bias_type multiplier,
-                                                                           bias_type offset) {
+                                                                           bias_type offset,
+                                                                           int num_threads) {
     objective.substitute_variable(v, multiplier, offset);
-    for (auto& c_ptr : constraints_) {
-        c_ptr->substitute_variable(v, multiplier, offset);
-    }
+    for_each_constraint(
+            [&](Constraint<bias_type, index_type>& c) {
+                c.substitute_variable(v, multiplier, offset);
+            },
+            num_threads);
 }
 
 template <class bias_type, class index_type>
@@ -792,4 +1086,38 @@ Vartype ConstrainedQuadraticModel<bias_type, index_type>::vartype(index_type v)
     return varinfo_[v].vartype;
 }
 
+template <class bias_type, class index_type>
+template <class T, class R>
+void ConstrainedQuadraticModel<bias_type, index_type>::violations(const T* samples,
+                                                                  size_type num_samples,
+                                                                  size_type stride, R* out,
+                                                                  int num_threads) const {
+    assert(stride >= num_variables());
+
+    const size_type chunk_size = 256;
+    const size_type num_chunks = (num_samples + chunk_size - 1) / chunk_size;
+    const size_type nc = num_constraints();
+
+    // Every (constraint, chunk of samples) pair can be done independently, so
+    // we divide those between the threads. This way we get parallelism both
+    // for many constraints and few samples, and for few constraints and many
+    // samples.
+    utils::parallel_for(nc * num_chunks, num_threads, [&](size_type first, size_type last) {
+        std::vector<R> lhs(chunk_size);
+
+        for (size_type task = first; task < last; ++task) {
+            const size_type c = task / num_chunks;
+            const auto& constraint = *constraints_[c];
+            const size_type start = (task % num_chunks) * chunk_size;
+            const size_type length = std::min(chunk_size, num_samples - start);
+
+            constraint.energies(samples + start * stride, length, stride, lhs.data());
+
+            for (size_type si = 0; si < length; ++si) {
+                out[(start + si) * nc + c] = constraint.violation(lhs[si]);
+            }
+        }
+    });
+}
+
 }  // namespace dimod
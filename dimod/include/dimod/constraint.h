@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cmath>
 #include <limits>
 #include <unordered_map>
 #include <utility>
@@ -90,6 +91,10 @@ class Constraint : public Expression<Bias, Index> {
     /// Set the weight for a soft constraint.
     void set_weight(bias_type weight);
 
+    /// Return the amount by which the constraint is violated when its left-hand
+    /// side has energy `lhs_energy`. Non-positive values mean it is satisfied.
+    bias_type violation(bias_type lhs_energy) const;
+
     /// Return a soft constraint's weight.
     bias_type weight() const;
 
@@ -214,6 +219,19 @@ Sense Constraint<bias_type, index_type>::sense() const {
     return sense_;
 }
 
+template <class bias_type, class index_type>
+bias_type Constraint<bias_type, index_type>::violation(bias_type lhs_energy) const {
+    switch (sense_) {
+        case Sense::EQ:
+            return std::abs(lhs_energy - rhs_);
+        case Sense::LE:
+            return lhs_energy - rhs_;
+        case Sense::GE:
+            return rhs_ - lhs_energy;
+    }
+    throw std::logic_error("unexpected sense");
+}
+
 template <class bias_type, class index_type>
 bias_type Constraint<bias_type, index_type>::weight() const {
     return weight_;
@@ -0,0 +1,771 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/fileview.h"
+#include "dimod/utils.h"
+
+namespace dimod {
+namespace fileview {
+
+/**
+ * Major version of the format written by `dump()` and read by
+ * `ConstrainedQuadraticModelReader`.
+ *
+ * The file starts with a header, see `read_header()`, with the magic string
+ * "DIMODCQM". The header data holds the `compression`, `dtype`, `itype`,
+ * `num_constraints` and `num_variables`.
+ *
+ * The body is a sequence of independently encoded (and compressed) blocks:
+ *
+ * 1. the vartype and bounds of every variable
+ * 2. the objective
+ * 3. each of the constraints, in order
+ * 4. the variable labels
+ * 5. the constraint labels
+ *
+ * followed by the start of each of the blocks as `std::uint64_t`, plus the
+ * end of the last block, and finally a 24 byte footer: the start of that
+ * table, the number of constraints, and the magic string "DIMODEND". So the
+ * file can be written in a single pass and any constraint can be read without
+ * decoding the others.
+ */
+constexpr unsigned char CQM_VERSION_MAJOR = 3;
+/// Minor version of the format, see `CQM_VERSION_MAJOR`.
+constexpr unsigned char CQM_VERSION_MINOR = 0;
+
+/// Transform one block of a file, e.g. compress or decompress it. Must be safe to call
+/// concurrently.
+using BlockCodec = std::function<std::string(const std::string&)>;
+
+/// Options for writing a constrained quadratic model with `dump()`.
+struct DumpOptions {
+    /// Stored as-is, see `ConstrainedQuadraticModelReader::variable_labels()`.
+    std::string variable_labels;
+
+    /// Stored as-is, see `ConstrainedQuadraticModelReader::constraint_labels()`.
+    std::string constraint_labels;
+
+    /// Name of the compression applied by `compress`, saved in the header.
+    std::string compression;
+
+    /// If set, applied to every block after it is encoded.
+    BlockCodec compress;
+
+    /// Number of threads used to encode (and compress) constraints, see utils::parallel_for().
+    int num_threads = 1;
+
+    /// Number of constraints that are encoded before being written. Bounds the memory used.
+    std::size_t batch_size = 4096;
+};
+
+/**
+ * Write `cqm` to `os` using format version 3.0.
+ *
+ * The constraints are encoded in batches of `options.batch_size`, each
+ * divided between up to `options.num_threads` threads, and every batch is
+ * written as soon as it is encoded. `os` does not need to be seekable.
+ */
+template <class Bias, class Index>
+void dump(const ConstrainedQuadraticModel<Bias, Index>& cqm, std::ostream& os,
+          const DumpOptions& options = DumpOptions());
+
+/**
+ * A function that writes the `n` bytes at `data` to the file identified by
+ * `context`, e.g. a file object of another language. Returns false if the
+ * write failed.
+ */
+using WriteFunction = bool (*)(void* context, const char* data, std::size_t n);
+
+/**
+ * A function that reads the `n` bytes starting at byte `offset` of the file
+ * identified by `context` into `out`. Returns false if they could not all be
+ * read.
+ */
+using ReadFunction = bool (*)(void* context, std::uint64_t offset, std::size_t n, char* out);
+
+/**
+ * Write `cqm` using format version 3.0 by passing it to `write` in chunks of
+ * bounded size. See `dump()`.
+ *
+ * # Exceptions
+ * Throws `std::runtime_error` if `write` fails. Nothing more is written after
+ * the first failure.
+ */
+template <class Bias, class Index>
+void dump(const ConstrainedQuadraticModel<Bias, Index>& cqm, WriteFunction write, void* context,
+          const DumpOptions& options = DumpOptions());
+
+/// Return `cqm` serialized using format version 3.0. See `dump()`.
+template <class Bias, class Index>
+std::string dumps(const ConstrainedQuadraticModel<Bias, Index>& cqm,
+                  const DumpOptions& options = DumpOptions()) {
+    std::ostringstream os;
+    dump(cqm, os, options);
+    return os.str();
+}
+
+/**
+ * Read constrained quadratic models serialized with format version 3.0 from
+ * a buffer, e.g. a `MappedFile`, or from a file read with a `ReadFunction`.
+ *
+ * Constructing a reader only reads the header and the block table. The
+ * blocks are decoded on demand, so any one constraint can be read without
+ * decoding the rest. The buffer must outlive the reader.
+ */
+template <class Bias, class Index = int>
+class ConstrainedQuadraticModelReader {
+ public:
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Type of the model that is read.
+    using model_type = ConstrainedQuadraticModel<bias_type, index_type>;
+
+    /**
+     * Construct a reader for the model serialized in the `length` bytes of `data`.
+     *
+     * If the blocks were compressed, `decompress` must invert the compression.
+     *
+     * # Exceptions
+     * Throws `std::invalid_argument` if `data` is not a version 3.0 file with
+     * biases of type `bias_type` and indices of type `index_type`, or if it is
+     * truncated, or if it is compressed and `decompress` is not given.
+     */
+    ConstrainedQuadraticModelReader(const void* data, size_type length,
+                                    BlockCodec decompress = nullptr);
+
+    /**
+     * Construct a reader for the model serialized in a file of `length` bytes
+     * that is read with `read`.
+     *
+     * Only the header and the block table are read up front. Each block is
+     * read when it is decoded, so loading the model needs memory for the
+     * model and for the blocks being decoded rather than for the whole file.
+     * Calls to `read` are serialized, but may be made from any of the threads
+     * used by `load()`. `context` must outlive the reader.
+     *
+     * # Exceptions
+     * As above, and throws `std::runtime_error` if `read` fails.
+     */
+    ConstrainedQuadraticModelReader(ReadFunction read, void* context, size_type length,
+                                    BlockCodec decompress = nullptr);
+
+    /// Return the name of the compression used by the file, or an empty string if none.
+    const std::string& compression() const;
+
+    /// Return the constraint labels stored with the model.
+    std::string constraint_labels() const;
+
+    /**
+     * Read the model.
+     *
+     * The constraints are decoded by up to `num_threads` threads, see
+     * utils::parallel_for().
+     */
+    model_type load(int num_threads = 1) const;
+
+    /**
+     * Read constraint `c` only.
+     *
+     * The constraint belongs to `parent`, which must have the same variables
+     * as the saved model, e.g. one returned by `load_objective()`. The
+     * constraint is not added to `parent`, see
+     * `ConstrainedQuadraticModel::add_constraint()`.
+     */
+    Constraint<bias_type, index_type> load_constraint(size_type c, const model_type& parent) const;
+
+    /// Read the variables and the objective of the model, without any constraints.
+    model_type load_objective() const;
+
+    /// Return the number of constraints in the model.
+    size_type num_constraints() const;
+
+    /// Return the number of variables in the model.
+    size_type num_variables() const;
+
+    /// Return the variable labels stored with the model.
+    std::string variable_labels() const;
+
+ private:
+    // Exactly one of data_ and read_ is set
+    const char* data_;
+    ReadFunction read_;
+    void* context_;
+    std::shared_ptr<std::mutex> read_mutex_;
+
+    BlockCodec decompress_;
+    std::string compression_;
+
+    size_type num_variables_;
+    size_type num_constraints_;
+
+    // The start of each block, and the end of the last one
+    std::vector<std::uint64_t> starts_;
+
+    // Return the contents of block b, decompressed if needed.
+    std::string block(size_type b) const;
+
+    // Read the header and the block table of a file of `length` bytes.
+    void init(size_type length);
+
+    // Copy the `n` bytes of the file starting at `offset` into `out`.
+    void read(std::uint64_t offset, size_type n, char* out) const;
+
+    // Decode the constraint in block `b` into `constraint`.
+    void read_constraint(size_type b, Constraint<bias_type, index_type>& constraint) const;
+};
+
+/// @private  <- don't doc
+namespace detail {
+
+// Appends fixed-size values to a block.
+class BlockWriter {
+ public:
+    template <class T>
+    void write(const T& value) {
+        write(&value, 1);
+    }
+
+    template <class T>
+    void write(const T* values, std::size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        if (!n) return;
+        buffer.append(reinterpret_cast<const char*>(values), n * sizeof(T));
+    }
+
+    std::string buffer;
+};
+
+// Reads fixed-size values from a block, checking that the block is long enough.
+class BlockReader {
+ public:
+    explicit BlockReader(const std::string& buffer)
+            : pos_(buffer.data()), end_(buffer.data() + buffer.size()) {}
+
+    template <class T>
+    T read() {
+        T value;
+        read(&value, 1);
+        return value;
+    }
+
+    template <class T>
+    void read(T* values, std::size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        if (static_cast<std::size_t>(end_ - pos_) / sizeof(T) < n) {
+            throw std::invalid_argument("block is truncated");
+        }
+        if (!n) return;
+        std::memcpy(values, pos_, n * sizeof(T));
+        pos_ += n * sizeof(T);
+    }
+
+    std::size_t remaining() const { return end_ - pos_; }
+
+ private:
+    const char* pos_;
+    const char* end_;
+};
+
+// An expression is encoded as its number of variables and interactions, the
+// offset, the variables, the linear biases and then the (row, column, bias)
+// of each interaction. Rows and columns are the model's variable indices.
+template <class Bias, class Index>
+void write_expression(BlockWriter& writer, const Expression<Bias, Index>& expression) {
+    const abc::QuadraticModelBase<Bias, Index>& base = expression;
+
+    writer.write<std::uint64_t>(expression.num_variables());
+    writer.write<std::uint64_t>(expression.num_interactions());
+    writer.write(expression.offset());
+
+    writer.write(expression.variables().data(), expression.num_variables());
+    for (std::size_t i = 0; i < expression.num_variables(); ++i) writer.write(base.linear(i));
+
+    for (auto it = expression.cbegin_quadratic(); it != expression.cend_quadratic(); ++it) {
+        writer.write(it->u);
+    }
+    for (auto it = expression.cbegin_quadratic(); it != expression.cend_quadratic(); ++it) {
+        writer.write(it->v);
+    }
+    for (auto it = expression.cbegin_quadratic(); it != expression.cend_quadratic(); ++it) {
+        writer.write(it->bias);
+    }
+}
+
+template <class Bias, class Index>
+void read_expression(BlockReader& reader, Expression<Bias, Index>& expression,
+                     std::size_t num_variables) {
+    const std::uint64_t n = reader.read<std::uint64_t>();
+    const std::uint64_t m = reader.read<std::uint64_t>();
+
+    // check the lengths before allocating anything
+    const std::size_t term_size = 2 * sizeof(Index) + sizeof(Bias);
+    if (n > num_variables || m > reader.remaining() / term_size) {
+        throw std::invalid_argument("block is corrupted");
+    }
+
+    expression.clear();
+    expression.set_offset(reader.read<Bias>());
+
+    std::vector<Index> variables(n);
+    std::vector<Bias> biases(std::max(n, m));
+    reader.read(variables.data(), n);
+    reader.read(biases.data(), n);
+
+    // adding the variables in order gives them the same indices as before
+    expression.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (variables[i] < 0 || static_cast<std::size_t>(variables[i]) >= num_variables) {
+            throw std::invalid_argument("block is corrupted");
+        }
+        expression.add_linear(variables[i], biases[i]);
+    }
+    if (expression.num_variables() != n) throw std::invalid_argument("block is corrupted");
+
+    std::vector<Index> irow(m);
+    std::vector<Index> icol(m);
+    reader.read(irow.data(), m);
+    reader.read(icol.data(), m);
+    reader.read(biases.data(), m);
+    for (std::size_t i = 0; i < m; ++i) {
+        if (!expression.has_variable(irow[i]) || !expression.has_variable(icol[i])) {
+            throw std::invalid_argument("block is corrupted");
+        }
+    }
+    expression.add_quadratic_coo(irow.begin(), icol.begin(), biases.begin(), m);
+}
+
+// A constraint is encoded as its sense, penalty and discrete marker, then its
+// rhs and weight, then its left-hand side.
+template <class Bias, class Index>
+void write_constraint(BlockWriter& writer, const Constraint<Bias, Index>& constraint) {
+    writer.write<std::int8_t>(constraint.sense());
+    writer.write<std::int8_t>(constraint.penalty());
+    writer.write<std::int8_t>(constraint.marked_discrete());
+    writer.write(constraint.rhs());
+    writer.write(constraint.weight());
+    write_expression(writer, constraint);
+}
+
+// Buffers what is written to it and passes it on to a WriteFunction.
+class WriteFunctionStreambuf : public std::streambuf {
+ public:
+    WriteFunctionStreambuf(WriteFunction write, void* context, std::size_t buffer_size = 1 << 20)
+            : write_(write), context_(context), buffer_(buffer_size), failed_(false) {
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+    bool failed() const { return failed_; }
+
+ protected:
+    int_type overflow(int_type ch) override {
+        if (!flush()) return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override { return flush() ? 0 : -1; }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        if (n <= epptr() - pptr()) {
+            std::memcpy(pptr(), s, n);
+            pbump(static_cast<int>(n));
+            return n;
+        }
+
+        // make room, then pass large writes on without copying them
+        if (!flush()) return 0;
+        if (static_cast<std::size_t>(n) >= buffer_.size()) {
+            return put(s, n) ? n : 0;
+        }
+        std::memcpy(pptr(), s, n);
+        pbump(static_cast<int>(n));
+        return n;
+    }
+
+ private:
+    bool put(const char* s, std::size_t n) {
+        if (failed_ || (n && !write_(context_, s, n))) failed_ = true;
+        return !failed_;
+    }
+
+    bool flush() {
+        const bool ok = put(pbase(), pptr() - pbase());
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+        return ok;
+    }
+
+    WriteFunction write_;
+    void* context_;
+    std::vector<char> buffer_;
+    bool failed_;
+};
+
+}  // namespace detail
+
+template <class Bias, class Index>
+void dump(const ConstrainedQuadraticModel<Bias, Index>& cqm, std::ostream& os,
+          const DumpOptions& options) {
+    // match the header produced by json.dumps(data, sort_keys=True)
+    std::uint64_t written = write_header(
+            os, "DIMODCQM", CQM_VERSION_MAJOR, CQM_VERSION_MINOR,
+            "{\"compression\": \"" + options.compression + "\", \"dtype\": \"" +
+                    dtype_name<Bias>() + "\", \"itype\": \"" + dtype_name<Index>() +
+                    "\", \"num_constraints\": " + std::to_string(cqm.num_constraints()) +
+                    ", \"num_variables\": " + std::to_string(cqm.num_variables()) +
+                    ", \"type\": \"ConstrainedQuadraticModel\"}");
+
+    std::vector<std::uint64_t> starts;
+    starts.reserve(cqm.num_constraints() + 5);
+
+    auto finish = [&](std::string& block) {
+        if (options.compress) block = options.compress(block);
+    };
+    auto write = [&](const std::string& block) {
+        starts.push_back(written);
+        os.write(block.data(), block.size());
+        written += block.size();
+    };
+
+    // the variables
+    {
+        detail::BlockWriter writer;
+        writer.write<std::uint64_t>(cqm.num_variables());
+        for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+            writer.write<std::int8_t>(cqm.vartype(v));
+        }
+        for (std::size_t v = 0; v < cqm.num_variables(); ++v) writer.write(cqm.lower_bound(v));
+        for (std::size_t v = 0; v < cqm.num_variables(); ++v) writer.write(cqm.upper_bound(v));
+        finish(writer.buffer);
+        write(writer.buffer);
+    }
+
+    // the objective
+    {
+        detail::BlockWriter writer;
+        detail::write_expression(writer, cqm.objective);
+        finish(writer.buffer);
+        write(writer.buffer);
+    }
+
+    // the constraints in batches, encoding each batch in parallel
+    const std::size_t batch_size = std::max<std::size_t>(options.batch_size, 1);
+    std::vector<std::string> batch;
+    for (std::size_t first = 0; first < cqm.num_constraints(); first += batch_size) {
+        batch.resize(std::min(batch_size, cqm.num_constraints() - first));
+
+        std::exception_ptr error;
+        std::mutex mutex;
+        utils::parallel_for(batch.size(), options.num_threads, [&](std::size_t i, std::size_t j) {
+            try {
+                for (; i < j; ++i) {
+                    detail::BlockWriter writer;
+                    detail::write_constraint(writer, cqm.constraint_ref(first + i));
+                    finish(writer.buffer);
+                    batch[i].swap(writer.buffer);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+        });
+        if (error) std::rethrow_exception(error);
+
+        for (auto& block : batch) write(block);
+    }
+
+    // the labels
+    for (const std::string* labels : {&options.variable_labels, &options.constraint_labels}) {
+        std::string block = *labels;
+        finish(block);
+        write(block);
+    }
+
+    // finally the block table and the footer
+    starts.push_back(written);
+    os.write(reinterpret_cast<const char*>(starts.data()), starts.size() * sizeof(std::uint64_t));
+
+    const std::uint64_t num_constraints = cqm.num_constraints();
+    os.write(reinterpret_cast<const char*>(&starts.back()), sizeof(std::uint64_t));
+    os.write(reinterpret_cast<const char*>(&num_constraints), sizeof(num_constraints));
+    os.write("DIMODEND", 8);
+}
+
+template <class Bias, class Index>
+void dump(const ConstrainedQuadraticModel<Bias, Index>& cqm, WriteFunction write, void* context,
+          const DumpOptions& options) {
+    detail::WriteFunctionStreambuf buffer(write, context);
+    std::ostream os(&buffer);
+    dump(cqm, os, options);
+    os.flush();
+    if (buffer.failed()) throw std::runtime_error("could not write the file");
+}
+
+template <class bias_type, class index_type>
+ConstrainedQuadraticModelReader<bias_type, index_type>::ConstrainedQuadraticModelReader(
+        const void* data, size_type length, BlockCodec decompress)
+        : data_(static_cast<const char*>(data)),
+          read_(nullptr),
+          context_(nullptr),
+          decompress_(std::move(decompress)) {
+    init(length);
+}
+
+template <class bias_type, class index_type>
+ConstrainedQuadraticModelReader<bias_type, index_type>::ConstrainedQuadraticModelReader(
+        ReadFunction read, void* context, size_type length, BlockCodec decompress)
+        : data_(nullptr),
+          read_(read),
+          context_(context),
+          read_mutex_(std::make_shared<std::mutex>()),
+          decompress_(std::move(decompress)) {
+    init(length);
+}
+
+template <class bias_type, class index_type>
+std::string ConstrainedQuadraticModelReader<bias_type, index_type>::block(size_type b) const {
+    assert(b + 1 < starts_.size());
+    std::string contents(starts_[b + 1] - starts_[b], '\0');
+    read(starts_[b], contents.size(), &contents[0]);
+    if (decompress_) contents = decompress_(contents);
+    return contents;
+}
+
+template <class bias_type, class index_type>
+const std::string& ConstrainedQuadraticModelReader<bias_type, index_type>::compression() const {
+    return compression_;
+}
+
+template <class bias_type, class index_type>
+std::string ConstrainedQuadraticModelReader<bias_type, index_type>::constraint_labels() const {
+    return block(num_constraints_ + 3);
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModelReader<bias_type, index_type>::init(size_type length) {
+    // the magic string, the version and the header length, then the header data
+    std::string header(std::min<size_type>(length, 14), '\0');
+    read(0, header.size(), &header[0]);
+    if (header.size() == 14) {
+        std::uint32_t data_length;
+        std::memcpy(&data_length, &header[10], sizeof(data_length));
+        if (length >= 14 + static_cast<size_type>(data_length)) {
+            header.resize(14 + data_length);
+            read(14, data_length, &header[14]);
+        }
+    }
+
+    const Header info = read_header(header.data(), header.size(), "DIMODCQM");
+    if (info.major != CQM_VERSION_MAJOR) {
+        throw std::invalid_argument("only files with format version 3.0 can be read");
+    }
+
+    if (header_field(info.data, "dtype") != dtype_name<bias_type>() ||
+        header_field(info.data, "itype") != dtype_name<index_type>()) {
+        throw std::invalid_argument("file data types do not match bias_type and index_type");
+    }
+
+    compression_ = header_field(info.data, "compression");
+    if (!compression_.empty() && !decompress_) {
+        throw std::invalid_argument("file is compressed with \"" + compression_ +
+                                    "\" but no decompress function was given");
+    }
+
+    num_variables_ = std::stoull(header_field(info.data, "num_variables"));
+    num_constraints_ = std::stoull(header_field(info.data, "num_constraints"));
+
+    // the footer
+    const size_type footer_length = 2 * sizeof(std::uint64_t) + 8;
+    if (length < info.length + footer_length) throw std::invalid_argument("file is truncated");
+
+    char footer[footer_length];
+    read(length - footer_length, footer_length, footer);
+    if (std::memcmp(footer + 16, "DIMODEND", 8)) throw std::invalid_argument("file is truncated");
+
+    std::uint64_t table_start;
+    std::uint64_t num_constraints;
+    std::memcpy(&table_start, footer, sizeof(table_start));
+    std::memcpy(&num_constraints, footer + 8, sizeof(num_constraints));
+
+    const size_type num_blocks = num_constraints_ + 4;
+    if (num_constraints != num_constraints_ ||
+        table_start + (num_blocks + 1) * sizeof(std::uint64_t) + footer_length != length) {
+        throw std::invalid_argument("file footer does not match the header");
+    }
+
+    starts_.resize(num_blocks + 1);
+    read(table_start, starts_.size() * sizeof(std::uint64_t),
+         reinterpret_cast<char*>(starts_.data()));
+
+    if (starts_.front() != info.length || starts_.back() != table_start ||
+        !std::is_sorted(starts_.begin(), starts_.end())) {
+        throw std::invalid_argument("file block table is corrupted");
+    }
+}
+
+template <class bias_type, class index_type>
+auto ConstrainedQuadraticModelReader<bias_type, index_type>::load(int num_threads) const
+        -> model_type {
+    model_type cqm = load_objective();
+    cqm.add_constraints(num_constraints_);
+
+    std::exception_ptr error;
+    std::mutex mutex;
+    utils::parallel_for(num_constraints_, num_threads, [&](size_type first, size_type last) {
+        try {
+            for (size_type c = first; c < last; ++c) read_constraint(c + 2, cqm.constraint_ref(c));
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    });
+    if (error) std::rethrow_exception(error);
+
+    return cqm;
+}
+
+template <class bias_type, class index_type>
+auto ConstrainedQuadraticModelReader<bias_type, index_type>::load_constraint(
+        size_type c, const model_type& parent) const -> Constraint<bias_type, index_type> {
+    if (c >= num_constraints_) throw std::out_of_range("constraint index out of range");
+    if (parent.num_variables() != num_variables_) {
+        throw std::invalid_argument("parent does not have the same variables as the saved model");
+    }
+
+    Constraint<bias_type, index_type> constraint = parent.new_constraint();
+    read_constraint(c + 2, constraint);
+    return constraint;
+}
+
+template <class bias_type, class index_type>
+auto ConstrainedQuadraticModelReader<bias_type, index_type>::load_objective() const -> model_type {
+    model_type cqm;
+
+    // the variables
+    {
+        const std::string contents = block(0);
+        detail::BlockReader reader(contents);
+
+        if (reader.read<std::uint64_t>() != num_variables_) {
+            throw std::invalid_argument("block is corrupted");
+        }
+
+        std::vector<std::int8_t> vartypes(num_variables_);
+        std::vector<bias_type> lbs(num_variables_);
+        std::vector<bias_type> ubs(num_variables_);
+        reader.read(vartypes.data(), num_variables_);
+        reader.read(lbs.data(), num_variables_);
+        reader.read(ubs.data(), num_variables_);
+
+        for (size_type v = 0; v < num_variables_; ++v) {
+            if (vartypes[v] < Vartype::BINARY || vartypes[v] > Vartype::REAL) {
+                throw std::invalid_argument("block is corrupted");
+            }
+            cqm.add_variable(static_cast<Vartype>(vartypes[v]), lbs[v], ubs[v]);
+        }
+    }
+
+    // the objective
+    {
+        const std::string contents = block(1);
+        detail::BlockReader reader(contents);
+        detail::read_expression(reader, cqm.objective, num_variables_);
+    }
+
+    return cqm;
+}
+
+template <class bias_type, class index_type>
+auto ConstrainedQuadraticModelReader<bias_type, index_type>::num_constraints() const -> size_type {
+    return num_constraints_;
+}
+
+template <class bias_type, class index_type>
+auto ConstrainedQuadraticModelReader<bias_type, index_type>::num_variables() const -> size_type {
+    return num_variables_;
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModelReader<bias_type, index_type>::read(std::uint64_t offset, size_type n,
+                                                                  char* out) const {
+    if (!n) return;
+    if (data_) {
+        std::memcpy(out, data_ + offset, n);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(*read_mutex_);
+    if (!read_(context_, offset, n, out)) throw std::runtime_error("could not read the file");
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModelReader<bias_type, index_type>::read_constraint(
+        size_type b, Constraint<bias_type, index_type>& constraint) const {
+    const std::string contents = block(b);
+    detail::BlockReader reader(contents);
+
+    const auto sense = reader.read<std::int8_t>();
+    const auto penalty = reader.read<std::int8_t>();
+    const auto marked_discrete = reader.read<std::int8_t>();
+    const auto rhs = reader.read<bias_type>();
+    const auto weight = reader.read<bias_type>();
+    if (sense < Sense::LE || sense > Sense::EQ || penalty < Penalty::LINEAR ||
+        penalty > Penalty::CONSTANT) {
+        throw std::invalid_argument("block is corrupted");
+    }
+
+    detail::read_expression(reader, constraint, num_variables_);
+
+    constraint.set_sense(static_cast<Sense>(sense));
+    constraint.set_penalty(static_cast<Penalty>(penalty));
+    constraint.mark_discrete(marked_discrete);
+    constraint.set_rhs(rhs);
+    constraint.set_weight(weight);
+}
+
+template <class bias_type, class index_type>
+std::string ConstrainedQuadraticModelReader<bias_type, index_type>::variable_labels() const {
+    return block(num_constraints_ + 2);
+}
+
+}  // namespace fileview
+}  // namespace dimod
@@ -0,0 +1,438 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/instrumentation.h"
+#include "dimod/utils.h"
+
+namespace dimod {
+
+/**
+ * A discrete quadratic model (DQM) is a quadratic polynomial over discrete
+ * variables, each of which takes exactly one of a fixed number of cases.
+ *
+ * Each case has a linear bias. The interactions between two variables are
+ * stored as one dense `num_cases(u) x num_cases(v)` block, so the energy of
+ * an interaction is a single lookup rather than a search over the cases.
+ */
+template <class Bias, class Index = int>
+class DiscreteQuadraticModel {
+ public:
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Empty constructor. The DQM has no variables.
+    DiscreteQuadraticModel();
+
+    /**
+     * Create a DQM from a quadratic model over its cases.
+     *
+     * `case_starts` must hold `num_variables() + 1` non-decreasing indices
+     * starting at 0 and ending at `cases.num_variables()`. The cases of
+     * variable `v` are the variables `[case_starts[v], case_starts[v + 1])`
+     * of `cases`.
+     *
+     * Throws `std::invalid_argument` if `case_starts` is inconsistent or if
+     * two cases of the same variable interact.
+     */
+    template <class B, class I>
+    DiscreteQuadraticModel(const abc::QuadraticModelBase<B, I>& cases,
+                           const std::vector<I>& case_starts);
+
+    /// Add `bias` to case `case_v` of variable `v`.
+    void add_linear(index_type v, index_type case_v, bias_type bias);
+
+    /// Add `bias` to the offset.
+    void add_offset(bias_type bias);
+
+    /**
+     * Add `bias` to the interaction between case `case_u` of variable `u`
+     * and case `case_v` of variable `v`.
+     *
+     * Throws `std::invalid_argument` if `u == v`.
+     */
+    void add_quadratic(index_type u, index_type case_u, index_type v, index_type case_v,
+                       bias_type bias);
+
+    /// Add a variable with `num_cases` cases and return its index.
+    index_type add_variable(index_type num_cases);
+
+    /// Return the index of the first case of `v` when the cases of all variables are concatenated.
+    index_type case_start(index_type v) const;
+
+    /**
+     * Calculate the energies of a batch of samples.
+     *
+     * `samples` must point to the beginning of a row-major array with
+     * `num_samples` rows. Each row holds the case of every variable, in
+     * variable order, and consecutive rows are `stride` elements apart.
+     * `stride` must be at least `num_variables()`. The energies are written
+     * to `out`, which must have room for `num_samples` values.
+     *
+     * The samples are divided between up to `num_threads` threads. If
+     * `num_threads` is less than 1, `std::thread::hardware_concurrency()`
+     * threads are used.
+     *
+     * Throws `std::out_of_range` if any sample holds a case that its variable
+     * does not have, in which case the contents of `out` are unspecified.
+     */
+    template <class T, class R>
+    void energies(const T* samples, size_type num_samples, size_type stride, R* out,
+                  int num_threads = 1) const;
+
+    /// Return the linear bias of case `case_v` of variable `v`.
+    bias_type linear(index_type v, index_type case_v) const;
+
+    /**
+     * Return a breakdown of the heap memory used by the model. The
+     * interaction blocks are counted as quadratic and the case starts as
+     * per-variable information.
+     *
+     * If `capacity` is true, use the capacity of the underlying vectors rather
+     * than the size.
+     */
+    MemoryUsage memory_usage(bool capacity = false) const;
+
+    /// Return the number of cases of variable `v`.
+    size_type num_cases(index_type v) const;
+
+    /// Return the total number of cases.
+    size_type num_cases() const;
+
+    /// Return the number of pairs of variables with an interaction block.
+    size_type num_variable_interactions() const;
+
+    /// Return the number of variables.
+    size_type num_variables() const;
+
+    /// Return the offset.
+    bias_type offset() const;
+
+    /**
+     * Return the interaction between case `case_u` of variable `u` and case
+     * `case_v` of variable `v`, 0 if the variables do not interact.
+     */
+    bias_type quadratic(index_type u, index_type case_u, index_type v, index_type case_v) const;
+
+    /// Set the offset.
+    void set_offset(bias_type offset);
+
+ private:
+    // A neighbor of a variable and the position of their block in blocks_.
+    // The block of u and v, u < v, is the row-major num_cases(u) x num_cases(v)
+    // matrix starting at blocks_[block].
+    struct Neighbor {
+        index_type v;
+        size_type block;
+
+        friend bool operator<(const Neighbor& a, index_type v) { return a.v < v; }
+    };
+
+    // Return the start of the block for u and v, creating it if needed.
+    size_type block(index_type u, index_type v);
+
+    // Return the start of the block for u and v, or blocks_.size() if there is none.
+    size_type find_block(index_type u, index_type v) const;
+
+    std::vector<index_type> case_starts_;
+    std::vector<bias_type> linear_biases_;
+
+    // The sorted neighbors of each variable.
+    std::vector<std::vector<Neighbor>> adj_;
+
+    std::vector<bias_type> blocks_;
+    bias_type offset_;
+};
+
+template <class bias_type, class index_type>
+DiscreteQuadraticModel<bias_type, index_type>::DiscreteQuadraticModel()
+        : case_starts_(1, 0), offset_(0) {}
+
+template <class bias_type, class index_type>
+template <class B, class I>
+DiscreteQuadraticModel<bias_type, index_type>::DiscreteQuadraticModel(
+        const abc::QuadraticModelBase<B, I>& cases, const std::vector<I>& case_starts)
+        : DiscreteQuadraticModel() {
+    if (case_starts.empty() || case_starts.front() != 0 ||
+        static_cast<size_type>(case_starts.back()) != cases.num_variables() ||
+        !std::is_sorted(case_starts.begin(), case_starts.end())) {
+        throw std::invalid_argument("case_starts does not match the cases");
+    }
+
+    const size_type num_variables = case_starts.size() - 1;
+
+    case_starts_.assign(case_starts.begin(), case_starts.end());
+    adj_.resize(num_variables);
+    linear_biases_.resize(cases.num_variables());
+    offset_ = cases.offset();
+
+    // the variable of each case
+    std::vector<index_type> variable_of(cases.num_variables());
+    for (size_type v = 0; v < num_variables; ++v) {
+        std::fill(variable_of.begin() + case_starts_[v], variable_of.begin() + case_starts_[v + 1],
+                  static_cast<index_type>(v));
+    }
+
+    for (size_type ci = 0; ci < cases.num_variables(); ++ci) {
+        const index_type u = variable_of[ci];
+
+        linear_biases_[ci] = cases.linear(ci);
+
+        for (auto it = cases.cbegin_neighborhood(ci), end = cases.cend_neighborhood(ci);
+             it != end && static_cast<size_type>(it->v) < ci; ++it) {
+            const index_type v = variable_of[it->v];
+
+            if (u == v) {
+                throw std::invalid_argument("two cases of the same variable interact");
+            }
+
+            // v < u so the block is indexed [case_v][case_u]
+            blocks_[block(v, u) + (it->v - case_starts_[v]) * num_cases(u) +
+                    (ci - case_starts_[u])] = it->bias;
+        }
+    }
+}
+
+template <class bias_type, class index_type>
+void DiscreteQuadraticModel<bias_type, index_type>::add_linear(index_type v, index_type case_v,
+                                                               bias_type bias) {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    assert(case_v >= 0 && static_cast<size_type>(case_v) < num_cases(v));
+    linear_biases_[case_starts_[v] + case_v] += bias;
+}
+
+template <class bias_type, class index_type>
+void DiscreteQuadraticModel<bias_type, index_type>::add_offset(bias_type bias) {
+    offset_ += bias;
+}
+
+template <class bias_type, class index_type>
+void DiscreteQuadraticModel<bias_type, index_type>::add_quadratic(index_type u, index_type case_u,
+                                                                  index_type v, index_type case_v,
+                                                                  bias_type bias) {
+    assert(u >= 0 && static_cast<size_type>(u) < num_variables());
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    assert(case_u >= 0 && static_cast<size_type>(case_u) < num_cases(u));
+    assert(case_v >= 0 && static_cast<size_type>(case_v) < num_cases(v));
+
+    if (u == v) {
+        throw std::invalid_argument("two cases of the same variable cannot interact");
+    }
+    if (v < u) {
+        std::swap(u, v);
+        std::swap(case_u, case_v);
+    }
+
+    blocks_[block(u, v) + case_u * num_cases(v) + case_v] += bias;
+}
+
+template <class bias_type, class index_type>
+index_type DiscreteQuadraticModel<bias_type, index_type>::add_variable(index_type num_cases) {
+    if (num_cases <= 0) {
+        throw std::invalid_argument("num_cases must be a positive integer");
+    }
+
+    index_type v = num_variables();
+    adj_.emplace_back();
+    linear_biases_.resize(linear_biases_.size() + num_cases, 0);
+    case_starts_.push_back(linear_biases_.size());
+    return v;
+}
+
+template <class bias_type, class index_type>
+typename DiscreteQuadraticModel<bias_type, index_type>::size_type
+DiscreteQuadraticModel<bias_type, index_type>::block(index_type u, index_type v) {
+    assert(u < v);
+
+    auto it = std::lower_bound(adj_[u].begin(), adj_[u].end(), v);
+    if (it != adj_[u].end() && it->v == v) return it->block;
+
+    size_type start = blocks_.size();
+    const size_type capacity = blocks_.capacity();
+    blocks_.resize(start + num_cases(u) * num_cases(v), 0);
+    detail::count_reallocation(blocks_, capacity);
+
+    adj_[u].insert(it, Neighbor{v, start});
+    adj_[v].insert(std::lower_bound(adj_[v].begin(), adj_[v].end(), u), Neighbor{u, start});
+
+    return start;
+}
+
+template <class bias_type, class index_type>
+index_type DiscreteQuadraticModel<bias_type, index_type>::case_start(index_type v) const {
+    assert(v >= 0 && static_cast<size_type>(v) <= num_variables());
+    return case_starts_[v];
+}
+
+template <class bias_type, class index_type>
+template <class T, class R>
+void DiscreteQuadraticModel<bias_type, index_type>::energies(const T* samples,
+                                                             size_type num_samples,
+                                                             size_type stride, R* out,
+                                                             int num_threads) const {
+    static_assert(std::is_integral<T>::value, "T must be an integer type");
+    static_assert(std::is_floating_point<R>::value, "R must be a floating point type");
+    assert(stride >= num_variables());
+
+    detail::count(Counter::ENERGY_CALLS);
+
+    const size_type n = num_variables();
+
+    // parallel_for cannot throw, so each sample records whether it is valid
+    // and we throw once all of the chunks are done
+    std::vector<char> invalid(num_samples, 0);
+
+    utils::parallel_for(num_samples, num_threads, [&](size_type first, size_type last) {
+        for (size_type si = first; si < last; ++si) {
+            const T* sample = samples + si * stride;
+
+            R energy = offset_;
+            for (size_type u = 0; u < n; ++u) {
+                const T case_u = sample[u];
+                const size_type num_cases_u = case_starts_[u + 1] - case_starts_[u];
+
+                if (case_u < 0 || static_cast<size_type>(case_u) >= num_cases_u) {
+                    invalid[si] = 1;
+                    break;
+                }
+
+                energy += linear_biases_[case_starts_[u] + case_u];
+
+                // the lower triangle, the blocks are indexed [case_v][case_u]
+                // and sample[v] was checked when we visited v
+                for (const auto& neighbor : adj_[u]) {
+                    if (static_cast<size_type>(neighbor.v) >= u) break;
+                    energy += blocks_[neighbor.block + sample[neighbor.v] * num_cases_u + case_u];
+                }
+            }
+
+            out[si] = energy;
+        }
+    });
+
+    if (std::find(invalid.begin(), invalid.end(), 1) != invalid.end()) {
+        throw std::out_of_range("invalid case");
+    }
+}
+
+template <class bias_type, class index_type>
+typename DiscreteQuadraticModel<bias_type, index_type>::size_type
+DiscreteQuadraticModel<bias_type, index_type>::find_block(index_type u, index_type v) const {
+    assert(u < v);
+
+    auto it = std::lower_bound(adj_[u].begin(), adj_[u].end(), v);
+    if (it != adj_[u].end() && it->v == v) return it->block;
+    return blocks_.size();
+}
+
+template <class bias_type, class index_type>
+bias_type DiscreteQuadraticModel<bias_type, index_type>::linear(index_type v,
+                                                                index_type case_v) const {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    assert(case_v >= 0 && static_cast<size_type>(case_v) < num_cases(v));
+    return linear_biases_[case_starts_[v] + case_v];
+}
+
+template <class bias_type, class index_type>
+MemoryUsage DiscreteQuadraticModel<bias_type, index_type>::memory_usage(bool capacity) const {
+    MemoryUsage usage;
+
+    usage.linear = sizeof(bias_type);  // offset
+    usage.linear += (capacity ? linear_biases_.capacity() : linear_biases_.size()) *
+                    sizeof(bias_type);
+
+    usage.quadratic += (capacity ? adj_.capacity() : adj_.size()) * sizeof(std::vector<Neighbor>);
+    for (const auto& n : adj_) {
+        usage.quadratic += (capacity ? n.capacity() : n.size()) * sizeof(Neighbor);
+    }
+    usage.quadratic += (capacity ? blocks_.capacity() : blocks_.size()) * sizeof(bias_type);
+
+    usage.variables += (capacity ? case_starts_.capacity() : case_starts_.size()) *
+                       sizeof(index_type);
+
+    return usage;
+}
+
+template <class bias_type, class index_type>
+typename DiscreteQuadraticModel<bias_type, index_type>::size_type
+DiscreteQuadraticModel<bias_type, index_type>::num_cases(index_type v) const {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    return case_starts_[v + 1] - case_starts_[v];
+}
+
+template <class bias_type, class index_type>
+typename DiscreteQuadraticModel<bias_type, index_type>::size_type
+DiscreteQuadraticModel<bias_type, index_type>::num_cases() const {
+    return linear_biases_.size();
+}
+
+template <class bias_type, class index_type>
+typename DiscreteQuadraticModel<bias_type, index_type>::size_type
+DiscreteQuadraticModel<bias_type, index_type>::num_variable_interactions() const {
+    size_type count = 0;
+    for (const auto& neighborhood : adj_) count += neighborhood.size();
+    return count / 2;
+}
+
+template <class bias_type, class index_type>
+typename DiscreteQuadraticModel<bias_type, index_type>::size_type
+DiscreteQuadraticModel<bias_type, index_type>::num_variables() const {
+    return adj_.size();
+}
+
+template <class bias_type, class index_type>
+bias_type DiscreteQuadraticModel<bias_type, index_type>::offset() const {
+    return offset_;
+}
+
+template <class bias_type, class index_type>
+bias_type DiscreteQuadraticModel<bias_type, index_type>::quadratic(index_type u, index_type case_u,
+                                                                   index_type v,
+                                                                   index_type case_v) const {
+    assert(u >= 0 && static_cast<size_type>(u) < num_variables());
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    assert(case_u >= 0 && static_cast<size_type>(case_u) < num_cases(u));
+    assert(case_v >= 0 && static_cast<size_type>(case_v) < num_cases(v));
+
+    if (u == v) return 0;
+    if (v < u) {
+        std::swap(u, v);
+        std::swap(case_u, case_v);
+    }
+
+    size_type start = find_block(u, v);
+    if (start == blocks_.size()) return 0;
+    return blocks_[start + case_u * num_cases(v) + case_v];
+}
+
+template <class bias_type, class index_type>
+void DiscreteQuadraticModel<bias_type, index_type>::set_offset(bias_type offset) {
+    offset_ = offset;
+}
+
+}  // namespace dimod
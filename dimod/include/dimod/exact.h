@@ -0,0 +1,578 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/local_field_state.h"
+#include "dimod/quadratic_model.h"
+#include "dimod/utils.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+namespace exact {
+
+/// A state of a model with only BINARY and SPIN variables, packed into the bits of an integer.
+template <class Bias>
+struct State {
+    /// Bit `v` is set when variable `v` has its upper value, 1 for both BINARY and SPIN.
+    std::uint64_t bits;
+
+    /// The energy of the state.
+    Bias energy;
+};
+
+/// A sample of a constrained quadratic model.
+template <class Bias>
+struct Sample {
+    /// The value of each variable, in the variable order of the model.
+    std::vector<Bias> values;
+
+    /// The energy of the objective plus the penalties of the soft constraints.
+    Bias energy;
+};
+
+/**
+ * Return the `num_states` lowest-energy states of a model with BINARY and SPIN variables.
+ *
+ * Every one of the `2^num_variables()` states is visited in Gray-code order.
+ * Consecutive states differ by a single variable, so each step costs time
+ * linear in the degree of that variable, see LocalFieldState. The states are
+ * divided between up to `num_threads` threads by the values of the
+ * highest-indexed variables, see utils::parallel_for(), and each thread keeps
+ * only its `num_states` best states in a bounded heap.
+ *
+ * If `num_states` is at least `2^num_variables()` then every state is
+ * returned. The states are ordered by increasing energy, ties broken by
+ * `bits`, and their energies are recalculated from the model so they do not
+ * include any rounding error accumulated over the walk.
+ *
+ * Throws `std::invalid_argument` if the model has a variable that is neither
+ * BINARY nor SPIN, or if it has 64 or more variables.
+ */
+template <class Bias, class Index>
+std::vector<State<Bias>> lowest_states(const abc::QuadraticModelBase<Bias, Index>& model,
+                                       std::size_t num_states, int num_threads = 1);
+
+/**
+ * Return the `num_samples` lowest-energy feasible samples of a constrained quadratic model.
+ *
+ * The samples are enumerated depth-first in the variable order of the model
+ * and divided between up to `num_threads` threads by the values of the
+ * lowest-indexed variables. After each variable is assigned, every hard linear
+ * constraint over it is checked against the range of values its remaining
+ * variables can contribute, and prefixes that cannot satisfy it are pruned.
+ * Hard quadratic constraints are checked once all of their variables are
+ * assigned. As in ConstrainedQuadraticModel::feasible(), a constraint is
+ * satisfied when its violation is at most `atol + rtol * |rhs|`.
+ *
+ * The energy of a sample is the energy of the objective plus the penalties of
+ * its soft constraints, see ConstrainedQuadraticModel::penalties(). The
+ * samples are ordered by increasing energy, ties broken by their values.
+ *
+ * Throws `std::invalid_argument` if the model has a REAL variable.
+ */
+template <class Bias, class Index>
+std::vector<Sample<Bias>> lowest_feasible(const ConstrainedQuadraticModel<Bias, Index>& cqm,
+                                          std::size_t num_samples, Bias rtol = 1e-6,
+                                          Bias atol = 1e-8, int num_threads = 1);
+
+namespace detail {
+
+// Keeps the (at most) `capacity` smallest values pushed, as a max-heap.
+template <class T, class Compare>
+class BoundedHeap {
+ public:
+    BoundedHeap(std::size_t capacity, Compare less) : capacity_(capacity), less_(less) {}
+
+    void push(const T& value) {
+        if (heap_.size() < capacity_) {
+            heap_.push_back(value);
+            std::push_heap(heap_.begin(), heap_.end(), less_);
+        } else if (capacity_ && less_(value, heap_.front())) {
+            std::pop_heap(heap_.begin(), heap_.end(), less_);
+            heap_.back() = value;
+            std::push_heap(heap_.begin(), heap_.end(), less_);
+        }
+    }
+
+    // Return the values in no particular order, leaving the heap empty.
+    std::vector<T> release() {
+        std::vector<T> values;
+        std::swap(values, heap_);
+        return values;
+    }
+
+ private:
+    std::size_t capacity_;
+    Compare less_;
+    std::vector<T> heap_;
+};
+
+template <class Bias>
+struct StateLess {
+    bool operator()(const State<Bias>& a, const State<Bias>& b) const {
+        return a.energy < b.energy || (a.energy == b.energy && a.bits < b.bits);
+    }
+};
+
+template <class Bias>
+struct SampleLess {
+    bool operator()(const Sample<Bias>& a, const Sample<Bias>& b) const {
+        return a.energy < b.energy || (a.energy == b.energy && a.values < b.values);
+    }
+};
+
+// Merge the per-chunk results and keep the `n` smallest of them according to `less`.
+template <class T, class Compare>
+std::vector<T> merge_lowest(std::vector<std::vector<T>>& results, std::size_t n, Compare less) {
+    std::vector<T> merged;
+    for (auto& result : results) {
+        std::move(result.begin(), result.end(), std::back_inserter(merged));
+        result.clear();
+        result.shrink_to_fit();
+    }
+    if (merged.size() > n) {
+        std::nth_element(merged.begin(), merged.begin() + n, merged.end(), less);
+        merged.resize(n);
+    }
+    return merged;
+}
+
+// The number of threads utils::parallel_for() would use
+inline std::size_t resolve_num_threads(int num_threads) {
+    std::size_t nt = (num_threads < 1) ? std::thread::hardware_concurrency() : num_threads;
+    return std::max(nt, static_cast<std::size_t>(1));  // hardware_concurrency can be 0
+}
+
+inline unsigned int lowest_set_bit(std::uint64_t x) {
+    assert(x);
+    unsigned int bit = 0;
+    for (; !(x & 1); x >>= 1) ++bit;
+    return bit;
+}
+
+// The model data shared by the threads of lowest_feasible(), built once.
+template <class Bias, class Index>
+class FeasibleSearchModel {
+ public:
+    using cqm_type = ConstrainedQuadraticModel<Bias, Index>;
+    using constraint_type = Constraint<Bias, Index>;
+    using size_type = std::size_t;
+
+    struct LinearConstraint {
+        Sense sense;
+        Bias rhs;
+        Bias tolerance;
+        Bias offset;
+
+        // the smallest and largest contribution of the variables that are not
+        // yet assigned, indexed by the number that are
+        std::vector<Bias> min_remaining;
+        std::vector<Bias> max_remaining;
+    };
+
+    // variable v is the `position`th variable of `constraint` in index order
+    struct Entry {
+        size_type constraint;
+        size_type position;
+        Bias coefficient;
+    };
+
+    struct CheckedConstraint {
+        const constraint_type* constraint;
+        Bias tolerance;
+    };
+
+    FeasibleSearchModel(const cqm_type& cqm, Bias rtol, Bias atol)
+            : cqm_(&cqm), columns_(cqm.num_variables()) {
+        const size_type n = cqm.num_variables();
+
+        objective_.set_offset(cqm.objective.offset());
+        for (Index v = 0; static_cast<size_type>(v) < n; ++v) {
+            const Vartype vartype = cqm.vartype(v);
+            if (vartype == Vartype::REAL) {
+                throw std::invalid_argument("cannot enumerate the values of a REAL variable");
+            }
+            objective_.add_variable(vartype, cqm.lower_bound(v), cqm.upper_bound(v));
+
+            if (vartype == Vartype::INTEGER) {
+                Bias lb = std::ceil(cqm.lower_bound(v));
+                Bias ub = std::floor(cqm.upper_bound(v));
+                first_.push_back(lb);
+                step_.push_back(1);
+                size_.push_back(ub < lb ? 0 : static_cast<size_type>(ub - lb) + 1);
+            } else {
+                Bias lb = vartype_info<Bias>::min(vartype);
+                first_.push_back(lb);
+                step_.push_back(vartype_info<Bias>::max(vartype) - lb);
+                size_.push_back(2);
+            }
+        }
+        for (const auto& v : cqm.objective.variables()) {
+            objective_.add_linear(v, cqm.objective.linear(v));
+        }
+        for (auto it = cqm.objective.cbegin_quadratic(); it != cqm.objective.cend_quadratic();
+             ++it) {
+            objective_.add_quadratic(it->u, it->v, it->bias);
+        }
+
+        for (size_type c = 0; c < cqm.num_constraints(); ++c) {
+            const auto& constraint = cqm.constraint_ref(c);
+            const Bias tolerance = atol + rtol * std::abs(constraint.rhs());
+
+            if (constraint.is_soft()) {
+                soft_.push_back(CheckedConstraint{&constraint, tolerance});
+            } else if (!constraint.is_linear()) {
+                quadratic_.push_back(CheckedConstraint{&constraint, tolerance});
+            } else {
+                add_linear_constraint(constraint, tolerance);
+            }
+        }
+    }
+
+    // Return the penalty from the soft constraints for a complete sample.
+    template <class Iter>
+    Bias penalty(Iter sample_start) const {
+        Bias total = 0;
+        for (const auto& soft : soft_) {
+            const auto& constraint = *soft.constraint;
+            const Bias violation = constraint.violation(constraint.energy(sample_start));
+            if (violation <= soft.tolerance) continue;
+
+            switch (constraint.penalty()) {
+                case Penalty::LINEAR:
+                    total += constraint.weight() * violation;
+                    break;
+                case Penalty::QUADRATIC:
+                    total += constraint.weight() * violation * violation;
+                    break;
+                case Penalty::CONSTANT:
+                    total += constraint.weight();
+                    break;
+            }
+        }
+        return total;
+    }
+
+    // Return whether the hard quadratic constraints are satisfied by a complete sample.
+    template <class Iter>
+    bool quadratic_satisfied(Iter sample_start) const {
+        for (const auto& hard : quadratic_) {
+            const auto& constraint = *hard.constraint;
+            if (constraint.violation(constraint.energy(sample_start)) > hard.tolerance) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Return whether linear constraint `c` can be satisfied given the
+    // activity of its first `k` variables.
+    bool satisfiable(size_type c, size_type k, Bias activity) const {
+        const auto& constraint = linear_[c];
+        const Bias lo = activity + constraint.min_remaining[k];
+        const Bias hi = activity + constraint.max_remaining[k];
+        switch (constraint.sense) {
+            case Sense::LE:
+                return lo - constraint.rhs <= constraint.tolerance;
+            case Sense::GE:
+                return constraint.rhs - hi <= constraint.tolerance;
+            case Sense::EQ:
+                return lo - constraint.rhs <= constraint.tolerance &&
+                       constraint.rhs - hi <= constraint.tolerance;
+        }
+        return true;
+    }
+
+    // Return whether every linear constraint can be satisfied before any variable is assigned.
+    bool satisfiable() const {
+        for (size_type c = 0; c < linear_.size(); ++c) {
+            if (!satisfiable(c, 0, linear_[c].offset)) return false;
+        }
+        return true;
+    }
+
+    const std::vector<Entry>& column(Index v) const { return columns_[v]; }
+    const cqm_type& cqm() const { return *cqm_; }
+    Bias first_value(Index v) const { return first_[v]; }
+    const std::vector<LinearConstraint>& linear_constraints() const { return linear_; }
+    size_type num_values(Index v) const { return size_[v]; }
+    size_type num_variables() const { return size_.size(); }
+    const QuadraticModel<Bias, Index>& objective() const { return objective_; }
+    Bias value(Index v, size_type j) const { return first_[v] + step_[v] * j; }
+
+ private:
+    void add_linear_constraint(const constraint_type& constraint, Bias tolerance) {
+        std::vector<Index> variables(constraint.variables());
+        std::sort(variables.begin(), variables.end());
+
+        LinearConstraint linear{constraint.sense(), constraint.rhs(), tolerance,
+                                constraint.offset(), std::vector<Bias>(variables.size() + 1, 0),
+                                std::vector<Bias>(variables.size() + 1, 0)};
+
+        for (size_type k = variables.size(); k-- > 0;) {
+            const Index v = variables[k];
+            const Bias a = constraint.linear(v);
+            const Bias lo = a * value(v, 0);
+            const Bias hi = a * value(v, size_[v] ? size_[v] - 1 : 0);
+            linear.min_remaining[k] = linear.min_remaining[k + 1] + std::min(lo, hi);
+            linear.max_remaining[k] = linear.max_remaining[k + 1] + std::max(lo, hi);
+            columns_[v].push_back(Entry{linear_.size(), k, a});
+        }
+
+        linear_.push_back(std::move(linear));
+    }
+
+    const cqm_type* cqm_;
+
+    QuadraticModel<Bias, Index> objective_;
+
+    // the values of variable v are first_[v] + j * step_[v] for j in [0, size_[v])
+    std::vector<Bias> first_;
+    std::vector<Bias> step_;
+    std::vector<size_type> size_;
+
+    std::vector<LinearConstraint> linear_;
+    std::vector<std::vector<Entry>> columns_;
+    std::vector<CheckedConstraint> quadratic_;
+    std::vector<CheckedConstraint> soft_;
+};
+
+// The depth-first search of one thread of lowest_feasible().
+template <class Bias, class Index>
+class FeasibleSearch {
+ public:
+    using model_type = FeasibleSearchModel<Bias, Index>;
+    using size_type = std::size_t;
+
+    FeasibleSearch(const model_type& model, size_type capacity)
+            : model_(&model),
+              state_(model.objective(), initial_sample(model).begin()),
+              heap_(capacity, SampleLess<Bias>()) {
+        for (const auto& constraint : model.linear_constraints()) {
+            activities_.emplace_back(constraint.min_remaining.size());
+            activities_.back()[0] = constraint.offset;
+        }
+        candidate_.values.resize(model.num_variables());
+    }
+
+    // Assign the first `num_fixed` variables from the mixed-radix digits of
+    // `task`, the first variable being the most significant, then search the rest.
+    void run(size_type task, size_type num_fixed) {
+        std::vector<size_type> digits(num_fixed);
+        for (size_type d = num_fixed; d-- > 0;) {
+            digits[d] = task % model_->num_values(d);
+            task /= model_->num_values(d);
+        }
+        for (size_type d = 0; d < num_fixed; ++d) {
+            if (!assign(d, model_->value(d, digits[d]))) return;
+        }
+        search(num_fixed);
+    }
+
+    std::vector<Sample<Bias>> release() { return heap_.release(); }
+
+ private:
+    static std::vector<Bias> initial_sample(const model_type& model) {
+        std::vector<Bias> sample(model.num_variables());
+        for (size_type v = 0; v < sample.size(); ++v) sample[v] = model.first_value(v);
+        return sample;
+    }
+
+    // Set v to `value` and return whether the linear constraints over v can
+    // still be satisfied.
+    bool assign(Index v, Bias value) {
+        state_.apply(v, value);
+        for (const auto& entry : model_->column(v)) {
+            auto& activity = activities_[entry.constraint];
+            activity[entry.position + 1] = activity[entry.position] + entry.coefficient * value;
+            if (!model_->satisfiable(entry.constraint, entry.position + 1,
+                                     activity[entry.position + 1])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void search(size_type depth) {
+        if (depth == model_->num_variables()) {
+            const auto& sample = state_.sample();
+            if (!model_->quadratic_satisfied(sample.begin())) return;
+
+            std::copy(sample.begin(), sample.end(), candidate_.values.begin());
+            candidate_.energy = state_.energy() + model_->penalty(sample.begin());
+            heap_.push(candidate_);
+            return;
+        }
+
+        for (size_type j = 0; j < model_->num_values(depth); ++j) {
+            if (assign(depth, model_->value(depth, j))) search(depth + 1);
+        }
+    }
+
+    const model_type* model_;
+
+    LocalFieldState<Bias, Index> state_;
+
+    // the activity of each linear constraint, indexed by the number of its
+    // variables that are assigned
+    std::vector<std::vector<Bias>> activities_;
+
+    BoundedHeap<Sample<Bias>, SampleLess<Bias>> heap_;
+
+    Sample<Bias> candidate_;
+};
+
+}  // namespace detail
+
+template <class Bias, class Index>
+std::vector<State<Bias>> lowest_states(const abc::QuadraticModelBase<Bias, Index>& model,
+                                       std::size_t num_states, int num_threads) {
+    using size_type = std::size_t;
+
+    const size_type n = model.num_variables();
+    for (Index v = 0; static_cast<size_type>(v) < n; ++v) {
+        if (model.vartype(v) != Vartype::BINARY && model.vartype(v) != Vartype::SPIN) {
+            throw std::invalid_argument("only BINARY and SPIN variables can be enumerated");
+        }
+    }
+    if (n >= 64) throw std::invalid_argument("too many variables to enumerate");
+
+    if (static_cast<std::uint64_t>(num_states) > (static_cast<std::uint64_t>(1) << n)) {
+        num_states = static_cast<size_type>(static_cast<std::uint64_t>(1) << n);
+    }
+    if (!num_states) return {};
+
+    // the highest variables are fixed per task, aim for a few tasks per thread
+    // so that they are balanced even if some threads are slower
+    const size_type min_tasks = 4 * detail::resolve_num_threads(num_threads);
+    size_type num_fixed = 0;
+    while (num_fixed < n && (static_cast<size_type>(1) << num_fixed) < min_tasks) ++num_fixed;
+    const size_type num_free = n - num_fixed;
+    const size_type num_tasks = static_cast<size_type>(1) << num_fixed;
+
+    // rebuild the local fields now and then so rounding errors don't accumulate
+    const std::uint64_t resync_mask = (static_cast<std::uint64_t>(1) << 16) - 1;
+
+    // each chunk of tasks writes to the result of its first task
+    std::vector<std::vector<State<Bias>>> results(num_tasks);
+    utils::parallel_for(num_tasks, num_threads, [&](size_type first, size_type last) {
+        detail::BoundedHeap<State<Bias>, detail::StateLess<Bias>> heap(num_states,
+                                                                       detail::StateLess<Bias>());
+        std::vector<Bias> sample(n);
+
+        for (size_type task = first; task < last; ++task) {
+            std::uint64_t bits = static_cast<std::uint64_t>(task) << num_free;
+            for (size_type v = 0; v < n; ++v) {
+                const Vartype vartype = model.vartype(v);
+                sample[v] = ((bits >> v) & 1) ? vartype_info<Bias>::max(vartype)
+                                              : vartype_info<Bias>::min(vartype);
+            }
+
+            auto state = LocalFieldState<Bias, Index>(model, sample.begin());
+            heap.push(State<Bias>{bits, state.energy()});
+
+            const std::uint64_t num_steps = static_cast<std::uint64_t>(1) << num_free;
+            for (std::uint64_t step = 1; step < num_steps; ++step) {
+                const unsigned int v = detail::lowest_set_bit(step);
+                state.flip(v);
+                bits ^= static_cast<std::uint64_t>(1) << v;
+
+                if (!(step & resync_mask)) {
+                    sample = state.sample();
+                    state = LocalFieldState<Bias, Index>(model, sample.begin());
+                }
+
+                heap.push(State<Bias>{bits, state.energy()});
+            }
+        }
+
+        results[first] = heap.release();
+    });
+
+    auto states = detail::merge_lowest(results, num_states, detail::StateLess<Bias>());
+
+    utils::parallel_for(states.size(), num_threads, [&](size_type first, size_type last) {
+        std::vector<Bias> sample(n);
+        for (size_type i = first; i < last; ++i) {
+            for (size_type v = 0; v < n; ++v) {
+                const Vartype vartype = model.vartype(v);
+                sample[v] = ((states[i].bits >> v) & 1) ? vartype_info<Bias>::max(vartype)
+                                                        : vartype_info<Bias>::min(vartype);
+            }
+            states[i].energy = model.energy(sample.begin());
+        }
+    });
+
+    std::sort(states.begin(), states.end(), detail::StateLess<Bias>());
+    return states;
+}
+
+template <class Bias, class Index>
+std::vector<Sample<Bias>> lowest_feasible(const ConstrainedQuadraticModel<Bias, Index>& cqm,
+                                          std::size_t num_samples, Bias rtol, Bias atol,
+                                          int num_threads) {
+    using size_type = std::size_t;
+
+    const auto model = detail::FeasibleSearchModel<Bias, Index>(cqm, rtol, atol);
+    const size_type n = model.num_variables();
+
+    if (!num_samples || !model.satisfiable()) return {};
+    for (size_type v = 0; v < n; ++v) {
+        if (!model.num_values(v)) return {};  // an integer variable with no values
+    }
+
+    // the lowest variables are fixed per task
+    const size_type min_tasks = 4 * detail::resolve_num_threads(num_threads);
+    size_type num_fixed = 0;
+    size_type num_tasks = 1;
+    while (num_fixed < n && num_tasks < min_tasks) num_tasks *= model.num_values(num_fixed++);
+
+    std::vector<std::vector<Sample<Bias>>> results(num_tasks);
+    utils::parallel_for(num_tasks, num_threads, [&](size_type first, size_type last) {
+        auto search = detail::FeasibleSearch<Bias, Index>(model, num_samples);
+        for (size_type task = first; task < last; ++task) search.run(task, num_fixed);
+        results[first] = search.release();
+    });
+
+    auto samples = detail::merge_lowest(results, num_samples, detail::SampleLess<Bias>());
+
+    // the objective energies were accumulated over the search, recalculate them
+    utils::parallel_for(samples.size(), num_threads, [&](size_type first, size_type last) {
+        for (size_type i = first; i < last; ++i) {
+            const auto& values = samples[i].values;
+            samples[i].energy =
+                    cqm.objective.energy(values.begin()) + model.penalty(values.begin());
+        }
+    });
+
+    std::sort(samples.begin(), samples.end(), detail::SampleLess<Bias>());
+    return samples;
+}
+
+}  // namespace exact
+}  // namespace dimod
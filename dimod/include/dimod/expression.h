@@ -16,12 +16,12 @@
 
 #include <algorithm>
 #include <limits>
-#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "dimod/abc.h"
+#include "dimod/flat_index_map.h"
 #include "dimod/utils.h"
 #include "dimod/vartypes.h"
 
@@ -183,6 +183,13 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
 
     void add_quadratic_back(index_type u, index_type v, bias_type bias);
 
+    /// Add quadratic biases from COO-formatted arrays of the parent's variables.
+    /// Variables not already in the expression are added.
+    /// See `abc::QuadraticModelBase::add_quadratic_coo()`.
+    template <class ItRow, class ItCol, class ItBias>
+    void add_quadratic_coo(ItRow row_iterator, ItCol col_iterator, ItBias bias_iterator,
+                           size_type length);
+
     template <class T>
     void add_quadratic_from_dense(const T dense[], index_type num_variables);
 
@@ -209,6 +216,21 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     template <class Iter>
     bias_type energy(Iter sample_start) const;
 
+    /**
+     * Calculate the energies of a batch of samples.
+     *
+     * `samples` must point to a row-major array of `num_samples` samples,
+     * each given over all of the parent's variables. Consecutive samples are
+     * `stride` elements apart. The energies are written to `out`, which must
+     * have room for `num_samples` values.
+     *
+     * The samples are divided between up to `num_threads` threads, see
+     * utils::parallel_for().
+     */
+    template <class T, class R>
+    void energies(const T* samples, size_type num_samples, size_type stride, R* out,
+                  int num_threads = 1) const;
+
     template <class T>
     void fix_variable(index_type v, T assignment);
 
@@ -229,13 +251,21 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     bias_type lower_bound(index_type v) const;
 
     /**
-     * Total bytes consumed by the biases and indices.
+     * Total bytes consumed by the biases and indices, including the map from
+     * the parent's variables to the expression's.
      *
      * If `capacity` is true, use the capacity of the underlying vectors rather
      * than the size.
      */
     size_type nbytes(bool capacity = false) const;
 
+    /**
+     * Return a breakdown of the heap memory used by the expression, including
+     * the maps between its variables and its parent's.
+     * See QuadraticModelBase::memory_usage().
+     */
+    MemoryUsage memory_usage(bool capacity = false) const;
+
     using base_type::num_interactions;
 
     /// The number of other variables `v` interacts with.
@@ -278,6 +308,13 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
         return remove_variables(variables.begin(), variables.end());
     }
 
+    /// Make room for at least `num_variables` variables without reallocating.
+    void reserve(size_type num_variables);
+
+    /// Make room for at least `n` interactions in the neighborhood of `v`
+    /// without reallocating. Does nothing if `v` is not in the expression.
+    void reserve_interactions(index_type v, size_type n);
+
     /// Set the linear bias of variable `v`.
     void set_linear(index_type v, bias_type bias);
 
@@ -303,6 +340,11 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     /// This removes a variable from the model *and* reindexes
     void reindex_variables(index_type v);
 
+    /// Remove every variable `v` with `old_to_new[v] < 0` and relabel the
+    /// others as `old_to_new[v]`. `old_to_new` is indexed by the parent's
+    /// variables, and must be order-preserving on the variables kept.
+    void reindex_variables(const std::vector<index_type>& old_to_new);
+
     /// This gets used by base_type to determine how to handle self-loops, etc.
     /// So we want to use the vartype relative to the base_type's indices.
     Vartype vartype_(index_type v) const { return vartype(variables_[v]); }
@@ -313,25 +355,75 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     /// List of the parent's label used by expression
     std::vector<index_type> variables_;
 
-    /// Map from parent's labels to the internal ones
-    std::unordered_map<index_type, index_type> indices_;  // todo: consider Tessil
+    /// Expressions with at most this many variables find them by scanning
+    /// ``variables_`` rather than through ``indices_``. Most constraints are
+    /// small and linear, so for them the variables and the linear biases are
+    /// all that we store.
+    static constexpr size_type INDEX_THRESHOLD = 16;
+
+    /// Map from parent's labels to the internal ones. Either empty or complete,
+    /// and always complete when there are more than INDEX_THRESHOLD variables.
+    utils::FlatIndexMap<index_type, index_type> indices_;
 
     /// Make sure ``v`` exists in the model and return the index in the underlying QM
     index_type enforce_variable(index_type v) {
-        auto it = indices_.find(v);
-        if (it != indices_.end()) {
+        index_type vi = find_index(v);
+        if (vi >= 0) {
             // we're already tracking it
-            return it->second;
+            return vi;
         }
         // we need to create it
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
 
-        index_type vi = variables_.size();
-        indices_[v] = vi;
+        vi = variables_.size();
         variables_.emplace_back(v);
+        if (!indices_.empty()) {
+            indices_[v] = vi;
+        } else if (variables_.size() > INDEX_THRESHOLD) {
+            rebuild_indices();
+        }
         base_type::add_variable();
         return vi;
     }
+
+    /// Remove ``v``, the variable at index ``vi``, from ``variables_`` and ``indices_``.
+    void erase_index(index_type v, index_type vi) {
+        auto it = variables_.erase(variables_.begin() + vi);
+        if (indices_.empty()) return;
+        if (variables_.size() <= INDEX_THRESHOLD) {
+            rebuild_indices();
+            return;
+        }
+        indices_.erase(v);
+        for (; it != variables_.end(); ++it) {
+            indices_[*it] -= 1;
+        }
+    }
+
+    /// Return the index of ``v`` in the underlying QM, or -1 if it's not present.
+    index_type find_index(index_type v) const {
+        if (indices_.empty()) {
+            for (size_type i = 0; i < variables_.size(); ++i) {
+                if (variables_[i] == v) return i;
+            }
+            return -1;
+        }
+        auto it = indices_.find(v);
+        return (it == indices_.end()) ? -1 : it->second;
+    }
+
+    /// Rebuild ``indices_`` from ``variables_``.
+    void rebuild_indices() {
+        if (variables_.size() <= INDEX_THRESHOLD) {
+            // release the memory rather than just clearing it
+            indices_ = utils::FlatIndexMap<index_type, index_type>();
+            return;
+        }
+        indices_.clear();
+        for (size_type i = 0; i < variables_.size(); ++i) {
+            indices_[variables_[i]] = i;
+        }
+    }
 };
 
 template <class bias_type, class index_type>
@@ -367,7 +459,8 @@ template <class bias_type, class index_type>
 template <class ItRow, class ItCol, class ItBias>
 void Expression<bias_type, index_type>::add_quadratic(ItRow row_iterator, ItCol col_iterator,
                                                       ItBias bias_iterator, index_type length) {
-    throw std::logic_error("not implemented - add_quadratic from iterators");
+    assert(length >= 0);
+    add_quadratic_coo(row_iterator, col_iterator, bias_iterator, length);
 }
 
 template <class bias_type, class index_type>
@@ -375,6 +468,21 @@ void Expression<bias_type, index_type>::add_quadratic_back(index_type u, index_t
     base_type::add_quadratic_back(enforce_variable(u), enforce_variable(v), bias);
 }
 
+template <class bias_type, class index_type>
+template <class ItRow, class ItCol, class ItBias>
+void Expression<bias_type, index_type>::add_quadratic_coo(ItRow row_iterator, ItCol col_iterator,
+                                                          ItBias bias_iterator, size_type length) {
+    // translate to the underlying indices, the underlying order is not the
+    // parent's so we cannot assume the result is sorted
+    std::vector<index_type> irow(length);
+    std::vector<index_type> icol(length);
+    for (size_type i = 0; i < length; ++i) {
+        irow[i] = enforce_variable(row_iterator[i]);
+        icol[i] = enforce_variable(col_iterator[i]);
+    }
+    base_type::add_quadratic_coo(irow.begin(), icol.begin(), bias_iterator, length);
+}
+
 template <class bias_type, class index_type>
     template <class T>
 void Expression<bias_type, index_type>::add_quadratic_from_dense(const T dense[], index_type num_variables) {
@@ -384,27 +492,27 @@ void Expression<bias_type, index_type>::add_quadratic_from_dense(const T dense[]
 template <class bias_type, class index_type>
 typename Expression<bias_type, index_type>::const_neighborhood_iterator
 Expression<bias_type, index_type>::cbegin_neighborhood(index_type v) const {
-    auto it = indices_.find(v);
-    if (it == indices_.end()) {
+    index_type vi = find_index(v);
+    if (vi < 0) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         auto empty = base_type::empty_neighborhood();
         return const_neighborhood_iterator(this, empty.begin(), empty.end());
     }
-    return const_neighborhood_iterator(this, base_type::cbegin_neighborhood(it->second),
-                                       base_type::cend_neighborhood(it->second));
+    return const_neighborhood_iterator(this, base_type::cbegin_neighborhood(vi),
+                                       base_type::cend_neighborhood(vi));
 }
 
 template <class bias_type, class index_type>
 typename Expression<bias_type, index_type>::const_neighborhood_iterator
 Expression<bias_type, index_type>::cend_neighborhood(index_type v) const {
-    auto it = indices_.find(v);
-    if (it == indices_.end()) {
+    index_type vi = find_index(v);
+    if (vi < 0) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         auto empty = base_type::empty_neighborhood();
         return const_neighborhood_iterator(this, empty.end(), empty.end());
     }
-    return const_neighborhood_iterator(this, base_type::cend_neighborhood(it->second),
-                                       base_type::cend_neighborhood(it->second));
+    return const_neighborhood_iterator(this, base_type::cend_neighborhood(vi),
+                                       base_type::cend_neighborhood(vi));
 }
 
 template <class bias_type, class index_type>
@@ -423,7 +531,7 @@ Expression<bias_type, index_type>::cend_quadratic() const {
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::clear() {
     base_type::clear();
-    indices_.clear();
+    indices_ = utils::FlatIndexMap<index_type, index_type>();
     variables_.clear();
 }
 
@@ -432,36 +540,32 @@ template <class T>
 void Expression<bias_type, index_type>::fix_variable(index_type v, T assignment) {
     assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
 
-    auto vit = indices_.find(v);
-    if (vit == indices_.end()) return;  // nothing to remove
+    index_type vi = find_index(v);
+    if (vi < 0) return;  // nothing to remove
 
     // remove the biases
-    base_type::fix_variable(vit->second, assignment);
+    base_type::fix_variable(vi, assignment);
 
     // update the indices
-    auto it = variables_.erase(variables_.begin() + vit->second);
-    indices_.erase(vit);
-    for (; it != variables_.end(); ++it) {
-        indices_[*it] -= 1;
-    }
+    erase_index(v, vi);
 }
 
 template <class bias_type, class index_type>
 bool Expression<bias_type, index_type>::has_interaction(index_type u, index_type v) const {
-    auto uit = indices_.find(u);
-    auto vit = indices_.find(v);
-    if (uit == indices_.end() || vit == indices_.end()) {
+    index_type ui = find_index(u);
+    index_type vi = find_index(v);
+    if (ui < 0 || vi < 0) {
         assert(u >= 0 && static_cast<size_type>(u) < parent_->num_variables());
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         return 0;
     }
 
-    return base_type::has_interaction(uit->second, vit->second);
+    return base_type::has_interaction(ui, vi);
 }
 
 template <class bias_type, class index_type>
 bool Expression<bias_type, index_type>::has_variable(index_type v) const {
-    return indices_.count(v);
+    return find_index(v) >= 0;
 }
 
 template <class bias_type, class index_type>
@@ -472,7 +576,7 @@ bool Expression<bias_type, index_type>::is_disjoint(const Expression& other) con
     }
 
     for (const auto& v : variables_) {
-        if (other.indices_.count(v)) {
+        if (other.has_variable(v)) {
             return false;
         }
     }
@@ -493,6 +597,15 @@ bias_type Expression<bias_type, index_type>::energy(Iter sample_start) const {
                                typename std::iterator_traits<Iter>::iterator_category>::value,
                   "iterator must be random access");
 
+    if (base_type::is_linear()) {
+        // a sparse dot product, no need to gather the sample first
+        bias_type en = base_type::offset();
+        for (size_type i = 0; i < variables_.size(); ++i) {
+            en += base_type::linear(i) * *(sample_start + variables_[i]);
+        }
+        return en;
+    }
+
     // we could try to do this "virtually" but almost certainly we'll get better
     // performance by just making a new sample in the order of the underlying base type
     std::vector<typename std::iterator_traits<Iter>::value_type> subsample;
@@ -504,14 +617,64 @@ bias_type Expression<bias_type, index_type>::energy(Iter sample_start) const {
     return base_type::energy(subsample.begin());
 }
 
+template <class bias_type, class index_type>
+template <class T, class R>
+void Expression<bias_type, index_type>::energies(const T* samples, size_type num_samples,
+                                                 size_type stride, R* out,
+                                                 int num_threads) const {
+    assert(parent_ == nullptr || stride >= parent_->num_variables());
+
+    // We copy the columns of our variables into a compact buffer, a chunk of
+    // samples at a time, and then calculate the energies in the underlying
+    // variable order.
+    const size_type chunk_size = 256;
+    const size_type num_chunks = (num_samples + chunk_size - 1) / chunk_size;
+    const size_type n = variables_.size();
+
+    if (base_type::is_linear()) {
+        // linear expressions, which most constraints are, are a sparse dot
+        // product with each sample so we skip the gather
+        utils::parallel_for(num_chunks, num_threads, [&](size_type first, size_type last) {
+            const size_type end = std::min(last * chunk_size, num_samples);
+            for (size_type si = first * chunk_size; si < end; ++si) {
+                const T* sample = samples + si * stride;
+                R en = base_type::offset();
+                for (size_type i = 0; i < n; ++i) {
+                    en += base_type::linear(i) * sample[variables_[i]];
+                }
+                out[si] = en;
+            }
+        });
+        return;
+    }
+
+    utils::parallel_for(num_chunks, num_threads, [&](size_type first, size_type last) {
+        std::vector<T> subsamples(n * chunk_size);
+
+        for (size_type chunk = first; chunk < last; ++chunk) {
+            const size_type start = chunk * chunk_size;
+            const size_type length = std::min(chunk_size, num_samples - start);
+
+            for (size_type si = 0; si < length; ++si) {
+                const T* sample = samples + (start + si) * stride;
+                for (size_type i = 0; i < n; ++i) {
+                    subsamples[si * n + i] = sample[variables_[i]];
+                }
+            }
+
+            base_type::energies(subsamples.data(), length, n, out + start);
+        }
+    });
+}
+
 template <class bias_type, class index_type>
 bias_type Expression<bias_type, index_type>::linear(index_type v) const {
-    auto it = indices_.find(v);
-    if (it == indices_.end()) {
+    index_type vi = find_index(v);
+    if (vi < 0) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         return 0;
     }
-    return base_type::linear(it->second);
+    return base_type::linear(vi);
 }
 
 template <class bias_type, class index_type>
@@ -521,77 +684,97 @@ bias_type Expression<bias_type, index_type>::lower_bound(index_type v) const {
 
 template <class bias_type, class index_type>
 bias_type Expression<bias_type, index_type>::quadratic(index_type u, index_type v) const {
-    auto uit = indices_.find(u);
-    auto vit = indices_.find(v);
-    if (uit == indices_.end() || vit == indices_.end()) {
+    index_type ui = find_index(u);
+    index_type vi = find_index(v);
+    if (ui < 0 || vi < 0) {
         assert(u >= 0 && static_cast<size_type>(u) < parent_->num_variables());
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         return 0;
     }
-    return base_type::quadratic(uit->second, vit->second);
+    return base_type::quadratic(ui, vi);
 }
 
 template <class bias_type, class index_type>
 bias_type Expression<bias_type, index_type>::quadratic_at(index_type u, index_type v) const {
-    auto uit = indices_.find(u);
-    auto vit = indices_.find(v);
-    if (uit == indices_.end() || vit == indices_.end()) {
+    index_type ui = find_index(u);
+    index_type vi = find_index(v);
+    if (ui < 0 || vi < 0) {
         throw std::out_of_range("given variables have no interaction");
     }
-    return base_type::quadratic_at(uit->second, vit->second);
+    return base_type::quadratic_at(ui, vi);
+}
+
+template <class bias_type, class index_type>
+MemoryUsage Expression<bias_type, index_type>::memory_usage(bool capacity) const {
+    MemoryUsage usage = base_type::memory_usage(capacity);
+    usage.indices += (capacity ? variables_.capacity() : variables_.size()) * sizeof(index_type);
+    usage.indices += indices_.nbytes(capacity);
+    return usage;
 }
 
 template <class bias_type, class index_type>
 typename Expression<bias_type, index_type>::size_type Expression<bias_type, index_type>::nbytes(
         bool capacity) const {
-    throw std::logic_error("not implemented - nbytes");
+    size_type count = base_type::nbytes(capacity);
+    if (capacity) {
+        count += variables_.capacity() * sizeof(index_type);
+    } else {
+        count += variables_.size() * sizeof(index_type);
+    }
+    count += indices_.nbytes(capacity);
+    return count;
 }
 
 template <class bias_type, class index_type>
 typename Expression<bias_type, index_type>::size_type
 Expression<bias_type, index_type>::num_interactions(index_type v) const {
-    auto it = indices_.find(v);
-    if (it == indices_.end()) {
+    index_type vi = find_index(v);
+    if (vi < 0) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         return 0;
     }
-    return base_type::num_interactions(it->second);
+    return base_type::num_interactions(vi);
 }
 
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::reindex_variables(index_type v) {
-    size_type start = variables_.size();  // the start of the indices that need to change
-
     // see if v is present
-    auto it = indices_.find(v);
-    if (it != indices_.end()) {
-        start = it->second;
-        base_type::remove_variable(it->second);
-        variables_.erase(variables_.begin() + it->second);
-        indices_.erase(it);
+    index_type vi = find_index(v);
+    if (vi >= 0) {
+        base_type::remove_variable(vi);
+        variables_.erase(variables_.begin() + vi);
     }
 
-    // remove any v/index pairs from indices_ for which v changed
+    // shift the labels above v down by one
     for (auto& u : variables_) {
-        if (u > v) {
-            indices_.erase(u);
-            --u;
-        }
+        if (u > v) --u;
     }
 
-    // update the indices before start
-    for (size_type i = 0; i < start; ++i) {
-        if (variables_[i] >= v) {
-            indices_[variables_[i]] = i;
-        }
+    rebuild_indices();
+}
+
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::reindex_variables(
+        const std::vector<index_type>& old_to_new) {
+    // find our local indices that need to be removed, they are already sorted
+    std::vector<index_type> to_remove;
+    for (size_type i = 0; i < variables_.size(); ++i) {
+        assert(static_cast<size_type>(variables_[i]) < old_to_new.size());
+        if (old_to_new[variables_[i]] < 0) to_remove.emplace_back(i);
     }
 
-    // update the indices after start
-    for (size_type i = start; i < variables_.size(); ++i) {
-        indices_[variables_[i]] = i;
+    if (!to_remove.empty()) {
+        base_type::remove_variables(to_remove);
+        variables_.erase(utils::remove_by_index(variables_.begin(), variables_.end(),
+                                                to_remove.begin(), to_remove.end()),
+                         variables_.end());
     }
 
-    assert(indices_.size() == variables_.size());
+    // relabel what's left and rebuild the map
+    for (auto& u : variables_) {
+        u = old_to_new[u];
+    }
+    rebuild_indices();
 }
 
 template <class bias_type, class index_type>
@@ -600,39 +783,32 @@ void Expression<bias_type, index_type>::relabel_variables(std::vector<index_type
 
     variables_ = std::move(labels);
 
-    indices_.clear();
-    for (size_type ui = 0; ui < variables_.size(); ++ui) {
-        indices_[variables_[ui]] = ui;
-    }
+    rebuild_indices();
 }
 
 
 template <class bias_type, class index_type>
 bool Expression<bias_type, index_type>::remove_interaction(index_type u, index_type v) {
-    auto uit = indices_.find(u);
-    auto vit = indices_.find(v);
-    if (uit == indices_.end() || vit == indices_.end()) {
+    index_type ui = find_index(u);
+    index_type vi = find_index(v);
+    if (ui < 0 || vi < 0) {
         return false;
     }
-    return base_type::remove_interaction(uit->second, vit->second);
+    return base_type::remove_interaction(ui, vi);
 }
 
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::remove_variable(index_type v) {
     assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
 
-    auto vit = indices_.find(v);
-    if (vit == indices_.end()) return;  // nothing to remove
+    index_type vi = find_index(v);
+    if (vi < 0) return;  // nothing to remove
 
     // remove the biases
-    base_type::remove_variable(vit->second);
+    base_type::remove_variable(vi);
 
     // update the indices
-    auto it = variables_.erase(variables_.begin() + vit->second);
-    indices_.erase(vit);
-    for (; it != variables_.end(); ++it) {
-        indices_[*it] -= 1;
-    }
+    erase_index(v, vi);
 }
 
 template <class bias_type, class index_type>
@@ -641,10 +817,8 @@ void Expression<bias_type, index_type>::remove_variables(Iter first, Iter last)
     // get the indices of any variables that need to be removed
     std::vector<index_type> to_remove;
     for (auto it = first; it != last; ++it) {
-        auto search = indices_.find(*it);
-        if (search != indices_.end()) {
-            to_remove.emplace_back(search->second);
-        }
+        index_type vi = find_index(*it);
+        if (vi >= 0) to_remove.emplace_back(vi);
     }
     std::sort(to_remove.begin(), to_remove.end());
 
@@ -657,10 +831,20 @@ void Expression<bias_type, index_type>::remove_variables(Iter first, Iter last)
     base_type::remove_variables(to_remove);
 
     // finally fix the indices by rebuilding from scratch
-    indices_.clear();
-    for (size_type i = 0, end = variables_.size(); i < end; ++i) {
-        indices_[variables_[i]] = i;
-    }
+    rebuild_indices();
+}
+
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::reserve(size_type num_variables) {
+    variables_.reserve(num_variables);
+    if (num_variables > INDEX_THRESHOLD) indices_.reserve(num_variables);
+    base_type::reserve(num_variables);
+}
+
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::reserve_interactions(index_type v, size_type n) {
+    index_type vi = find_index(v);
+    if (vi >= 0) base_type::reserve_interactions(vi, n);
 }
 
 template <class bias_type, class index_type>
@@ -684,12 +868,12 @@ bool Expression<bias_type, index_type>::shares_variables(const Expression& other
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::substitute_variable(index_type v, bias_type multiplier,
                                                             bias_type offset) {
-    auto it = indices_.find(v);
-    if (it == indices_.end()) {
+    index_type vi = find_index(v);
+    if (vi < 0) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         return;
     }
-    return base_type::substitute_variable(it->second, multiplier, offset);
+    return base_type::substitute_variable(vi, multiplier, offset);
 }
 
 template <class bias_type, class index_type>
@@ -0,0 +1,621 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+namespace fileview {
+
+/**
+ * Major version of the format written by `dump()` and read by `BinaryQuadraticModelView`.
+ *
+ * The file starts with the same header as the earlier versions, see
+ * `BinaryQuadraticModel.to_file()` in the Python package. The 8 bytes
+ * "DIMODBQM" are followed by the major and minor version as unsigned bytes,
+ * a 4 byte little-endian unsigned header length, and then the header itself,
+ * a json-serialized dictionary padded with spaces to a multiple of 64 bytes.
+ *
+ * The model follows the header as five little-endian arrays, each starting
+ * on a multiple of 64 bytes and padded with zeros:
+ *
+ * 1. the offset, one `dtype`
+ * 2. the linear biases, `num_variables` `dtype`
+ * 3. the start of each neighborhood, `num_variables + 1` `ntype`
+ * 4. the neighbors of each variable, sorted, `2 * num_interactions` `itype`
+ * 5. the quadratic biases, `2 * num_interactions` `dtype`
+ *
+ * so the quadratic biases are in compressed sparse row (CSR) format and can
+ * be used directly from memory, without copying. If the model is labeled,
+ * a "VARS" section with the labels comes last.
+ */
+constexpr unsigned char BQM_VERSION_MAJOR = 3;
+/// Minor version of the format, see `BQM_VERSION_MAJOR`.
+constexpr unsigned char BQM_VERSION_MINOR = 0;
+
+/// Byte boundary that each array in a version 3.0 file starts on.
+constexpr std::size_t ALIGNMENT = 64;
+
+/// Return the NumPy name for the data type `T`, e.g. "float64" for `double`.
+template <class T>
+std::string dtype_name() {
+    static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+    std::string kind = std::is_floating_point<T>::value ? "float"
+                       : std::is_signed<T>::value       ? "int"
+                                                        : "uint";
+    return kind + std::to_string(8 * sizeof(T));
+}
+
+/// The header at the start of every file, see `read_header()`.
+struct Header {
+    unsigned char major;
+    unsigned char minor;
+
+    /// The json-serialized header data.
+    std::string data;
+
+    /// Total length of the header in bytes, including the magic string. Where the body starts.
+    std::size_t length;
+};
+
+/**
+ * Read the header from the first `length` bytes of `data`.
+ *
+ * The first 8 bytes must be exactly `prefix`. They are followed by the major
+ * and minor version of the file format as unsigned bytes, then by a 4 byte
+ * little-endian unsigned header length and then by the json header data.
+ *
+ * # Exceptions
+ * Throws `std::invalid_argument` if the prefix does not match or if `data`
+ * is too short.
+ */
+inline Header read_header(const char* data, std::size_t length, const char* prefix) {
+    const std::size_t start = 14;  // the magic string, version and header length
+
+    if (length < start || std::memcmp(data, prefix, 8)) {
+        throw std::invalid_argument("unknown file type, expected magic string \"" +
+                                    std::string(prefix, 8) + "\"");
+    }
+
+    // we only support little-endian hosts, like the rest of the serialization
+    std::uint32_t data_length;
+    std::memcpy(&data_length, data + 10, sizeof(data_length));
+    if (length < start + data_length) throw std::invalid_argument("file is truncated");
+
+    return Header{static_cast<unsigned char>(data[8]), static_cast<unsigned char>(data[9]),
+                  std::string(data + start, data_length), start + data_length};
+}
+
+/**
+ * Write a header that can be read by `read_header()` and return its length.
+ *
+ * `data` should be json-serialized with sorted keys, to match the headers
+ * written by the Python package. The header is terminated by a newline and
+ * padded with spaces to a multiple of `ALIGNMENT` bytes.
+ */
+inline std::size_t write_header(std::ostream& os, const char* prefix, unsigned char major,
+                                unsigned char minor, std::string data) {
+    const std::size_t start = 14;
+
+    data += '\n';
+    data.append((ALIGNMENT - (start + data.size()) % ALIGNMENT) % ALIGNMENT, ' ');
+
+    const std::uint32_t data_length = data.size();
+
+    os.write(prefix, 8);
+    os.put(major);
+    os.put(minor);
+    os.write(reinterpret_cast<const char*>(&data_length), sizeof(data_length));
+    os.write(data.data(), data.size());
+
+    return start + data.size();
+}
+
+/**
+ * Return the raw value of `key` in json header data written by dimod.
+ *
+ * Strings are returned without their quotes and arrays without their
+ * brackets, e.g. "1, 2" for `[1, 2]`.
+ *
+ * # Exceptions
+ * Throws `std::invalid_argument` if `key` is missing.
+ */
+inline std::string header_field(const std::string& data, const std::string& key) {
+    // The header is always written by json.dumps(), or by write_header(), and
+    // only ever holds flat values, so we don't need a full parser.
+    std::size_t pos = data.find("\"" + key + "\"");
+    if (pos != std::string::npos) pos = data.find(':', pos + key.size() + 2);
+    if (pos != std::string::npos) pos = data.find_first_not_of(" \t\n", pos + 1);
+    if (pos == std::string::npos) {
+        throw std::invalid_argument("header is missing \"" + key + "\"");
+    }
+
+    std::size_t end;
+    if (data[pos] == '"') {
+        ++pos;
+        end = data.find('"', pos);
+    } else if (data[pos] == '[') {
+        ++pos;
+        end = data.find(']', pos);
+    } else {
+        end = data.find_first_of(",}", pos);
+    }
+    if (end == std::string::npos) {
+        throw std::invalid_argument("could not parse \"" + key + "\" in the header");
+    }
+
+    return data.substr(pos, end - pos);
+}
+
+/**
+ * A read-only binary quadratic model backed by a buffer holding a model
+ * serialized with format version 3.0.
+ *
+ * Nothing is copied out of the buffer, so constructing a view takes constant
+ * time. The buffer must outlive the view and its contents are trusted: only
+ * the header and the array lengths are checked.
+ */
+template <class Bias, class Index = int>
+class BinaryQuadraticModelView {
+ public:
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Type of the neighborhood starts in the file.
+    using offset_type = std::int64_t;
+
+    /// The neighbors of a variable and the biases of its interactions, as parallel arrays.
+    struct Neighborhood {
+        const index_type* neighbors;
+        const bias_type* biases;
+        size_type size;
+    };
+
+    /**
+     * Construct a view of the model serialized in `data`.
+     *
+     * `data` must point to `length` bytes aligned to at least `alignof(offset_type)`.
+     *
+     * # Exceptions
+     * Throws `std::invalid_argument` if `data` is not a version 3.0 file with
+     * biases of type `bias_type` and indices of type `index_type`, or if it is
+     * truncated or misaligned.
+     */
+    BinaryQuadraticModelView(const void* data, size_type length);
+
+    /// Return the degree of variable `v`.
+    size_type degree(index_type v) const;
+
+    /**
+     * Return the energy of the given sample.
+     *
+     * `sample_start` must be a random access iterator pointing to the
+     * beginning of the sample.
+     */
+    template <class Iter>
+    bias_type energy(Iter sample_start) const;
+
+    /// Return the linear bias associated with `v`.
+    bias_type linear(index_type v) const;
+
+    /// Return the neighborhood of variable `v`, sorted by neighbor.
+    Neighborhood neighborhood(index_type v) const;
+
+    /// Return the number of variables in the model.
+    size_type num_variables() const;
+
+    /// Return the number of interactions in the model.
+    size_type num_interactions() const;
+
+    /// Return the offset.
+    bias_type offset() const;
+
+    /**
+     * Return the quadratic bias associated with `u`, `v`.
+     *
+     * If `u` and `v` do not have a quadratic bias, returns 0.
+     */
+    bias_type quadratic(index_type u, index_type v) const;
+
+    /**
+     * Return the quadratic bias associated with `u`, `v`.
+     *
+     * # Exceptions
+     * Throws `std::out_of_range` if `u` and `v` do not have a quadratic bias.
+     */
+    bias_type quadratic_at(index_type u, index_type v) const;
+
+    /// Return the variable type of the model.
+    Vartype vartype() const;
+
+ private:
+    size_type num_variables_;
+    size_type num_interactions_;
+    Vartype vartype_;
+
+    bias_type offset_;
+    const bias_type* linear_biases_;
+    const offset_type* starts_;
+    const index_type* neighbors_;
+    const bias_type* quadratic_biases_;
+
+    // Return a pointer to the quadratic bias of (u, v), or nullptr if there is none.
+    const bias_type* find_quadratic(index_type u, index_type v) const;
+};
+
+/**
+ * Write `bqm` to `os` using format version 3.0.
+ *
+ * The variables are saved unlabeled, so the output can be read with
+ * `BinaryQuadraticModelView`, or in the Python package with
+ * `BinaryQuadraticModel.from_file()`.
+ */
+template <class Bias, class Index>
+void dump(const BinaryQuadraticModel<Bias, Index>& bqm, std::ostream& os);
+
+/// A read-only memory mapping of an entire file. Mappings of the same file can share pages
+/// across processes.
+class MappedFile {
+ public:
+    /**
+     * Map the file at `filename` into memory.
+     *
+     * # Exceptions
+     * Throws `std::runtime_error` if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& filename);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    /// Return a pointer to the start of the mapping. Aligned to a page boundary.
+    const void* data() const { return data_; }
+
+    /// Return the length of the mapping in bytes.
+    std::size_t size() const { return size_; }
+
+ private:
+    void* data_;
+    std::size_t size_;
+#if defined(_WIN32)
+    HANDLE mapping_;
+#endif
+};
+
+/**
+ * A read-only binary quadratic model served directly from a memory-mapped
+ * file written with format version 3.0.
+ *
+ * Opening a model only maps the file, so it takes milliseconds regardless of
+ * the size of the model. Pages are read from disk as they are used.
+ */
+template <class Bias, class Index = int>
+class MappedBinaryQuadraticModel : private MappedFile,
+                                   public BinaryQuadraticModelView<Bias, Index> {
+ public:
+    /// Map the model saved in the file at `filename`.
+    explicit MappedBinaryQuadraticModel(const std::string& filename)
+            : MappedFile(filename),
+              BinaryQuadraticModelView<Bias, Index>(MappedFile::data(), MappedFile::size()) {}
+};
+
+template <class bias_type, class index_type>
+BinaryQuadraticModelView<bias_type, index_type>::BinaryQuadraticModelView(const void* data,
+                                                                          size_type length) {
+    const char* bytes = static_cast<const char*>(data);
+
+    if (reinterpret_cast<std::uintptr_t>(bytes) % alignof(offset_type)) {
+        throw std::invalid_argument("data is not sufficiently aligned");
+    }
+
+    const Header info = read_header(bytes, length, "DIMODBQM");
+    if (info.major != BQM_VERSION_MAJOR) {
+        throw std::invalid_argument("only files with format version 3.0 can be viewed");
+    }
+    const std::string& header = info.data;
+
+    if (header_field(header, "dtype") != dtype_name<bias_type>() ||
+        header_field(header, "itype") != dtype_name<index_type>() ||
+        header_field(header, "ntype") != dtype_name<offset_type>()) {
+        throw std::invalid_argument("file data types do not match bias_type and index_type");
+    }
+
+    std::string vartype = header_field(header, "vartype");
+    if (vartype == "SPIN") {
+        vartype_ = Vartype::SPIN;
+    } else if (vartype == "BINARY") {
+        vartype_ = Vartype::BINARY;
+    } else {
+        throw std::invalid_argument("unknown vartype \"" + vartype + "\"");
+    }
+
+    std::string shape = header_field(header, "shape");
+    size_type comma = shape.find(',');
+    if (comma == std::string::npos) throw std::invalid_argument("could not parse the shape");
+    num_variables_ = std::stoull(shape.substr(0, comma));
+    num_interactions_ = std::stoull(shape.substr(comma + 1));
+
+    // now find each of the arrays, the last one is not necessarily padded
+    size_type pos = info.length;
+    size_type end = pos;
+    auto next = [&](size_type nbytes) -> const char* {
+        const char* start = bytes + pos;
+        end = pos + nbytes;
+        pos += (nbytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        return start;
+    };
+
+    const char* offset = next(sizeof(bias_type));
+    linear_biases_ = reinterpret_cast<const bias_type*>(next(num_variables_ * sizeof(bias_type)));
+    starts_ = reinterpret_cast<const offset_type*>(
+            next((num_variables_ + 1) * sizeof(offset_type)));
+    neighbors_ =
+            reinterpret_cast<const index_type*>(next(2 * num_interactions_ * sizeof(index_type)));
+    quadratic_biases_ =
+            reinterpret_cast<const bias_type*>(next(2 * num_interactions_ * sizeof(bias_type)));
+
+    if (end > length) throw std::invalid_argument("file is truncated");
+
+    std::memcpy(&offset_, offset, sizeof(bias_type));
+
+    if (starts_[0] != 0 || static_cast<size_type>(starts_[num_variables_]) !=
+                                   2 * num_interactions_) {
+        throw std::invalid_argument("neighborhood starts do not match the shape");
+    }
+}
+
+template <class bias_type, class index_type>
+auto BinaryQuadraticModelView<bias_type, index_type>::degree(index_type v) const -> size_type {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    return starts_[v + 1] - starts_[v];
+}
+
+template <class bias_type, class index_type>
+template <class Iter>
+bias_type BinaryQuadraticModelView<bias_type, index_type>::energy(Iter sample_start) const {
+    static_assert(std::is_same<std::random_access_iterator_tag,
+                               typename std::iterator_traits<Iter>::iterator_category>::value,
+                  "iterators must be random access");
+
+    bias_type en = offset();
+
+    for (index_type u = 0; static_cast<size_type>(u) < num_variables(); ++u) {
+        auto u_val = *(sample_start + u);
+
+        en += u_val * linear_biases_[u];
+
+        // neighborhoods are sorted so we can stop at the first v >= u
+        bias_type total = 0;
+        for (offset_type k = starts_[u]; k < starts_[u + 1]; ++k) {
+            index_type v = neighbors_[k];
+            if (v >= u) break;
+            total += *(sample_start + v) * quadratic_biases_[k];
+        }
+        en += u_val * total;
+    }
+
+    return en;
+}
+
+template <class bias_type, class index_type>
+const bias_type* BinaryQuadraticModelView<bias_type, index_type>::find_quadratic(
+        index_type u, index_type v) const {
+    assert(u >= 0 && static_cast<size_type>(u) < num_variables());
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+
+    const index_type* first = neighbors_ + starts_[u];
+    const index_type* last = neighbors_ + starts_[u + 1];
+    const index_type* it = std::lower_bound(first, last, v);
+
+    if (it == last || *it != v) return nullptr;
+    return quadratic_biases_ + (it - neighbors_);
+}
+
+template <class bias_type, class index_type>
+bias_type BinaryQuadraticModelView<bias_type, index_type>::linear(index_type v) const {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    return linear_biases_[v];
+}
+
+template <class bias_type, class index_type>
+auto BinaryQuadraticModelView<bias_type, index_type>::neighborhood(index_type v) const
+        -> Neighborhood {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    return Neighborhood{neighbors_ + starts_[v], quadratic_biases_ + starts_[v], degree(v)};
+}
+
+template <class bias_type, class index_type>
+auto BinaryQuadraticModelView<bias_type, index_type>::num_variables() const -> size_type {
+    return num_variables_;
+}
+
+template <class bias_type, class index_type>
+auto BinaryQuadraticModelView<bias_type, index_type>::num_interactions() const -> size_type {
+    return num_interactions_;
+}
+
+template <class bias_type, class index_type>
+bias_type BinaryQuadraticModelView<bias_type, index_type>::offset() const {
+    return offset_;
+}
+
+template <class bias_type, class index_type>
+bias_type BinaryQuadraticModelView<bias_type, index_type>::quadratic(index_type u,
+                                                                     index_type v) const {
+    const bias_type* bias = find_quadratic(u, v);
+    return bias ? *bias : 0;
+}
+
+template <class bias_type, class index_type>
+bias_type BinaryQuadraticModelView<bias_type, index_type>::quadratic_at(index_type u,
+                                                                        index_type v) const {
+    const bias_type* bias = find_quadratic(u, v);
+    if (!bias) throw std::out_of_range("given variables have no interaction");
+    return *bias;
+}
+
+template <class bias_type, class index_type>
+Vartype BinaryQuadraticModelView<bias_type, index_type>::vartype() const {
+    return vartype_;
+}
+
+template <class Bias, class Index>
+void dump(const BinaryQuadraticModel<Bias, Index>& bqm, std::ostream& os) {
+    using offset_type = typename BinaryQuadraticModelView<Bias, Index>::offset_type;
+
+    if (bqm.vartype() != Vartype::SPIN && bqm.vartype() != Vartype::BINARY) {
+        throw std::logic_error("unsupported vartype");
+    }
+
+    // match the header produced by json.dumps(data, sort_keys=True)
+    std::size_t written = write_header(
+            os, "DIMODBQM", BQM_VERSION_MAJOR, BQM_VERSION_MINOR,
+            "{\"dtype\": \"" + dtype_name<Bias>() + "\", \"itype\": \"" + dtype_name<Index>() +
+                    "\", \"ntype\": \"" + dtype_name<offset_type>() + "\", \"shape\": [" +
+                    std::to_string(bqm.num_variables()) + ", " +
+                    std::to_string(bqm.num_interactions()) +
+                    "], \"type\": \"BinaryQuadraticModel\", \"variables\": false, " +
+                    "\"vartype\": \"" + (bqm.vartype() == Vartype::SPIN ? "SPIN" : "BINARY") +
+                    "\"}");
+
+    auto write = [&](const void* data, std::size_t nbytes) {
+        os.write(static_cast<const char*>(data), nbytes);
+        written += nbytes;
+    };
+    auto pad = [&]() {
+        const std::string padding((ALIGNMENT - written % ALIGNMENT) % ALIGNMENT, 0);
+        write(padding.data(), padding.size());
+    };
+
+    const Bias offset = bqm.offset();
+    write(&offset, sizeof(offset));
+    pad();
+
+    for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+        const Bias bias = bqm.linear(v);
+        write(&bias, sizeof(bias));
+    }
+    pad();
+
+    offset_type start = 0;
+    write(&start, sizeof(start));
+    for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+        start += bqm.num_interactions(v);
+        write(&start, sizeof(start));
+    }
+    pad();
+
+    for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+        for (auto it = bqm.cbegin_neighborhood(v); it != bqm.cend_neighborhood(v); ++it) {
+            write(&it->v, sizeof(Index));
+        }
+    }
+    pad();
+
+    for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+        for (auto it = bqm.cbegin_neighborhood(v); it != bqm.cend_neighborhood(v); ++it) {
+            write(&it->bias, sizeof(Bias));
+        }
+    }
+    pad();
+}
+
+#if defined(_WIN32)
+
+inline MappedFile::MappedFile(const std::string& filename)
+        : data_(nullptr), size_(0), mapping_(nullptr) {
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("could not open " + filename);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || !size.QuadPart) {
+        CloseHandle(file);
+        throw std::runtime_error("could not map " + filename);
+    }
+    size_ = static_cast<std::size_t>(size.QuadPart);
+
+    mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);  // the mapping keeps the file open
+    if (!mapping_) throw std::runtime_error("could not map " + filename);
+
+    data_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (!data_) {
+        CloseHandle(mapping_);
+        throw std::runtime_error("could not map " + filename);
+    }
+}
+
+inline MappedFile::~MappedFile() {
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+}
+
+#else
+
+inline MappedFile::MappedFile(const std::string& filename) : data_(nullptr), size_(0) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("could not open " + filename);
+
+    struct stat st;
+    if (::fstat(fd, &st) || !st.st_size) {
+        ::close(fd);
+        throw std::runtime_error("could not map " + filename);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    // MAP_SHARED so that every process mapping the file shares the same pages
+    data_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file open
+    if (data_ == MAP_FAILED) throw std::runtime_error("could not map " + filename);
+}
+
+inline MappedFile::~MappedFile() { ::munmap(data_, size_); }
+
+#endif
+
+}  // namespace fileview
+}  // namespace dimod
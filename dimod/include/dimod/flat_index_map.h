@@ -0,0 +1,199 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dimod {
+namespace utils {
+
+/**
+ * A hash map from non-negative integer keys (typically variable indices) to
+ * values.
+ *
+ * The (key, value) pairs are stored in a single flat array using open
+ * addressing with linear probing, so lookups touch one or two cache lines
+ * and there is no per-element allocation. Erasing uses backward-shift
+ * deletion, so no tombstones are left behind.
+ *
+ * Inserting into the map invalidates all iterators. Negative keys are
+ * reserved to mark empty slots and cannot be stored.
+ */
+template <class Key, class T>
+class FlatIndexMap {
+    static_assert(std::is_integral<Key>::value && std::is_signed<Key>::value,
+                  "Key must be a signed integer type");
+
+ public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+
+    /// Points to a (key, value) pair. Only ever compared to `end()` or dereferenced.
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    FlatIndexMap() : slots_(), size_(0) {}
+
+    /// Remove all of the pairs, keeping the capacity.
+    void clear() {
+        std::fill(slots_.begin(), slots_.end(), value_type(empty_key(), T()));
+        size_ = 0;
+    }
+
+    /// Return 1 if `key` is in the map, otherwise 0.
+    size_type count(key_type key) const { return find(key) != end(); }
+
+    /// Return true if the map has no pairs.
+    bool empty() const { return !size_; }
+
+    iterator end() { return slots_.data() + slots_.size(); }
+    const_iterator end() const { return slots_.data() + slots_.size(); }
+
+    /// Remove the pair pointed to by `pos`.
+    void erase(iterator pos);
+
+    /// Remove `key` from the map. Return the number of pairs removed.
+    size_type erase(key_type key) {
+        auto it = find(key);
+        if (it == end()) return 0;
+        erase(it);
+        return 1;
+    }
+
+    /// Return an iterator to the pair with `key`, or `end()` if there is none.
+    iterator find(key_type key) {
+        return const_cast<iterator>(static_cast<const FlatIndexMap&>(*this).find(key));
+    }
+    const_iterator find(key_type key) const;
+
+    /// Total bytes consumed by the pairs, including the empty slots.
+    size_type nbytes(bool capacity = false) const {
+        return (capacity ? slots_.capacity() : slots_.size()) * sizeof(value_type);
+    }
+
+    /// Return a reference to the value for `key`, inserting `T()` if it is not present.
+    mapped_type& operator[](key_type key);
+
+    /// Make room for at least `n` pairs without further reallocation.
+    void reserve(size_type n) {
+        if (n > max_load(slots_.size())) rehash(n);
+    }
+
+    /// Return the number of pairs in the map.
+    size_type size() const { return size_; }
+
+ private:
+    std::vector<value_type> slots_;
+    size_type size_;
+
+    static constexpr key_type empty_key() { return -1; }
+
+    // the maximum number of pairs for the given number of slots, 3/4 full
+    static size_type max_load(size_type num_slots) { return num_slots - num_slots / 4; }
+
+    // the preferred slot for key, fibonacci hashing variable indices spreads
+    // runs of consecutive keys across the table
+    size_type home(key_type key) const {
+        assert(!slots_.empty());
+        std::uint64_t h = static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_type>(h ^ (h >> 32)) & (slots_.size() - 1);
+    }
+
+    // resize the table to hold at least n pairs and reinsert everything
+    void rehash(size_type n);
+};
+
+template <class Key, class T>
+void FlatIndexMap<Key, T>::erase(iterator pos) {
+    assert(pos != end() && pos->first != empty_key());
+
+    const size_type mask = slots_.size() - 1;
+
+    // shift back any following pairs that would no longer be reachable
+    size_type i = pos - slots_.data();
+    size_type j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (slots_[j].first == empty_key()) break;
+
+        size_type k = home(slots_[j].first);
+
+        // if k is cyclically in (i, j] then the pair at j can stay where it is
+        if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j)) continue;
+
+        slots_[i] = std::move(slots_[j]);
+        i = j;
+    }
+
+    slots_[i] = value_type(empty_key(), T());
+    --size_;
+}
+
+template <class Key, class T>
+auto FlatIndexMap<Key, T>::find(key_type key) const -> const_iterator {
+    if (key < 0 || slots_.empty()) return end();
+
+    const size_type mask = slots_.size() - 1;
+    for (size_type i = home(key);; i = (i + 1) & mask) {
+        if (slots_[i].first == key) return slots_.data() + i;
+        if (slots_[i].first == empty_key()) return end();
+    }
+}
+
+template <class Key, class T>
+auto FlatIndexMap<Key, T>::operator[](key_type key) -> mapped_type& {
+    assert(key >= 0);
+
+    if (size_ + 1 > max_load(slots_.size())) rehash(size_ + 1);
+
+    const size_type mask = slots_.size() - 1;
+    for (size_type i = home(key);; i = (i + 1) & mask) {
+        if (slots_[i].first == key) return slots_[i].second;
+        if (slots_[i].first == empty_key()) {
+            slots_[i].first = key;
+            ++size_;
+            return slots_[i].second;
+        }
+    }
+}
+
+template <class Key, class T>
+void FlatIndexMap<Key, T>::rehash(size_type n) {
+    // smallest power of two with room for n (and at least 4, so small maps fit
+    // in a single cache line)
+    size_type num_slots = std::max<size_type>(slots_.size(), 4);
+    while (max_load(num_slots) < n) num_slots *= 2;
+
+    std::vector<value_type> old(num_slots, value_type(empty_key(), T()));
+    std::swap(old, slots_);
+
+    const size_type mask = num_slots - 1;
+    for (auto& pair : old) {
+        if (pair.first == empty_key()) continue;
+        size_type i = home(pair.first);
+        while (slots_[i].first != empty_key()) i = (i + 1) & mask;
+        slots_[i] = std::move(pair);
+    }
+}
+
+}  // namespace utils
+}  // namespace dimod
@@ -0,0 +1,337 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/utils.h"
+
+namespace dimod {
+namespace generators {
+
+/**
+ * Uniformly random biases in `[low, high)`.
+ *
+ * This is an example of a distribution for the generators below. A
+ * distribution is a function object that is called with a
+ * `utils::XorShift128Plus&` and returns a bias. It is called concurrently
+ * from several threads, so it must not modify any shared state.
+ */
+template <class Bias>
+struct Uniform {
+    Bias low;
+    Bias high;
+
+    explicit Uniform(Bias low = 0, Bias high = 1) : low(low), high(high) {}
+
+    template <class Engine>
+    Bias operator()(Engine& rng) const {
+        return low + (high - low) * rng.uniform();
+    }
+};
+
+/**
+ * Set every linear bias and the offset of `model` to a value drawn from
+ * `distribution`.
+ *
+ * The values are drawn from random number streams derived from `seed` in
+ * fixed-size chunks, so the model is the same for any `num_threads`. See
+ * utils::parallel_for() for the meaning of `num_threads`.
+ */
+template <class Bias, class Index, class Distribution>
+void set_random_linear(abc::QuadraticModelBase<Bias, Index>& model,
+                       const Distribution& distribution, std::uint64_t seed, int num_threads = 1);
+
+/**
+ * Add `num_interactions` interactions between distinct, uniformly random pairs
+ * of variables, with biases drawn from `distribution`.
+ *
+ * This is the structure of an Erdős-Rényi G(n, m) random graph. The result
+ * depends only on `seed`, not on `num_threads`, see set_random_linear(). The
+ * biases are added to any existing interactions.
+ *
+ * It runs in O(`num_interactions` log `num_interactions`) time, or in time
+ * linear in the number of pairs of variables when more than half of them are
+ * chosen.
+ *
+ * Throws `std::invalid_argument` if `num_interactions` is greater than the
+ * number of pairs of variables.
+ */
+template <class Bias, class Index, class Distribution>
+void add_gnm_interactions(abc::QuadraticModelBase<Bias, Index>& model,
+                          std::uint64_t num_interactions, const Distribution& distribution,
+                          std::uint64_t seed, int num_threads = 1);
+
+/**
+ * Add an interaction between each pair of variables with probability `p`,
+ * with biases drawn from `distribution`.
+ *
+ * This is the structure of an Erdős-Rényi G(n, p) random graph. Values of `p`
+ * less than 0 are treated as 0 and values greater than 1 as 1. The result
+ * depends only on `seed`, not on `num_threads`, see set_random_linear(). The
+ * biases are added to any existing interactions.
+ *
+ * The pairs are chosen by skipping ahead a geometrically distributed number of
+ * pairs at a time, so it runs in time linear in the number of interactions
+ * added rather than in the number of pairs.
+ */
+template <class Bias, class Index, class Distribution>
+void add_gnp_interactions(abc::QuadraticModelBase<Bias, Index>& model, double p,
+                          const Distribution& distribution, std::uint64_t seed,
+                          int num_threads = 1);
+
+namespace detail {
+
+// Each use of the seed has its own streams, so that, for instance, the biases
+// do not depend on how many values were drawn to choose the structure.
+enum class Stream : std::uint64_t { LINEAR = 1, OFFSET, STRUCTURE, QUADRATIC };
+
+// The number of values drawn from each stream. It is fixed, rather than
+// derived from the number of threads, so that the results do not depend on it.
+constexpr std::size_t CHUNK_SIZE = 1 << 16;
+
+// The number of pairs of variables considered by each stream of G(n, p).
+constexpr std::uint64_t PAIRS_PER_BLOCK = 1 << 20;
+
+inline utils::XorShift128Plus engine(std::uint64_t seed, Stream stream, std::uint64_t round,
+                                     std::uint64_t chunk) {
+    const std::uint64_t id = (static_cast<std::uint64_t>(stream) << 56) ^ (round << 40) ^ chunk;
+    return utils::XorShift128Plus(seed, id);
+}
+
+// A uniformly random integer in [0, n) for n > 0, without modulo bias.
+template <class Engine>
+std::uint64_t bounded(Engine& rng, std::uint64_t n) {
+    assert(n > 0);
+    const std::uint64_t threshold = (0 - n) % n;  // 2**64 % n
+    std::uint64_t x;
+    do {
+        x = rng();
+    } while (x < threshold);
+    return x % n;
+}
+
+// Fill `out[0, length)` with values drawn from `distribution`, one stream per chunk.
+template <class T, class Distribution>
+void fill_random(T* out, std::size_t length, const Distribution& distribution,
+                 std::uint64_t seed, Stream stream, std::uint64_t round, int num_threads) {
+    const std::size_t num_chunks = (length + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    utils::parallel_for(num_chunks, num_threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t c = first; c < last; ++c) {
+            auto rng = engine(seed, stream, round, c);
+            const std::size_t end = std::min(length, (c + 1) * CHUNK_SIZE);
+            for (std::size_t i = c * CHUNK_SIZE; i < end; ++i) out[i] = distribution(rng);
+        }
+    });
+}
+
+// The pairs (u, v), u < v, of n variables are numbered in row-major order.
+// This is the number of the first pair in row u.
+inline std::uint64_t row_start(std::uint64_t n, std::uint64_t u) { return u * (2 * n - u - 1) / 2; }
+
+// The row of the pair numbered `pair`.
+inline std::uint64_t row_of(std::uint64_t n, std::uint64_t pair) {
+    // the last row u with row_start(n, u) <= pair
+    std::uint64_t low = 0;
+    std::uint64_t high = n - 1;
+    while (high - low > 1) {
+        const std::uint64_t mid = low + (high - low) / 2;
+        if (row_start(n, mid) <= pair) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Return `k` distinct, uniformly random pair numbers in [0, num_pairs), sorted.
+inline std::vector<std::uint64_t> sample_pairs(std::uint64_t num_pairs, std::uint64_t k,
+                                               std::uint64_t seed, int num_threads) {
+    assert(k <= num_pairs);
+
+    // Draw with replacement and then redraw the duplicates until there are
+    // none. The distribution of the draws is invariant under any permutation
+    // of the pairs, so every subset of size k is equally likely.
+    std::vector<std::uint64_t> pairs;
+    std::vector<std::uint64_t> draws;
+    std::vector<std::uint64_t> merged;
+    auto distribution = [num_pairs](utils::XorShift128Plus& rng) {
+        return bounded(rng, num_pairs);
+    };
+    for (std::uint64_t round = 0; pairs.size() < k; ++round) {
+        draws.resize(k - pairs.size());
+        fill_random(draws.data(), draws.size(), distribution, seed, Stream::STRUCTURE, round,
+                    num_threads);
+        std::sort(draws.begin(), draws.end());
+
+        merged.clear();
+        merged.reserve(pairs.size() + draws.size());
+        std::merge(pairs.begin(), pairs.end(), draws.begin(), draws.end(),
+                   std::back_inserter(merged));
+        merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+        pairs.swap(merged);
+    }
+    return pairs;
+}
+
+// Add the pairs numbered by the sorted `pairs` to `model` as interactions with
+// biases drawn from `distribution`.
+template <class Bias, class Index, class Distribution>
+void add_pairs(abc::QuadraticModelBase<Bias, Index>& model, std::vector<std::uint64_t>&& pairs,
+               const Distribution& distribution, std::uint64_t seed, int num_threads) {
+    const std::uint64_t n = model.num_variables();
+    const std::size_t length = pairs.size();
+    if (!length) return;
+
+    std::vector<Index> rows(length);
+    std::vector<Index> cols(length);
+    const std::size_t num_chunks = (length + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    utils::parallel_for(num_chunks, num_threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t c = first; c < last; ++c) {
+            const std::size_t end = std::min(length, (c + 1) * CHUNK_SIZE);
+
+            // the pairs are sorted, so we only need to search for the first row
+            std::uint64_t u = row_of(n, pairs[c * CHUNK_SIZE]);
+            std::uint64_t next = row_start(n, u + 1);
+            for (std::size_t i = c * CHUNK_SIZE; i < end; ++i) {
+                while (pairs[i] >= next) {
+                    ++u;
+                    next = row_start(n, u + 1);
+                }
+                rows[i] = static_cast<Index>(u);
+                cols[i] = static_cast<Index>(u + 1 + (pairs[i] - row_start(n, u)));
+            }
+        }
+    });
+    pairs.clear();
+    pairs.shrink_to_fit();
+
+    std::vector<Bias> biases(length);
+    fill_random(biases.data(), length, distribution, seed, Stream::QUADRATIC, 0, num_threads);
+
+    model.add_quadratic_coo(rows.begin(), cols.begin(), biases.begin(), length, true);
+}
+
+}  // namespace detail
+
+template <class Bias, class Index, class Distribution>
+void set_random_linear(abc::QuadraticModelBase<Bias, Index>& model,
+                       const Distribution& distribution, std::uint64_t seed, int num_threads) {
+    const std::size_t n = model.num_variables();
+
+    std::vector<Bias> biases(n);
+    detail::fill_random(biases.data(), n, distribution, seed, detail::Stream::LINEAR, 0,
+                        num_threads);
+    for (std::size_t v = 0; v < n; ++v) model.set_linear(v, biases[v]);
+
+    auto rng = detail::engine(seed, detail::Stream::OFFSET, 0, 0);
+    model.set_offset(distribution(rng));
+}
+
+template <class Bias, class Index, class Distribution>
+void add_gnm_interactions(abc::QuadraticModelBase<Bias, Index>& model,
+                          std::uint64_t num_interactions, const Distribution& distribution,
+                          std::uint64_t seed, int num_threads) {
+    const std::uint64_t n = model.num_variables();
+    const std::uint64_t num_pairs = (n < 2) ? 0 : n * (n - 1) / 2;
+
+    if (num_interactions > num_pairs) {
+        throw std::invalid_argument(
+                "num_interactions must not be greater than the number of pairs of variables");
+    }
+
+    std::vector<std::uint64_t> pairs;
+    if (num_interactions <= num_pairs / 2) {
+        pairs = detail::sample_pairs(num_pairs, num_interactions, seed, num_threads);
+    } else {
+        // choose the pairs to leave out instead
+        auto excluded =
+                detail::sample_pairs(num_pairs, num_pairs - num_interactions, seed, num_threads);
+
+        pairs.reserve(num_interactions);
+        auto it = excluded.begin();
+        for (std::uint64_t pair = 0; pair < num_pairs; ++pair) {
+            if (it != excluded.end() && *it == pair) {
+                ++it;
+            } else {
+                pairs.push_back(pair);
+            }
+        }
+    }
+
+    detail::add_pairs(model, std::move(pairs), distribution, seed, num_threads);
+}
+
+template <class Bias, class Index, class Distribution>
+void add_gnp_interactions(abc::QuadraticModelBase<Bias, Index>& model, double p,
+                          const Distribution& distribution, std::uint64_t seed,
+                          int num_threads) {
+    const std::uint64_t n = model.num_variables();
+    const std::uint64_t num_pairs = (n < 2) ? 0 : n * (n - 1) / 2;
+
+    if (!(p > 0) || !num_pairs) return;
+
+    // the pairs from each block of PAIRS_PER_BLOCK consecutive pairs, each
+    // with its own stream
+    const double log_q = std::log1p(-std::min(p, 1.));
+    const std::size_t num_blocks =
+            (num_pairs + detail::PAIRS_PER_BLOCK - 1) / detail::PAIRS_PER_BLOCK;
+    std::vector<std::vector<std::uint64_t>> blocks(num_blocks);
+    utils::parallel_for(num_blocks, num_threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t b = first; b < last; ++b) {
+            const std::uint64_t end = std::min(num_pairs, (b + 1) * detail::PAIRS_PER_BLOCK);
+            std::uint64_t pair = b * detail::PAIRS_PER_BLOCK;
+
+            if (p >= 1) {
+                for (; pair < end; ++pair) blocks[b].push_back(pair);
+                continue;
+            }
+
+            auto rng = detail::engine(seed, detail::Stream::STRUCTURE, 0, b);
+            while (true) {
+                // the number of pairs skipped before the next one is chosen
+                const double skip = std::floor(std::log1p(-rng.uniform()) / log_q);
+                if (skip >= static_cast<double>(end - pair)) break;
+                pair += static_cast<std::uint64_t>(skip);
+                blocks[b].push_back(pair++);
+            }
+        }
+    });
+
+    std::size_t length = 0;
+    for (const auto& block : blocks) length += block.size();
+
+    std::vector<std::uint64_t> pairs;
+    pairs.reserve(length);
+    for (auto& block : blocks) {
+        pairs.insert(pairs.end(), block.begin(), block.end());
+        std::vector<std::uint64_t>().swap(block);
+    }
+
+    detail::add_pairs(model, std::move(pairs), distribution, seed, num_threads);
+}
+
+}  // namespace generators
+}  // namespace dimod
@@ -0,0 +1,134 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace dimod {
+
+/**
+ * A breakdown of the heap memory used by a model, in bytes.
+ *
+ * Only memory owned by the model is counted, not the model object itself.
+ * The exception is the constraints of a constrained quadratic model, which
+ * are each allocated individually, so their objects and the reference counts
+ * of their shared pointers are counted in `other`.
+ */
+struct MemoryUsage {
+    /// The linear biases and the offset.
+    std::size_t linear;
+
+    /// The neighborhoods, or the packed adjacency of a frozen model.
+    std::size_t quadratic;
+
+    /// The per-variable information: vartypes, bounds and numbers of cases.
+    std::size_t variables;
+
+    /// The maps between the variables of an expression and of its parent.
+    std::size_t indices;
+
+    /// Everything else, such as the constraints' objects and metadata.
+    std::size_t other;
+
+    MemoryUsage() : linear(0), quadratic(0), variables(0), indices(0), other(0) {}
+
+    /// Return the sum of all of the categories.
+    std::size_t total() const { return linear + quadratic + variables + indices + other; }
+
+    MemoryUsage& operator+=(const MemoryUsage& rhs) {
+        linear += rhs.linear;
+        quadratic += rhs.quadratic;
+        variables += rhs.variables;
+        indices += rhs.indices;
+        other += rhs.other;
+        return *this;
+    }
+};
+
+/// The events counted when dimod is compiled with `DIMOD_ENABLE_COUNTERS`.
+enum class Counter {
+    /// Vectors of biases or neighborhoods that grew beyond their capacity.
+    REALLOCATIONS,
+
+    /// Quadratic biases that had to be inserted into a neighborhood.
+    QUADRATIC_INSERTS,
+
+    /// Quadratic biases that were updated in place.
+    QUADRATIC_HITS,
+
+    /// Calls to `energy()` and `energies()`.
+    ENERGY_CALLS,
+
+    NUM_COUNTERS
+};
+
+/**
+ * Whether dimod was compiled with the counters enabled.
+ *
+ * The counters are opt-in because incrementing them adds an atomic operation
+ * to hot paths like `add_quadratic()`. Define `DIMOD_ENABLE_COUNTERS` before
+ * including any dimod header to enable them. Every translation unit that is
+ * linked together must agree.
+ */
+#ifdef DIMOD_ENABLE_COUNTERS
+constexpr bool counters_enabled = true;
+#else
+constexpr bool counters_enabled = false;
+#endif
+
+namespace detail {
+
+inline std::atomic<std::uint64_t>* counter_storage() {
+    static std::atomic<std::uint64_t> counts[static_cast<int>(Counter::NUM_COUNTERS)] = {};
+    return counts;
+}
+
+/// Increment `counter` by `n`. A no-op unless the counters are enabled.
+inline void count(Counter counter, std::uint64_t n = 1) {
+    if (counters_enabled) {
+        counter_storage()[static_cast<int>(counter)].fetch_add(n, std::memory_order_relaxed);
+    }
+}
+
+/// Count a reallocation if the capacity of `vector` is no longer `capacity`.
+template <class Vector>
+void count_reallocation(const Vector& vector, std::size_t capacity) {
+    if (counters_enabled && vector.capacity() != capacity) count(Counter::REALLOCATIONS);
+}
+
+}  // namespace detail
+
+/**
+ * Return the number of times `counter` was incremented since the program
+ * started or since the last call to `reset_counters()`.
+ *
+ * Always 0 unless the counters are enabled, see `counters_enabled`. The
+ * counters are shared by all models and threads, but not between shared
+ * libraries that each include the dimod headers.
+ */
+inline std::uint64_t counter_value(Counter counter) {
+    return detail::counter_storage()[static_cast<int>(counter)].load(std::memory_order_relaxed);
+}
+
+/// Set all of the counters to 0.
+inline void reset_counters() {
+    for (int c = 0; c < static_cast<int>(Counter::NUM_COUNTERS); ++c) {
+        detail::counter_storage()[c].store(0, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,223 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+
+/**
+ * A sample together with the local field of each of its variables.
+ *
+ * The local field of `v` is its linear bias plus the sum of its quadratic
+ * biases, each multiplied by the value of the neighboring variable. Square
+ * terms (self-loops) are tracked separately. With the local fields cached,
+ * the energy change from setting a single variable to a new value can be
+ * calculated in constant time, and the change can be applied in time linear
+ * in the degree of the variable.
+ *
+ * The state keeps a pointer to the model it was constructed from. The model
+ * must outlive the state and must not be modified while the state is in use.
+ */
+template <class Bias, class Index = int>
+class LocalFieldState {
+ public:
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Type of the model the state is calculated from.
+    using model_type = abc::QuadraticModelBase<bias_type, index_type>;
+
+    /**
+     * Construct the state of `model` at a sample.
+     *
+     * `sample_start` must be a random access iterator pointing to the
+     * beginning of a sample of length `model.num_variables()` in the variable
+     * order of the model.
+     */
+    template <class Iter>
+    LocalFieldState(const model_type& model, Iter sample_start);
+
+    /// Set variable `v` to `value` and update the local fields of its neighbors.
+    /// Throws `std::out_of_range` if `value` is outside the bounds of `v`.
+    void apply(index_type v, bias_type value);
+
+    /// Return the energy change from setting variable `v` to `value`.
+    bias_type delta(index_type v, bias_type value) const;
+
+    /// Return the energy change from flipping the BINARY or SPIN variable `v`.
+    bias_type delta_flip(index_type v) const;
+
+    /// Return the energy of the current sample.
+    bias_type energy() const;
+
+    /// Flip the BINARY or SPIN variable `v` and return the new value.
+    bias_type flip(index_type v);
+
+    /// Return the local field of variable `v`.
+    bias_type local_field(index_type v) const;
+
+    /// Return the model the state was constructed from.
+    const model_type& model() const;
+
+    /// Return the number of variables in the state.
+    size_type num_variables() const;
+
+    /// Return the current sample.
+    const std::vector<bias_type>& sample() const;
+
+    /// Return the current value of variable `v`.
+    bias_type value(index_type v) const;
+
+ private:
+    const model_type* model_;
+
+    std::vector<bias_type> sample_;
+
+    // the linear bias plus the contribution of every neighbor other than v
+    std::vector<bias_type> fields_;
+
+    // the bias on the v*v term, if any
+    std::vector<bias_type> squares_;
+
+    bias_type energy_;
+
+    // Return the value that flipping v would give, only defined for BINARY and SPIN
+    bias_type flipped_value(index_type v) const;
+};
+
+template <class bias_type, class index_type>
+template <class Iter>
+LocalFieldState<bias_type, index_type>::LocalFieldState(const model_type& model,
+                                                        Iter sample_start)
+        : model_(&model),
+          sample_(sample_start, sample_start + model.num_variables()),
+          fields_(model.num_variables()),
+          squares_(model.num_variables(), 0),
+          energy_(0) {
+    bool binary = true;  // whether the energy can skip the 0-valued variables
+    for (index_type v = 0; static_cast<size_type>(v) < num_variables(); ++v) {
+        binary = binary && model.vartype(v) == Vartype::BINARY;
+
+        bias_type field = model.linear(v);
+        for (auto it = model.cbegin_neighborhood(v); it != model.cend_neighborhood(v); ++it) {
+            if (it->v == v) {
+                squares_[v] = it->bias;
+            } else {
+                field += it->bias * sample_[it->v];
+            }
+        }
+        fields_[v] = field;
+    }
+
+    energy_ = binary ? model.template energy<Vartype::BINARY>(sample_.cbegin())
+                     : model.energy(sample_.cbegin());
+}
+
+template <class bias_type, class index_type>
+void LocalFieldState<bias_type, index_type>::apply(index_type v, bias_type value) {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+
+    if (value < model_->lower_bound(v) || value > model_->upper_bound(v)) {
+        throw std::out_of_range("value is outside the bounds of the variable");
+    }
+
+    energy_ += delta(v, value);
+
+    bias_type change = value - sample_[v];
+    for (auto it = model_->cbegin_neighborhood(v); it != model_->cend_neighborhood(v); ++it) {
+        if (it->v != v) fields_[it->v] += it->bias * change;
+    }
+
+    sample_[v] = value;
+}
+
+template <class bias_type, class index_type>
+bias_type LocalFieldState<bias_type, index_type>::delta(index_type v, bias_type value) const {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    bias_type old = sample_[v];
+    return (value - old) * fields_[v] + squares_[v] * (value * value - old * old);
+}
+
+template <class bias_type, class index_type>
+bias_type LocalFieldState<bias_type, index_type>::delta_flip(index_type v) const {
+    return delta(v, flipped_value(v));
+}
+
+template <class bias_type, class index_type>
+bias_type LocalFieldState<bias_type, index_type>::energy() const {
+    return energy_;
+}
+
+template <class bias_type, class index_type>
+bias_type LocalFieldState<bias_type, index_type>::flip(index_type v) {
+    bias_type value = flipped_value(v);
+    apply(v, value);
+    return value;
+}
+
+template <class bias_type, class index_type>
+bias_type LocalFieldState<bias_type, index_type>::flipped_value(index_type v) const {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+
+    Vartype vartype = model_->vartype(v);
+    if (vartype != Vartype::BINARY && vartype != Vartype::SPIN) {
+        throw std::logic_error("only BINARY and SPIN variables can be flipped");
+    }
+
+    // 0 <-> 1 for BINARY and -1 <-> +1 for SPIN
+    return vartype_info<bias_type>::min(vartype) + vartype_info<bias_type>::max(vartype) -
+           sample_[v];
+}
+
+template <class bias_type, class index_type>
+bias_type LocalFieldState<bias_type, index_type>::local_field(index_type v) const {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    return fields_[v];
+}
+
+template <class bias_type, class index_type>
+auto LocalFieldState<bias_type, index_type>::model() const -> const model_type& {
+    return *model_;
+}
+
+template <class bias_type, class index_type>
+std::size_t LocalFieldState<bias_type, index_type>::num_variables() const {
+    return sample_.size();
+}
+
+template <class bias_type, class index_type>
+const std::vector<bias_type>& LocalFieldState<bias_type, index_type>::sample() const {
+    return sample_;
+}
+
+template <class bias_type, class index_type>
+bias_type LocalFieldState<bias_type, index_type>::value(index_type v) const {
+    assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    return sample_[v];
+}
+
+}  // namespace dimod
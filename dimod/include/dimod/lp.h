@@ -0,0 +1,1774 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+// The tokenizer and grammar are adapted from filereaderlp, the LP file reader
+// from HiGHS, which is distributed under the following license:
+//
+// Copyright (c) 2020 Michael Feldmeier
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/fileview.h"
+#include "dimod/utils.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+namespace lp {
+
+/// A constrained quadratic model read from an LP file, along with its labels.
+template <class Bias, class Index>
+struct LPModel {
+    /// The model. Maximization objectives are negated.
+    ConstrainedQuadraticModel<Bias, Index> model;
+
+    /// The name of each variable in the model, in order.
+    std::vector<std::string> variable_labels;
+
+    /// The name of each constraint in the model, in order. Empty for unnamed constraints.
+    std::vector<std::string> constraint_labels;
+};
+
+/**
+ * Read a constrained quadratic model from the `length` bytes of `data`,
+ * formatted as an LP file.
+ *
+ * The constraints are tokenized and parsed in chunks of about `chunk_size`
+ * bytes, divided between up to `num_threads` threads, see
+ * utils::parallel_for().
+ * Each chunk is written directly into the model before the next batch of
+ * chunks is parsed, so the memory used besides the model itself is bounded
+ * by the number of threads. `data` does not need to be null-terminated.
+ *
+ * Variables are added to the model in the order they first appear in the
+ * objective, the constraints, and then the remaining sections.
+ *
+ * # Exceptions
+ * Throws `std::invalid_argument` if `data` is not a valid LP file, or
+ * `std::domain_error` if it uses semi-continuous variables.
+ */
+template <class Bias, class Index = int>
+LPModel<Bias, Index> read(const char* data, std::size_t length, int num_threads = 1,
+                          std::size_t chunk_size = 1 << 20);
+
+/**
+ * Read a constrained quadratic model from the LP file at `filename`.
+ *
+ * The file is memory-mapped rather than read into memory. See `read()`.
+ *
+ * # Exceptions
+ * Throws `std::runtime_error` if the file cannot be opened, as well as the
+ * exceptions thrown by `read()`.
+ */
+template <class Bias, class Index = int>
+LPModel<Bias, Index> read_file(const std::string& filename, int num_threads = 1);
+
+/// The file formats that a model can be written as.
+enum Format {
+    LP,  ///< The LP file format, as read by `read()`.
+    MPS  ///< The free MPS format, with QUADOBJ and QCMATRIX sections for quadratic terms.
+};
+
+/**
+ * Write a constrained quadratic model to `os` as an LP or MPS file.
+ *
+ * Variables and constraints are named by `variable_labels` and
+ * `constraint_labels`. If those are empty the names default to "v0", "v1",
+ * ... and "c0", "c1", ... The labels are written as given, so they must be
+ * valid names for the format. Output is buffered internally and written to
+ * `os` in large blocks.
+ *
+ * # Exceptions
+ * Throws `std::invalid_argument` if the model has soft constraints or `SPIN`
+ * variables, or if the number of labels does not match the model.
+ */
+template <class Bias, class Index>
+void dump(const ConstrainedQuadraticModel<Bias, Index>& cqm, std::ostream& os,
+          const std::vector<std::string>& variable_labels = {},
+          const std::vector<std::string>& constraint_labels = {}, Format format = Format::LP);
+
+/// Write a constrained quadratic model to a string as an LP or MPS file. See `dump()`.
+template <class Bias, class Index>
+std::string dumps(const ConstrainedQuadraticModel<Bias, Index>& cqm,
+                  const std::vector<std::string>& variable_labels = {},
+                  const std::vector<std::string>& constraint_labels = {},
+                  Format format = Format::LP);
+
+/// Write a constrained quadratic model to the file at `filename`. See `dump()`.
+template <class Bias, class Index>
+void dump_file(const ConstrainedQuadraticModel<Bias, Index>& cqm, const std::string& filename,
+               const std::vector<std::string>& variable_labels = {},
+               const std::vector<std::string>& constraint_labels = {},
+               Format format = Format::LP);
+
+/// @private  <- don't doc
+namespace detail {
+
+inline void lpassert(bool condition, const char* message) {
+    if (!condition) throw std::invalid_argument(std::string("illegal LP file format: ") + message);
+}
+
+// A name in the file, not owned
+struct Name {
+    const char* data;
+    std::size_t size;
+
+    std::string str() const { return std::string(data, size); }
+};
+
+struct NameHash {
+    std::size_t operator()(const Name& name) const {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < name.size; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(name.data[i])) * 1099511628211ull;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+};
+
+struct NameEqual {
+    bool operator()(const Name& a, const Name& b) const {
+        return a.size == b.size && !std::memcmp(a.data, b.data, a.size);
+    }
+};
+
+template <class T>
+using NameMap = std::unordered_map<Name, T, NameHash, NameEqual>;
+
+// Compare the name to a lower-case keyword, ignoring case
+inline bool iequals(const Name& name, const char* keyword) {
+    std::size_t i = 0;
+    for (; i < name.size && keyword[i]; ++i) {
+        if (std::tolower(static_cast<unsigned char>(name.data[i])) != keyword[i]) return false;
+    }
+    return i == name.size && !keyword[i];
+}
+
+enum class RawType {
+    STR,
+    CONS,
+    LESS,
+    GREATER,
+    EQUAL,
+    COLON,
+    FLEND,
+    BRKOP,
+    BRKCL,
+    PLUS,
+    MINUS,
+    HAT,
+    SLASH,
+    ASTERISK
+};
+
+struct RawToken {
+    RawType type;
+    double value;
+    const char* begin;
+    const char* end;
+
+    bool istype(RawType t) const { return type == t; }
+};
+
+// Splits the characters into raw tokens. Only tokens that start before
+// `limit` are returned, but they may extend to `end`.
+class Lexer {
+ public:
+    Lexer(const char* begin, const char* limit, const char* end)
+            : pos_(begin), limit_(limit), end_(end) {}
+
+    RawToken next();
+
+ private:
+    const char* pos_;
+    const char* limit_;
+    const char* end_;
+
+    RawToken make(RawType type, std::size_t length) {
+        RawToken token{type, 0, pos_, pos_ + length};
+        pos_ += length;
+        return token;
+    }
+
+    static bool is_delimiter(char c) {
+        switch (c) {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+            case '\\':
+            case ':':
+            case '+':
+            case '-':
+            case '<':
+            case '>':
+            case '^':
+            case '=':
+            case '/':
+            case '*':
+            case '[':
+            case ']':
+            case '\0':
+                return true;
+            default:
+                return false;
+        }
+    }
+};
+
+inline RawToken Lexer::next() {
+    while (pos_ < limit_) {
+        switch (*pos_) {
+            // comments and ; run to the end of the line
+            case '\\':
+            case ';': {
+                const void* newline = std::memchr(pos_, '\n', end_ - pos_);
+                pos_ = newline ? static_cast<const char*>(newline) : end_;
+                continue;
+            }
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+            case '\0':
+                ++pos_;
+                continue;
+            case '[':
+                return make(RawType::BRKOP, 1);
+            case ']':
+                return make(RawType::BRKCL, 1);
+            case '<':
+                return make(RawType::LESS, 1);
+            case '>':
+                return make(RawType::GREATER, 1);
+            case '=':
+                return make(RawType::EQUAL, 1);
+            case ':':
+                return make(RawType::COLON, 1);
+            case '+':
+                return make(RawType::PLUS, 1);
+            case '^':
+                return make(RawType::HAT, 1);
+            case '/':
+                return make(RawType::SLASH, 1);
+            case '*':
+                return make(RawType::ASTERISK, 1);
+            case '-':
+                return make(RawType::MINUS, 1);
+        }
+
+        // numbers, including inf and nan. The data is not necessarily
+        // null-terminated so we copy the candidate into a buffer for strtod
+        const char c = std::tolower(static_cast<unsigned char>(*pos_));
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.' || c == 'i' || c == 'n') {
+            char buffer[64];
+            std::size_t n = 0;
+            while (n + 1 < sizeof(buffer) && pos_ + n < end_ &&
+                   (!is_delimiter(pos_[n]) || pos_[n] == '+' || pos_[n] == '-')) {
+                buffer[n] = pos_[n];
+                ++n;
+            }
+            buffer[n] = '\0';
+
+            char* last;
+            double value = std::strtod(buffer, &last);
+            if (last != buffer) {
+                RawToken token = make(RawType::CONS, last - buffer);
+                token.value = value;
+                return token;
+            }
+        }
+
+        // everything else is a (section/variable/constraint) identifier
+        std::size_t n = 1;
+        while (pos_ + n < end_ && !is_delimiter(pos_[n])) ++n;
+        return make(RawType::STR, n);
+    }
+
+    return RawToken{RawType::FLEND, 0, end_, end_};
+}
+
+enum class Section { NONE, OBJMIN, OBJMAX, CON, BOUNDS, GEN, BIN, SEMI, SOS, END };
+
+enum class Comparison { LEQ, L, EQ, G, GEQ };
+
+enum class TokenType {
+    END,  // the end of the tokens
+    SECID,
+    VARID,
+    CONID,
+    CONST,
+    FREE,
+    BRKOP,
+    BRKCL,
+    COMP,
+    SLASH,
+    ASTERISK,
+    HAT,
+    SOSTYPE
+};
+
+struct Token {
+    TokenType type;
+    Section section;
+    Comparison comparison;
+    double value;
+    Name name;
+
+    // where the token is in the data
+    const char* begin;
+    const char* end;
+
+    bool istype(TokenType t) const { return type == t; }
+};
+
+inline Section section_keyword(const Name& name) {
+    static const std::pair<const char*, Section> keywords[] = {
+            {"minimize", Section::OBJMIN}, {"min", Section::OBJMIN},
+            {"minimum", Section::OBJMIN},  {"maximize", Section::OBJMAX},
+            {"max", Section::OBJMAX},      {"maximum", Section::OBJMAX},
+            {"st", Section::CON},          {"s.t.", Section::CON},
+            {"bounds", Section::BOUNDS},   {"bound", Section::BOUNDS},
+            {"binary", Section::BIN},      {"binaries", Section::BIN},
+            {"bin", Section::BIN},         {"general", Section::GEN},
+            {"generals", Section::GEN},    {"gen", Section::GEN},
+            {"integer", Section::GEN},     {"integers", Section::GEN},
+            {"semi", Section::SEMI},       {"semis", Section::SEMI},
+            {"sos", Section::SOS},         {"end", Section::END}};
+
+    if (name.size > 8) return Section::NONE;  // longest keyword
+    for (const auto& keyword : keywords) {
+        if (iequals(name, keyword.first)) return keyword.second;
+    }
+    return Section::NONE;
+}
+
+// Combines raw tokens into the tokens used by the parser, e.g. signs with
+// constants and identifiers with colons into constraint names.
+class Tokenizer {
+ public:
+    explicit Tokenizer(Lexer lexer) : lexer_(lexer) {
+        for (auto& raw : raw_) raw = lexer_.next();
+    }
+
+    Token next();
+
+    /// Whether any /* */ comments have been skipped.
+    bool skipped_comments() const { return skipped_comments_; }
+
+ private:
+    Lexer lexer_;
+    RawToken raw_[3];
+    bool skipped_comments_ = false;
+
+    void advance(std::size_t n = 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            raw_[0] = raw_[1];
+            raw_[1] = raw_[2];
+            raw_[2] = lexer_.next();
+        }
+    }
+
+    const char* name_end(std::size_t i) const { return raw_[i].end; }
+};
+
+inline Token Tokenizer::next() {
+    while (true) {
+        Token token{TokenType::END, Section::NONE, Comparison::EQ, 0, Name{nullptr, 0},
+                    raw_[0].begin, raw_[0].end};
+
+        if (raw_[0].istype(RawType::FLEND)) return token;
+
+        // slash + asterisk: comment, skip everything up to next asterisk + slash
+        if (raw_[0].istype(RawType::SLASH) && raw_[1].istype(RawType::ASTERISK)) {
+            skipped_comments_ = true;
+            advance(2);
+            while (!(raw_[0].istype(RawType::ASTERISK) && raw_[1].istype(RawType::SLASH)) &&
+                   !raw_[0].istype(RawType::FLEND)) {
+                advance();
+            }
+            advance(2);
+            continue;
+        }
+
+        if (raw_[0].istype(RawType::STR)) {
+            const Name name{raw_[0].begin, static_cast<std::size_t>(raw_[0].end - raw_[0].begin)};
+
+            // long section keywords
+            if (raw_[1].istype(RawType::MINUS) && raw_[2].istype(RawType::STR) &&
+                iequals(name, "semi") &&
+                iequals(Name{raw_[2].begin, static_cast<std::size_t>(raw_[2].end - raw_[2].begin)},
+                        "continuous")) {
+                token.type = TokenType::SECID;
+                token.section = Section::SEMI;
+                token.end = name_end(2);
+                advance(3);
+                return token;
+            }
+            if (raw_[1].istype(RawType::STR)) {
+                const Name second{raw_[1].begin,
+                                  static_cast<std::size_t>(raw_[1].end - raw_[1].begin)};
+                if ((iequals(name, "subject") && iequals(second, "to")) ||
+                    (iequals(name, "such") && iequals(second, "that"))) {
+                    token.type = TokenType::SECID;
+                    token.section = Section::CON;
+                    token.end = name_end(1);
+                    advance(2);
+                    return token;
+                }
+            }
+
+            // other section keywords
+            Section section = section_keyword(name);
+            if (section != Section::NONE) {
+                token.type = TokenType::SECID;
+                token.section = section;
+                advance();
+                return token;
+            }
+
+            // sos type identifier, "S1 ::" or "S2 ::"
+            if (raw_[1].istype(RawType::COLON) && raw_[2].istype(RawType::COLON)) {
+                lpassert(name.size == 2 && (name.data[0] == 'S' || name.data[0] == 's') &&
+                                 (name.data[1] == '1' || name.data[1] == '2'),
+                         "expected an SOS type");
+                token.type = TokenType::SOSTYPE;
+                token.value = name.data[1] - '0';
+                token.end = name_end(2);
+                advance(3);
+                return token;
+            }
+
+            // constraint identifier
+            if (raw_[1].istype(RawType::COLON)) {
+                token.type = TokenType::CONID;
+                token.name = name;
+                token.end = name_end(1);
+                advance(2);
+                return token;
+            }
+
+            if (iequals(name, "free")) {
+                token.type = TokenType::FREE;
+                advance();
+                return token;
+            }
+
+            if (iequals(name, "infinity") || iequals(name, "inf")) {
+                token.type = TokenType::CONST;
+                token.value = std::numeric_limits<double>::infinity();
+                advance();
+                return token;
+            }
+
+            // assume variable identifier
+            token.type = TokenType::VARID;
+            token.name = name;
+            advance();
+            return token;
+        }
+
+        // + or -
+        if (raw_[0].istype(RawType::PLUS) || raw_[0].istype(RawType::MINUS)) {
+            double sign = raw_[0].istype(RawType::PLUS) ? 1.0 : -1.0;
+            advance();
+
+            // another + or -
+            if (raw_[0].istype(RawType::PLUS) || raw_[0].istype(RawType::MINUS)) {
+                sign *= raw_[0].istype(RawType::PLUS) ? 1.0 : -1.0;
+                advance();
+            }
+
+            // +/- constant
+            if (raw_[0].istype(RawType::CONS)) {
+                token.type = TokenType::CONST;
+                token.value = sign * raw_[0].value;
+                token.end = raw_[0].end;
+                advance();
+                return token;
+            }
+
+            // + [, + + [, - - [
+            lpassert(!raw_[0].istype(RawType::BRKOP) || sign == 1.0,
+                     "quadratic terms cannot be negated");
+            if (raw_[0].istype(RawType::BRKOP)) {
+                token.type = TokenType::BRKOP;
+                token.end = raw_[0].end;
+                advance();
+                return token;
+            }
+
+            // +/- variable name, the name is the next token
+            lpassert(raw_[0].istype(RawType::STR), "expected a constant or a variable after a sign");
+            token.type = TokenType::CONST;
+            token.value = sign;
+            token.end = raw_[0].begin;
+            return token;
+        }
+
+        switch (raw_[0].type) {
+            case RawType::CONS:
+                lpassert(!raw_[1].istype(RawType::BRKOP), "quadratic terms cannot be scaled");
+                token.type = TokenType::CONST;
+                token.value = raw_[0].value;
+                advance();
+                return token;
+            case RawType::BRKOP:
+                token.type = TokenType::BRKOP;
+                advance();
+                return token;
+            case RawType::BRKCL:
+                token.type = TokenType::BRKCL;
+                advance();
+                return token;
+            case RawType::SLASH:
+                token.type = TokenType::SLASH;
+                advance();
+                return token;
+            case RawType::ASTERISK:
+                token.type = TokenType::ASTERISK;
+                advance();
+                return token;
+            case RawType::HAT:
+                token.type = TokenType::HAT;
+                advance();
+                return token;
+            case RawType::LESS:
+            case RawType::GREATER:
+            case RawType::EQUAL: {
+                token.type = TokenType::COMP;
+                const bool less = raw_[0].istype(RawType::LESS) ||
+                                  (raw_[0].istype(RawType::EQUAL) && raw_[1].istype(RawType::LESS));
+                const bool greater =
+                        raw_[0].istype(RawType::GREATER) ||
+                        (raw_[0].istype(RawType::EQUAL) && raw_[1].istype(RawType::GREATER));
+                const bool equal = raw_[0].istype(RawType::EQUAL) || raw_[1].istype(RawType::EQUAL);
+                const bool pair = (less || greater) && equal;
+
+                if (less) {
+                    token.comparison = pair ? Comparison::LEQ : Comparison::L;
+                } else if (greater) {
+                    token.comparison = pair ? Comparison::GEQ : Comparison::G;
+                } else {
+                    token.comparison = Comparison::EQ;
+                }
+                token.end = raw_[pair ? 1 : 0].end;
+                advance(pair ? 2 : 1);
+                return token;
+            }
+            default:
+                lpassert(false, "unexpected symbol");
+        }
+    }
+}
+
+// Tokens with lookahead
+class TokenStream {
+ public:
+    // Tokenize [begin, end), skipping any repeats of the `section` keyword
+    TokenStream(const char* begin, const char* end, Section section = Section::NONE)
+            : tokenizer_(Lexer(begin, end, end)), section_(section) {}
+
+    bool done() { return peek().istype(TokenType::END); }
+
+    const Token& peek(std::size_t i = 0) {
+        while (buffer_.size() <= i) {
+            Token token = tokenizer_.next();
+            if (section_ != Section::NONE && token.istype(TokenType::SECID) &&
+                token.section == section_) {
+                continue;
+            }
+            buffer_.push_back(token);
+        }
+        return buffer_[i];
+    }
+
+    void pop(std::size_t n = 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            peek();
+            buffer_.pop_front();
+        }
+    }
+
+ private:
+    Tokenizer tokenizer_;
+    Section section_;
+    std::deque<Token> buffer_;
+};
+
+// Parse an expression, calling sink.name(), sink.linear(), sink.quadratic()
+// and sink.offset() for its parts. In the objective, quadratic terms are
+// written as [ ... ] / 2.
+template <class Sink>
+void parse_expression(TokenStream& tokens, Sink& sink, bool is_objective) {
+    if (tokens.peek().istype(TokenType::CONID)) {
+        sink.name(tokens.peek().name);
+        tokens.pop();
+    }
+
+    while (true) {
+        const Token& token = tokens.peek();
+
+        // const var
+        if (token.istype(TokenType::CONST) && tokens.peek(1).istype(TokenType::VARID)) {
+            sink.linear(tokens.peek(1).name, token.value);
+            tokens.pop(2);
+            continue;
+        }
+
+        // const
+        if (token.istype(TokenType::CONST)) {
+            sink.offset(token.value);
+            tokens.pop();
+            continue;
+        }
+
+        // var
+        if (token.istype(TokenType::VARID)) {
+            sink.linear(token.name, 1);
+            tokens.pop();
+            continue;
+        }
+
+        // quadratic expression
+        if (token.istype(TokenType::BRKOP)) {
+            tokens.pop();
+            while (!tokens.peek().istype(TokenType::BRKCL) && !tokens.done()) {
+                const Token& t0 = tokens.peek(0);
+                const Token& t1 = tokens.peek(1);
+                const Token& t2 = tokens.peek(2);
+                const Token& t3 = tokens.peek(3);
+
+                // const var hat const
+                if (t0.istype(TokenType::CONST) && t1.istype(TokenType::VARID) &&
+                    t2.istype(TokenType::HAT) && t3.istype(TokenType::CONST)) {
+                    lpassert(t3.value == 2, "only squares are supported");
+                    sink.quadratic(t1.name, t1.name, t0.value);
+                    tokens.pop(4);
+                    continue;
+                }
+
+                // var hat const
+                if (t0.istype(TokenType::VARID) && t1.istype(TokenType::HAT) &&
+                    t2.istype(TokenType::CONST)) {
+                    lpassert(t2.value == 2, "only squares are supported");
+                    sink.quadratic(t0.name, t0.name, 1);
+                    tokens.pop(3);
+                    continue;
+                }
+
+                // const var asterisk var
+                if (t0.istype(TokenType::CONST) && t1.istype(TokenType::VARID) &&
+                    t2.istype(TokenType::ASTERISK) && t3.istype(TokenType::VARID)) {
+                    sink.quadratic(t1.name, t3.name, t0.value);
+                    tokens.pop(4);
+                    continue;
+                }
+
+                // var asterisk var
+                if (t0.istype(TokenType::VARID) && t1.istype(TokenType::ASTERISK) &&
+                    t2.istype(TokenType::VARID)) {
+                    sink.quadratic(t0.name, t2.name, 1);
+                    tokens.pop(3);
+                    continue;
+                }
+
+                break;
+            }
+
+            lpassert(tokens.peek().istype(TokenType::BRKCL), "expected ]");
+            if (is_objective) {
+                // only in the objective function, a quadratic term is followed by "/2"
+                lpassert(tokens.peek(1).istype(TokenType::SLASH) &&
+                                 tokens.peek(2).istype(TokenType::CONST) &&
+                                 tokens.peek(2).value == 2,
+                         "expected ] / 2");
+                tokens.pop(3);
+            } else {
+                tokens.pop();
+            }
+            continue;
+        }
+
+        break;
+    }
+}
+
+// The (contiguous) sections of the file
+struct Span {
+    const char* begin;
+    const char* end;
+};
+
+struct Sections {
+    std::vector<std::pair<Section, Span>> spans;
+
+    // the constraint section is split into chunks at the end of constraints
+    std::vector<Span> constraint_chunks;
+
+    // return the span of section, or an empty span if it is not present
+    Span find(Section section) const {
+        for (const auto& span : spans) {
+            if (span.first == section) return span.second;
+        }
+        return Span{nullptr, nullptr};
+    }
+};
+
+// What a quick pass over one piece of the file found
+struct PieceInfo {
+    // section keywords and the characters they span
+    std::vector<Token> keywords;
+
+    // positions just after "<comparison> <constant>", the first after the
+    // start of the piece and the first after each keyword
+    std::vector<const char*> splits;
+
+    // whether the piece has /* */ comments or could not be tokenized on its
+    // own, in which case the whole file is scanned sequentially
+    bool sequential = false;
+};
+
+// Tokenize the lines in [begin, end) of the data, recording section
+// keywords and where constraints may end. If `strict` then errors are
+// thrown, otherwise the piece is marked as needing a sequential scan.
+inline void scan(const char* begin, const char* end, const char* data_end, PieceInfo& info,
+                 bool strict = false) {
+    try {
+        // tokens may cross into the next piece, but must start in this one
+        Tokenizer tokenizer{Lexer(begin, data_end, data_end)};
+
+        bool comparison = false;  // whether the last token was a comparison
+        bool seek = true;         // whether we're looking for a split
+        bool slash = false;       // whether the last token was a slash or asterisk
+        bool first = true;
+        for (Token token = tokenizer.next(); token.begin < end && !token.istype(TokenType::END);
+             token = tokenizer.next()) {
+            // The piece may start inside of a /* */ comment, in which case
+            // there will be a leftover "*/". In a valid file "*" and "/"
+            // are never next to each other.
+            if (token.istype(TokenType::SLASH) || token.istype(TokenType::ASTERISK)) {
+                if (slash || first) info.sequential = true;
+                slash = true;
+            } else {
+                slash = false;
+            }
+            first = false;
+
+            if (token.istype(TokenType::SECID)) {
+                info.keywords.push_back(token);
+                seek = true;
+            } else if (seek && comparison && token.istype(TokenType::CONST)) {
+                info.splits.push_back(token.end);
+                seek = false;
+            }
+
+            comparison = token.istype(TokenType::COMP);
+        }
+        if (slash || tokenizer.skipped_comments()) info.sequential = true;
+    } catch (const std::invalid_argument&) {
+        // the piece might start partway through a token sequence, let the
+        // sequential pass decide whether the file is valid
+        if (strict) throw;
+        info.sequential = true;
+    }
+}
+
+// Find the sections of the file, and split the constraints section into chunks
+inline Sections find_sections(const char* data, std::size_t length, int num_threads,
+                              std::size_t chunk_size) {
+    const char* end = data + length;
+
+    // divide the data into pieces at line boundaries
+    std::vector<const char*> starts;
+    starts.push_back(data);
+    for (std::size_t offset = chunk_size; offset < length; offset += chunk_size) {
+        const char* pos = std::max(data + offset, starts.back());
+        if (pos >= end) break;
+        const void* newline = std::memchr(pos, '\n', end - pos);
+        if (!newline) break;
+        const char* start = static_cast<const char*>(newline) + 1;
+        if (start < end) starts.push_back(start);
+    }
+    starts.push_back(end);
+
+    std::vector<PieceInfo> pieces(starts.size() - 1);
+    utils::parallel_for(pieces.size(), num_threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) scan(starts[i], starts[i + 1], end, pieces[i]);
+    });
+
+    bool sequential = false;
+    for (const auto& piece : pieces) sequential = sequential || piece.sequential;
+    if (sequential) {
+        // start over from the beginning, this time letting any exceptions propagate
+        pieces.assign(1, PieceInfo());
+        scan(data, end, end, pieces[0], true);
+    }
+
+    // the sections, merging consecutive repeats of the same keyword
+    Sections sections;
+    Section current = Section::NONE;
+    const char* current_begin = data;
+    for (const auto& piece : pieces) {
+        for (const auto& keyword : piece.keywords) {
+            if (keyword.section == current) continue;  // e.g. "general x general y"
+
+            sections.spans.emplace_back(current, Span{current_begin, keyword.begin});
+            current = keyword.section;
+            current_begin = keyword.end;
+        }
+    }
+    sections.spans.emplace_back(current, Span{current_begin, end});
+
+    for (std::size_t i = 0; i < sections.spans.size(); ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            lpassert(sections.spans[i].first != sections.spans[j].first,
+                     "sections cannot be repeated");
+        }
+    }
+
+    // split the constraints at the ends of constraints
+    Span constraints = sections.find(Section::CON);
+    if (constraints.begin) {
+        const char* chunk_begin = constraints.begin;
+        for (const auto& piece : pieces) {
+            for (const char* split : piece.splits) {
+                if (split > chunk_begin && split < constraints.end) {
+                    sections.constraint_chunks.push_back(Span{chunk_begin, split});
+                    chunk_begin = split;
+                }
+            }
+        }
+        sections.constraint_chunks.push_back(Span{chunk_begin, constraints.end});
+    }
+
+    return sections;
+}
+
+enum class VariableType { CONTINUOUS, BINARY, GENERAL, SEMICONTINUOUS, SEMIINTEGER };
+
+struct VariableInfo {
+    VariableType type = VariableType::CONTINUOUS;
+    double lower_bound = 0;
+    double upper_bound = std::numeric_limits<double>::infinity();
+};
+
+// The variables declared in the bounds, general, binary, semi-continuous and
+// sos sections
+struct VariableDeclarations {
+    NameMap<VariableInfo> info;
+
+    // the variables in the order they first appear in these sections
+    std::vector<Name> order;
+
+    VariableInfo& operator[](const Name& name) {
+        auto it = info.find(name);
+        if (it == info.end()) {
+            it = info.emplace(name, VariableInfo()).first;
+            order.push_back(name);
+        }
+        return it->second;
+    }
+};
+
+inline void parse_bounds(TokenStream& tokens, VariableDeclarations& variables) {
+    const double inf = std::numeric_limits<double>::infinity();
+
+    while (!tokens.done()) {
+        const Token& t0 = tokens.peek(0);
+        const Token& t1 = tokens.peek(1);
+
+        // VAR free
+        if (t0.istype(TokenType::VARID) && t1.istype(TokenType::FREE)) {
+            VariableInfo& info = variables[t0.name];
+            info.lower_bound = -inf;
+            info.upper_bound = +inf;
+            tokens.pop(2);
+            continue;
+        }
+
+        const Token& t2 = tokens.peek(2);
+        const Token& t3 = tokens.peek(3);
+        const Token& t4 = tokens.peek(4);
+
+        // CONST COMP VAR COMP CONST
+        if (t0.istype(TokenType::CONST) && t1.istype(TokenType::COMP) &&
+            t2.istype(TokenType::VARID) && t3.istype(TokenType::COMP) &&
+            t4.istype(TokenType::CONST)) {
+            lpassert(t1.comparison == Comparison::LEQ && t3.comparison == Comparison::LEQ,
+                     "double bounds must use <=");
+            VariableInfo& info = variables[t2.name];
+            info.lower_bound = t0.value;
+            info.upper_bound = t4.value;
+            tokens.pop(5);
+            continue;
+        }
+
+        // CONST COMP VAR and VAR COMP CONST
+        const bool constant_first = t0.istype(TokenType::CONST) && t2.istype(TokenType::VARID);
+        const bool variable_first = t0.istype(TokenType::VARID) && t2.istype(TokenType::CONST);
+        lpassert((constant_first || variable_first) && t1.istype(TokenType::COMP),
+                 "could not parse bound");
+        lpassert(t1.comparison != Comparison::L && t1.comparison != Comparison::G,
+                 "bounds must use <=, >= or =");
+
+        VariableInfo& info = variables[constant_first ? t2.name : t0.name];
+        const double value = constant_first ? t0.value : t2.value;
+        if (t1.comparison == Comparison::EQ) {
+            info.lower_bound = info.upper_bound = value;
+        } else if ((t1.comparison == Comparison::LEQ) == constant_first) {
+            info.lower_bound = value;
+        } else {
+            info.upper_bound = value;
+        }
+        tokens.pop(3);
+    }
+}
+
+inline void parse_types(TokenStream& tokens, VariableDeclarations& variables, Section section) {
+    for (; !tokens.done(); tokens.pop()) {
+        lpassert(tokens.peek().istype(TokenType::VARID), "expected a variable");
+        VariableInfo& info = variables[tokens.peek().name];
+
+        switch (section) {
+            case Section::BIN:
+                info.type = VariableType::BINARY;
+                // respect any bounds already declared
+                if (info.upper_bound == std::numeric_limits<double>::infinity()) {
+                    info.upper_bound = 1;
+                }
+                break;
+            case Section::GEN:
+                info.type = (info.type == VariableType::SEMICONTINUOUS)
+                                    ? VariableType::SEMIINTEGER
+                                    : VariableType::GENERAL;
+                break;
+            case Section::SEMI:
+                info.type = (info.type == VariableType::GENERAL) ? VariableType::SEMIINTEGER
+                                                                 : VariableType::SEMICONTINUOUS;
+                break;
+            default:
+                assert(false);
+        }
+    }
+}
+
+// SOS constraints are not supported by the CQM, but their variables are
+inline void parse_sos(TokenStream& tokens, VariableDeclarations& variables) {
+    while (!tokens.done()) {
+        // sos1: S1 :: x1 : 1  x2 : 2  x3 : 3
+        lpassert(tokens.peek(0).istype(TokenType::CONID), "SOS constraints must be named");
+        lpassert(tokens.peek(1).istype(TokenType::SOSTYPE), "expected an SOS type");
+        tokens.pop(2);
+
+        // the variables look like constraint names because they are followed by a colon
+        while (tokens.peek(0).istype(TokenType::CONID) &&
+               tokens.peek(1).istype(TokenType::CONST)) {
+            variables[tokens.peek(0).name];
+            tokens.pop(2);
+        }
+    }
+}
+
+// Adds the variables to the model as they are encountered
+template <class Bias, class Index>
+class VariableBuilder {
+ public:
+    VariableBuilder(ConstrainedQuadraticModel<Bias, Index>& cqm,
+                    const VariableDeclarations& declarations)
+            : cqm_(cqm), declarations_(declarations) {}
+
+    Index index(const Name& name) {
+        auto it = indices_.find(name);
+        if (it != indices_.end()) return it->second;
+
+        VariableInfo info;
+        auto dit = declarations_.info.find(name);
+        if (dit != declarations_.info.end()) info = dit->second;
+
+        Vartype vartype;
+        switch (info.type) {
+            case VariableType::CONTINUOUS:
+                vartype = Vartype::REAL;
+                break;
+            case VariableType::BINARY:
+                vartype = Vartype::BINARY;
+                break;
+            case VariableType::GENERAL:
+                vartype = Vartype::INTEGER;
+                break;
+            default:
+                throw std::domain_error("unsupported vartype");
+        }
+
+        // clip the bounds to those supported by the vartype
+        const Bias min_bound = vartype_info<Bias>::min(vartype);
+        const Bias max_bound = vartype_info<Bias>::max(vartype);
+        const Bias lb = std::min(std::max<Bias>(info.lower_bound, min_bound), max_bound);
+        const Bias ub = std::min(std::max<Bias>(info.upper_bound, min_bound), max_bound);
+
+        Index v = cqm_.add_variable(vartype, lb, ub);
+        indices_.emplace(name, v);
+        labels_.push_back(name);
+        return v;
+    }
+
+    const std::vector<Name>& labels() const { return labels_; }
+
+ private:
+    ConstrainedQuadraticModel<Bias, Index>& cqm_;
+    const VariableDeclarations& declarations_;
+    NameMap<Index> indices_;
+    std::vector<Name> labels_;
+};
+
+// Writes the objective directly into the model
+template <class Bias, class Index>
+struct ObjectiveSink {
+    VariableBuilder<Bias, Index>& variables;
+    Expression<Bias, Index>& objective;
+
+    void name(const Name&) {}
+    void linear(const Name& v, double bias) { objective.add_linear(variables.index(v), bias); }
+    void quadratic(const Name& u, const Name& v, double bias) {
+        // index() adds new variables, so look them up in order of appearance
+        Index ui = variables.index(u);
+        Index vi = variables.index(v);
+
+        // [ ... ] / 2
+        objective.add_quadratic(ui, vi, bias / 2);
+    }
+    void offset(double bias) { objective.add_offset(bias); }
+};
+
+// The constraints in one chunk of the constraint section, using variable
+// indices local to the chunk so that chunks can be parsed concurrently
+template <class Bias, class Index>
+struct ConstraintChunk {
+    struct Term {
+        Index u;
+        Index v;
+        Bias bias;
+    };
+
+    struct Row {
+        Name label;
+        Sense sense;
+        Bias rhs;
+        Bias offset;
+        std::size_t linear_end;
+        std::size_t quadratic_end;
+    };
+
+    std::vector<Row> rows;
+    std::vector<std::pair<Index, Bias>> linear;
+    std::vector<Term> quadratic;
+
+    // local index -> name, in the order they first appear
+    std::vector<Name> variables;
+    NameMap<Index> indices;
+
+    // local index -> model index, filled in once all of the chunks before
+    // this one have been added to the model
+    std::vector<Index> mapping;
+
+    Index index(const Name& name) {
+        auto it = indices.emplace(name, static_cast<Index>(variables.size()));
+        if (it.second) variables.push_back(name);
+        return it.first->second;
+    }
+
+    void name(const Name& label) { rows.back().label = label; }
+    void linear_term(const Name& v, double bias) { linear.emplace_back(index(v), bias); }
+    void quadratic_term(const Name& u, const Name& v, double bias) {
+        Index ui = index(u);
+        quadratic.push_back(Term{ui, index(v), static_cast<Bias>(bias)});
+    }
+
+    void parse(const Span& span) {
+        struct Sink {
+            ConstraintChunk& chunk;
+            void name(const Name& label) { chunk.name(label); }
+            void linear(const Name& v, double bias) { chunk.linear_term(v, bias); }
+            void quadratic(const Name& u, const Name& v, double bias) {
+                chunk.quadratic_term(u, v, bias);
+            }
+            void offset(double bias) { chunk.rows.back().offset += bias; }
+        } sink{*this};
+
+        TokenStream tokens(span.begin, span.end, Section::CON);
+        while (!tokens.done()) {
+            rows.push_back(Row{Name{nullptr, 0}, Sense::EQ, 0, 0, 0, 0});
+
+            parse_expression(tokens, sink, false);
+
+            // a comparison operator and then the right-hand side should be next
+            const Token& comparison = tokens.peek(0);
+            const Token& rhs = tokens.peek(1);
+            lpassert(comparison.istype(TokenType::COMP), "expected a comparison");
+            lpassert(rhs.istype(TokenType::CONST), "expected a constant right-hand side");
+
+            Row& row = rows.back();
+            switch (comparison.comparison) {
+                case Comparison::EQ:
+                    row.sense = Sense::EQ;
+                    break;
+                case Comparison::LEQ:
+                    row.sense = Sense::LE;
+                    break;
+                case Comparison::GEQ:
+                    row.sense = Sense::GE;
+                    break;
+                default:
+                    lpassert(false, "constraints must use <=, >= or =");
+            }
+            row.rhs = rhs.value;
+            row.linear_end = linear.size();
+            row.quadratic_end = quadratic.size();
+            tokens.pop(2);
+        }
+
+        // the names all point into the data so we can free the map
+        NameMap<Index>().swap(indices);
+    }
+
+    // Add the rows to the model as constraints `first`, `first + 1`, ...
+    void write(ConstrainedQuadraticModel<Bias, Index>& cqm, std::size_t first) const {
+        std::size_t l = 0;
+        std::size_t q = 0;
+        for (std::size_t r = 0; r < rows.size(); ++r) {
+            const Row& row = rows[r];
+            auto& constraint = cqm.constraint_ref(first + r);
+
+            for (; l < row.linear_end; ++l) {
+                constraint.add_linear(mapping[linear[l].first], linear[l].second);
+            }
+            for (; q < row.quadratic_end; ++q) {
+                constraint.add_quadratic(mapping[quadratic[q].u], mapping[quadratic[q].v],
+                                         quadratic[q].bias);
+            }
+            constraint.add_offset(row.offset);
+            constraint.set_sense(row.sense);
+            constraint.set_rhs(row.rhs);
+        }
+    }
+};
+
+// Buffers output to a stream, tracking the length of the current line
+class OutputBuffer {
+ public:
+    explicit OutputBuffer(std::ostream& os) : os_(os) { buffer_.reserve(CAPACITY + 1024); }
+
+    ~OutputBuffer() { flush(); }
+
+    void flush() {
+        os_.write(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+
+    std::size_t line_length() const { return line_length_; }
+
+    OutputBuffer& operator<<(char c) {
+        buffer_.push_back(c);
+        line_length_ = (c == '\n') ? 0 : line_length_ + 1;
+        return *this;
+    }
+
+    OutputBuffer& operator<<(const char* s) { return write(s, std::strlen(s)); }
+
+    OutputBuffer& operator<<(const std::string& s) { return write(s.data(), s.size()); }
+
+    // doubles are written with the fewest digits needed to read them back exactly
+    OutputBuffer& operator<<(double value) {
+        char buffer[32];
+        return write(buffer, format_number(value, buffer));
+    }
+
+    OutputBuffer& write(const char* s, std::size_t n) {
+        buffer_.append(s, n);
+        const void* newline = std::memchr(s, '\n', n);
+        if (newline) {
+            const char* last = s + n;
+            while (*(last - 1) != '\n') --last;
+            line_length_ = s + n - last;
+        } else {
+            line_length_ += n;
+        }
+        if (buffer_.size() >= CAPACITY) flush();
+        return *this;
+    }
+
+    // Write at most 40 characters, called for every number in the output
+    static std::size_t format_number(double value, char* buffer) {
+        // integers, the overwhelmingly common case, are formatted by hand
+        if (value == std::trunc(value) && std::abs(value) < 9007199254740992.0) {  // 2**53
+            std::int64_t integer = static_cast<std::int64_t>(value);
+            std::uint64_t magnitude = (integer < 0) ? -static_cast<std::uint64_t>(integer)
+                                                    : static_cast<std::uint64_t>(integer);
+            char digits[20];
+            std::size_t n = 0;
+            do {
+                digits[n++] = '0' + magnitude % 10;
+                magnitude /= 10;
+            } while (magnitude);
+
+            std::size_t length = 0;
+            if (integer < 0) buffer[length++] = '-';
+            while (n) buffer[length++] = digits[--n];
+            return length;
+        }
+
+        if (std::isinf(value)) {
+            std::strcpy(buffer, (value < 0) ? "-inf" : "inf");
+            return std::strlen(buffer);
+        }
+
+        // otherwise use the shortest of 15, 16 or 17 significant digits that round-trips
+        int length = 0;
+        for (int precision = 15; precision <= 17; ++precision) {
+            length = std::snprintf(buffer, 32, "%.*g", precision, value);
+            if (std::strtod(buffer, nullptr) == value) break;
+        }
+        return length;
+    }
+
+ private:
+    static constexpr std::size_t CAPACITY = 1 << 20;
+
+    std::ostream& os_;
+    std::string buffer_;
+    std::size_t line_length_ = 0;
+};
+
+// The names of the variables or constraints, either given or generated
+class Names {
+ public:
+    Names(const std::vector<std::string>& labels, std::size_t size, char prefix)
+            : labels_(&labels) {
+        if (labels.empty()) {
+            generated_.reserve(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                generated_.emplace_back(prefix + std::to_string(i));
+            }
+            labels_ = &generated_;
+        } else if (labels.size() != size) {
+            throw std::invalid_argument("the number of labels does not match the model");
+        }
+    }
+
+    const std::string& operator[](std::size_t i) const { return (*labels_)[i]; }
+
+    const std::vector<std::string>& labels() const { return *labels_; }
+
+ private:
+    const std::vector<std::string>* labels_;
+    std::vector<std::string> generated_;
+};
+
+template <class Bias, class Index>
+void check_writable(const ConstrainedQuadraticModel<Bias, Index>& cqm) {
+    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+        if (cqm.constraint_ref(c).is_soft()) {
+            throw std::invalid_argument("soft constraints cannot be written to LP or MPS files");
+        }
+    }
+    for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+        if (cqm.vartype(v) == Vartype::SPIN) {
+            throw std::invalid_argument(
+                    "SPIN variables cannot be written to LP or MPS files, convert them to BINARY "
+                    "beforehand");
+        }
+    }
+}
+
+// LP files have a maximum line length, so long expressions are wrapped
+constexpr std::size_t TARGET_LINE_LENGTH = 80;
+
+inline void wrap(OutputBuffer& out, std::size_t length) {
+    if (out.line_length() + length > TARGET_LINE_LENGTH - 1) out << "\n ";
+}
+
+inline void write_term(OutputBuffer& out, double bias, const std::string& u) {
+    char number[32];
+    std::size_t n = OutputBuffer::format_number(std::abs(bias), number);
+    wrap(out, n + u.size() + 4);
+    out << ((bias < 0) ? "- " : "+ ");
+    out.write(number, n) << ' ' << u << ' ';
+}
+
+inline void write_term(OutputBuffer& out, double bias, const std::string& u,
+                       const std::string& v) {
+    char number[32];
+    std::size_t n = OutputBuffer::format_number(std::abs(bias), number);
+    wrap(out, n + u.size() + v.size() + 7);
+    out << ((bias < 0) ? "- " : "+ ");
+    out.write(number, n) << ' ' << u << " * " << v << ' ';
+}
+
+// Write the terms of the expression, multiplying the quadratic biases
+template <class Bias, class Index>
+void write_lp_terms(OutputBuffer& out, const Expression<Bias, Index>& expression,
+                    const Names& variables, bool is_objective) {
+    const abc::QuadraticModelBase<Bias, Index>& base = expression;
+
+    for (std::size_t i = 0; i < expression.num_variables(); ++i) {
+        const Bias bias = base.linear(i);
+        if (bias) write_term(out, bias, variables[expression.variables()[i]]);
+    }
+
+    if (expression.num_interactions()) {
+        out << "+ [ ";
+        for (auto it = expression.cbegin_quadratic(); it != expression.cend_quadratic(); ++it) {
+            // in the objective, quadratic terms are divided by two outside of the brackets
+            write_term(out, is_objective ? 2 * static_cast<double>(it->bias) : it->bias,
+                       variables[it->u], variables[it->v]);
+        }
+        out << (is_objective ? "]/2 " : "] ");
+    }
+}
+
+template <class Bias, class Index>
+void dump_lp(const ConstrainedQuadraticModel<Bias, Index>& cqm, OutputBuffer& out,
+             const std::vector<std::string>& variable_labels,
+             const std::vector<std::string>& constraint_labels) {
+    Names variables(variable_labels, cqm.num_variables(), 'v');
+    Names constraints(constraint_labels, cqm.num_constraints(), 'c');
+
+    // LP files allow the objective to be omitted if it is empty
+    const auto& objective = cqm.objective;
+    bool empty = !objective.offset() && !objective.num_interactions();
+    for (std::size_t i = 0; empty && i < objective.num_variables(); ++i) {
+        empty = !objective.linear(objective.variables()[i]);
+    }
+    if (!empty) {
+        out << "Minimize\n obj: ";
+        write_lp_terms(out, objective, variables, true);
+        if (objective.offset()) {
+            char number[32];
+            std::size_t n = OutputBuffer::format_number(std::abs(objective.offset()), number);
+            wrap(out, n + 3);
+            out << ((objective.offset() < 0) ? "- " : "+ ");
+            out.write(number, n) << ' ';
+        }
+    }
+
+    out << "\n\nSubject To \n";
+    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+        const auto& constraint = cqm.constraint_ref(c);
+
+        out << ' ' << constraints[c] << ": ";
+        write_lp_terms(out, constraint, variables, false);
+
+        switch (constraint.sense()) {
+            case Sense::LE:
+                out << " <= ";
+                break;
+            case Sense::GE:
+                out << " >= ";
+                break;
+            case Sense::EQ:
+                out << " = ";
+                break;
+        }
+        out << static_cast<double>(constraint.rhs() - constraint.offset()) << '\n';
+    }
+
+    out << "\nBounds\n";
+    for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+        if (cqm.vartype(v) == Vartype::BINARY) continue;
+        out << ' ' << static_cast<double>(cqm.lower_bound(v)) << " <= " << variables[v]
+            << " <= " << static_cast<double>(cqm.upper_bound(v)) << '\n';
+    }
+
+    for (Vartype vartype : {Vartype::BINARY, Vartype::INTEGER}) {
+        out << ((vartype == Vartype::BINARY) ? "\nBinary\n" : "\nGeneral\n");
+        for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+            if (cqm.vartype(v) != vartype) continue;
+            const std::string& name = variables[v];
+            wrap(out, name.size() + 1);
+            out << ' ' << name;
+        }
+    }
+
+    out << "\nEnd";
+}
+
+template <class Bias, class Index>
+void dump_mps(const ConstrainedQuadraticModel<Bias, Index>& cqm, OutputBuffer& out,
+              const std::vector<std::string>& variable_labels,
+              const std::vector<std::string>& constraint_labels) {
+    Names variables(variable_labels, cqm.num_variables(), 'v');
+    Names constraints(constraint_labels, cqm.num_constraints(), 'c');
+
+    // the objective row needs a name distinct from the constraints
+    std::string objective_name = "obj";
+    while (std::find(constraints.labels().begin(), constraints.labels().end(), objective_name) !=
+           constraints.labels().end()) {
+        objective_name += '_';
+    }
+
+    out << "NAME\nROWS\n N  " << objective_name << '\n';
+    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+        switch (cqm.constraint_ref(c).sense()) {
+            case Sense::LE:
+                out << " L  ";
+                break;
+            case Sense::GE:
+                out << " G  ";
+                break;
+            case Sense::EQ:
+                out << " E  ";
+                break;
+        }
+        out << constraints[c] << '\n';
+    }
+
+    // MPS files are column-major, so we transpose the linear biases of the
+    // constraints into (constraint, bias) pairs for each variable. Index -1
+    // is the objective.
+    std::vector<std::size_t> starts(cqm.num_variables() + 1, 0);
+    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+        for (const auto& v : cqm.constraint_ref(c).variables()) ++starts[v + 1];
+    }
+    for (std::size_t v = 0; v < cqm.num_variables(); ++v) starts[v + 1] += starts[v];
+
+    std::vector<std::pair<std::size_t, double>> entries(starts.back());
+    {
+        std::vector<std::size_t> positions(starts.begin(), starts.end() - 1);
+        for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+            const auto& constraint = cqm.constraint_ref(c);
+            const abc::QuadraticModelBase<Bias, Index>& base = constraint;
+            for (std::size_t i = 0; i < constraint.num_variables(); ++i) {
+                entries[positions[constraint.variables()[i]]++] = {c, base.linear(i)};
+            }
+        }
+    }
+
+    std::vector<double> objective(cqm.num_variables(), 0);
+    {
+        const abc::QuadraticModelBase<Bias, Index>& base = cqm.objective;
+        for (std::size_t i = 0; i < cqm.objective.num_variables(); ++i) {
+            objective[cqm.objective.variables()[i]] = base.linear(i);
+        }
+    }
+
+    out << "COLUMNS\n";
+    bool integer = false;  // whether we're between integer markers
+    for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+        const bool is_integer = cqm.vartype(v) != Vartype::REAL;
+        if (is_integer != integer) {
+            out << "    MARKER  'MARKER'  " << (is_integer ? "'INTORG'\n" : "'INTEND'\n");
+            integer = is_integer;
+        }
+
+        const std::string& name = variables[v];
+
+        // every variable is written at least once so that it is declared
+        bool written = false;
+        if (objective[v] || starts[v] == starts[v + 1]) {
+            out << "    " << name << "  " << objective_name << "  " << objective[v] << '\n';
+            written = true;
+        }
+        for (std::size_t i = starts[v]; i < starts[v + 1]; ++i) {
+            if (!entries[i].second && (written || i + 1 < starts[v + 1])) continue;
+            out << "    " << name << "  " << constraints[entries[i].first] << "  "
+                << entries[i].second << '\n';
+            written = true;
+        }
+    }
+    if (integer) out << "    MARKER  'MARKER'  'INTEND'\n";
+
+    // the objective's offset is the negative of its right-hand side
+    out << "RHS\n";
+    if (cqm.objective.offset()) {
+        out << "    RHS  " << objective_name << "  " << -static_cast<double>(cqm.objective.offset())
+            << '\n';
+    }
+    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+        const auto& constraint = cqm.constraint_ref(c);
+        const double rhs = constraint.rhs() - constraint.offset();
+        if (rhs) out << "    RHS  " << constraints[c] << "  " << rhs << '\n';
+    }
+
+    out << "BOUNDS\n";
+    for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+        const std::string& name = variables[v];
+        if (cqm.vartype(v) == Vartype::BINARY) {
+            out << " BV BND  " << name << '\n';
+            continue;
+        }
+
+        // bounds at or beyond the limits of the vartype are written as infinite
+        const double lb = cqm.lower_bound(v);
+        const double ub = cqm.upper_bound(v);
+        const bool unbounded_below = lb <= vartype_info<Bias>::min(cqm.vartype(v));
+        const bool unbounded_above = ub >= vartype_info<Bias>::max(cqm.vartype(v));
+
+        if (unbounded_below && unbounded_above) {
+            out << " FR BND  " << name << '\n';
+            continue;
+        }
+
+        if (unbounded_below) {
+            out << " MI BND  " << name << '\n';
+        } else {
+            out << " LO BND  " << name << "  " << lb << '\n';
+        }
+        if (unbounded_above) {
+            out << " PL BND  " << name << '\n';
+        } else {
+            out << " UP BND  " << name << "  " << ub << '\n';
+        }
+    }
+
+    // the objective is c'x + 1/2 x'Qx, with only the upper triangle of Q given
+    if (cqm.objective.num_interactions()) {
+        out << "QUADOBJ\n";
+        for (auto it = cqm.objective.cbegin_quadratic(); it != cqm.objective.cend_quadratic();
+             ++it) {
+            const double bias = (it->u == it->v) ? 2 * static_cast<double>(it->bias) : it->bias;
+            out << "    " << variables[std::min(it->u, it->v)] << "  "
+                << variables[std::max(it->u, it->v)] << "  " << bias << '\n';
+        }
+    }
+
+    // the quadratic part of each constraint is x'Qx, with all of Q given
+    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+        const auto& constraint = cqm.constraint_ref(c);
+        if (!constraint.num_interactions()) continue;
+
+        out << "QCMATRIX  " << constraints[c] << '\n';
+        for (auto it = constraint.cbegin_quadratic(); it != constraint.cend_quadratic(); ++it) {
+            const std::string& name_u = variables[it->u];
+            const std::string& name_v = variables[it->v];
+            if (it->u == it->v) {
+                out << "    " << name_u << "  " << name_u << "  " << static_cast<double>(it->bias)
+                    << '\n';
+            } else {
+                const double bias = static_cast<double>(it->bias) / 2;
+                out << "    " << name_u << "  " << name_v << "  " << bias << '\n';
+                out << "    " << name_v << "  " << name_u << "  " << bias << '\n';
+            }
+        }
+    }
+
+    out << "ENDATA\n";
+}
+
+}  // namespace detail
+
+template <class Bias, class Index>
+LPModel<Bias, Index> read(const char* data, std::size_t length, int num_threads,
+                          std::size_t chunk_size) {
+    using namespace detail;
+
+    LPModel<Bias, Index> lp;
+    auto& cqm = lp.model;
+
+    const Sections sections = find_sections(data, length, num_threads, chunk_size);
+
+    for (const auto& section : sections.spans) {
+        if (section.first == Section::NONE || section.first == Section::END) {
+            TokenStream tokens(section.second.begin, section.second.end);
+            lpassert(tokens.done(), "unexpected tokens outside of a section");
+        }
+    }
+
+    // the variable declarations come last in the file but we need them before
+    // we can add any variables to the model
+    VariableDeclarations declarations;
+    {
+        Span span = sections.find(Section::BOUNDS);
+        TokenStream tokens(span.begin, span.end, Section::BOUNDS);
+        parse_bounds(tokens, declarations);
+    }
+    for (Section section : {Section::GEN, Section::BIN, Section::SEMI}) {
+        Span span = sections.find(section);
+        TokenStream tokens(span.begin, span.end, section);
+        parse_types(tokens, declarations, section);
+    }
+    {
+        Span span = sections.find(Section::SOS);
+        TokenStream tokens(span.begin, span.end, Section::SOS);
+        parse_sos(tokens, declarations);
+    }
+
+    VariableBuilder<Bias, Index> variables(cqm, declarations);
+
+    // the objective
+    Span objective = sections.find(Section::OBJMIN);
+    const bool maximize = !objective.begin && sections.find(Section::OBJMAX).begin;
+    if (maximize) objective = sections.find(Section::OBJMAX);
+    {
+        ObjectiveSink<Bias, Index> sink{variables, cqm.objective};
+        TokenStream tokens(objective.begin, objective.end);
+        parse_expression(tokens, sink, true);
+        lpassert(tokens.done(), "could not parse the objective");
+    }
+
+    // the constraints, one batch of chunks at a time
+    const std::vector<Span>& chunks = sections.constraint_chunks;
+    const std::size_t batch_size = std::max<std::size_t>(
+            (num_threads < 1) ? std::thread::hardware_concurrency() : num_threads, 1);
+
+    std::vector<ConstraintChunk<Bias, Index>> batch;
+    for (std::size_t first = 0; first < chunks.size(); first += batch_size) {
+        batch.clear();
+        batch.resize(std::min(batch_size, chunks.size() - first));
+
+        std::exception_ptr error;
+        std::mutex mutex;
+        auto capture = [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        };
+
+        utils::parallel_for(batch.size(), num_threads, [&](std::size_t i, std::size_t j) {
+            try {
+                for (; i < j; ++i) batch[i].parse(chunks[first + i]);
+            } catch (...) {
+                capture();
+            }
+        });
+        if (error) std::rethrow_exception(error);
+
+        // add the variables in the order they appear and then the constraints
+        std::size_t c = cqm.num_constraints();
+        std::vector<std::size_t> offsets;
+        for (auto& chunk : batch) {
+            chunk.mapping.reserve(chunk.variables.size());
+            for (const Name& name : chunk.variables) chunk.mapping.push_back(variables.index(name));
+
+            offsets.push_back(c);
+            c += chunk.rows.size();
+            for (const auto& row : chunk.rows) {
+                lp.constraint_labels.emplace_back(row.label.data ? row.label.str() : std::string());
+            }
+        }
+        cqm.add_constraints(c - cqm.num_constraints());
+
+        utils::parallel_for(batch.size(), num_threads, [&](std::size_t i, std::size_t j) {
+            try {
+                for (; i < j; ++i) batch[i].write(cqm, offsets[i]);
+            } catch (...) {
+                capture();
+            }
+        });
+        if (error) std::rethrow_exception(error);
+    }
+
+    // then any variables that only appear in the declarations
+    for (const Name& name : declarations.order) variables.index(name);
+
+    // handle maximization
+    if (maximize) cqm.objective.scale(-1);
+
+    lp.variable_labels.reserve(variables.labels().size());
+    for (const Name& name : variables.labels()) lp.variable_labels.push_back(name.str());
+
+    return lp;
+}
+
+template <class Bias, class Index>
+LPModel<Bias, Index> read_file(const std::string& filename, int num_threads) {
+    {
+        // an empty file cannot be mapped, but it is a valid (empty) LP file
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) throw std::runtime_error("could not open " + filename);
+        if (file.tellg() == 0) return read<Bias, Index>(nullptr, 0, num_threads);
+    }
+
+    fileview::MappedFile file(filename);
+    return read<Bias, Index>(static_cast<const char*>(file.data()), file.size(), num_threads);
+}
+
+template <class Bias, class Index>
+void dump(const ConstrainedQuadraticModel<Bias, Index>& cqm, std::ostream& os,
+          const std::vector<std::string>& variable_labels,
+          const std::vector<std::string>& constraint_labels, Format format) {
+    detail::check_writable(cqm);
+
+    detail::OutputBuffer out(os);
+    switch (format) {
+        case Format::LP:
+            detail::dump_lp(cqm, out, variable_labels, constraint_labels);
+            break;
+        case Format::MPS:
+            detail::dump_mps(cqm, out, variable_labels, constraint_labels);
+            break;
+    }
+}
+
+template <class Bias, class Index>
+std::string dumps(const ConstrainedQuadraticModel<Bias, Index>& cqm,
+                  const std::vector<std::string>& variable_labels,
+                  const std::vector<std::string>& constraint_labels, Format format) {
+    std::ostringstream os;
+    dump(cqm, os, variable_labels, constraint_labels, format);
+    return os.str();
+}
+
+template <class Bias, class Index>
+void dump_file(const ConstrainedQuadraticModel<Bias, Index>& cqm, const std::string& filename,
+               const std::vector<std::string>& variable_labels,
+               const std::vector<std::string>& constraint_labels, Format format) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("could not open " + filename);
+    dump(cqm, file, variable_labels, constraint_labels, format);
+    if (!file) throw std::runtime_error("could not write to " + filename);
+}
+
+}  // namespace lp
+}  // namespace dimod
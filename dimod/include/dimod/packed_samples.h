@@ -0,0 +1,404 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/utils.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+
+/**
+ * A store of BINARY or SPIN samples, packed one bit per variable.
+ *
+ * The bit of a variable is set when its value is positive, so both `{0, 1}`
+ * and `{-1, +1}` samples can be packed. Each sample takes
+ * `num_words()` 64-bit words, an eighth of the memory of one byte per
+ * variable.
+ */
+class PackedSamples {
+ public:
+    /// The type of each packed word.
+    using word_type = std::uint64_t;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Construct an empty store of samples with `num_variables` variables.
+    explicit PackedSamples(size_type num_variables);
+
+    /**
+     * Construct a store from a batch of samples.
+     *
+     * `samples` must point to a row-major array of `num_samples` samples,
+     * each of `num_variables` values. Consecutive samples are `stride`
+     * elements apart.
+     */
+    template <class T>
+    PackedSamples(const T* samples, size_type num_samples, size_type stride,
+                  size_type num_variables);
+
+    /**
+     * Find the distinct samples, in one pass and without sorting.
+     *
+     * Returns the index of the first occurrence of each distinct sample, in
+     * the order they first occur. If `inverse` is not null, the position in
+     * the returned vector of the distinct sample equal to sample `i` is
+     * written to `inverse[i]`, so it must have room for `num_samples()`
+     * values.
+     */
+    std::vector<size_type> aggregate(size_type* inverse = nullptr) const;
+
+    /// Return the value of variable `v` in sample `i` as a bool.
+    bool bit(size_type i, size_type v) const;
+
+    /// Remove all of the samples.
+    void clear();
+
+    /**
+     * Calculate the energies of the samples for `model`.
+     *
+     * The model must have `num_variables()` BINARY or SPIN variables. Each
+     * sample is unpacked into the values of the model's variables in blocks,
+     * and the blocks are passed to `QuadraticModelBase::energies()`. The
+     * energies are written to `out`, which must have room for `num_samples()`
+     * values. The blocks are divided between up to `num_threads` threads, see
+     * utils::parallel_for().
+     */
+    template <class Bias, class Index, class R>
+    void energies(const abc::QuadraticModelBase<Bias, Index>& model, R* out,
+                  int num_threads = 1) const;
+
+    /// Total bytes consumed by the packed samples.
+    size_type nbytes() const;
+
+    /// Return the number of samples in the store.
+    size_type num_samples() const;
+
+    /// Return the number of variables in each sample.
+    size_type num_variables() const;
+
+    /// Return the number of words used by each sample.
+    size_type num_words() const;
+
+    /// Add a sample of `num_variables()` values to the store.
+    template <class T>
+    void push_back(const T* sample);
+
+    /// Return a pointer to the `num_words()` words of sample `i`.
+    const word_type* row(size_type i) const;
+
+    /// Write sample `i` to `out`, using `low` for unset bits and `high` for set ones.
+    template <class T>
+    void unpack(size_type i, T low, T high, T* out) const;
+
+ private:
+    static constexpr size_type WORD_BITS = 64;
+
+    // Unpack the samples a block at a time and calculate their energies.
+    // `value_of(bit, v)` gives the value of variable `v` for its bit.
+    template <class Bias, class Index, class R, class ValueOf>
+    void energies_(const abc::QuadraticModelBase<Bias, Index>& model, R* out, int num_threads,
+                   ValueOf value_of) const;
+
+    size_type num_variables_;
+    size_type num_words_;
+    size_type num_samples_;
+
+    std::vector<word_type> words_;
+};
+
+/**
+ * Find the distinct rows of a batch of BINARY or SPIN samples, in one pass.
+ *
+ * `samples`, `num_samples`, `stride` and `num_variables` are as for the
+ * PackedSamples constructor. Unlike constructing a PackedSamples first, only
+ * the distinct samples are packed and kept. The return value and `inverse` are
+ * as for PackedSamples::aggregate().
+ */
+template <class T>
+std::vector<std::size_t> aggregate_samples(const T* samples, std::size_t num_samples,
+                                           std::size_t stride, std::size_t num_variables,
+                                           std::size_t* inverse = nullptr);
+
+namespace detail {
+
+// An open-addressing hash set of packed rows, each stored once.
+class PackedRowSet {
+ public:
+    using word_type = PackedSamples::word_type;
+    using size_type = std::size_t;
+
+    explicit PackedRowSet(size_type num_words)
+            : num_words_(num_words), table_(16, 0), mask_(15) {
+        assert(num_words > 0);
+    }
+
+    // Return the position of `row` among the distinct rows, adding it if it
+    // is new. `is_new` is set accordingly.
+    size_type insert(const word_type* row, bool& is_new) {
+        size_type slot = hash(row) & mask_;
+        while (table_[slot]) {
+            const size_type position = table_[slot] - 1;
+            if (std::equal(row, row + num_words_, words_.begin() + position * num_words_)) {
+                is_new = false;
+                return position;
+            }
+            slot = (slot + 1) & mask_;
+        }
+
+        const size_type position = size();
+        words_.insert(words_.end(), row, row + num_words_);
+        table_[slot] = position + 1;
+        is_new = true;
+
+        if (2 * size() > table_.size()) grow();
+        return position;
+    }
+
+    size_type size() const { return words_.size() / num_words_; }
+
+ private:
+    size_type hash(const word_type* row) const {
+        std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+        for (size_type w = 0; w < num_words_; ++w) {
+            h ^= row[w] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            h *= 0xbf58476d1ce4e5b9ULL;
+        }
+        return static_cast<size_type>(h ^ (h >> 31));
+    }
+
+    void grow() {
+        std::vector<size_type> table(2 * table_.size(), 0);
+        mask_ = table.size() - 1;
+        for (size_type position = 0; position < size(); ++position) {
+            size_type slot = hash(words_.data() + position * num_words_) & mask_;
+            while (table[slot]) slot = (slot + 1) & mask_;
+            table[slot] = position + 1;
+        }
+        table_.swap(table);
+    }
+
+    size_type num_words_;
+
+    // the distinct rows, in the order they were added
+    std::vector<word_type> words_;
+
+    // the position of a row plus one, or 0 if the slot is empty
+    std::vector<size_type> table_;
+    size_type mask_;
+};
+
+// Pack `num_variables` values into `out`, which must have room for the words.
+template <class T>
+void pack_row(const T* sample, std::size_t num_variables, PackedSamples::word_type* out) {
+    const std::size_t num_words = (num_variables + 63) / 64;
+    for (std::size_t w = 0; w < num_words; ++w) {
+        const std::size_t first = 64 * w;
+        const std::size_t last = std::min(first + 64, num_variables);
+
+        PackedSamples::word_type word = 0;
+        for (std::size_t v = first; v < last; ++v) {
+            word |= static_cast<PackedSamples::word_type>(sample[v] > 0) << (v - first);
+        }
+        out[w] = word;
+    }
+}
+
+}  // namespace detail
+
+inline PackedSamples::PackedSamples(size_type num_variables)
+        : num_variables_(num_variables),
+          num_words_((num_variables + WORD_BITS - 1) / WORD_BITS),
+          num_samples_(0) {}
+
+template <class T>
+PackedSamples::PackedSamples(const T* samples, size_type num_samples, size_type stride,
+                             size_type num_variables)
+        : PackedSamples(num_variables) {
+    assert(stride >= num_variables);
+    words_.resize(num_samples * num_words_);
+    for (size_type i = 0; i < num_samples; ++i) {
+        detail::pack_row(samples + i * stride, num_variables_, words_.data() + i * num_words_);
+    }
+    num_samples_ = num_samples;
+}
+
+inline std::vector<std::size_t> PackedSamples::aggregate(size_type* inverse) const {
+    std::vector<size_type> first;
+
+    if (!num_words_) {
+        // every sample is the empty one
+        if (num_samples()) first.push_back(0);
+        if (inverse) std::fill(inverse, inverse + num_samples(), 0);
+        return first;
+    }
+
+    auto rows = detail::PackedRowSet(num_words_);
+    for (size_type i = 0; i < num_samples(); ++i) {
+        bool is_new;
+        const size_type position = rows.insert(row(i), is_new);
+        if (is_new) first.push_back(i);
+        if (inverse) inverse[i] = position;
+    }
+    return first;
+}
+
+inline bool PackedSamples::bit(size_type i, size_type v) const {
+    assert(i < num_samples() && v < num_variables());
+    return (row(i)[v / WORD_BITS] >> (v % WORD_BITS)) & 1;
+}
+
+inline void PackedSamples::clear() {
+    words_.clear();
+    num_samples_ = 0;
+}
+
+template <class Bias, class Index, class R>
+void PackedSamples::energies(const abc::QuadraticModelBase<Bias, Index>& model, R* out,
+                             int num_threads) const {
+    if (model.num_variables() != num_variables()) {
+        throw std::invalid_argument("the model must have the same number of variables");
+    }
+
+    size_type num_binary = 0;
+    size_type num_spin = 0;
+    for (size_type v = 0; v < num_variables(); ++v) {
+        const Vartype vartype = model.vartype(v);
+        if (vartype == Vartype::BINARY) {
+            ++num_binary;
+        } else if (vartype == Vartype::SPIN) {
+            ++num_spin;
+        } else {
+            throw std::invalid_argument("only BINARY and SPIN variables can be unpacked");
+        }
+    }
+
+    // Models are almost always all BINARY or all SPIN, in which case the
+    // values are computed from the bits rather than looked up per variable.
+    if (num_binary == num_variables()) {
+        energies_(model, out, num_threads,
+                  [](word_type bit, size_type) { return static_cast<Bias>(bit); });
+    } else if (num_spin == num_variables()) {
+        energies_(model, out, num_threads,
+                  [](word_type bit, size_type) { return 2 * static_cast<Bias>(bit) - 1; });
+    } else {
+        std::vector<Bias> low(num_variables());
+        for (size_type v = 0; v < num_variables(); ++v) {
+            low[v] = vartype_info<Bias>::min(model.vartype(v));
+        }
+        // the upper bound is always 1
+        energies_(model, out, num_threads, [&low](word_type bit, size_type v) {
+            return bit ? static_cast<Bias>(1) : low[v];
+        });
+    }
+}
+
+template <class Bias, class Index, class R, class ValueOf>
+void PackedSamples::energies_(const abc::QuadraticModelBase<Bias, Index>& model, R* out,
+                              int num_threads, ValueOf value_of) const {
+    // unpack a block at a time so the unpacked samples stay in cache, fewer
+    // samples than fit in a block get a smaller one
+    const size_type block_size = 64;
+    const size_type num_blocks = (num_samples() + block_size - 1) / block_size;
+    const size_type width = std::min(block_size, num_samples());
+
+    utils::parallel_for(num_blocks, num_threads, [&](size_type first, size_type last) {
+        std::vector<Bias> block(width * num_variables());
+
+        for (size_type b = first; b < last; ++b) {
+            const size_type start = b * block_size;
+            const size_type length = std::min(block_size, num_samples() - start);
+
+            for (size_type si = 0; si < length; ++si) {
+                const word_type* words = row(start + si);
+                Bias* sample = block.data() + si * num_variables();
+
+                for (size_type w = 0; w < num_words_; ++w) {
+                    const size_type offset = WORD_BITS * w;
+                    const size_type end = std::min(offset + WORD_BITS, num_variables_);
+                    for (size_type v = offset; v < end; ++v) {
+                        sample[v] = value_of((words[w] >> (v - offset)) & 1, v);
+                    }
+                }
+            }
+
+            const Bias* samples = num_variables() ? block.data() : nullptr;
+            model.energies(samples, length, num_variables(), out + start);
+        }
+    });
+}
+
+inline std::size_t PackedSamples::nbytes() const { return words_.size() * sizeof(word_type); }
+
+inline std::size_t PackedSamples::num_samples() const { return num_samples_; }
+
+inline std::size_t PackedSamples::num_variables() const { return num_variables_; }
+
+inline std::size_t PackedSamples::num_words() const { return num_words_; }
+
+template <class T>
+void PackedSamples::push_back(const T* sample) {
+    words_.resize(words_.size() + num_words_);
+    detail::pack_row(sample, num_variables_, words_.data() + num_samples_ * num_words_);
+    ++num_samples_;
+}
+
+inline const PackedSamples::word_type* PackedSamples::row(size_type i) const {
+    assert(i < num_samples());
+    return words_.data() + i * num_words_;
+}
+
+template <class T>
+void PackedSamples::unpack(size_type i, T low, T high, T* out) const {
+    for (size_type v = 0; v < num_variables(); ++v) out[v] = bit(i, v) ? high : low;
+}
+
+template <class T>
+std::vector<std::size_t> aggregate_samples(const T* samples, std::size_t num_samples,
+                                           std::size_t stride, std::size_t num_variables,
+                                           std::size_t* inverse) {
+    using size_type = std::size_t;
+
+    const size_type num_words = (num_variables + 63) / 64;
+    std::vector<size_type> first;
+
+    if (!num_words) {
+        if (num_samples) first.push_back(0);
+        if (inverse) std::fill(inverse, inverse + num_samples, 0);
+        return first;
+    }
+
+    auto rows = detail::PackedRowSet(num_words);
+    std::vector<PackedSamples::word_type> packed(num_words);
+    for (size_type i = 0; i < num_samples; ++i) {
+        detail::pack_row(samples + i * stride, num_variables, packed.data());
+
+        bool is_new;
+        const size_type position = rows.insert(packed.data(), is_new);
+        if (is_new) first.push_back(i);
+        if (inverse) inverse[i] = position;
+    }
+    return first;
+}
+
+}  // namespace dimod
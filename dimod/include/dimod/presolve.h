@@ -0,0 +1,712 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+namespace presolve {
+
+/// The presolve techniques. They can be combined as bit flags.
+enum TechniqueFlags : std::uint64_t {
+    NONE = 0,
+    /// Remove variables whose lower and upper bounds are equal.
+    REMOVE_FIXED_VARIABLES = 1 << 0,
+    /// Remove variables that have no bias in the objective or in any constraint.
+    REMOVE_UNUSED_VARIABLES = 1 << 1,
+    /// Remove empty constraints, and replace single-variable linear constraints with bounds.
+    REMOVE_SMALL_CONSTRAINTS = 1 << 2,
+    /// Tighten the bounds of variables using the activity of the linear constraints,
+    /// and remove linear constraints that the bounds already satisfy.
+    TIGHTEN_BOUNDS = 1 << 3,
+    /// Remove linear constraints that are implied by an otherwise identical one.
+    REMOVE_DUPLICATE_CONSTRAINTS = 1 << 4,
+    ALL = ~static_cast<std::uint64_t>(0),
+};
+
+/// The outcome of presolve.
+enum Feasibility {
+    INFEASIBLE,  ///< Presolve proved that no sample satisfies the hard constraints.
+    UNKNOWN,     ///< Presolve did not find a proof of infeasibility.
+};
+
+/**
+ * Restores samples of a presolved model to samples of the original model.
+ *
+ * Each variable of the presolved model is a variable of the original model.
+ * The other variables of the original model were removed with a known value.
+ */
+template <class Bias, class Index = int>
+class Postsolver {
+ public:
+    /// The first template parameter (Bias).
+    using bias_type = Bias;
+
+    /// The second template parameter (Index).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    Postsolver() : Postsolver(0) {}
+
+    /// Construct a postsolver for a model with `num_variables` variables.
+    explicit Postsolver(size_type num_variables)
+            : num_original_variables_(num_variables), variables_(num_variables) {
+        std::iota(variables_.begin(), variables_.end(), 0);
+    }
+
+    /**
+     * Record that some variables of the presolved model were fixed and removed.
+     *
+     * `first` and `last` give the indices in the presolved model, and
+     * `assignment` their values. The remaining variables are reindexed,
+     * preserving their relative order, as by
+     * ConstrainedQuadraticModel::fix_variables().
+     */
+    template <class VarIter, class AssignmentIter>
+    void fix_variables(VarIter first, VarIter last, AssignmentIter assignment) {
+        std::vector<bool> removed(variables_.size(), false);
+        for (auto it = first; it != last; ++it, ++assignment) {
+            assert(*it >= 0 && static_cast<size_type>(*it) < variables_.size());
+            removed[*it] = true;
+            fixed_.emplace_back(variables_[*it], *assignment);
+        }
+
+        size_type i = 0;
+        for (size_type v = 0; v < variables_.size(); ++v) {
+            if (!removed[v]) variables_[i++] = variables_[v];
+        }
+        variables_.resize(i);
+    }
+
+    /// Return the number of variables in the original model.
+    size_type num_original_variables() const { return num_original_variables_; }
+
+    /// Return the number of variables in the presolved model.
+    size_type num_variables() const { return variables_.size(); }
+
+    /// Return the original index of each variable in the presolved model.
+    const std::vector<index_type>& variables() const { return variables_; }
+
+    /// Return a sample of the original model given one of the presolved model.
+    template <class T>
+    std::vector<T> apply(const std::vector<T>& reduced) const {
+        assert(reduced.size() == num_variables());
+        std::vector<T> original(num_original_variables_);
+        apply(reduced.data(), 1, original.data());
+        return original;
+    }
+
+    /**
+     * Restore a batch of samples.
+     *
+     * `samples` must point to a row-major `num_samples` by `num_variables()`
+     * array. The samples of the original model are written as a row-major
+     * `num_samples` by `num_original_variables()` array to `out`.
+     */
+    template <class T>
+    void apply(const T* samples, size_type num_samples, T* out) const {
+        const size_type n = num_variables();
+        for (size_type s = 0; s < num_samples; ++s) {
+            const T* reduced = samples + s * n;
+            T* original = out + s * num_original_variables_;
+
+            for (size_type i = 0; i < n; ++i) {
+                original[variables_[i]] = reduced[i];
+            }
+            for (const auto& fixed : fixed_) {
+                original[fixed.first] = static_cast<T>(fixed.second);
+            }
+        }
+    }
+
+ private:
+    size_type num_original_variables_;
+
+    // the original index of each variable in the presolved model
+    std::vector<index_type> variables_;
+
+    // the original index and value of the removed variables
+    std::vector<std::pair<index_type, bias_type>> fixed_;
+};
+
+/**
+ * Reduce the size of a constrained quadratic model without changing its
+ * feasible region or the energy of any feasible sample.
+ *
+ * Each round of presolve applies every enabled technique once and takes time
+ * linear in the size of the model, apart from sorting the variables of each
+ * constraint when looking for duplicates. Rounds are repeated until nothing
+ * changes or `max_rounds` are done.
+ *
+ * @code
+ * auto presolver = presolve::Presolver<double>(std::move(cqm));
+ * presolver.apply();
+ * auto reduced = presolver.detach_model();
+ * // ... sample the reduced model ...
+ * auto sample = presolver.postsolver().apply(reduced_sample);
+ * @endcode
+ *
+ * Soft constraints are left as-is, except that fixed variables are removed
+ * from them.
+ */
+template <class Bias, class Index = int>
+class Presolver {
+ public:
+    /// The first template parameter (Bias).
+    using bias_type = Bias;
+
+    /// The second template parameter (Index).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    using model_type = ConstrainedQuadraticModel<bias_type, index_type>;
+
+    Presolver() : Presolver(model_type()) {}
+
+    /// Construct a presolver for `model`.
+    explicit Presolver(model_type model)
+            : model_(std::move(model)),
+              postsolver_(model_.num_variables()),
+              techniques_(TechniqueFlags::ALL),
+              feasibility_(Feasibility::UNKNOWN),
+              detached_(false) {}
+
+    /**
+     * Presolve the model.
+     *
+     * Returns Feasibility::INFEASIBLE if the model was found to be infeasible,
+     * in which case presolve stops early and the model should be discarded.
+     *
+     * @exception Throws std::logic_error if the model has been detached.
+     */
+    Feasibility apply(int max_rounds = 10);
+
+    /// Return the model and leave this presolver with an empty one.
+    model_type detach_model() {
+        detached_ = true;
+        return std::move(model_);
+    }
+
+    /// Return the result of the last call to apply().
+    Feasibility feasibility() const { return feasibility_; }
+
+    /// Return a const reference to the model.
+    const model_type& model() const { return model_; }
+
+    /// Return a const reference to the postsolver.
+    const Postsolver<bias_type, index_type>& postsolver() const { return postsolver_; }
+
+    /// Set the techniques used by apply(), as a combination of TechniqueFlags.
+    void set_techniques(std::uint64_t techniques) { techniques_ = techniques; }
+
+    /// Return the techniques used by apply().
+    std::uint64_t techniques() const { return techniques_; }
+
+    /// Tolerance used for feasibility and bound comparisons.
+    bias_type feasibility_tolerance = 1e-6;
+
+ private:
+    using constraint_type = Constraint<bias_type, index_type>;
+
+    // Update the bounds of `v` to be at least `lb`/at most `ub`. Bounds are
+    // rounded for the discrete variable types. Returns whether the bound
+    // changed. Sets feasibility_ if the bounds cross.
+    bool tighten_lower_bound(index_type v, bias_type lb);
+    bool tighten_upper_bound(index_type v, bias_type ub);
+
+    // `a * v` has been bounded by value in the direction given by sense
+    bool tighten_bound(index_type v, bias_type a, Sense sense, bias_type value);
+
+    // Whether the bound of the integer or real variable `v` is at the limit
+    // of what its vartype supports, in which case we treat it as infinite
+    bool infinite_lower_bound(index_type v) const {
+        const Vartype vartype = model_.vartype(v);
+        return (vartype == Vartype::INTEGER || vartype == Vartype::REAL) &&
+               model_.lower_bound(v) <= vartype_info<bias_type>::min(vartype);
+    }
+    bool infinite_upper_bound(index_type v) const {
+        const Vartype vartype = model_.vartype(v);
+        return (vartype == Vartype::INTEGER || vartype == Vartype::REAL) &&
+               model_.upper_bound(v) >= vartype_info<bias_type>::max(vartype);
+    }
+
+    // Remove the constraints flagged in `remove` and return whether there were any.
+    bool remove_constraints(const std::vector<bool>& remove);
+
+    // Each of the techniques, each returns whether it changed the model.
+    bool presolve_constraints();
+    bool presolve_duplicates();
+    bool presolve_fixed();
+    bool presolve_unused();
+
+    // Fix the given variables, in the model and in the postsolver.
+    void fix_variables(const std::vector<index_type>& variables,
+                       const std::vector<bias_type>& assignments);
+
+    model_type model_;
+    Postsolver<bias_type, index_type> postsolver_;
+
+    std::uint64_t techniques_;
+    Feasibility feasibility_;
+    bool detached_;
+};
+
+template <class bias_type, class index_type>
+Feasibility Presolver<bias_type, index_type>::apply(int max_rounds) {
+    if (detached_) throw std::logic_error("model has been detached, so there is nothing to apply");
+
+    feasibility_ = Feasibility::UNKNOWN;
+
+    for (int round = 0; round < max_rounds; ++round) {
+        bool changed = false;
+
+        if (techniques_ & (REMOVE_SMALL_CONSTRAINTS | TIGHTEN_BOUNDS)) {
+            changed |= presolve_constraints();
+            if (feasibility_ == Feasibility::INFEASIBLE) break;
+        }
+        if (techniques_ & REMOVE_DUPLICATE_CONSTRAINTS) {
+            changed |= presolve_duplicates();
+            if (feasibility_ == Feasibility::INFEASIBLE) break;
+        }
+        if (techniques_ & REMOVE_FIXED_VARIABLES) {
+            changed |= presolve_fixed();
+        }
+        if (techniques_ & REMOVE_UNUSED_VARIABLES) {
+            changed |= presolve_unused();
+        }
+
+        if (!changed) break;
+    }
+
+    return feasibility_;
+}
+
+template <class bias_type, class index_type>
+void Presolver<bias_type, index_type>::fix_variables(const std::vector<index_type>& variables,
+                                                     const std::vector<bias_type>& assignments) {
+    assert(variables.size() == assignments.size());
+    if (variables.empty()) return;
+
+    model_ = model_.fix_variables(variables.begin(), variables.end(), assignments.begin());
+    postsolver_.fix_variables(variables.begin(), variables.end(), assignments.begin());
+}
+
+template <class bias_type, class index_type>
+bool Presolver<bias_type, index_type>::presolve_constraints() {
+    const bool remove_small = techniques_ & REMOVE_SMALL_CONSTRAINTS;
+    const bool tighten = techniques_ & TIGHTEN_BOUNDS;
+    const bias_type tol = feasibility_tolerance;
+
+    bool changed = false;
+    std::vector<bool> remove(model_.num_constraints(), false);
+
+    for (size_type c = 0; c < model_.num_constraints(); ++c) {
+        const constraint_type& constraint = model_.constraint_ref(c);
+        if (constraint.is_soft()) continue;
+
+        // we access the underlying quadratic model by index for speed
+        const abc::QuadraticModelBase<bias_type, index_type>& base = constraint;
+        const auto& variables = constraint.variables();
+
+        if (remove_small && constraint.num_variables() == 0) {
+            // the constraint is a constant, so either always or never satisfied
+            if (constraint.violation(constraint.offset()) > tol) {
+                feasibility_ = Feasibility::INFEASIBLE;
+                return changed;
+            }
+            remove[c] = true;
+            continue;
+        }
+
+        if (!constraint.is_linear()) continue;
+
+        const Sense sense = constraint.sense();
+        const bias_type rhs = constraint.rhs() - constraint.offset();
+
+        if (remove_small && constraint.num_variables() == 1) {
+            // a * v (sense) rhs is equivalent to a bound on v
+            const bias_type a = base.linear(0);
+            if (a == 0) {
+                if (constraint.violation(constraint.offset()) > tol) {
+                    feasibility_ = Feasibility::INFEASIBLE;
+                    return changed;
+                }
+            } else {
+                changed |= tighten_bound(variables[0], a, sense, rhs);
+                if (feasibility_ == Feasibility::INFEASIBLE) return changed;
+            }
+            remove[c] = true;
+            continue;
+        }
+
+        if (!tighten) continue;
+
+        // The minimum and maximum activity of the constraint, separated into
+        // the finite part and the number of infinite terms.
+        bias_type min_activity = 0;
+        bias_type max_activity = 0;
+        size_type num_min_infinite = 0;
+        size_type num_max_infinite = 0;
+        for (size_type i = 0; i < variables.size(); ++i) {
+            const index_type v = variables[i];
+            const bias_type a = base.linear(i);
+            if (a > 0) {
+                if (infinite_lower_bound(v)) ++num_min_infinite;
+                else min_activity += a * model_.lower_bound(v);
+                if (infinite_upper_bound(v)) ++num_max_infinite;
+                else max_activity += a * model_.upper_bound(v);
+            } else if (a < 0) {
+                if (infinite_upper_bound(v)) ++num_min_infinite;
+                else min_activity += a * model_.upper_bound(v);
+                if (infinite_lower_bound(v)) ++num_max_infinite;
+                else max_activity += a * model_.lower_bound(v);
+            }
+        }
+
+        const bool check_le = sense != Sense::GE;  // lhs <= rhs
+        const bool check_ge = sense != Sense::LE;  // lhs >= rhs
+
+        // check whether the constraint can ever be satisfied
+        if ((check_le && !num_min_infinite && min_activity > rhs + tol) ||
+            (check_ge && !num_max_infinite && max_activity < rhs - tol)) {
+            feasibility_ = Feasibility::INFEASIBLE;
+            return changed;
+        }
+
+        // check whether the bounds already satisfy the constraint
+        if ((!check_le || (!num_max_infinite && max_activity <= rhs + tol)) &&
+            (!check_ge || (!num_min_infinite && min_activity >= rhs - tol))) {
+            remove[c] = true;
+            continue;
+        }
+
+        // Finally, the activity of the other terms bounds each term. Each
+        // variable appears once, so the activities of the others are exact.
+        for (size_type i = 0; i < variables.size(); ++i) {
+            const index_type v = variables[i];
+            const bias_type a = base.linear(i);
+            if (a == 0) continue;
+
+            // the bounds used for the activities, before we tighten them
+            const bias_type lb = model_.lower_bound(v);
+            const bias_type ub = model_.upper_bound(v);
+            const bool lb_infinite = infinite_lower_bound(v);
+            const bool ub_infinite = infinite_upper_bound(v);
+
+            if (check_le) {
+                // a * v <= rhs - (min activity of the others)
+                const bool infinite = (a > 0) ? lb_infinite : ub_infinite;
+                if (num_min_infinite == 0 || (num_min_infinite == 1 && infinite)) {
+                    bias_type others = min_activity;
+                    if (!infinite) others -= a * ((a > 0) ? lb : ub);
+                    changed |= tighten_bound(v, a, Sense::LE, rhs - others);
+                }
+            }
+            if (check_ge) {
+                // a * v >= rhs - (max activity of the others)
+                const bool infinite = (a > 0) ? ub_infinite : lb_infinite;
+                if (num_max_infinite == 0 || (num_max_infinite == 1 && infinite)) {
+                    bias_type others = max_activity;
+                    if (!infinite) others -= a * ((a > 0) ? ub : lb);
+                    changed |= tighten_bound(v, a, Sense::GE, rhs - others);
+                }
+            }
+            if (feasibility_ == Feasibility::INFEASIBLE) return changed;
+        }
+    }
+
+    changed |= remove_constraints(remove);
+    return changed;
+}
+
+template <class bias_type, class index_type>
+bool Presolver<bias_type, index_type>::presolve_duplicates() {
+    using term_type = std::pair<index_type, bias_type>;
+
+    // A hard linear constraint in a canonical form, with its variables sorted
+    // and the coefficient of the first variable scaled to 1.
+    struct Canonical {
+        std::vector<term_type> terms;
+        Sense sense;
+        bias_type rhs;
+        size_type constraint;
+    };
+
+    const bias_type tol = feasibility_tolerance;
+
+    std::vector<Canonical> canonicals;
+    std::unordered_multimap<std::size_t, size_type> buckets;  // hash -> index in canonicals
+    std::vector<bool> remove(model_.num_constraints(), false);
+
+    for (size_type c = 0; c < model_.num_constraints(); ++c) {
+        const constraint_type& constraint = model_.constraint_ref(c);
+        if (constraint.is_soft() || !constraint.is_linear() || constraint.num_variables() < 2) {
+            continue;
+        }
+
+        const abc::QuadraticModelBase<bias_type, index_type>& base = constraint;
+        const auto& variables = constraint.variables();
+
+        Canonical canonical;
+        canonical.terms.reserve(variables.size());
+        for (size_type i = 0; i < variables.size(); ++i) {
+            if (base.linear(i)) canonical.terms.emplace_back(variables[i], base.linear(i));
+        }
+        if (canonical.terms.empty()) continue;
+        std::sort(canonical.terms.begin(), canonical.terms.end());
+
+        const bias_type pivot = canonical.terms[0].second;
+        std::size_t hash = 0;
+        for (auto& term : canonical.terms) {
+            term.second /= pivot;
+            hash ^= std::hash<index_type>()(term.first) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<bias_type>()(term.second) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        canonical.rhs = (constraint.rhs() - constraint.offset()) / pivot;
+        canonical.sense = constraint.sense();
+        if (pivot < 0 && canonical.sense == Sense::LE) {
+            canonical.sense = Sense::GE;
+        } else if (pivot < 0 && canonical.sense == Sense::GE) {
+            canonical.sense = Sense::LE;
+        }
+        canonical.constraint = c;
+
+        // compare against the constraints we've already seen with the same terms
+        bool keep = true;
+        auto range = buckets.equal_range(hash);
+        for (auto it = range.first; it != range.second && keep; ++it) {
+            Canonical& other = canonicals[it->second];
+            if (other.terms != canonical.terms) continue;
+
+            if (other.sense == canonical.sense && canonical.sense != Sense::EQ) {
+                // keep whichever is tighter
+                const bool tighter = (canonical.sense == Sense::LE) ? canonical.rhs < other.rhs
+                                                                    : canonical.rhs > other.rhs;
+                if (tighter) {
+                    remove[other.constraint] = true;
+                    other.rhs = canonical.rhs;
+                    other.constraint = c;
+                } else {
+                    remove[c] = true;
+                }
+                keep = false;
+            } else if (other.sense == Sense::EQ || canonical.sense == Sense::EQ) {
+                // an equality implies any other constraint it satisfies, and
+                // contradicts any that it doesn't
+                const Canonical& eq = (other.sense == Sense::EQ) ? other : canonical;
+                const Canonical& ineq = (other.sense == Sense::EQ) ? canonical : other;
+
+                bias_type violation;
+                switch (ineq.sense) {
+                    case Sense::LE:
+                        violation = eq.rhs - ineq.rhs;
+                        break;
+                    case Sense::GE:
+                        violation = ineq.rhs - eq.rhs;
+                        break;
+                    default:
+                        violation = std::abs(eq.rhs - ineq.rhs);
+                        break;
+                }
+                if (violation > tol) {
+                    feasibility_ = Feasibility::INFEASIBLE;
+                    return false;
+                }
+
+                remove[ineq.constraint] = true;
+                if (&eq == &canonical) {
+                    // the equality replaces the one we have
+                    other = std::move(canonical);
+                }
+                keep = false;
+            }
+            // otherwise one LE and one GE, we leave both
+        }
+
+        if (keep) {
+            buckets.emplace(hash, canonicals.size());
+            canonicals.emplace_back(std::move(canonical));
+        }
+    }
+
+    return remove_constraints(remove);
+}
+
+template <class bias_type, class index_type>
+bool Presolver<bias_type, index_type>::presolve_fixed() {
+    std::vector<index_type> fixed;
+    std::vector<bias_type> assignments;
+    for (size_type v = 0; v < model_.num_variables(); ++v) {
+        if (model_.lower_bound(v) == model_.upper_bound(v)) {
+            fixed.emplace_back(v);
+            assignments.emplace_back(model_.lower_bound(v));
+        }
+    }
+
+    fix_variables(fixed, assignments);
+    return !fixed.empty();
+}
+
+template <class bias_type, class index_type>
+bool Presolver<bias_type, index_type>::presolve_unused() {
+    std::vector<bool> used(model_.num_variables(), false);
+
+    auto mark = [&used](const Expression<bias_type, index_type>& expression) {
+        const abc::QuadraticModelBase<bias_type, index_type>& base = expression;
+        const auto& variables = expression.variables();
+        for (size_type i = 0; i < variables.size(); ++i) {
+            if (base.linear(i) || base.num_interactions(i)) used[variables[i]] = true;
+        }
+    };
+
+    mark(model_.objective);
+    for (const auto& constraint : model_.constraints()) mark(constraint);
+
+    std::vector<index_type> unused;
+    std::vector<bias_type> assignments;
+    for (size_type v = 0; v < used.size(); ++v) {
+        if (used[v]) continue;
+
+        // any value in the bounds will do, we prefer 0
+        const bias_type lb = model_.lower_bound(v);
+        const bias_type ub = model_.upper_bound(v);
+        bias_type value = std::max(lb, std::min(ub, static_cast<bias_type>(0)));
+        if (model_.vartype(v) == Vartype::SPIN) value = lb;
+
+        unused.emplace_back(v);
+        assignments.emplace_back(value);
+    }
+
+    fix_variables(unused, assignments);
+    return !unused.empty();
+}
+
+template <class bias_type, class index_type>
+bool Presolver<bias_type, index_type>::remove_constraints(const std::vector<bool>& remove) {
+    assert(remove.size() == model_.num_constraints());
+
+    std::unordered_set<const constraint_type*> removed;
+    for (size_type c = 0; c < remove.size(); ++c) {
+        if (remove[c]) removed.insert(&model_.constraint_ref(c));
+    }
+    if (removed.empty()) return false;
+
+    model_.remove_constraints_if(
+            [&removed](const constraint_type& constraint) { return removed.count(&constraint); });
+    return true;
+}
+
+template <class bias_type, class index_type>
+bool Presolver<bias_type, index_type>::tighten_bound(index_type v, bias_type a, Sense sense,
+                                                     bias_type value) {
+    assert(a != 0);
+    const bias_type bound = value / a;
+
+    bool changed = false;
+    if (sense != Sense::GE) {
+        // a * v <= value
+        changed |= (a > 0) ? tighten_upper_bound(v, bound) : tighten_lower_bound(v, bound);
+    }
+    if (sense != Sense::LE) {
+        // a * v >= value
+        changed |= (a > 0) ? tighten_lower_bound(v, bound) : tighten_upper_bound(v, bound);
+    }
+    return changed;
+}
+
+template <class bias_type, class index_type>
+bool Presolver<bias_type, index_type>::tighten_lower_bound(index_type v, bias_type lb) {
+    const bias_type tol = feasibility_tolerance;
+    const bias_type ub = model_.upper_bound(v);
+
+    switch (model_.vartype(v)) {
+        case Vartype::SPIN:
+            lb = (lb > -1 + tol) ? 1 : -1;
+            break;
+        case Vartype::BINARY:
+        case Vartype::INTEGER:
+            lb = std::ceil(lb - tol);
+            break;
+        case Vartype::REAL:
+            break;
+    }
+
+    // only take improvements that are meaningful, otherwise we can end up
+    // tightening the bounds by tiny amounts for many rounds
+    if (lb <= model_.lower_bound(v) + tol * std::max<bias_type>(1, std::abs(lb))) return false;
+
+    if (lb > ub) {
+        if (lb > ub + tol) {
+            feasibility_ = Feasibility::INFEASIBLE;
+            return false;
+        }
+        lb = ub;
+    }
+
+    model_.set_lower_bound(v, lb);
+    return true;
+}
+
+template <class bias_type, class index_type>
+bool Presolver<bias_type, index_type>::tighten_upper_bound(index_type v, bias_type ub) {
+    const bias_type tol = feasibility_tolerance;
+    const bias_type lb = model_.lower_bound(v);
+
+    switch (model_.vartype(v)) {
+        case Vartype::SPIN:
+            ub = (ub < 1 - tol) ? -1 : 1;
+            break;
+        case Vartype::BINARY:
+        case Vartype::INTEGER:
+            ub = std::floor(ub + tol);
+            break;
+        case Vartype::REAL:
+            break;
+    }
+
+    if (ub >= model_.upper_bound(v) - tol * std::max<bias_type>(1, std::abs(ub))) return false;
+
+    if (ub < lb) {
+        if (ub < lb - tol) {
+            feasibility_ = Feasibility::INFEASIBLE;
+            return false;
+        }
+        ub = lb;
+    }
+
+    model_.set_upper_bound(v, ub);
+    return true;
+}
+
+}  // namespace presolve
+}  // namespace dimod
@@ -85,6 +85,10 @@ class QuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
      */
     size_type nbytes(bool capacity = false) const;
 
+    /// Return a breakdown of the heap memory used by the model, including
+    /// the `vartype` info and bounds. See QuadraticModelBase::memory_usage().
+    MemoryUsage memory_usage(bool capacity = false) const;
+
     /// Remove variable `v`.
     void remove_variable(index_type v);
 
@@ -255,6 +259,13 @@ bias_type QuadraticModel<bias_type, index_type>::lower_bound(index_type v) const
     return varinfo_[v].lb;
 }
 
+template <class bias_type, class index_type>
+MemoryUsage QuadraticModel<bias_type, index_type>::memory_usage(bool capacity) const {
+    MemoryUsage usage = base_type::memory_usage(capacity);
+    usage.variables += (capacity ? varinfo_.capacity() : varinfo_.size()) * sizeof(varinfo_type);
+    return usage;
+}
+
 template <class bias_type, class index_type>
 typename QuadraticModel<bias_type, index_type>::size_type
 QuadraticModel<bias_type, index_type>::nbytes(bool capacity) const {
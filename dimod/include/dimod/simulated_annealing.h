@@ -0,0 +1,215 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/utils.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+namespace simulated_annealing {
+
+/**
+ * Return the default beta range of a model with BINARY and SPIN variables.
+ *
+ * The range begins at 0.1 and ends at twice the largest total absolute bias,
+ * linear plus quadratic, of any variable when the model is written as an Ising
+ * model. This matches `dimod.SimulatedAnnealingSampler`.
+ *
+ * Throws `std::invalid_argument` if the model has a variable that is neither
+ * BINARY nor SPIN.
+ */
+template <class Bias, class Index>
+std::pair<double, double> default_beta_range(const abc::QuadraticModelBase<Bias, Index>& model);
+
+/**
+ * Return `num_sweeps` values of beta that increase linearly from `beta_init` to `beta_final`.
+ *
+ * A single sweep is done at `beta_final`.
+ */
+inline std::vector<double> linear_beta_schedule(double beta_init, double beta_final,
+                                                std::size_t num_sweeps);
+
+/**
+ * Sample from a model with BINARY and SPIN variables using simulated annealing.
+ *
+ * Each read begins at a uniformly random sample and does one sweep per value
+ * in `betas`. A sweep proposes flipping each variable in turn and accepts the
+ * flip with the Metropolis probability `min(1, exp(-beta * delta))`, where
+ * `delta` is the energy change, read from the cached local field of the
+ * variable. The neighborhoods are copied into compressed sparse row (CSR)
+ * arrays first, so the model does not need to be frozen.
+ *
+ * The samples are written as a row-major `num_reads` by `num_variables()`
+ * array to `samples` and their energies to `energies`. Every read has its
+ * own random number stream, derived from `seed` and the index of the read, so
+ * the results do not depend on the number of threads. The reads are divided
+ * between up to `num_threads` threads, see utils::parallel_for().
+ *
+ * Throws `std::invalid_argument` if the model has a variable that is neither
+ * BINARY nor SPIN.
+ */
+template <class Bias, class Index, class T>
+void sample(const abc::QuadraticModelBase<Bias, Index>& model, const std::vector<double>& betas,
+            std::size_t num_reads, std::uint64_t seed, T* samples, Bias* energies,
+            int num_threads = 1);
+
+namespace detail {
+
+template <class Bias, class Index>
+void check_vartypes(const abc::QuadraticModelBase<Bias, Index>& model) {
+    for (Index v = 0; static_cast<std::size_t>(v) < model.num_variables(); ++v) {
+        if (model.vartype(v) != Vartype::BINARY && model.vartype(v) != Vartype::SPIN) {
+            throw std::invalid_argument("only BINARY and SPIN variables can be annealed");
+        }
+    }
+}
+
+}  // namespace detail
+
+template <class Bias, class Index>
+std::pair<double, double> default_beta_range(const abc::QuadraticModelBase<Bias, Index>& model) {
+    detail::check_vartypes(model);
+
+    const std::size_t n = model.num_variables();
+
+    // the Ising biases, for x = (s + 1) / 2 a BINARY quadratic bias b
+    // becomes b / 4 and contributes b / 4 to the linear bias of each end
+    std::vector<double> sigmas(n, 0);
+    for (Index v = 0; static_cast<std::size_t>(v) < n; ++v) {
+        double linear = model.linear(v);
+        if (model.vartype(v) == Vartype::BINARY) linear /= 2;
+
+        for (auto it = model.cbegin_neighborhood(v); it != model.cend_neighborhood(v); ++it) {
+            if (it->v == v) {
+                // s*s == 1 and x*x == x, neither is an interaction
+                if (model.vartype(v) == Vartype::BINARY) linear += it->bias / 2.;
+                continue;
+            }
+
+            double bias = it->bias;
+            if (model.vartype(v) == Vartype::BINARY) bias /= 2;
+            if (model.vartype(it->v) == Vartype::BINARY) {
+                linear += bias / 2;
+                bias /= 2;
+            }
+            sigmas[v] += std::abs(bias);
+        }
+        sigmas[v] += std::abs(linear);
+    }
+
+    double beta_final = sigmas.empty() ? 0 : 2 * *std::max_element(sigmas.begin(), sigmas.end());
+    return std::make_pair(.1, beta_final);
+}
+
+inline std::vector<double> linear_beta_schedule(double beta_init, double beta_final,
+                                                std::size_t num_sweeps) {
+    std::vector<double> betas(num_sweeps, beta_final);
+    for (std::size_t i = 0; i + 1 < num_sweeps; ++i) {
+        betas[i] = beta_init + i * (beta_final - beta_init) / (num_sweeps - 1.);
+    }
+    return betas;
+}
+
+template <class Bias, class Index, class T>
+void sample(const abc::QuadraticModelBase<Bias, Index>& model, const std::vector<double>& betas,
+            std::size_t num_reads, std::uint64_t seed, T* samples, Bias* energies,
+            int num_threads) {
+    using size_type = std::size_t;
+
+    detail::check_vartypes(model);
+
+    const size_type n = model.num_variables();
+
+    // pack the neighborhoods, self-loops only change the linear bias (x*x == x)
+    // or the offset (s*s == 1), so they are left out
+    std::vector<size_type> row_ptr(n + 1, 0);
+    std::vector<Index> col;
+    std::vector<Bias> data;
+    std::vector<Bias> linear(n);
+    std::vector<Bias> low(n);
+    std::vector<Bias> high(n);
+    col.reserve(2 * model.num_interactions());
+    data.reserve(2 * model.num_interactions());
+    bool binary = true;  // whether the final energies can skip the 0-valued variables
+    for (Index v = 0; static_cast<size_type>(v) < n; ++v) {
+        binary = binary && model.vartype(v) == Vartype::BINARY;
+        linear[v] = model.linear(v);
+        for (auto it = model.cbegin_neighborhood(v); it != model.cend_neighborhood(v); ++it) {
+            if (it->v == v) {
+                if (model.vartype(v) == Vartype::BINARY) linear[v] += it->bias;
+                continue;
+            }
+            col.push_back(it->v);
+            data.push_back(it->bias);
+        }
+        row_ptr[v + 1] = col.size();
+        low[v] = vartype_info<Bias>::min(model.vartype(v));
+        high[v] = vartype_info<Bias>::max(model.vartype(v));
+    }
+
+    utils::parallel_for(num_reads, num_threads, [&](size_type first, size_type last) {
+        std::vector<Bias> state(n);
+        std::vector<Bias> fields(n);
+
+        for (size_type read = first; read < last; ++read) {
+            auto rng = utils::XorShift128Plus(seed, read);
+
+            for (size_type v = 0; v < n; ++v) state[v] = (rng() >> 63) ? high[v] : low[v];
+
+            for (size_type v = 0; v < n; ++v) {
+                Bias field = linear[v];
+                for (size_type i = row_ptr[v]; i < row_ptr[v + 1]; ++i) {
+                    field += data[i] * state[col[i]];
+                }
+                fields[v] = field;
+            }
+
+            for (const double beta : betas) {
+                for (size_type v = 0; v < n; ++v) {
+                    const Bias change = low[v] + high[v] - 2 * state[v];
+                    const double delta = change * fields[v];
+
+                    // flips less likely than exp(-22.2) ~ 2e-10 are rejected
+                    // without drawing a random number
+                    if (delta > 0 &&
+                        (beta * delta > 22.2 || std::exp(-beta * delta) <= rng.uniform())) {
+                        continue;
+                    }
+
+                    state[v] += change;
+                    for (size_type i = row_ptr[v]; i < row_ptr[v + 1]; ++i) {
+                        fields[col[i]] += data[i] * change;
+                    }
+                }
+            }
+
+            std::copy(state.begin(), state.end(), samples + read * n);
+            energies[read] = binary ? model.template energy<Vartype::BINARY>(state.begin())
+                                    : model.energy(state.begin());
+        }
+    });
+}
+
+}  // namespace simulated_annealing
+}  // namespace dimod
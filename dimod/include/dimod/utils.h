@@ -15,7 +15,11 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -50,6 +54,111 @@ ValueIter remove_by_index(ValueIter vfirst, ValueIter vlast, IndexIter ifirst, I
     return std::remove_if(vfirst, vlast, pred);
 }
 
+/**
+ * Divide the range `[0, n)` into contiguous chunks and call `f(first, last)`
+ * once for each chunk, using up to `num_threads` threads.
+ *
+ * If `num_threads` is less than 1, `std::thread::hardware_concurrency()` threads
+ * are used. The calling thread handles the last chunk.
+ * `f` must be safe to call concurrently and must not throw.
+ */
+template <class Function>
+void parallel_for(std::size_t n, int num_threads, Function f) {
+    std::size_t nt = (num_threads < 1) ? std::thread::hardware_concurrency() : num_threads;
+    nt = std::min(std::max(nt, static_cast<std::size_t>(1)), n);  // hardware_concurrency can be 0
+
+    if (nt <= 1) {
+        if (n) f(static_cast<std::size_t>(0), n);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(nt - 1);
+
+    std::size_t first = 0;
+    for (std::size_t t = 0; t < nt; ++t) {
+        std::size_t last = first + n / nt + (t < n % nt);
+        if (t + 1 < nt) {
+            threads.emplace_back(f, first, last);
+        } else {
+            f(first, last);
+        }
+        first = last;
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * Copy `length` samples, each `stride` apart in `samples`, into the
+ * variable-major `buffer`, so that value `v` of sample `si` is at
+ * `buffer[v * width + si]`.
+ *
+ * `buffer` must hold `num_variables * width` values. The lanes from `length`
+ * to `width` are set to 0.
+ */
+template <class T, class R>
+void transpose_samples(const T* samples, std::size_t length, std::size_t stride,
+                       std::size_t num_variables, std::size_t width, R* buffer) {
+    assert(length <= width);
+    for (std::size_t si = 0; si < length; ++si) {
+        const T* sample = samples + si * stride;
+        for (std::size_t v = 0; v < num_variables; ++v) {
+            buffer[v * width + si] = sample[v];
+        }
+    }
+    if (length < width) {
+        for (std::size_t v = 0; v < num_variables; ++v) {
+            std::fill(buffer + v * width + length, buffer + (v + 1) * width, 0);
+        }
+    }
+}
+
+// Advance `state` and return the next value of the splitmix64 generator.
+inline std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * A xorshift128+ random number generator.
+ *
+ * It is small and fast enough not to dominate the cost of the loops that
+ * use it, such as the sweeps of simulated annealing. Every `(seed, stream)`
+ * pair gives an independent sequence that is the same on every platform, so
+ * parallel algorithms can give each unit of work its own stream and get
+ * results that do not depend on the number of threads.
+ */
+class XorShift128Plus {
+ public:
+    XorShift128Plus(std::uint64_t seed, std::uint64_t stream) {
+        std::uint64_t state = seed ^ splitmix64(stream);
+        s0_ = splitmix64(state);
+        s1_ = splitmix64(state);
+        if (!s0_ && !s1_) s1_ = 1;  // the all-zero state is a fixed point
+    }
+
+    std::uint64_t operator()() {
+        std::uint64_t x = s0_;
+        const std::uint64_t y = s1_;
+        s0_ = y;
+        x ^= x << 23;
+        s1_ = x ^ y ^ (x >> 17) ^ (y >> 26);
+        return s1_ + y;
+    }
+
+    // A uniform value in [0, 1).
+    double uniform() { return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0); }
+
+ private:
+    std::uint64_t s0_;
+    std::uint64_t s1_;
+};
+
     // zip_sort is a modification of the code found here :
     // https://www.geeksforgeeks.org/iterative-quick-sort/
 
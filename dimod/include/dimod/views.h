@@ -0,0 +1,483 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/expression.h"
+#include "dimod/quadratic_model.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+
+/**
+ * A read-only view of a model with the variables of one vartype presented as
+ * the other, e.g. every SPIN variable as BINARY.
+ *
+ * No biases are copied. The converted biases are calculated when they are
+ * read: `quadratic()` in constant time on top of the model's lookup,
+ * `linear()` and `neighborhood()` in time linear in the degree of the
+ * variable. The offset depends on every bias, so it is calculated once, the
+ * first time it is read, and cached.
+ *
+ * The model must outlive the view and must not be modified while the view is
+ * in use. Because of the cached offset, the first call to `offset()` must not
+ * be made concurrently with other calls.
+ */
+template <class Bias, class Index = int>
+class VartypeView {
+ public:
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer that can represent non-negative values.
+    using size_type = std::size_t;
+
+    using model_type = abc::QuadraticModelBase<bias_type, index_type>;
+
+    using term_type = abc::OneVarTerm<bias_type, index_type>;
+
+    /**
+     * Construct a view of `model` with every variable of vartype `source`
+     * presented as a variable of vartype `target`.
+     *
+     * # Exceptions
+     * Throws `std::invalid_argument` unless `source` and `target` are each
+     * either BINARY or SPIN.
+     */
+    VartypeView(const model_type& model, Vartype source, Vartype target);
+
+    /**
+     * Construct a view of `expression` with every variable of vartype
+     * `source` presented as a variable of vartype `target`.
+     *
+     * The view is indexed by the expression's variables, not its parent's,
+     * see Expression::variables().
+     */
+    VartypeView(const Expression<bias_type, index_type>& expression, Vartype source,
+                Vartype target);
+
+    /**
+     * Return the energy of the given sample, whose values are in the vartypes
+     * of the view.
+     *
+     * `sample_start` must be a random access iterator pointing to the
+     * beginning of the sample.
+     */
+    template <class Iter>
+    bias_type energy(Iter sample_start) const;
+
+    /// Return the linear bias associated with `v`.
+    bias_type linear(index_type v) const;
+
+    /// Return the lower bound on variable `v`.
+    bias_type lower_bound(index_type v) const;
+
+    /**
+     * Return a model with the biases of the view.
+     *
+     * Works for any `Model` with the same `add_variable()` and
+     * `add_quadratic_coo()` methods as QuadraticModel.
+     */
+    template <class Model = QuadraticModel<bias_type, index_type>>
+    Model materialize() const;
+
+    /// Return the underlying model.
+    const model_type& model() const { return *model_; }
+
+    /// Return the neighborhood of variable `v`, sorted by neighbor.
+    std::vector<term_type> neighborhood(index_type v) const;
+
+    /// Return the number of interactions in the model.
+    size_type num_interactions() const { return model_->num_interactions(); }
+
+    /// Return the number of variables in the model.
+    size_type num_variables() const { return model_->num_variables(); }
+
+    /// Return the offset.
+    bias_type offset() const;
+
+    /**
+     * Return the quadratic bias associated with `u`, `v`.
+     *
+     * If `u` and `v` do not have a quadratic bias, returns 0.
+     */
+    bias_type quadratic(index_type u, index_type v) const;
+
+    /// Return the upper bound on variable `v`.
+    bias_type upper_bound(index_type v) const;
+
+    /// Return the vartype of `v` in the view.
+    Vartype vartype(index_type v) const;
+
+ private:
+    // Each converted variable x of the model is written as x = scale * y + shift
+    // in terms of the variable y of the view.
+    bool converted(index_type v) const { return model_vartype(v) == source_; }
+
+    // The vartype() and bounds of expressions are indexed by their parent's variables
+    index_type parent_index(index_type v) const {
+        return parent_variables_ ? (*parent_variables_)[v] : v;
+    }
+
+    Vartype model_vartype(index_type v) const { return model_->vartype(parent_index(v)); }
+    bias_type scale(index_type v) const { return converted(v) ? scale_ : 1; }
+    bias_type shift(index_type v) const { return converted(v) ? shift_ : 0; }
+
+    const model_type* model_;
+    const std::vector<index_type>* parent_variables_;
+
+    Vartype source_;
+    Vartype target_;
+
+    bias_type scale_;
+    bias_type shift_;
+
+    mutable bool offset_cached_;
+    mutable bias_type offset_;
+};
+
+/**
+ * A read-only view of a model with its variables relabelled.
+ *
+ * Variable `v` of the model is variable `mapping[v]` of the view. The mapping
+ * and its inverse are stored, but no biases are copied. The neighborhoods of
+ * the view are relabelled and sorted when they are read.
+ *
+ * The model must outlive the view and must not be modified while the view is
+ * in use.
+ */
+template <class Bias, class Index = int>
+class RelabelView {
+ public:
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer that can represent non-negative values.
+    using size_type = std::size_t;
+
+    using model_type = abc::QuadraticModelBase<bias_type, index_type>;
+
+    using term_type = abc::OneVarTerm<bias_type, index_type>;
+
+    /**
+     * Construct a view of `model` where variable `v` is relabelled as `mapping[v]`.
+     *
+     * # Exceptions
+     * Throws `std::invalid_argument` if `mapping` is not a permutation of
+     * the variables of `model`.
+     */
+    RelabelView(const model_type& model, std::vector<index_type> mapping);
+
+    /**
+     * Construct a view of `expression` where variable `v` is relabelled as `mapping[v]`.
+     *
+     * The model's variables are the expression's, not its parent's, see
+     * Expression::variables().
+     */
+    RelabelView(const Expression<bias_type, index_type>& expression,
+                std::vector<index_type> mapping);
+
+    /**
+     * Return the energy of the given sample, ordered by the labels of the view.
+     *
+     * `sample_start` must be a random access iterator pointing to the
+     * beginning of the sample.
+     */
+    template <class Iter>
+    bias_type energy(Iter sample_start) const;
+
+    /// Return the variable of the model labelled `v` in the view.
+    index_type label_of(index_type v) const { return inverse_[v]; }
+
+    /// Return the linear bias associated with `v`.
+    bias_type linear(index_type v) const { return model_->linear(inverse_[v]); }
+
+    /// Return the lower bound on variable `v`.
+    bias_type lower_bound(index_type v) const {
+        return model_->lower_bound(parent_index(inverse_[v]));
+    }
+
+    /// Return the label in the view of variable `v` of the model.
+    index_type mapping(index_type v) const { return mapping_[v]; }
+
+    /**
+     * Return a model with the biases of the view.
+     *
+     * See VartypeView::materialize().
+     */
+    template <class Model = QuadraticModel<bias_type, index_type>>
+    Model materialize() const;
+
+    /// Return the underlying model.
+    const model_type& model() const { return *model_; }
+
+    /// Return the neighborhood of variable `v`, sorted by neighbor.
+    std::vector<term_type> neighborhood(index_type v) const;
+
+    /// Return the number of interactions in the model.
+    size_type num_interactions() const { return model_->num_interactions(); }
+
+    /// Return the number of variables in the model.
+    size_type num_variables() const { return model_->num_variables(); }
+
+    /// Return the offset.
+    bias_type offset() const { return model_->offset(); }
+
+    /**
+     * Return the quadratic bias associated with `u`, `v`.
+     *
+     * If `u` and `v` do not have a quadratic bias, returns 0.
+     */
+    bias_type quadratic(index_type u, index_type v) const {
+        return model_->quadratic(inverse_[u], inverse_[v]);
+    }
+
+    /// Return the upper bound on variable `v`.
+    bias_type upper_bound(index_type v) const {
+        return model_->upper_bound(parent_index(inverse_[v]));
+    }
+
+    /// Return the vartype of `v` in the view.
+    Vartype vartype(index_type v) const { return model_->vartype(parent_index(inverse_[v])); }
+
+ private:
+    // See VartypeView
+    index_type parent_index(index_type v) const {
+        return parent_variables_ ? (*parent_variables_)[v] : v;
+    }
+
+    const model_type* model_;
+    const std::vector<index_type>* parent_variables_;
+
+    std::vector<index_type> mapping_;
+    std::vector<index_type> inverse_;
+};
+
+namespace detail {
+
+// Copy a view into a new model, one neighborhood at a time.
+template <class Model, class View>
+Model materialize_view(const View& view) {
+    using index_type = typename View::index_type;
+    using bias_type = typename View::bias_type;
+
+    Model model;
+    for (index_type v = 0; static_cast<std::size_t>(v) < view.num_variables(); ++v) {
+        model.add_variable(view.vartype(v), view.lower_bound(v), view.upper_bound(v));
+    }
+
+    // the upper triangle, already sorted by (row, col)
+    std::vector<index_type> rows;
+    std::vector<index_type> cols;
+    std::vector<bias_type> biases;
+    rows.reserve(view.num_interactions());
+    cols.reserve(view.num_interactions());
+    biases.reserve(view.num_interactions());
+    for (index_type u = 0; static_cast<std::size_t>(u) < view.num_variables(); ++u) {
+        model.set_linear(u, view.linear(u));
+        for (const auto& term : view.neighborhood(u)) {
+            if (term.v < u) continue;
+            rows.push_back(u);
+            cols.push_back(term.v);
+            biases.push_back(term.bias);
+        }
+    }
+    model.add_quadratic_coo(rows.begin(), cols.begin(), biases.begin(), rows.size(), true);
+
+    model.set_offset(view.offset());
+    return model;
+}
+
+}  // namespace detail
+
+template <class bias_type, class index_type>
+VartypeView<bias_type, index_type>::VartypeView(const model_type& model, Vartype source,
+                                                Vartype target)
+        : model_(&model),
+          parent_variables_(nullptr),
+          source_(source),
+          target_(target),
+          scale_(1),
+          shift_(0),
+          offset_cached_(false),
+          offset_(0) {
+    auto is_binary_or_spin = [](Vartype vartype) {
+        return vartype == Vartype::BINARY || vartype == Vartype::SPIN;
+    };
+    if (!is_binary_or_spin(source) || !is_binary_or_spin(target)) {
+        throw std::invalid_argument("only BINARY and SPIN variables can be converted");
+    }
+
+    if (source == Vartype::SPIN && target == Vartype::BINARY) {
+        // s = 2x - 1
+        scale_ = 2;
+        shift_ = -1;
+    } else if (source == Vartype::BINARY && target == Vartype::SPIN) {
+        // x = (s + 1) / 2
+        scale_ = .5;
+        shift_ = .5;
+    }
+}
+
+template <class bias_type, class index_type>
+VartypeView<bias_type, index_type>::VartypeView(const Expression<bias_type, index_type>& expression,
+                                                Vartype source, Vartype target)
+        : VartypeView(static_cast<const model_type&>(expression), source, target) {
+    parent_variables_ = &expression.variables();
+}
+
+template <class bias_type, class index_type>
+template <class Iter>
+bias_type VartypeView<bias_type, index_type>::energy(Iter sample_start) const {
+    // the energy of the view is the energy of the model at the same state
+    std::vector<bias_type> sample(num_variables());
+    for (index_type v = 0; static_cast<size_type>(v) < num_variables(); ++v) {
+        sample[v] = scale(v) * sample_start[v] + shift(v);
+    }
+    return model_->energy(sample.begin());
+}
+
+template <class bias_type, class index_type>
+bias_type VartypeView<bias_type, index_type>::linear(index_type v) const {
+    bias_type bias = model_->linear(v);
+    for (auto it = model_->cbegin_neighborhood(v); it != model_->cend_neighborhood(v); ++it) {
+        bias += it->bias * shift(it->v);
+    }
+    return scale(v) * bias;
+}
+
+template <class bias_type, class index_type>
+bias_type VartypeView<bias_type, index_type>::lower_bound(index_type v) const {
+    return converted(v) ? vartype_info<bias_type>::default_min(target_)
+                        : model_->lower_bound(parent_index(v));
+}
+
+template <class bias_type, class index_type>
+template <class Model>
+Model VartypeView<bias_type, index_type>::materialize() const {
+    return detail::materialize_view<Model>(*this);
+}
+
+template <class bias_type, class index_type>
+std::vector<typename VartypeView<bias_type, index_type>::term_type>
+VartypeView<bias_type, index_type>::neighborhood(index_type v) const {
+    std::vector<term_type> terms(model_->cbegin_neighborhood(v), model_->cend_neighborhood(v));
+    const bias_type scale_v = scale(v);
+    for (auto& term : terms) term.bias *= scale_v * scale(term.v);
+    return terms;
+}
+
+template <class bias_type, class index_type>
+bias_type VartypeView<bias_type, index_type>::offset() const {
+    if (offset_cached_) return offset_;
+
+    bias_type offset = model_->offset();
+    for (index_type u = 0; static_cast<size_type>(u) < num_variables(); ++u) {
+        const bias_type shift_u = shift(u);
+        if (!shift_u) continue;  // the only effect of u is through its neighbors
+
+        offset += model_->linear(u) * shift_u;
+        for (auto it = model_->cbegin_neighborhood(u); it != model_->cend_neighborhood(u); ++it) {
+            if (it->v < u) offset += it->bias * shift_u * shift(it->v);
+        }
+    }
+
+    offset_ = offset;
+    offset_cached_ = true;
+    return offset_;
+}
+
+template <class bias_type, class index_type>
+bias_type VartypeView<bias_type, index_type>::quadratic(index_type u, index_type v) const {
+    return model_->quadratic(u, v) * scale(u) * scale(v);
+}
+
+template <class bias_type, class index_type>
+bias_type VartypeView<bias_type, index_type>::upper_bound(index_type v) const {
+    return converted(v) ? vartype_info<bias_type>::default_max(target_)
+                        : model_->upper_bound(parent_index(v));
+}
+
+template <class bias_type, class index_type>
+Vartype VartypeView<bias_type, index_type>::vartype(index_type v) const {
+    return converted(v) ? target_ : model_vartype(v);
+}
+
+template <class bias_type, class index_type>
+RelabelView<bias_type, index_type>::RelabelView(const model_type& model,
+                                                std::vector<index_type> mapping)
+        : model_(&model),
+          parent_variables_(nullptr),
+          mapping_(std::move(mapping)),
+          inverse_(mapping_.size(), -1) {
+    if (mapping_.size() != model.num_variables()) {
+        throw std::invalid_argument("mapping must have one label per variable");
+    }
+    for (index_type v = 0; static_cast<size_type>(v) < mapping_.size(); ++v) {
+        const index_type label = mapping_[v];
+        if (label < 0 || static_cast<size_type>(label) >= mapping_.size() || inverse_[label] >= 0) {
+            throw std::invalid_argument("mapping must be a permutation of the variables");
+        }
+        inverse_[label] = v;
+    }
+}
+
+template <class bias_type, class index_type>
+RelabelView<bias_type, index_type>::RelabelView(const Expression<bias_type, index_type>& expression,
+                                                std::vector<index_type> mapping)
+        : RelabelView(static_cast<const model_type&>(expression), std::move(mapping)) {
+    parent_variables_ = &expression.variables();
+}
+
+template <class bias_type, class index_type>
+template <class Iter>
+bias_type RelabelView<bias_type, index_type>::energy(Iter sample_start) const {
+    std::vector<bias_type> sample(num_variables());
+    for (index_type v = 0; static_cast<size_type>(v) < num_variables(); ++v) {
+        sample[v] = sample_start[mapping_[v]];
+    }
+    return model_->energy(sample.begin());
+}
+
+template <class bias_type, class index_type>
+template <class Model>
+Model RelabelView<bias_type, index_type>::materialize() const {
+    return detail::materialize_view<Model>(*this);
+}
+
+template <class bias_type, class index_type>
+std::vector<typename RelabelView<bias_type, index_type>::term_type>
+RelabelView<bias_type, index_type>::neighborhood(index_type v) const {
+    const index_type u = inverse_[v];
+    std::vector<term_type> terms(model_->cbegin_neighborhood(u), model_->cend_neighborhood(u));
+    for (auto& term : terms) term.v = mapping_[term.v];
+    std::sort(terms.begin(), terms.end());
+    return terms;
+}
+
+}  // namespace dimod
@@ -12,7 +12,15 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+from dimod.libcpp.binary_polynomial cimport *
 from dimod.libcpp.binary_quadratic_model cimport *
 from dimod.libcpp.constrained_quadratic_model cimport *
+from dimod.libcpp.discrete_quadratic_model cimport *
+from dimod.libcpp.exact cimport *
+from dimod.libcpp.generators cimport *
+from dimod.libcpp.instrumentation cimport *
+from dimod.libcpp.local_field_state cimport *
+from dimod.libcpp.packed_samples cimport *
 from dimod.libcpp.quadratic_model cimport *
+from dimod.libcpp.simulated_annealing cimport *
 from dimod.libcpp.vartypes cimport *
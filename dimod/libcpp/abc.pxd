@@ -15,6 +15,7 @@
 #    limitations under the License.
 
 from libcpp.utility cimport pair
+from dimod.libcpp.instrumentation cimport MemoryUsage
 from dimod.libcpp.vartypes cimport Vartype
 
 __all__ = ['BinaryQuadraticModelBase']
@@ -95,6 +96,8 @@ cdef extern from "dimod/abc.h" namespace "dimod::abc" nogil:
         void add_quadratic(index_type, index_type, bias_type)
         void add_quadratic_from_coo "add_quadratic" [ItRow, ItCol, ItBias](ItRow, ItCol, ItBias, index_type)
         void add_quadratic_back(index_type, index_type, bias_type)
+        void add_quadratic_coo[ItRow, ItCol, ItBias](ItRow, ItCol, ItBias, size_type, bint)
+        void add_quadratic_csr[ItPtr, ItCol, ItBias](ItPtr, ItCol, ItBias, index_type, bint)
         void add_quadratic_from_dense[T](const T dense[], index_type)
         const_neighborhood_iterator cbegin_neighborhood(index_type)
         const_neighborhood_iterator cend_neighborhood(index_type)
@@ -102,10 +105,15 @@ cdef extern from "dimod/abc.h" namespace "dimod::abc" nogil:
         const_quadratic_iterator cend_quadratic()
         void clear()
         bias_type energy[Iter](Iter)
+        void energies[T, R](const T*, size_type, size_type, R*, int)
         void fix_variable[T](index_type, T)
+        void freeze()
+        bint is_frozen()
         bint is_linear()
         bias_type linear(index_type)
         bias_type lower_bound(index_type)
+        MemoryUsage memory_usage()
+        MemoryUsage memory_usage(bint)
         size_type nbytes()
         size_type nbytes(bint)
         size_type num_interactions()
@@ -116,9 +124,13 @@ cdef extern from "dimod/abc.h" namespace "dimod::abc" nogil:
         bias_type quadratic_at(index_type, index_type) except+
         bint remove_interaction(index_type, index_type)
         void remove_variable(index_type)
+        void reserve(size_type)
+        void reserve_interactions(index_type, size_type)
         void scale(bias_type)
         void set_linear(index_type, bias_type)
         void set_offset(bias_type)
         void set_quadratic(index_type, index_type, bias_type) except+
+        void thaw()
+        size_type to_csr[P, I, B](P*, I*, B*, bint)
         bias_type upper_bound(index_type)
         Vartype vartype(index_type)
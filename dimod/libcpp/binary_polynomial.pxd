@@ -0,0 +1,55 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+
+from libcpp.vector cimport vector
+
+from dimod.libcpp.binary_quadratic_model cimport BinaryQuadraticModel
+from dimod.libcpp.vartypes cimport Vartype
+
+__all__ = ['BinaryPolynomial', 'ProductReduction']
+
+
+cdef extern from "dimod/binary_polynomial.h" namespace "dimod" nogil:
+    cdef cppclass ProductReduction[Index]:
+        Index u
+        Index v
+        Index product
+        Index auxiliary
+
+    cdef cppclass BinaryPolynomial[Bias, Index]:
+        ctypedef Bias bias_type
+        ctypedef Index index_type
+        ctypedef size_t size_type
+
+        BinaryPolynomial()
+        BinaryPolynomial(Vartype) except+
+
+        void add_offset(bias_type)
+        void add_term[Iter](Iter, Iter, bias_type)
+        bias_type bias(size_type)
+        void clear()
+        size_type degree()
+        bias_type energy[T](const T*)
+        void energies[T, R](const T*, size_type, size_type, R*, int)
+        size_type find_term[Iter](Iter, Iter)
+        vector[ProductReduction[I]] make_quadratic[B, I](BinaryQuadraticModel[B, I]&, bias_type) except+
+        size_type num_terms()
+        size_type num_variables()
+        bias_type offset()
+        void resize(index_type) except+
+        void set_offset(bias_type)
+        const index_type* term_begin(size_type)
+        const index_type* term_end(size_type)
+        Vartype vartype()
@@ -14,12 +14,14 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+from libcpp cimport bool
 from libcpp.memory cimport weak_ptr
 from libcpp.vector cimport vector
 
 from dimod.libcpp.abc cimport QuadraticModelBase
 from dimod.libcpp.constraint cimport Constraint, Penalty, Sense
 from dimod.libcpp.expression cimport Expression
+from dimod.libcpp.instrumentation cimport MemoryUsage
 from dimod.libcpp.vartypes cimport Vartype
 
 __all__ = ['ConstrainedQuadraticModel']
@@ -40,15 +42,20 @@ cdef extern from "dimod/constrained_quadratic_model.h" namespace "dimod" nogil:
         void clear()
         Constraint[bias_type, index_type]& constraint_ref(index_type)
         weak_ptr[Constraint[bias_type, index_type]] constraint_weak_ptr(index_type)
+        MemoryUsage constraints_memory_usage(bint)
         void fix_variable[T](index_type, T)
         ConstrainedQuadraticModel fix_variables[VarIter, AssignmentIter](VarIter, VarIter, AssignmentIter)
+        void feasible[T](const T*, size_t, size_t, bool*, bias_type, bias_type, int)
         bias_type lower_bound(index_type)
+        MemoryUsage memory_usage(bint)
         Constraint[bias_type, index_type] new_constraint()
         size_t num_constraints()
         size_t num_interactions()
         size_t num_variables()
+        void penalties[T, R](const T*, size_t, size_t, R*, bias_type, bias_type, int)
         void remove_constraint(index_type)
         void remove_variable(index_type)
+        void remove_variables[Iter](Iter, Iter)
         void set_lower_bound(index_type, bias_type)
         void set_objective[B, I](QuadraticModelBase[B, I]&)
         void set_objective[B, I, T](QuadraticModelBase[B, I]&, vector[T])
@@ -56,3 +63,4 @@ cdef extern from "dimod/constrained_quadratic_model.h" namespace "dimod" nogil:
         void substitute_variable(index_type, bias_type, bias_type)
         bias_type upper_bound(index_type)
         Vartype vartype(index_type)
+        void violations[T, R](const T*, size_t, size_t, R*, int)
@@ -49,3 +49,4 @@ cdef extern from "dimod/constraint.h" namespace "dimod" nogil:
         void set_sense(Sense)
         void set_penalty(Penalty)
         void set_weight(bias_type)
+        bias_type violation(bias_type)
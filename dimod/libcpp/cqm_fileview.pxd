@@ -0,0 +1,50 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2022 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libcpp cimport bool
+from libcpp.string cimport string
+
+from dimod.libcpp.constrained_quadratic_model cimport ConstrainedQuadraticModel
+from dimod.typing cimport uint64_t
+
+__all__ = ['ConstrainedQuadraticModelReader', 'DumpOptions', 'dump', 'dumps',
+           'ReadFunction', 'WriteFunction']
+
+
+cdef extern from "dimod/cqm_fileview.h" namespace "dimod::fileview" nogil:
+    cdef cppclass DumpOptions:
+        string variable_labels
+        string constraint_labels
+        string compression
+        int num_threads
+        size_t batch_size
+
+    ctypedef bool (*WriteFunction)(void*, const char*, size_t) noexcept
+    ctypedef bool (*ReadFunction)(void*, uint64_t, size_t, char*) noexcept
+
+    void dump[bias_type, index_type](const ConstrainedQuadraticModel[bias_type, index_type]&, WriteFunction, void*, const DumpOptions&) except+
+    string dumps[bias_type, index_type](const ConstrainedQuadraticModel[bias_type, index_type]&, const DumpOptions&) except+
+
+    cdef cppclass ConstrainedQuadraticModelReader[bias_type, index_type]:
+        ConstrainedQuadraticModelReader(const void*, size_t) except+
+        ConstrainedQuadraticModelReader(ReadFunction, void*, size_t) except+
+
+        const string& compression()
+        string constraint_labels() except+
+        ConstrainedQuadraticModel[bias_type, index_type] load(int) except+
+        size_t num_constraints()
+        size_t num_variables()
+        string variable_labels() except+
@@ -0,0 +1,47 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+
+from libcpp.vector cimport vector
+
+from dimod.libcpp.abc cimport QuadraticModelBase
+from dimod.libcpp.instrumentation cimport MemoryUsage
+
+__all__ = ['DiscreteQuadraticModel']
+
+
+cdef extern from "dimod/discrete_quadratic_model.h" namespace "dimod" nogil:
+    cdef cppclass DiscreteQuadraticModel[Bias, Index]:
+        ctypedef Bias bias_type
+        ctypedef Index index_type
+        ctypedef size_t size_type
+
+        DiscreteQuadraticModel()
+        DiscreteQuadraticModel(const QuadraticModelBase[Bias, Index]&, const vector[Index]&) except+
+
+        void add_linear(index_type, index_type, bias_type)
+        void add_offset(bias_type)
+        void add_quadratic(index_type, index_type, index_type, index_type, bias_type) except+
+        index_type add_variable(index_type) except+
+        index_type case_start(index_type)
+        void energies[T, R](const T*, size_type, size_type, R*, int) except+
+        bias_type linear(index_type, index_type)
+        MemoryUsage memory_usage(bint)
+        size_type num_cases(index_type)
+        size_type num_cases()
+        size_type num_variable_interactions()
+        size_type num_variables()
+        bias_type offset()
+        bias_type quadratic(index_type, index_type, index_type, index_type)
+        void set_offset(bias_type)
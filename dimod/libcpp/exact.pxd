@@ -0,0 +1,36 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libc.stdint cimport uint64_t
+from libcpp.vector cimport vector
+
+from dimod.libcpp.abc cimport QuadraticModelBase
+from dimod.libcpp.constrained_quadratic_model cimport ConstrainedQuadraticModel
+
+__all__ = ['State', 'Sample', 'lowest_states', 'lowest_feasible']
+
+
+cdef extern from "dimod/exact.h" namespace "dimod::exact" nogil:
+    cdef cppclass State[Bias]:
+        uint64_t bits
+        Bias energy
+
+    cdef cppclass Sample[Bias]:
+        vector[Bias] values
+        Bias energy
+
+    vector[State[B]] lowest_states[B, I](const QuadraticModelBase[B, I]&, size_t, int) except+
+    vector[Sample[B]] lowest_feasible[B, I](const ConstrainedQuadraticModel[B, I]&, size_t, B, B, int) except+
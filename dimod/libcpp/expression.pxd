@@ -58,4 +58,5 @@ cdef extern from "dimod/expression.h" namespace "dimod" nogil:
 
         bint has_variable(index_type)
         bint is_disjoint(const Expression&)
+        void substitute_variable(index_type, bias_type, bias_type)
         const vector[index_type]& variables()
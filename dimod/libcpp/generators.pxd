@@ -0,0 +1,31 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libc.stdint cimport uint64_t
+
+from dimod.libcpp.abc cimport QuadraticModelBase
+
+__all__ = ['Uniform', 'set_random_linear', 'add_gnm_interactions', 'add_gnp_interactions']
+
+
+cdef extern from "dimod/generators.h" namespace "dimod::generators" nogil:
+    cdef cppclass Uniform[B]:
+        Uniform()
+        Uniform(B, B)
+
+    void set_random_linear[B, I, D](QuadraticModelBase[B, I]&, const D&, uint64_t, int)
+    void add_gnm_interactions[B, I, D](QuadraticModelBase[B, I]&, uint64_t, const D&, uint64_t, int) except+
+    void add_gnp_interactions[B, I, D](QuadraticModelBase[B, I]&, double, const D&, uint64_t, int)
@@ -0,0 +1,65 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+
+from libc.stdint cimport uint64_t
+
+__all__ = ['Counter', 'MemoryUsage']
+
+
+cdef extern from "dimod/instrumentation.h" namespace "dimod" nogil:
+    cdef cppclass MemoryUsage:
+        size_t linear
+        size_t quadratic
+        size_t variables
+        size_t indices
+        size_t other
+
+        MemoryUsage()
+        size_t total()
+
+    enum class Counter:
+        REALLOCATIONS
+        QUADRATIC_INSERTS
+        QUADRATIC_HITS
+        ENERGY_CALLS
+
+    const bint counters_enabled
+    uint64_t counter_value(Counter)
+    void reset_counters()
+
+
+cdef inline dict memory_usage_as_dict(MemoryUsage usage):
+    return dict(linear=usage.linear,
+                quadratic=usage.quadratic,
+                variables=usage.variables,
+                indices=usage.indices,
+                other=usage.other,
+                total=usage.total())
+
+
+cdef inline dict counters_as_dict(bint reset, dict counts=None):
+    # Each extension module has its own copy of the counters, so this only
+    # reports the events of the module that calls it. Classes whose methods
+    # span several modules add their counts to those of their base class.
+    if counts is None:
+        counts = dict(enabled=counters_enabled, reallocations=0, quadratic_inserts=0,
+                      quadratic_hits=0, energy_calls=0)
+    counts['reallocations'] += counter_value(Counter.REALLOCATIONS)
+    counts['quadratic_inserts'] += counter_value(Counter.QUADRATIC_INSERTS)
+    counts['quadratic_hits'] += counter_value(Counter.QUADRATIC_HITS)
+    counts['energy_calls'] += counter_value(Counter.ENERGY_CALLS)
+    if reset:
+        reset_counters()
+    return counts
@@ -0,0 +1,39 @@
+# Copyright 2022 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libcpp.vector cimport vector
+
+from dimod.libcpp.abc cimport QuadraticModelBase
+
+__all__ = ['LocalFieldState']
+
+
+cdef extern from "dimod/local_field_state.h" namespace "dimod" nogil:
+    cdef cppclass LocalFieldState[Bias, Index]:
+        ctypedef Bias bias_type
+        ctypedef Index index_type
+        ctypedef size_t size_type
+
+        LocalFieldState(const QuadraticModelBase[Bias, Index]&, const Bias*) except +
+
+        void apply(index_type, bias_type) except +
+        bias_type delta(index_type, bias_type)
+        bias_type delta_flip(index_type) except +
+        bias_type energy()
+        bias_type flip(index_type) except +
+        bias_type local_field(index_type)
+        const QuadraticModelBase[Bias, Index]& model()
+        size_type num_variables()
+        const vector[bias_type]& sample()
+        bias_type value(index_type)
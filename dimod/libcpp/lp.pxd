@@ -0,0 +1,38 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2022 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+from dimod.libcpp.constrained_quadratic_model cimport ConstrainedQuadraticModel
+
+__all__ = ['Format', 'LPModel', 'dump_file', 'dumps', 'read_file']
+
+
+cdef extern from "dimod/lp.h" namespace "dimod::lp" nogil:
+    enum Format:
+        LP
+        MPS
+
+    cdef cppclass LPModel[bias_type, index_type]:
+        ConstrainedQuadraticModel[bias_type, index_type] model
+        vector[string] variable_labels
+        vector[string] constraint_labels
+
+    LPModel[bias_type, index_type] read_file[bias_type, index_type](const string&, int) except+
+
+    void dump_file[bias_type, index_type](const ConstrainedQuadraticModel[bias_type, index_type]&, const string&, const vector[string]&, const vector[string]&, Format) except+
+    string dumps[bias_type, index_type](const ConstrainedQuadraticModel[bias_type, index_type]&, const vector[string]&, const vector[string]&, Format) except+
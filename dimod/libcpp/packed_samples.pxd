@@ -0,0 +1,42 @@
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libc.stdint cimport uint64_t
+from libcpp.vector cimport vector
+
+from dimod.libcpp.abc cimport QuadraticModelBase
+
+__all__ = ['PackedSamples', 'aggregate_samples']
+
+
+cdef extern from "dimod/packed_samples.h" namespace "dimod" nogil:
+    cdef cppclass PackedSamples:
+        ctypedef uint64_t word_type
+        ctypedef size_t size_type
+
+        PackedSamples(size_type)
+
+        vector[size_type] aggregate(size_type*)
+        bint bit(size_type, size_type)
+        void clear()
+        void energies[B, I, R](const QuadraticModelBase[B, I]&, R*, int) except+
+        size_type nbytes()
+        size_type num_samples()
+        size_type num_variables()
+        size_type num_words()
+        void push_back[T](const T*)
+        const word_type* row(size_type)
+        void unpack[T](size_type, T, T, T*)
+
+    vector[size_t] aggregate_samples[T](const T*, size_t, size_t, size_t, size_t*)
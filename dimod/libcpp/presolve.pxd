@@ -0,0 +1,58 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libc.stdint cimport uint64_t
+from libcpp.vector cimport vector
+
+from dimod.libcpp.constrained_quadratic_model cimport ConstrainedQuadraticModel
+
+__all__ = ['Feasibility', 'Postsolver', 'Presolver', 'TechniqueFlags']
+
+
+cdef extern from "dimod/presolve.h" namespace "dimod::presolve" nogil:
+    enum TechniqueFlags:
+        NONE
+        REMOVE_FIXED_VARIABLES
+        REMOVE_UNUSED_VARIABLES
+        REMOVE_SMALL_CONSTRAINTS
+        TIGHTEN_BOUNDS
+        REMOVE_DUPLICATE_CONSTRAINTS
+        ALL
+
+    enum Feasibility:
+        INFEASIBLE
+        UNKNOWN
+
+    cdef cppclass Postsolver[bias_type, index_type]:
+        void apply[T](const T*, size_t, T*)
+        size_t num_original_variables()
+        size_t num_variables()
+        const vector[index_type]& variables()
+
+    cdef cppclass Presolver[bias_type, index_type]:
+        Presolver()
+        Presolver(ConstrainedQuadraticModel[bias_type, index_type]) except+
+
+        Feasibility apply() except+
+        Feasibility apply(int) except+
+        ConstrainedQuadraticModel[bias_type, index_type] detach_model()
+        Feasibility feasibility()
+        const ConstrainedQuadraticModel[bias_type, index_type]& model()
+        const Postsolver[bias_type, index_type]& postsolver()
+        void set_techniques(uint64_t)
+        uint64_t techniques()
+
+        bias_type feasibility_tolerance
@@ -0,0 +1,29 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libc.stdint cimport uint64_t
+from libcpp.pair cimport pair
+from libcpp.vector cimport vector
+
+from dimod.libcpp.abc cimport QuadraticModelBase
+
+__all__ = ['default_beta_range', 'linear_beta_schedule', 'sample']
+
+
+cdef extern from "dimod/simulated_annealing.h" namespace "dimod::simulated_annealing" nogil:
+    pair[double, double] default_beta_range[B, I](const QuadraticModelBase[B, I]&) except+
+    vector[double] linear_beta_schedule(double, double, size_t)
+    void sample[B, I, T](const QuadraticModelBase[B, I]&, const vector[double]&, size_t, uint64_t, T*, B*, int) except+
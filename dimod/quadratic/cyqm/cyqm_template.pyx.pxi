@@ -28,6 +28,7 @@ import dimod
 
 from dimod.binary.cybqm cimport cyBQM
 from dimod.cyutilities cimport as_numpy_float, cppvartype
+from dimod.libcpp.instrumentation cimport counters_as_dict
 from dimod.libcpp.vartypes cimport vartype_info as cppvartype_info
 from dimod.quadratic cimport cyQM
 from dimod.sampleset import as_samples
@@ -190,13 +191,22 @@ cdef class cyQM_template(cyQMBase):
             for vi in range(length):
                 self.add_quadratic(irow[vi], icol[vi], qdata[vi])
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
     def add_quadratic_from_iterable(self, quadratic):
-        cdef Py_ssize_t ui, vi
-        cdef bias_type bias
+        # resolve all of the labels in one batch
+        labels = []
+        biases = []
         for u, v, bias in quadratic:
-            ui = self.variables.index(u)
-            vi = self.variables.index(v)
-            self._add_quadratic(ui, vi, bias)
+            labels.append(u)
+            labels.append(v)
+            biases.append(bias)
+
+        cdef Py_ssize_t[::1] indices = self.variables.index_array(labels)
+        cdef bias_type[::1] bias_view = np.asarray(biases, dtype=BIAS_DTYPE)
+        cdef Py_ssize_t i
+        for i in range(bias_view.shape[0]):
+            self._add_quadratic(indices[2*i], indices[2*i+1], bias_view[i])
 
     def add_variable(self, vartype, label=None, *, lower_bound=None, upper_bound=None):
         if not isinstance(vartype, Vartype):  # redundant, but provides a bit of a speedup
@@ -275,6 +285,16 @@ cdef class cyQM_template(cyQMBase):
             raise TypeError(f"cannot change vartype {self.vartype(v).name!r} "
                             f"to {vartype.name!r}") from None
 
+    @staticmethod
+    def counters(bint reset=False):
+        """Return the counts of events on the hot paths of the models.
+
+        See :meth:`cyQMBase.counters`.
+        """
+        # the methods of this class are compiled into this module and into the
+        # base class's module, which each have their own counters
+        return counters_as_dict(reset, cyQMBase.counters(reset))
+
     cdef cppVartype cppvartype(self, object vartype) except? cppVartype.SPIN:
         return cppvartype(vartype)
 
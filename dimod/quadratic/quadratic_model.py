@@ -969,6 +969,22 @@ class QuadraticModel(QuadraticViewsMixin):
         """
         return self.data.lower_bound
 
+    def memory_usage(self, capacity: bool = False) -> Dict[str, int]:
+        """Get a breakdown of the memory used by the quadratic model.
+
+        See :meth:`.BinaryQuadraticModel.memory_usage`.
+
+        Args:
+            capacity: If ``capacity`` is true, use the ``std::vector::capacity``
+                of the underlying vectors rather than their size.
+
+        Returns:
+            A dict with the number of bytes used for each part of the model,
+            and the ``total``.
+
+        """
+        return self.data.memory_usage(capacity)
+
     def nbytes(self, capacity: bool = False) -> int:
         """Get the total bytes consumed by the biases, vartype info, bounds,
         and indices.
@@ -1140,6 +1156,9 @@ class QuadraticModel(QuadraticViewsMixin):
                                       ) -> Tuple['QuadraticModel', Mapping[Variable, Variable]]:
         """Relabel the variables as `[0, n)` and return the mapping.
 
+        Models with integer labels that were added out of order, or that had
+        variables removed, are compacted and no longer store their labels.
+
         Args:
             inplace: If set to False, returns a new quadratic model
                 mapped to the new labels.
@@ -1249,6 +1268,40 @@ class QuadraticModel(QuadraticViewsMixin):
 
         return self
 
+    def to_csr(self, *, upper_triangular: bool = True,
+               ) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """Return the quadratic biases as a matrix in compressed sparse row (CSR) format.
+
+        The arrays are filled in a single pass over the interactions, without
+        iterating over them in Python.
+
+        Args:
+            upper_triangular:
+                If True, each interaction ``(u, v)`` appears once, in the
+                row of whichever of ``u`` and ``v`` is first in
+                :attr:`variables`. Otherwise the matrix is symmetric and each
+                interaction between two different variables appears twice.
+
+        Returns:
+            A 3-tuple of NumPy arrays ``(indptr, indices, data)``. The biases
+            of row ``i`` are ``data[indptr[i]:indptr[i+1]]`` and their
+            columns ``indices[indptr[i]:indptr[i+1]]``, which are sorted.
+            ``indptr`` is ``int64``, ``indices`` has the model's index dtype.
+            Rows and columns are the indices of the variables in
+            :attr:`variables`. Self-loops, e.g. ``i*i``, are on the diagonal.
+            The linear biases and the offset are not included.
+
+        Examples:
+            >>> qm = dimod.QuadraticModel()
+            >>> qm.add_variables_from('INTEGER', 'ij')
+            >>> qm.add_quadratic_from({('i', 'j'): 2, ('i', 'i'): -1})
+            >>> indptr, indices, data = qm.to_csr()
+            >>> print(indptr, indices, data)
+            [0 2 2] [0 1] [-1.  2.]
+
+        """
+        return self.data.to_csr(upper_triangular=upper_triangular)
+
     def to_file(self, *,
                 spool_size: int = int(1e9),
                 ) -> tempfile.SpooledTemporaryFile:
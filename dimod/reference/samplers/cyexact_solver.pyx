@@ -0,0 +1,129 @@
+# distutils: language = c++
+# cython: language_level=3
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+cimport cython
+
+from cython.operator cimport dereference as deref
+from libcpp.vector cimport vector
+
+import numpy as np
+
+from dimod.constrained.cyconstrained cimport cyConstrainedQuadraticModel
+from dimod.cyqmbase.cyqmbase_float64 cimport cyQMBase_float64, bias_type, index_type
+from dimod.libcpp.exact cimport State, Sample
+from dimod.libcpp.exact cimport lowest_states as cpplowest_states
+from dimod.libcpp.exact cimport lowest_feasible as cpplowest_feasible
+from dimod.libcpp.vartypes cimport Vartype as cppVartype
+from dimod.typing cimport int8_t, uint64_t
+
+__all__ = ['lowest_states', 'lowest_feasible']
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def lowest_states(cyQMBase_float64 model, Py_ssize_t num_states, int num_threads = 1):
+    """Return the lowest-energy states of a model with only binary and spin variables.
+
+    Args:
+        model: A model with fewer than 64 variables.
+        num_states: The maximum number of states to return. All of them if
+            at least ``2**model.num_variables()``.
+        num_threads: The maximum number of threads to use. All of the
+            available ones if less than 1.
+
+    Returns:
+        A 2-tuple of a ``(num_states, num_variables)`` array of samples, in
+        the variable order of ``model``, and their energies, both ordered by
+        increasing energy.
+    """
+    if num_states < 0:
+        raise ValueError("num_states must be non-negative")
+
+    cdef vector[State[bias_type]] states
+    with nogil:
+        states = cpplowest_states(deref(model.base), num_states, num_threads)
+
+    cdef Py_ssize_t num_variables = model.num_variables()
+
+    samples = np.empty((states.size(), num_variables), dtype=np.int8)
+    energies = np.empty(states.size(), dtype=np.float64)
+
+    cdef int8_t[:, ::1] samples_view = samples
+    cdef bias_type[::1] energies_view = energies
+
+    # the value of each variable when its bit is not set
+    cdef int8_t[::1] low = np.zeros(num_variables, dtype=np.int8)
+    cdef Py_ssize_t si, vi
+    for vi in range(num_variables):
+        if model.base.vartype(vi) == cppVartype.SPIN:
+            low[vi] = -1
+
+    cdef uint64_t bits
+    for si in range(samples_view.shape[0]):
+        bits = states[si].bits
+        for vi in range(num_variables):
+            samples_view[si, vi] = 1 if (bits >> vi) & 1 else low[vi]
+        energies_view[si] = states[si].energy
+
+    return samples, energies
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def lowest_feasible(cyConstrainedQuadraticModel cqm, Py_ssize_t num_samples, *,
+                    bias_type rtol = 1e-6, bias_type atol = 1e-8, int num_threads = 1):
+    """Return the lowest-energy feasible samples of a constrained quadratic model.
+
+    Prefixes of the variables that cannot satisfy a hard linear constraint
+    are pruned, so only a fraction of the samples may be visited.
+
+    Args:
+        cqm: A constrained quadratic model without real-valued variables.
+        num_samples: The maximum number of samples to return.
+        rtol: Relative tolerance for constraint violations.
+        atol: Absolute tolerance for constraint violations.
+        num_threads: The maximum number of threads to use. All of the
+            available ones if less than 1.
+
+    Returns:
+        A 2-tuple of a ``(num_samples, num_variables)`` array of samples, in
+        the variable order of ``cqm``, and their energies, including the
+        penalties of the soft constraints. Both are ordered by increasing
+        energy.
+    """
+    if num_samples < 0:
+        raise ValueError("num_samples must be non-negative")
+
+    cdef vector[Sample[bias_type]] found
+    with nogil:
+        found = cpplowest_feasible(cqm.cppcqm, num_samples, rtol, atol, num_threads)
+
+    cdef Py_ssize_t num_variables = cqm.cppcqm.num_variables()
+
+    samples = np.empty((found.size(), num_variables), dtype=np.float64)
+    energies = np.empty(found.size(), dtype=np.float64)
+
+    cdef bias_type[:, ::1] samples_view = samples
+    cdef bias_type[::1] energies_view = energies
+
+    cdef Py_ssize_t si, vi
+    for si in range(samples_view.shape[0]):
+        for vi in range(num_variables):
+            samples_view[si, vi] = found[si].values[vi]
+        energies_view[si] = found[si].energy
+
+    return samples, energies
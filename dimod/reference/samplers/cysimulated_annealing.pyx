@@ -0,0 +1,81 @@
+# distutils: language = c++
+# cython: language_level=3
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from cython.operator cimport dereference as deref
+from libcpp.pair cimport pair
+from libcpp.vector cimport vector
+
+import numpy as np
+
+from dimod.cyqmbase.cyqmbase_float64 cimport cyQMBase_float64, bias_type
+from dimod.libcpp.simulated_annealing cimport default_beta_range, linear_beta_schedule
+from dimod.libcpp.simulated_annealing cimport sample as cppsample
+from dimod.typing cimport int8_t, uint64_t
+
+__all__ = ['simulated_annealing']
+
+
+def simulated_annealing(cyQMBase_float64 model, Py_ssize_t num_reads, Py_ssize_t num_sweeps,
+                        beta_range=None, *, uint64_t seed = 0, int num_threads = 1):
+    """Sample from a model with only binary and spin variables using simulated annealing.
+
+    Args:
+        model: The model to sample from.
+        num_reads: The number of samples, each from its own anneal.
+        num_sweeps: The number of sweeps of each anneal.
+        beta_range: A 2-tuple of the first and last values of beta, the schedule is
+            linear in beta. If not given, ``(0.1, 2 * max_sigma)`` where
+            ``max_sigma`` is the largest total absolute Ising bias of a variable.
+        seed: Seed of the random number streams of the reads.
+        num_threads: The maximum number of threads to use. All of the
+            available ones if less than 1.
+
+    Returns:
+        A 2-tuple of a ``(num_reads, num_variables)`` array of samples, in
+        the variable order of ``model``, and their energies.
+    """
+    if num_reads < 0:
+        raise ValueError("num_reads must be non-negative")
+    if num_sweeps < 0:
+        raise ValueError("num_sweeps must be non-negative")
+
+    cdef pair[double, double] betas_range
+    if beta_range is None:
+        betas_range = default_beta_range(deref(model.base))
+    else:
+        betas_range.first, betas_range.second = beta_range
+
+    cdef vector[double] betas = linear_beta_schedule(betas_range.first, betas_range.second,
+                                                     num_sweeps)
+
+    cdef Py_ssize_t num_variables = model.num_variables()
+
+    samples = np.empty((num_reads, num_variables), dtype=np.int8)
+    energies = np.empty(num_reads, dtype=np.float64)
+
+    cdef int8_t[:, ::1] samples_view = samples
+    cdef bias_type[::1] energies_view = energies
+
+    if num_reads == 0:
+        return samples, energies
+
+    cdef int8_t* samples_ptr = &samples_view[0, 0] if num_variables else NULL
+    with nogil:
+        cppsample(deref(model.base), betas, num_reads, seed, samples_ptr, &energies_view[0],
+                  num_threads)
+
+    return samples, energies
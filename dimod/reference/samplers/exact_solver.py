@@ -20,15 +20,18 @@ Note:
     energy for every possible sample, they are very slow.
 """
 from itertools import product
+from typing import Optional
 
 import numpy as np
 
 from dimod.binary.binary_quadratic_model import BinaryQuadraticModel
+from dimod.binary.cybqm import cyBQM_float32, cyBQM_float64
 from dimod.constrained import ConstrainedQuadraticModel
 from dimod.core.polysampler import PolySampler
 from dimod.core.sampler import Sampler
 from dimod.discrete.discrete_quadratic_model import DiscreteQuadraticModel
 from dimod.higherorder.polynomial import BinaryPolynomial
+from dimod.reference.samplers.cyexact_solver import lowest_feasible, lowest_states
 from dimod.sampleset import SampleSet
 from dimod.vartypes import Vartype
 
@@ -39,8 +42,12 @@ class ExactSolver(Sampler):
     """A simple exact solver for testing and debugging code using your local CPU.
 
     Notes:
-        This solver becomes slow for problems with 18 or more
-        variables.
+        The energies are calculated natively, visiting the samples in
+        Gray-code order so that each one costs time linear in the degree of a
+        single variable, and the samples are divided between the available
+        threads. The sample set of every possible sample becomes very large
+        for problems with 25 or more variables, use ``num_samples`` to keep
+        only the lowest-energy ones.
 
     Examples:
         This example solves a two-variable Ising model.
@@ -62,30 +69,53 @@ class ExactSolver(Sampler):
 
     def __init__(self):
         self.properties = {}
-        self.parameters = {}
+        self.parameters = {'num_samples': []}
 
-    def sample(self, bqm: BinaryQuadraticModel, **kwargs) -> SampleSet:
+    def sample(self, bqm: BinaryQuadraticModel, *,
+               num_samples: Optional[int] = None,
+               **kwargs) -> SampleSet:
         """Sample from a binary quadratic model.
 
         Args:
             bqm:
                 Binary quadratic model to be sampled from.
+            num_samples:
+                Maximum number of samples to return. If given, only the
+                ``num_samples`` lowest-energy samples are kept, which takes
+                memory proportional to ``num_samples`` rather than to the
+                number of possible samples.
 
         Returns:
-            All possible solutions to the binary quadratic model.
+            All possible solutions to the binary quadratic model, or the
+            ``num_samples`` lowest-energy ones.
 
         """
         kwargs = self.remove_unknown_kwargs(**kwargs)
 
+        if num_samples is not None and num_samples < 0:
+            raise ValueError("num_samples must be non-negative")
+
         if not len(bqm.variables):
             return SampleSet.from_samples([], bqm.vartype, energy=[])
 
+        if isinstance(bqm, BinaryQuadraticModel) and len(bqm.variables) < 64:
+            data = bqm.data
+            if isinstance(data, cyBQM_float32):
+                data = BinaryQuadraticModel(bqm, dtype=np.float64).data
+            if isinstance(data, cyBQM_float64):
+                return _sample_native(bqm, data, num_samples)
+
         samples = _graycode(bqm)
 
         if bqm.vartype is Vartype.SPIN:
             samples = 2*samples - 1
 
-        return SampleSet.from_samples_bqm((samples, list(bqm.variables)), bqm)
+        sampleset = SampleSet.from_samples_bqm((samples, list(bqm.variables)), bqm)
+
+        if num_samples is not None:
+            sampleset = sampleset.truncate(num_samples)
+
+        return sampleset
 
 
 class ExactPolySolver(PolySampler):
@@ -217,6 +247,7 @@ class ExactCQMSolver():
     def sample_cqm(self, cqm: ConstrainedQuadraticModel, *,
                    rtol: float = 1e-6,
                    atol: float = 1e-8,
+                   num_samples: Optional[int] = None,
                    **kwargs) -> SampleSet:
         """Sample from a constrained quadratic model.
 
@@ -230,23 +261,60 @@ class ExactCQMSolver():
             atol:
                 Absolute tolerance for constraint violations. A constant any
                 violation must be smaller than for the constraint to be satisfied.
+            num_samples:
+                Maximum number of samples to return. If given, only the
+                ``num_samples`` lowest-energy feasible samples are returned.
+                Assignments that cannot satisfy a hard linear constraint,
+                such as the one-hot constraint of a discrete variable, are
+                pruned as soon as they are made, so far fewer than all
+                possible samples are visited.
 
         Returns:
-            A sampleset of all possible samples, with the fields ``is_feasible``
+            A sampleset of all possible samples, or of the ``num_samples``
+            lowest-energy feasible ones, with the fields ``is_feasible``
             and ``is_satisfied`` containing total and individual constraint
             violation information, respectively.
 
         """
         Sampler.remove_unknown_kwargs(self, **kwargs)
 
+        if num_samples is not None and num_samples < 0:
+            raise ValueError("num_samples must be non-negative")
+
         if not len(cqm.variables):
             return SampleSet.from_samples([], 'INTEGER', energy=[])
 
+        if num_samples is not None:
+            for v in cqm.variables:
+                _iterator_by_vartype(cqm, v)  # raise for REAL variables
+
+            # threads only pay off once there are enough samples to split
+            samples, _ = lowest_feasible(cqm, num_samples, rtol=rtol, atol=atol,
+                                         num_threads=0 if len(cqm.variables) >= 16 else 1)
+
+            return SampleSet.from_samples_cqm((samples, list(cqm.variables)), cqm,
+                                              rtol=rtol, atol=atol, **kwargs)
+
         cases = _all_cases_cqm(cqm)
 
         return SampleSet.from_samples_cqm(cases, cqm, rtol=rtol, atol=atol, **kwargs)
 
 
+def _sample_native(bqm, data, num_samples):
+    """Sample from a BQM with float64 data using the native enumeration."""
+    n = len(bqm.variables)
+
+    if num_samples is None:
+        num_samples = 1 << n
+
+    # threads only pay off once there are enough states to split
+    num_threads = 0 if n >= 16 else 1
+
+    samples, energies = lowest_states(data, num_samples, num_threads)
+
+    return SampleSet.from_samples((samples, list(bqm.variables)), bqm.vartype, energy=energies)
+
+
 def _graycode(bqm):
     """Get a numpy array containing all possible samples in a gray-code order"""
     # developer note: there are better/faster ways to do this, but because
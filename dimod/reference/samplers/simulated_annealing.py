@@ -22,10 +22,14 @@ solving problems.
 import random
 import math
 
+import numpy as np
+
+from dimod.binary.binary_quadratic_model import BinaryQuadraticModel
+from dimod.binary.cybqm import cyBQM_float64
 from dimod.core.sampler import Sampler
+from dimod.reference.samplers.cysimulated_annealing import simulated_annealing
 from dimod.sampleset import SampleSet
 from dimod.utilities import ising_energy
-from dimod.vartypes import Vartype
 
 __all__ = ['SimulatedAnnealingSampler']
 
@@ -81,36 +85,32 @@ class SimulatedAnnealingSampler(Sampler):
             :obj:`~dimod.SampleSet`
 
         Note:
-            This is a reference implementation, not optimized for speed
-            and therefore not an appropriate sampler for benchmarking.
+            The reads are annealed natively and in parallel, each with its
+            own random number stream seeded from :mod:`random`, so
+            :func:`random.seed` makes the samples reproducible. Each sweep
+            visits the variables in order rather than by color class.
             For a more performant implementation of simulated annealing,
-            use the :obj:`neal.sampler.SimulatedAnnealingSampler` sampler. 
+            use the :obj:`neal.sampler.SimulatedAnnealingSampler` sampler.
 
         """
 
         # input checking
         # h, J are handled by the @ising decorator
-        # beta_range, sweeps are handled by ising_simulated_annealing
         if not isinstance(num_reads, int):
             raise TypeError("'samples' should be a positive integer")
         if num_reads < 1:
             raise ValueError("'samples' should be a positive integer")
+        _check_schedule(beta_range, num_sweeps)
 
         kwargs = self.remove_unknown_kwargs(**kwargs)
 
-        h, J, offset = bqm.to_ising()
+        if not isinstance(bqm.data, cyBQM_float64):
+            bqm = BinaryQuadraticModel(bqm, dtype=np.float64)
 
-        # run the simulated annealing algorithm
-        samples = []
-        energies = []
-        for __ in range(num_reads):
-            sample, energy = ising_simulated_annealing(h, J, beta_range, num_sweeps)
-            samples.append(sample)
-            energies.append(energy)
+        samples, energies = simulated_annealing(bqm.data, num_reads, num_sweeps, beta_range,
+                                                seed=random.getrandbits(64), num_threads=0)
 
-        response = SampleSet.from_samples(samples, Vartype.SPIN, energies)
-        response.change_vartype(bqm.vartype, offset, inplace=True)
-        return response
+        return SampleSet.from_samples((samples, list(bqm.variables)), bqm.vartype, energies)
 
 
 def ising_simulated_annealing(h, J, beta_range=None, num_sweeps=1000):
@@ -148,6 +148,8 @@ def ising_simulated_annealing(h, J, beta_range=None, num_sweeps=1000):
 
     """
 
+    _check_schedule(beta_range, num_sweeps)
+
     if beta_range is None:
         beta_init = .1
 
@@ -162,19 +164,7 @@ def ising_simulated_annealing(h, J, beta_range=None, num_sweeps=1000):
             beta_final = 0.0
 
     else:
-        if not isinstance(beta_range, (tuple, list)):
-            raise TypeError("'beta_range' should be a tuple of length 2")
-        if any(not isinstance(b, (int, float)) for b in beta_range):
-            raise TypeError("values in 'beta_range' should be numeric")
-        if any(b <= 0 for b in beta_range):
-            raise ValueError("beta values in 'beta_range' should be positive")
-        if len(beta_range) != 2:
-            raise ValueError("'beta_range' should be a tuple of length 2")
         beta_init, beta_final = beta_range
-    if not isinstance(num_sweeps, int):
-        raise TypeError("'sweeps' should be a positive int")
-    if num_sweeps <= 0:
-        raise ValueError("'sweeps' should be a positive int")
 
     # We want the schedule to be linear in beta (inverse temperature)
     betas = [beta_init + i * (beta_final - beta_init) / (num_sweeps - 1.)
@@ -231,6 +221,23 @@ def ising_simulated_annealing(h, J, beta_range=None, num_sweeps=1000):
     return spins, ising_energy(spins, h, J)
 
 
+def _check_schedule(beta_range, num_sweeps):
+    """Raise an exception if `beta_range` or `num_sweeps` is invalid."""
+    if beta_range is not None:
+        if not isinstance(beta_range, (tuple, list)):
+            raise TypeError("'beta_range' should be a tuple of length 2")
+        if any(not isinstance(b, (int, float)) for b in beta_range):
+            raise TypeError("values in 'beta_range' should be numeric")
+        if any(b <= 0 for b in beta_range):
+            raise ValueError("beta values in 'beta_range' should be positive")
+        if len(beta_range) != 2:
+            raise ValueError("'beta_range' should be a tuple of length 2")
+    if not isinstance(num_sweeps, int):
+        raise TypeError("'sweeps' should be a positive int")
+    if num_sweeps <= 0:
+        raise ValueError("'sweeps' should be a positive int")
+
+
 def greedy_coloring(adj):
     """Determines a vertex coloring.
 
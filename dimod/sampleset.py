@@ -32,6 +32,7 @@ import numpy as np
 
 from numpy.lib import recfunctions
 
+from dimod.cysampleset import aggregate_samples
 from dimod.exceptions import WriteableError
 from dimod.serialization.format import Formatter
 from dimod.serialization.utils import (pack_samples as _pack_samples,
@@ -40,7 +41,6 @@ from dimod.serialization.utils import (pack_samples as _pack_samples,
                                        deserialize_ndarray,
                                        serialize_ndarrays,
                                        deserialize_ndarrays)
-from dimod.sym import Sense
 from dimod.typing import ArrayLike, DTypeLike, SampleLike, SamplesLike, Variable
 from dimod.variables import Variables, iter_deserialize_variables
 from dimod.vartypes import as_vartype, Vartype, DISCRETE
@@ -883,45 +883,34 @@ class SampleSet(abc.Iterable, abc.Sized):
 
         energies = cqm.objective.energies(samples_like)
 
-        constraint_labels = []
-        is_satisfied = np.empty((samples.shape[0], len(cqm.constraints)), dtype=bool)
-        soft = set()
-        for i, (label, comparison) in enumerate(cqm.constraints.items()):
-            constraint_labels.append(label)
-
-            lhs = comparison.lhs.energies(samples_like)
-            rhs = comparison.rhs
-            sense = comparison.sense
-            if sense is Sense.Eq:
-                violation = np.abs(lhs - rhs)
-            elif sense is Sense.Ge:
-                violation = rhs - lhs
-            elif sense is Sense.Le:
-                violation = lhs - rhs
-            else:
-                raise RuntimeError("unexpected sense")
+        # the violations of all of the constraints are calculated in one pass
+        violations = cqm._violations(samples_like)
 
-            is_satisfied[:, i] = violation <= atol + rtol*abs(rhs)
+        constraint_labels = list(cqm.constraint_labels)
+        rhs = np.fromiter((comparison.rhs for comparison in cqm.constraints.values()),
+                          dtype=np.float64, count=len(constraint_labels))
 
-            if comparison.lhs.is_soft() and not is_satisfied.all():
-                weight = comparison.lhs.weight()
-                penalty = comparison.lhs.penalty()
+        is_satisfied = violations <= atol + rtol*np.abs(rhs)
 
-                if penalty == 'linear':
-                    energies += weight * (is_satisfied[:, i] != True) * violation
-                elif penalty == 'quadratic':
-                    energies += weight * (is_satisfied[:, i] != True) * np.power(violation, 2)
-                else:
-                    raise RuntimeError("unexpected penalty")
+        soft = np.zeros(len(constraint_labels), dtype=bool)
+        for i, comparison in enumerate(cqm.constraints.values()):
+            if not comparison.lhs.is_soft():
+                continue
 
-                soft.add(label)
+            soft[i] = True
 
-        if soft:
-            hard = [i for i, label in enumerate(constraint_labels) if label not in soft]
-            is_feasible = is_satisfied[:, hard].all(axis=1)
-        else:
-            # no soft constraints to worry about
-            is_feasible = is_satisfied.all(axis=1)
+            weight = comparison.lhs.weight()
+            penalty = comparison.lhs.penalty()
+
+            if penalty == 'linear':
+                energies += weight * (is_satisfied[:, i] != True) * violations[:, i]
+            elif penalty == 'quadratic':
+                energies += weight * (is_satisfied[:, i] != True) * np.power(violations[:, i], 2)
+            else:
+                raise RuntimeError("unexpected penalty")
+
+        # soft constraints do not affect feasibility
+        is_feasible = is_satisfied[:, ~soft].all(axis=1)
 
         kwargs.setdefault('info', {})['constraint_labels'] = constraint_labels
 
@@ -1522,24 +1511,14 @@ class SampleSet(abc.Iterable, abc.Sized):
             1  1  1  1      1       1
             ['BINARY', 2 rows, 3 samples, 3 variables]
         """
-        _, indices, inverse = np.unique(self.record.sample, axis=0,
-                                        return_index=True, return_inverse=True)
-
-        # unique also sorts the array which we don't want, so we undo the sort
-        order = np.argsort(indices)
-        indices = indices[order]
-
-        # and on the inverse
-        revorder = np.empty(len(order), dtype=order.dtype)
-        revorder[order] = np.arange(len(order))
-        inverse = revorder[inverse]
+        indices, inverse = self._unique_samples()
 
         record = self.record[indices]
 
         # fix the number of occurrences
-        record.num_occurrences = 0
-        for old_idx, new_idx in enumerate(inverse):
-            record["num_occurrences"][new_idx] += self.record[old_idx].num_occurrences
+        num_occurrences = np.zeros(len(indices), dtype=record.num_occurrences.dtype)
+        np.add.at(num_occurrences, inverse, self.record.num_occurrences)
+        record.num_occurrences = num_occurrences
 
         # dev note: we don't check the energies as they should be the same
         # for individual samples
@@ -1547,6 +1526,34 @@ class SampleSet(abc.Iterable, abc.Sized):
         return type(self)(record, self.variables, copy.deepcopy(self.info),
                           self.vartype)
 
+    def _unique_samples(self):
+        """Return the indices of the first occurrence of each distinct sample,
+        in the order they occur, and the inverse of the samples."""
+        samples = self.record.sample
+
+        if self.vartype is Vartype.SPIN or self.vartype is Vartype.BINARY:
+            low = -1 if self.vartype is Vartype.SPIN else 0
+            try:
+                # packs the samples and deduplicates them in one pass
+                return aggregate_samples(samples, low, 1)
+            except (TypeError, ValueError):
+                # dtypes without a kernel or samples with other values
+                pass
+
+        _, indices, inverse = np.unique(samples, axis=0,
+                                        return_index=True, return_inverse=True)
+
+        # unique also sorts the array which we don't want, so we undo the sort
+        order = np.argsort(indices)
+        indices = indices[order]
+
+        # and on the inverse
+        revorder = np.empty(len(order), dtype=order.dtype)
+        revorder[order] = np.arange(len(order))
+        inverse = revorder[inverse.reshape(-1)]
+
+        return indices, inverse
+
     def append_variables(self, samples_like, sort_labels=True):
         """Deprecated in favor of `dimod.append_variables`."""
 
@@ -1739,8 +1746,13 @@ class SampleSet(abc.Iterable, abc.Sized):
         if sorted_by is None:
             record = self.record[selector]
         else:
-            sort_indices = np.argsort(self.record[sorted_by])
-            record = self.record[sort_indices[selector]]
+            keys = self.record[sorted_by]
+
+            sort_indices = _lowest_indices(keys, selector)
+            if sort_indices is None:
+                sort_indices = np.argsort(keys)[selector]
+
+            record = self.record[sort_indices]
 
         return type(self)(record, self.variables, copy.deepcopy(self.info),
                           self.vartype)
@@ -1951,6 +1963,32 @@ class SampleSet(abc.Iterable, abc.Sized):
         return df
 
 
+def _lowest_indices(keys: np.ndarray, selector: slice) -> Optional[np.ndarray]:
+    """Return the indices of the `k` lowest keys in order, if `selector` is a
+    prefix ``slice(k)`` shorter than `keys`, otherwise None.
+
+    Only the `k` selected keys are sorted, so taking a few samples from a large
+    sample set is linear in its size. Ties are broken by index.
+    """
+    k = selector.stop
+    if (selector.start not in (None, 0) or selector.step not in (None, 1)
+            or not isinstance(k, numbers.Integral) or not 0 < k < len(keys)
+            or keys.ndim != 1):
+        return None
+
+    kth = keys[np.argpartition(keys, k - 1)[k - 1]]
+    if kth != kth:
+        # NaN, which does not compare equal to itself
+        return None
+
+    lower = np.flatnonzero(keys < kth)
+    ties = np.flatnonzero(keys == kth)[:k - len(lower)]
+    indices = np.concatenate((lower, ties))
+    indices.sort()
+
+    return indices[np.argsort(keys[indices], kind='stable')]
+
+
 @as_samples.register(SampleSet)
 def _as_samples_sampleset(samples_like: SampleSet,
                           dtype: Optional[DTypeLike] = None,
@@ -75,6 +75,8 @@ import warnings
 
 from numbers import Integral
 
+import numpy as np
+
 from dimod.vartypes import Vartype
 from dimod.binary_quadratic_model import BinaryQuadraticModel
 
@@ -217,15 +219,26 @@ def load(fp: typing.TextIO, cls: None = None,
     if vartype is None:
         raise ValueError("vartype must be provided either as a header or as an argument")
 
-    bqm = BinaryQuadraticModel.empty(vartype)
-
-    for u, v, bias in triplets:
-        if u == v:
-            bqm.add_variable(int(u), float(bias))
-        else:
-            bqm.add_interaction(int(u), int(v), float(bias))
-
-    return bqm
+    # variables are indexed in order of first appearance
+    labels = {}
+    irow = np.empty(len(triplets), dtype=np.intc)
+    icol = np.empty(len(triplets), dtype=np.intc)
+    qdata = np.empty(len(triplets), dtype=np.float64)
+    for i, (u, v, bias) in enumerate(triplets):
+        irow[i] = labels.setdefault(int(u), len(labels))
+        icol[i] = labels.setdefault(int(v), len(labels))
+        qdata[i] = float(bias)
+
+    # diagonal entries are linear biases, the rest are handed to the bulk
+    # COO constructor in one go
+    diagonal = irow == icol
+    ldata = np.zeros(len(labels), dtype=np.float64)
+    np.add.at(ldata, irow[diagonal], qdata[diagonal])
+
+    offdiagonal = ~diagonal
+    return BinaryQuadraticModel.from_numpy_vectors(
+        ldata, (irow[offdiagonal], icol[offdiagonal], qdata[offdiagonal]), 0.0, vartype,
+        variable_order=list(labels))
 
 
 def _iter_triplets(bqm, vartype_header):
@@ -1,10 +0,0 @@
-#ifndef __READERLP_READER_HPP__
-#define __READERLP_READER_HPP__
-
-#include <string>
-
-#include "model.hpp"
-
-Model readinstance(std::string filename);
-
-#endif
@@ -21,12 +21,12 @@ from setuptools.command.build_ext import build_ext as _build_ext
 
 extra_compile_args = {
     'msvc': ['/EHsc'],
-    'unix': ['-std=c++11', '-g1'],
+    'unix': ['-std=c++11', '-g1', '-pthread'],
 }
 
 extra_link_args = {
     'msvc': [],
-    'unix': ['-std=c++11', '-g1'],
+    'unix': ['-std=c++11', '-g1', '-pthread'],
 }
 
 
@@ -42,6 +42,11 @@ class build_ext(_build_ext):
         for ext in self.extensions:
             ext.extra_link_args.extend(link_args)
 
+        # the hot-path counters are opt-in, see dimod/include/dimod/instrumentation.h
+        if os.getenv('DIMOD_ENABLE_COUNTERS'):
+            for ext in self.extensions:
+                ext.define_macros.append(('DIMOD_ENABLE_COUNTERS', None))
+
         super().build_extensions()
 
     def finalize_options(self):
@@ -67,7 +72,10 @@ setup(
          'dimod/constrained/*.pyx',
          'dimod/cyqmbase/*.pyx',
          'dimod/discrete/cydiscrete_quadratic_model.pyx',
+         'dimod/generators/cyrandom.pyx',
+         'dimod/higherorder/*.pyx',
          'dimod/quadratic/cyqm/*.pyx',
+         'dimod/reference/samplers/*.pyx',
          'dimod/*.pyx',
          ],
         annotate=True,
@@ -167,6 +167,19 @@ class TestAddInteractionsFrom(unittest.TestCase):
         self.assertEqual(bqm.adj, {'a': {'b': -.5},
                                    'b': {'a': -.5}})
 
+    @parameterized.expand(BQMs.items())
+    def test_order_and_duplicates(self, name, BQM):
+        bqm = BQM({'a': 0}, {}, 0, dimod.BINARY)
+        bqm.add_interactions_from(iter([('c', 'a', 1), ('b', 'c', 2), ('a', 'c', 3)]))
+        self.assertEqual(bqm.variables, 'acb')
+        self.assertEqual(bqm.adj, {'a': {'c': 4}, 'b': {'c': 2}, 'c': {'a': 4, 'b': 2}})
+
+    @parameterized.expand(BQMs.items())
+    def test_self_loop(self, name, BQM):
+        bqm = BQM(dimod.SPIN)
+        with self.assertRaises(ValueError):
+            bqm.add_interactions_from([('a', 'a', -.5)])
+
 
 class TestAdjacency(unittest.TestCase):
     @parameterized.expand(BQMs.items())
@@ -915,6 +928,77 @@ class TestCoo(unittest.TestCase):
         self.assertEqual(bqm, new_bqm)
 
 
+class TestCSR(unittest.TestCase):
+    @parameterized.expand(BQMs.items())
+    def test_to_csr(self, name, BQM):
+        bqm = BQM({'a': 1}, {'ab': 1, 'bc': -1, 'ac': .5}, 1.5, dimod.SPIN)
+
+        indptr, indices, data = bqm.to_csr()
+        np.testing.assert_array_equal(indptr, [0, 2, 3, 3])
+        np.testing.assert_array_equal(indices, [1, 2, 2])
+        np.testing.assert_array_equal(data, [1, .5, -1])
+        self.assertEqual(indptr.dtype, np.int64)
+
+        indptr, indices, data = bqm.to_csr(upper_triangular=False)
+        np.testing.assert_array_equal(indptr, [0, 2, 4, 6])
+        np.testing.assert_array_equal(indices, [1, 2, 0, 2, 0, 1])
+        np.testing.assert_array_equal(data, [1, .5, 1, -1, .5, -1])
+
+    @parameterized.expand(BQMs.items())
+    def test_to_csr_linear(self, name, BQM):
+        bqm = BQM({'a': 1, 'b': -1}, {}, 0, dimod.BINARY)
+
+        indptr, indices, data = bqm.to_csr()
+        np.testing.assert_array_equal(indptr, [0, 0, 0])
+        self.assertEqual(len(indices), 0)
+        self.assertEqual(len(data), 0)
+
+    @parameterized.expand(BQMs.items())
+    def test_round_trip(self, name, BQM):
+        bqm = BQM({'a': 1}, {'ab': 1, 'bc': -1, 'ac': .5}, 1.5, dimod.BINARY)
+
+        new = BQM(bqm.linear, {}, bqm.offset, dimod.BINARY)
+        new.add_quadratic_from_csr(*bqm.to_csr())
+        self.assertEqual(new, bqm)
+
+        # a symmetric matrix has each interaction added twice
+        new = BQM(bqm.linear, {}, bqm.offset, dimod.BINARY)
+        new.add_quadratic_from_csr(*bqm.to_csr(upper_triangular=False))
+        self.assertEqual(new.quadratic, {uv: 2*bias for uv, bias in bqm.quadratic.items()})
+        self.assertEqual(new.linear, bqm.linear)
+        self.assertEqual(new.offset, bqm.offset)
+
+    @parameterized.expand(BQMs.items())
+    def test_add_quadratic_from_csr(self, name, BQM):
+        bqm = BQM(4, dimod.SPIN)
+        bqm.add_quadratic_from_csr([0, 2, 2, 4], np.array([3, 1, 0, 1], dtype=np.uint8),
+                                   [1, 2, 3, 4])
+
+        self.assertEqual(bqm.quadratic, {(0, 3): 1, (0, 1): 2, (2, 0): 3, (2, 1): 4})
+        self.assertEqual(bqm.linear, {0: 0, 1: 0, 2: 0, 3: 0})
+        self.assertEqual(bqm.offset, 0)
+
+        # explicit zeros on the diagonal are fine
+        bqm.add_quadratic_from_csr([0, 2], [0, 1], [0, 1])
+        self.assertEqual(bqm.quadratic[0, 1], 3)
+
+    @parameterized.expand(BQMs.items())
+    def test_add_quadratic_from_csr_invalid(self, name, BQM):
+        bqm = BQM(3, dimod.SPIN)
+
+        with self.subTest("self-loop"):
+            with self.assertRaises(ValueError):
+                bqm.add_quadratic_from_csr([0, 0, 1], [1], [1])
+        with self.subTest("too many rows"):
+            with self.assertRaises(ValueError):
+                bqm.add_quadratic_from_csr([0, 0, 0, 0, 0], [], [])
+        with self.subTest("out of range column"):
+            with self.assertRaises(ValueError):
+                bqm.add_quadratic_from_csr([0, 1], [3], [1])
+
+        self.assertEqual(bqm.num_interactions, 0)
+
+
 class TestDegree(unittest.TestCase):
     @parameterized.expand(BQM_CLSs.items())
     def test_degrees(self, name, BQM):
@@ -1247,6 +1331,51 @@ class TestFileView(unittest.TestCase):
 
         self.assertEqual(bqm, new)
 
+    @parameterized.expand(BQM_CLSs.items())
+    def test_csr_empty(self, name, BQM):
+        bqm = BQM('BINARY')
+        bqm.offset = 1.5
+
+        with bqm.to_file(version=3) as f:
+            new = BQM.from_file(f)
+
+        self.assertEqual(bqm, new)
+
+    @parameterized.expand(BQM_CLSs.items())
+    def test_csr_labelled(self, name, BQM):
+        bqm = BQM({'a': .1, 'b': -.2, 'c': 0}, {'ab': -1, 'bc': 3, 'ca': 2}, 1.5, 'SPIN')
+
+        with bqm.to_file(version=3) as f:
+            new = BQM.from_file(f)
+
+        self.assertEqual(bqm, new)
+        self.assertEqual(bqm.variables, new.variables)
+
+        with bqm.to_file(version=(3, 0), ignore_labels=True) as f:
+            new = BQM.from_file(f)
+
+        self.assertEqual(new.variables, range(3))
+        self.assertEqual(bqm.energies(np.ones((1, 3))), new.energies(np.ones((1, 3))))
+
+    def test_csr_layout(self):
+        bqm = dimod.BinaryQuadraticModel({0: 1, 1: 2}, {(0, 1): -1, (1, 2): 3}, 0, 'SPIN')
+
+        with bqm.to_file(version=3) as f:
+            header = dimod.serialization.fileview.read_header(f, b'DIMODBQM')
+            self.assertEqual(header.version, (3, 0))
+            self.assertEqual(header.data['ntype'], 'int64')
+            self.assertEqual(f.tell() % 64, 0)
+
+            f.seek(0)
+            buff = f.read()
+
+        self.assertEqual(len(buff) % 64, 0)
+
+        # the neighborhood starts are followed by the neighbors and the biases
+        start = -3*64
+        np.testing.assert_array_equal(
+            np.frombuffer(buff[start:start+4*8], dtype='<i8'), [0, 1, 3, 4])
+
 
 class TestFixVariable(unittest.TestCase):
     @parameterized.expand(BQMs.items())
@@ -1629,6 +1758,60 @@ class TestLen(unittest.TestCase):
         self.assertEqual(len(bqm), 107)
 
 
+class TestLocalFieldState(unittest.TestCase):
+    @parameterized.expand([(np.float32,), (np.float64,)])
+    def test_flip(self, dtype):
+        bqm = BinaryQuadraticModel({'a': 1, 'b': -2, 'c': 3},
+                                   {'ab': 1, 'bc': -2, 'ac': .5},
+                                   1.5, 'SPIN', dtype=dtype)
+
+        sample = {'c': -1, 'a': +1, 'b': -1}
+        state = bqm.data.local_field_state(sample)
+
+        self.assertAlmostEqual(state.energy(), bqm.energy(sample))
+        self.assertEqual(state.local_field('a'), 1 + 1 * -1 + .5 * -1)
+
+        for v in 'abcba':
+            delta = state.delta_flip(v)
+            energy = state.energy()
+
+            sample[v] *= -1
+            self.assertEqual(state.flip(v), sample[v])
+            self.assertAlmostEqual(state.energy(), energy + delta, places=5)
+            self.assertAlmostEqual(state.energy(), bqm.energy(sample), places=5)
+
+        self.assertEqual(state.sample(), sample)
+
+    def test_integer(self):
+        qm = dimod.QuadraticModel()
+        i, j = 'ij'
+        qm.add_variables_from('INTEGER', 'ij')
+        qm.set_upper_bound(i, 5)
+        qm.add_quadratic(i, i, 2)
+        qm.add_quadratic(i, j, -1)
+        qm.add_linear(j, 3)
+
+        state = qm.data.local_field_state({i: 1, j: 2})
+
+        self.assertEqual(state.delta(i, 3), qm.energy({i: 3, j: 2}) - qm.energy({i: 1, j: 2}))
+        state.apply(i, 3)
+        self.assertEqual(state.energy(), qm.energy({i: 3, j: 2}))
+        self.assertEqual(state.value(i), 3)
+
+        with self.assertRaises(IndexError):
+            state.apply(i, 6)  # out of bounds
+
+        with self.assertRaises(RuntimeError):
+            state.flip(i)  # integer variables cannot be flipped
+
+    def test_modified(self):
+        bqm = BinaryQuadraticModel({'a': 1}, {}, 0, 'BINARY')
+        state = bqm.data.local_field_state({'a': 0})
+        bqm.add_variable('b')
+        with self.assertRaises(RuntimeError):
+            state.flip('a')
+
+
 class TestNBytes(unittest.TestCase):
     @parameterized.expand(BQMs.items())
     def test_small(self, name, BQM):
@@ -1651,6 +1834,42 @@ class TestNBytes(unittest.TestCase):
         self.assertGreaterEqual(bqm.nbytes(True), bqm.nbytes(False))
 
 
+class TestMemoryUsage(unittest.TestCase):
+    @parameterized.expand(BQMs.items())
+    def test_small(self, name, BQM):
+        bqm = BQM({'a': 1}, {'ab': 1, 'bc': 1}, 1.5, dimod.BINARY)
+
+        if bqm.dtype == object:
+            with self.assertRaises(TypeError):
+                bqm.memory_usage()
+            return
+
+        usage = bqm.memory_usage()
+
+        itemsize = bqm.dtype.itemsize
+        self.assertEqual(usage['linear'], (bqm.num_variables + 1)*itemsize)
+        self.assertGreater(usage['quadratic'], 2*bqm.num_interactions*(2*itemsize))
+        self.assertGreater(usage['labels'], 0)
+        self.assertEqual(usage['total'], sum(b for k, b in usage.items() if k != 'total'))
+        self.assertGreater(usage['total'], bqm.nbytes())
+        self.assertGreaterEqual(bqm.memory_usage(True)['total'], usage['total'])
+
+    def test_counters(self):
+        bqm = dimod.BinaryQuadraticModel('BINARY')
+        bqm.data.counters(reset=True)
+
+        bqm.add_quadratic('a', 'b', 1)
+        bqm.add_quadratic('a', 'b', 1)
+
+        counters = bqm.data.counters()
+        if counters['enabled']:
+            self.assertEqual(counters['quadratic_inserts'], 2)
+            self.assertEqual(counters['quadratic_hits'], 2)
+        else:
+            self.assertEqual(counters['quadratic_inserts'], 0)
+            self.assertEqual(counters['quadratic_hits'], 0)
+
+
 class TestNetworkxGraph(unittest.TestCase):
     def setUp(self):
         try:
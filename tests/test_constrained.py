@@ -12,6 +12,7 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+import io
 import itertools
 import json
 import numbers
@@ -607,6 +608,18 @@ class TestFixVariables(unittest.TestCase):
         self.assertEqual(set(new.discrete), {d1})
         self.assertEqual(set(cqm.discrete), {d1})
 
+    def test_discrete(self):
+        cqm = CQM()
+        cqm.add_discrete('xyz', label='one')
+        cqm.add_discrete('abc', label='zero')
+
+        cqm.fix_variables({'x': 1, 'a': 0})
+
+        y, z = dimod.Binaries('yz')
+        self.assertTrue(cqm.constraints['one'].lhs.is_equal(1 + y + z))
+        self.assertNotIn('one', cqm.discrete)  # sum(rest) == 0 is not one-hot
+        self.assertIn('zero', cqm.discrete)
+
 
 class TestFlipVariable(unittest.TestCase):
     def test_exceptions(self):
@@ -1010,6 +1023,36 @@ class TestFromDQM(unittest.TestCase):
             self.assertTrue(cqm.constraints[v].lhs.is_discrete())
 
 
+class TestMemoryUsage(unittest.TestCase):
+    def test_breakdown(self):
+        x, y, z = dimod.Binaries('xyz')
+        i = dimod.Integer('i', upper_bound=5)
+
+        cqm = dimod.ConstrainedQuadraticModel()
+        cqm.set_objective(x*y + i)
+        cqm.add_constraint(x + y + z <= 1, label='c0')
+        cqm.add_constraint(i - 2*x >= 0, label='c1')
+
+        usage = cqm.memory_usage()
+
+        self.assertGreater(usage['objective']['quadratic'], 0)
+        self.assertGreater(usage['constraints']['linear'], 0)
+        self.assertGreater(usage['constraints']['other'], 0)  # the constraints' metadata
+        self.assertGreater(usage['variables'], 0)
+        self.assertGreater(usage['labels'], 0)
+
+        self.assertEqual(usage['total'],
+                         usage['objective']['total'] + usage['constraints']['total']
+                         + usage['variables'] + usage['labels'])
+
+        self.assertGreaterEqual(cqm.memory_usage(capacity=True)['total'], usage['total'])
+
+        # removing a constraint frees its memory
+        cqm.remove_constraint('c0')
+        self.assertLess(cqm.memory_usage()['constraints']['total'],
+                        usage['constraints']['total'])
+
+
 class TestNumBiases(unittest.TestCase):
     def test_simple(self):
         x, y, z = dimod.Binaries('xyz')
@@ -1171,6 +1214,73 @@ class TestRemoveConstraint(unittest.TestCase):
             constraint.lhs.get_linear('x')
 
 
+class TestRemoveVariables(unittest.TestCase):
+    def test_simple(self):
+        i, j, k, m = dimod.Integers('ijkm')
+        x, y = dimod.Binaries('xy')
+
+        cqm = CQM()
+        cqm.set_objective(i + 2*j + 3*k*m + x)
+        c0 = cqm.add_constraint(i + j*k + m <= 5, label='c0')
+        c1 = cqm.add_constraint(k - x >= 1, label='c1')
+        c2 = cqm.add_discrete(x + y == 1, label='c2')
+
+        cqm.remove_variables(['j', 'm', 'j'])
+
+        self.assertEqual(cqm.variables, ['i', 'k', 'x', 'y'])
+        self.assertEqual(cqm.objective.linear, {'i': 1, 'x': 1, 'k': 0})
+        self.assertEqual(cqm.objective.quadratic, {})
+        self.assertEqual(cqm.constraints[c0].lhs.linear, {'i': 1, 'k': 0})
+        self.assertEqual(cqm.constraints[c0].lhs.quadratic, {})
+        self.assertEqual(cqm.constraints[c1].lhs.linear, {'k': 1, 'x': -1})
+        self.assertEqual(cqm.vartype('k'), dimod.INTEGER)
+        self.assertEqual(cqm.vartype('y'), dimod.BINARY)
+
+    def test_discrete(self):
+        x, y, z = dimod.Binaries('xyz')
+
+        cqm = CQM()
+        cqm.add_discrete(x + y == 1, label='c0')
+        cqm.set_objective(z)
+
+        with self.assertRaises(ValueError):
+            cqm.remove_variables(['z', 'x'])
+        self.assertEqual(cqm.variables, 'xyz')
+
+        cqm.remove_variables(['z'])
+        self.assertEqual(cqm.variables, 'xy')
+
+    def test_fix_variables_inplace(self):
+        i, j, k = dimod.Integers('ijk')
+
+        cqm = CQM()
+        cqm.set_objective(i + 2*j + 3*j*k)
+        c0 = cqm.add_constraint(i*j + k <= 5, label='c0')
+
+        cqm.fix_variables({'j': 2, 'i': 3})
+
+        self.assertEqual(cqm.variables, ['k'])
+        self.assertEqual(cqm.objective.linear, {'k': 6})
+        self.assertEqual(cqm.objective.offset, 7)
+        self.assertEqual(cqm.constraints[c0].lhs.linear, {'k': 1})
+        self.assertEqual(cqm.constraints[c0].lhs.offset, 6)
+
+    def test_fix_variables_inplace_many_constraints(self):
+        x = dimod.Binaries(range(20))
+
+        cqm = CQM()
+        cqm.set_objective(sum(x[v] * x[v + 1] for v in range(19)))
+        for v in range(0, 18, 3):
+            cqm.add_discrete([v, v + 1, v + 2], label=v)
+
+        fixed = {v: v % 4 == 0 for v in range(0, 20, 2)}
+        new = cqm.fix_variables(fixed, inplace=False)
+        cqm.fix_variables(fixed)
+
+        self.assertTrue(cqm.is_equal(new))
+        self.assertEqual(set(cqm.discrete), set(new.discrete))
+
+
 class TestSpinToBinary(unittest.TestCase):
     def test_simple(self):
         cqm = CQM()
@@ -1256,6 +1366,75 @@ class TestSerialization(unittest.TestCase):
             new = CQM.from_file(f)
         self.assertEqual(len(new.variables), 0)
 
+    def test_functional_version_3(self):
+        cqm = CQM()
+
+        bqm = BQM({'a': -1}, {'ab': 1}, 1.5, 'SPIN')
+        cqm.add_constraint(bqm, '<=', label='first')
+        cqm.add_constraint(bqm, '>=', weight=3, penalty='quadratic')
+        cqm.set_objective(BQM({'c': -1}, {}, 'SPIN'))
+        cqm.add_constraint(Spin('a')*Integer('d', lower_bound=-3)*5 <= 3, label=('a', 1))
+        cqm.add_discrete('efg')
+
+        for num_threads in [1, 2]:
+            with self.subTest(num_threads=num_threads):
+                with cqm.to_file(version=(3, 0), num_threads=num_threads) as f:
+                    new = CQM.from_file(f)
+
+                self.assertTrue(new.is_equal(cqm))
+                self.assertEqual(list(new.variables), list(cqm.variables))
+                self.assertEqual(list(new.constraints), list(cqm.constraints))
+                self.assertEqual(new.lower_bound('d'), -3)
+                for label, constraint in cqm.constraints.items():
+                    self.assertEqual(constraint.lhs.weight(), new.constraints[label].lhs.weight())
+                    self.assertEqual(constraint.lhs.is_discrete(),
+                                     new.constraints[label].lhs.is_discrete())
+
+        with self.subTest("empty"):
+            with CQM().to_file(version=(3, 0)) as f:
+                new = CQM.from_file(f)
+            self.assertEqual(len(new.variables), 0)
+            self.assertEqual(len(new.constraints), 0)
+
+        with self.subTest("compress"):
+            with self.assertRaises(ValueError):
+                cqm.to_file(version=(3, 0), compress=True)
+
+        with self.subTest("blocks are read one at a time"):
+            class RecordingFile(io.BytesIO):
+                def read(self, n=-1):
+                    data = super().read(n)
+                    self.reads.append(len(data))
+                    return data
+
+            with cqm.to_file(version=(3, 0)) as f:
+                data = f.read()
+
+            # the model follows some other data in the file
+            file = RecordingFile(b'prefix' + data)
+            file.seek(6)
+            file.reads = []
+            new = CQM.from_file(file)
+
+            self.assertTrue(new.is_equal(cqm))
+            self.assertEqual(list(new.constraints), list(cqm.constraints))
+            self.assertLess(max(file.reads), len(data) / 2)
+
+            self.assertTrue(CQM.from_file(data).is_equal(cqm))
+
+        with self.subTest("errors raised by the file are propagated"):
+            class FailingFile(io.BytesIO):
+                def write(self, data):
+                    raise OSError("disk is full")
+
+            with self.assertRaisesRegex(OSError, "disk is full"):
+                cqm._to_file_native(FailingFile())
+
+            with cqm.to_file(version=(3, 0)) as f:
+                data = f.read()
+            with self.assertRaisesRegex(ValueError, "truncated"):
+                CQM._from_file_native(io.BytesIO(data), 0, len(data) + 10)
+
     def test_functional_discrete(self):
         cqm = CQM()
 
@@ -218,6 +218,36 @@ class TestEnergy(unittest.TestCase):
         np.testing.assert_array_equal([0.0, 5.0, 0.0, 1.5, 0.0, 0.0, 0.0, 1.5,
                                        107.0, 0.0, 0.0, 1.5], energies)
 
+    def test_energies_after_changes(self):
+        dqm = dimod.DQM()
+        u = dqm.add_variable(3)
+        v = dqm.add_variable(2)
+        dqm.set_quadratic_case(u, 2, v, 1, 4)
+
+        samples = [[2, 1], [0, 0]]
+        np.testing.assert_array_equal(dqm.energies(samples), [4, 0])
+
+        # every kind of change is reflected in the next call
+        dqm.set_linear_case(u, 0, -1)
+        np.testing.assert_array_equal(dqm.energies(samples), [4, -1])
+        dqm.set_quadratic(u, v, {(0, 0): 2})
+        np.testing.assert_array_equal(dqm.energies(samples), [4, 1])
+        dqm.offset = 10
+        np.testing.assert_array_equal(dqm.energies(samples), [14, 11])
+        dqm.add_linear_equality_constraint([(u, 0, 1)], 1, 0)
+        np.testing.assert_array_equal(dqm.energies(samples), [14, 12])
+
+        w = dqm.add_variable(2)
+        np.testing.assert_array_equal(dqm.energies([[2, 1, 0], [0, 0, 1]]), [14, 12])
+
+    def test_energies_invalid_case(self):
+        dqm = dimod.DQM()
+        dqm.add_variable(3)
+        dqm.add_variable(2)
+
+        with self.assertRaises(ValueError):
+            dqm.energies([[0, 0], [0, 2]])
+
     def test_two_variable_labelled(self):
         dqm = dimod.DQM()
         u = dqm.add_variable(10)
@@ -382,6 +412,26 @@ class TestFile(unittest.TestCase):
             self.assertDQMEqual(dimod.DQM.from_file(f), dqm)
 
 
+class TestMemoryUsage(unittest.TestCase):
+    def test_small(self):
+        dqm = dimod.DQM()
+        u = dqm.add_variable(3, 'u')
+        v = dqm.add_variable(2, 'v')
+        dqm.set_quadratic(u, v, {(0, 1): 1.5})
+
+        usage = dqm.memory_usage()
+
+        self.assertEqual(usage['linear'], (6 + 1)*dqm.dtype.itemsize)  # cases and offset
+        self.assertGreater(usage['quadratic'], 0)
+        self.assertGreater(usage['variables'], 0)
+        self.assertGreater(usage['labels'], 0)
+        self.assertEqual(usage['total'], sum(b for k, b in usage.items() if k != 'total'))
+
+        # calculating the energies builds a cache
+        dqm.energies([[0, 0]])
+        self.assertGreater(dqm.memory_usage()['other'], usage['other'])
+
+
 class TestLinear(unittest.TestCase):
     def test_set_linear_case(self):
         dqm = dimod.DQM()
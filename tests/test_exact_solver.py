@@ -30,9 +30,9 @@ class TestExactSolver(unittest.TestCase):
 
         dimod.testing.assert_sampler_api(sampler)
 
-        # this sampler has no properties and has no accepted parameters
+        # this sampler has no properties
         self.assertEqual(sampler.properties, {})
-        self.assertEqual(sampler.parameters, {})
+        self.assertEqual(sampler.parameters, {'num_samples': []})
 
     def test_sample_SPIN_empty(self):
         bqm = dimod.BinaryQuadraticModel({}, {}, 0.0, dimod.SPIN)
@@ -95,6 +95,39 @@ class TestExactSolver(unittest.TestCase):
 
         dimod.testing.assert_response_energies(response, bqm)
 
+    def test_num_samples(self):
+        bqm = dimod.generators.gnp_random_bqm(12, .5, 'SPIN', random_state=5)
+
+        full = dimod.ExactSolver().sample(bqm)
+        lowest = dimod.ExactSolver().sample(bqm, num_samples=7)
+
+        self.assertEqual(len(lowest), 7)
+        npt.assert_allclose(lowest.record.energy, np.sort(full.record.energy)[:7])
+        dimod.testing.assert_response_energies(lowest, bqm)
+
+        self.assertEqual(len(dimod.ExactSolver().sample(bqm, num_samples=0)), 0)
+        self.assertEqual(len(dimod.ExactSolver().sample(bqm, num_samples=10000)), 2**12)
+
+        with self.assertRaises(ValueError):
+            dimod.ExactSolver().sample(bqm, num_samples=-1)
+
+    def test_dtypes(self):
+        for dtype in [np.float32, np.float64, object]:
+            with self.subTest(dtype=dtype):
+                bqm = dimod.BQM({'a': 1, 'b': -2}, {'ab': .5}, 1, 'BINARY', dtype=dtype)
+                sampleset = dimod.ExactSolver().sample(bqm, num_samples=2)
+                self.assertEqual(len(sampleset), 2)
+                self.assertEqual(sampleset.first.sample, {'a': 0, 'b': 1})
+                self.assertEqual(sampleset.first.energy, -1)
+                dimod.testing.assert_response_energies(sampleset, bqm)
+
+    def test_vartype_view(self):
+        bqm = dimod.BQM({'a': 1, 'b': -2}, {'ab': .5}, 1, 'BINARY')
+        sampleset = dimod.ExactSolver().sample(bqm.spin)
+        self.assertIs(sampleset.vartype, dimod.SPIN)
+        self.assertEqual(len(sampleset), 4)
+        dimod.testing.assert_response_energies(sampleset, bqm.spin)
+
     def test_sample_DISCRETE(self):
         dqm = dimod.DiscreteQuadraticModel.from_numpy_vectors(
                         case_starts =   [0, 3],
@@ -198,6 +231,39 @@ class TestExactSolver(unittest.TestCase):
         dimod.testing.assert_sampleset_energies_cqm(response, cqm)
         
 
+    def test_sample_CONSTRAINED_num_samples(self):
+        cqm = dimod.ConstrainedQuadraticModel()
+        i = dimod.Integer('i', lower_bound=-2, upper_bound=3)
+        j = dimod.Integer('j', lower_bound=-2, upper_bound=3)
+        x, y, z = dimod.Binaries('xyz')
+        s = dimod.Spin('s')
+        cqm.set_objective(i*j - 2*x + y*s + 3*z - i)
+        cqm.add_constraint(i + j + x <= 3, label='c0')
+        cqm.add_constraint(i*s >= -1, label='c1')
+        cqm.add_constraint(x + y + z - 2*j >= 0, label='soft', weight=1.5)
+        cqm.add_discrete('abc', label='d')
+        cqm.objective.add_linear('b', -1)
+
+        full = dimod.ExactCQMSolver().sample_cqm(cqm)
+        feasible = full.filter(lambda d: d.is_feasible)
+
+        sampleset = dimod.ExactCQMSolver().sample_cqm(cqm, num_samples=5)
+        self.assertEqual(len(sampleset), 5)
+        self.assertTrue(sampleset.record.is_feasible.all())
+        npt.assert_allclose(sampleset.record.energy, np.sort(feasible.record.energy)[:5])
+
+        sampleset = dimod.ExactCQMSolver().sample_cqm(cqm, num_samples=len(full))
+        self.assertEqual(len(sampleset), len(feasible))
+
+        # infeasible
+        cqm.add_constraint(x + y >= 3)
+        self.assertEqual(len(dimod.ExactCQMSolver().sample_cqm(cqm, num_samples=5)), 0)
+
+        # real variables are not allowed
+        cqm.add_variable('REAL', 'r')
+        with self.assertRaises(ValueError):
+            dimod.ExactCQMSolver().sample_cqm(cqm, num_samples=5)
+
     def test_sample_ising(self):
         h = {0: 0.0, 1: 0.0, 2: 0.0}
         J = {(0, 1): -1.0, (1, 2): 1.0, (0, 2): 1.0}
@@ -52,6 +52,38 @@ class TestRandomGNMRandomBQM(unittest.TestCase):
                 bqm = dimod.generators.gnm_random_bqm(n, m, 'SPIN')
                 self.assertEqual(bqm.shape, (n, m))
 
+    def test_biases(self):
+        bqm = dimod.generators.gnm_random_bqm(50, 300, 'BINARY', random_state=3)
+        for bias in itertools.chain(bqm.linear.values(), bqm.quadratic.values(), [bqm.offset]):
+            self.assertGreaterEqual(bias, 0)
+            self.assertLess(bias, 1)
+
+    def test_complete(self):
+        bqm = dimod.generators.gnm_random_bqm(30, 1000, 'SPIN')
+        self.assertEqual(bqm.shape, (30, 435))
+
+    def test_random_state(self):
+        r = np.random.RandomState(16)
+
+        bqm0 = dimod.generators.gnm_random_bqm(10, 20, 'SPIN', random_state=r)
+        bqm1 = dimod.generators.gnm_random_bqm(10, 20, 'SPIN', random_state=r)
+        self.assertNotEqual(bqm0, bqm1)
+
+        r = np.random.RandomState(16)
+
+        bqm2 = dimod.generators.gnm_random_bqm(10, 20, 'SPIN', random_state=r)
+        bqm3 = dimod.generators.gnm_random_bqm(10, 20, 'SPIN', random_state=r)
+        self.assertEqual(bqm0, bqm2)
+        self.assertEqual(bqm1, bqm3)
+
+    def test_seed(self):
+        bqm0 = dimod.generators.gnm_random_bqm(100, 2000, 'SPIN', random_state=5)
+        bqm1 = dimod.generators.gnm_random_bqm(100, 2000, 'SPIN', random_state=5)
+        self.assertEqual(bqm0, bqm1)
+
+        bqm2 = dimod.generators.gnm_random_bqm(100, 2000, 'SPIN', random_state=6)
+        self.assertNotEqual(bqm0, bqm2)
+
     def test_deprecation(self):
         with self.assertWarns(DeprecationWarning):
             bqm = dimod.generators.gnm_random_bqm(2, 1, "SPIN", cls=dimod.BinaryQuadraticModel)
@@ -123,6 +155,17 @@ class TestRandomGNPRandomBQM(unittest.TestCase):
 
         self.assertEqual(bqm0, bqm1)
 
+    def test_sparse(self):
+        bqm = dimod.generators.gnp_random_bqm(3000, .001, 'BINARY', random_state=8)
+
+        # the expected number of interactions is 4498.5 with a standard deviation of 67
+        self.assertGreater(bqm.num_interactions, 4000)
+        self.assertLess(bqm.num_interactions, 5000)
+        for (u, v), bias in bqm.quadratic.items():
+            self.assertNotEqual(u, v)
+            self.assertGreaterEqual(bias, 0)
+            self.assertLess(bias, 1)
+
     def test_singleton(self):
         bqm = dimod.generators.gnp_random_bqm(1, 1, 'SPIN')
         self.assertEqual(bqm.shape, (1, 0))
@@ -509,6 +552,13 @@ class TestDoped(unittest.TestCase):
 
         self.assertNotEqual(bqm2, bqm1)
 
+    def test_edgelist(self):
+        bqm = dimod.generators.random.doped(0.5, [('b', 'a'), ('a', 'c'), ('d', 'b')], seed=5)
+        self.assertEqual(list(bqm.variables), ['b', 'a', 'c', 'd'])
+        self.assertEqual(bqm.shape, (4, 3))
+        self.assertTrue(all(bias == 0 for bias in bqm.linear.values()))
+        self.assertTrue(all(bias in (-1, 1) for bias in bqm.quadratic.values()))
+
     def test_correct_ratio(self):
         bqm = dimod.generators.random.doped(0.3, 100, seed=506)
         total = len(bqm.quadratic)
@@ -15,6 +15,8 @@
 import itertools
 import unittest
 
+import numpy as np
+
 import dimod
 from dimod import make_quadratic, poly_energy, poly_energies
 
@@ -240,6 +242,46 @@ class TestMakeQuadratic(unittest.TestCase):
 
             self.assertAlmostEqual(energy, min(reduced_energies))
 
+    def test_reduction_info(self):
+        poly = {'abc': 1, 'abd': -1, 'cd': .5}
+
+        for vartype in [dimod.BINARY, dimod.SPIN]:
+            with self.subTest(vartype=vartype):
+                bqm = make_quadratic(poly, 5.0, vartype)
+
+                self.assertEqual(len(bqm.info['reduction']), 1)
+                (u, v), changes = next(iter(bqm.info['reduction'].items()))
+                self.assertEqual({u, v}, {'a', 'b'})  # the most common pair
+                self.assertEqual(changes['product'], f'{u}*{v}')
+                self.assertIn(changes['product'], bqm.variables)
+
+                if vartype is dimod.SPIN:
+                    self.assertEqual(changes['auxiliary'], f'aux{u},{v}')
+                    self.assertEqual(bqm.num_variables, 6)
+                else:
+                    self.assertNotIn('auxiliary', changes)
+                    self.assertEqual(bqm.num_variables, 5)
+
+    def test_product_label_collision(self):
+        poly = {(0, 1, 2): 1, ('0*1',): 1, ('0*2',): 1, ('1*2',): 1}
+
+        bqm = make_quadratic(poly, 5.0, dimod.BINARY)
+
+        (u, v), changes = next(iter(bqm.info['reduction'].items()))
+        self.assertEqual(changes['product'], f'_{u}*{v}')
+        self.assertEqual(bqm.num_variables, 7)
+
+    def test_existing_bqm(self):
+        bqm = dimod.BinaryQuadraticModel({'x': 1}, {}, 1.5, dimod.BINARY, dtype=np.float32)
+
+        out = make_quadratic({'abc': -1}, 5.0, bqm=bqm)
+
+        self.assertIs(out, bqm)
+        self.assertEqual(out.dtype, np.float32)
+        self.assertEqual(out.offset, 1.5)
+        self.assertEqual(out.get_linear('x'), 1)
+        self.assertEqual(out.num_variables, 5)
+
     def test_poly_energies(self):
         linear = {0: 1.0, 1: 1.0}
         j = {(0, 1, 2): 0.5}
@@ -99,6 +99,25 @@ class Test_energies(unittest.TestCase):
         energies = poly.energies(([[-1], [1]], ['a']))
         np.testing.assert_array_equal(energies, [1, -1])
 
+    def test_unordered_samples(self):
+        poly = BinaryPolynomial({'abc': 2, 'ab': -1, 'c': .5, (): 1}, 'BINARY')
+
+        samples = ([[1, 1, 1, 0], [0, 1, 1, 1], [1, 0, 1, 1]], ['c', 'x', 'b', 'a'])
+
+        np.testing.assert_array_equal(poly.energies(samples), [1.5, 0, 2.5])
+        np.testing.assert_array_equal(poly.energies(samples, dtype=np.float32), [1.5, 0, 2.5])
+        np.testing.assert_array_equal(poly.energies(samples, dtype=object), [1.5, 0, 2.5])
+
+    def test_many_samples(self):
+        poly = BinaryPolynomial({'abc': -1, 'bcd': 1.5, 'ad': .25, 'e': 2}, 'SPIN')
+
+        samples = np.random.default_rng(42).choice([-1, 1], size=(100, 5)).astype(np.int8)
+        labels = 'abcde'
+
+        # object dtype uses the term-by-term calculation
+        np.testing.assert_array_almost_equal(poly.energies((samples, labels)),
+                                             poly.energies((samples, labels), dtype=object))
+
 
 class TestDegree(unittest.TestCase):
     def test_empty(self):
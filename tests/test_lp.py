@@ -14,6 +14,8 @@
 
 import io
 import os
+import pathlib
+import tempfile
 import unittest
 
 import numpy as np
@@ -127,6 +129,14 @@ class TestLoads(unittest.TestCase):
         self.assertFalse(cqm.constraints)
         self.assertTrue(cqm.objective.is_equal(x * y / 2))
 
+    def test_quadratic_variable_order(self):
+        # the variables are in the order they first appear, as they were with
+        # the previous reader
+        with open(os.path.join(os.path.dirname(__file__), 'data', 'test_quadratic.lp')) as f:
+            cqm = load(f)
+
+        self.assertEqual(list(cqm.variables), ['x0', 'x1', 'x2', 'x3'])
+
     def test_quadratic_nospace(self):
         lp = """
         minimize
@@ -174,6 +184,28 @@ class TestLoads(unittest.TestCase):
         self.assertTrue(cqm.objective.is_equal(2e3 * x0 + (4.1e-2 * x0 * x0) / 2))
 
 
+    def test_num_threads(self):
+        cqm = CQM()
+        x = dimod.Integers(f'x{i}' for i in range(100))
+        cqm.set_objective(sum(x))
+        for i in range(100):
+            cqm.add_constraint(x[i] - 2 * x[(3 * i) % 100] <= i, label=f'c{i}')
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            filename = os.path.join(tmpdir, 'model.lp')
+            with open(filename, 'w') as f:
+                dimod.lp.dump(cqm, f)
+
+            for num_threads in [1, 2, 0]:
+                with self.subTest(num_threads=num_threads):
+                    new = load(filename, num_threads=num_threads)
+                    self.assertEqual(new.variables, cqm.variables)
+                    self.assertEqual(list(new.constraints), list(cqm.constraints))
+                    for label, constraint in cqm.constraints.items():
+                        self.assertTrue(new.constraints[label].lhs.is_equal(constraint.lhs))
+                        self.assertEqual(new.constraints[label].rhs, constraint.rhs)
+
+
 class TestDumps(unittest.TestCase):
 
     def _assert_cqms_are_equivalent(self, cqm, new):
@@ -411,6 +443,46 @@ class TestDumps(unittest.TestCase):
         new = dimod.lp.loads(dimod.lp.dumps(cqm))
         self._assert_cqms_are_equivalent(cqm, new)
 
+    def test_mps(self):
+        cqm = CQM()
+        x, y = dimod.Binaries('xy')
+        i = Integer('i', lower_bound=-5, upper_bound=5)
+        cqm.set_objective(x + 2 * y - i + 3 * x * y + 1.5)
+        cqm.add_constraint(x + i * y <= 3, label='c0')
+
+        mps = dimod.lp.dumps(cqm, format='mps')
+
+        self.assertTrue(mps.startswith('NAME\nROWS\n N  obj\n L  c0\n'))
+        self.assertIn('    x  obj  1\n    x  c0  1\n', mps)
+        self.assertIn('    RHS  obj  -1.5\n    RHS  c0  3\n', mps)
+        self.assertIn(' BV BND  x\n', mps)
+        self.assertIn(' LO BND  i  -5\n UP BND  i  5\n', mps)
+        self.assertIn('QUADOBJ\n    x  y  3\n', mps)
+        self.assertIn('QCMATRIX  c0\n', mps)
+        self.assertTrue(mps.endswith('ENDATA\n'))
+
+        with self.assertRaises(ValueError):
+            dimod.lp.dumps(cqm, format='xml')
+
+    def test_path(self):
+        cqm = CQM()
+        cqm.set_objective(Binary('a') + 2 * Integer('b'))
+        cqm.add_constraint(Binary('a') + Integer('b') <= 5, label='c0')
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            filename = os.path.join(tmpdir, 'model.lp')
+            dimod.lp.dump(cqm, filename)
+
+            with open(filename) as f:
+                self.assertEqual(f.read(), dimod.lp.dumps(cqm))
+
+            self._assert_cqms_are_equivalent(cqm, dimod.lp.load(filename))
+
+            path = pathlib.Path(tmpdir) / 'model.mps'
+            dimod.lp.dump(cqm, path, format='mps')
+
+            self.assertEqual(path.read_text(), dimod.lp.dumps(cqm, format='mps'))
+
     def test_soft_constraint(self):
         cqm = CQM()
         a, b = dimod.Binaries(['a', 'b'])
@@ -779,6 +779,11 @@ class TestNBytes(unittest.TestCase):
         self.assertEqual(qm.nbytes(), qm.nbytes(False))
         self.assertGreaterEqual(qm.nbytes(True), qm.nbytes(False))
 
+        usage = qm.memory_usage()
+        self.assertEqual(usage['variables'], qm.num_variables*3*itemsize)
+        self.assertEqual(usage['total'], sum(b for k, b in usage.items() if k != 'total'))
+        self.assertGreater(usage['total'], qm.nbytes())
+
 
 class TestOffset(unittest.TestCase):
     def test_setting(self):
@@ -1027,6 +1032,31 @@ class TestSymbolic(unittest.TestCase):
         exp = i + j + x + y + s + t + i*j + s*i + x*j + (s + 1)*(1 - j)
 
 
+class TestToCSR(unittest.TestCase):
+    def test_self_loops(self):
+        qm = QM()
+        qm.add_variables_from('INTEGER', 'ijk')
+        qm.add_quadratic_from({('i', 'j'): 2, ('j', 'j'): -1, ('k', 'i'): 3})
+
+        indptr, indices, data = qm.to_csr()
+        np.testing.assert_array_equal(indptr, [0, 2, 3, 3])
+        np.testing.assert_array_equal(indices, [1, 2, 1])
+        np.testing.assert_array_equal(data, [2, 3, -1])
+        self.assertEqual(indptr.dtype, np.int64)
+
+        # the self-loop appears once
+        indptr, indices, data = qm.to_csr(upper_triangular=False)
+        np.testing.assert_array_equal(indptr, [0, 2, 4, 5])
+        np.testing.assert_array_equal(indices, [1, 2, 0, 1, 0])
+        np.testing.assert_array_equal(data, [2, 3, 2, -1, 3])
+
+    def test_empty(self):
+        indptr, indices, data = QM().to_csr()
+        np.testing.assert_array_equal(indptr, [0])
+        self.assertEqual(len(indices), 0)
+        self.assertEqual(len(data), 0)
+
+
 class TestToPolyString(unittest.TestCase):
     def test_simple(self):
         i, j = dimod.Integers('ij')
@@ -424,6 +424,29 @@ class TestConstruction(unittest.TestCase):
             np.testing.assert_array_equal(sampleset.record.is_satisfied, [[True], [False]])
             np.testing.assert_array_equal(sampleset.record.energy, [0, 5])
 
+    def test_from_samples_cqm_many_samples(self):
+        i, j = dimod.Integers('ij', upper_bound=5)
+        x = dimod.Binary('x')
+
+        cqm = dimod.ConstrainedQuadraticModel()
+        cqm.set_objective(i*j - x)
+        cqm.add_constraint(i + j <= 6, label='le')
+        cqm.add_constraint(i*x >= 1, label='ge')
+        cqm.add_constraint(i - j == 0, label='eq')
+
+        # samples given in a different variable order than the model
+        rng = np.random.default_rng(42)
+        samples = (rng.integers(0, 2, size=(100, 3)) * [1, 5, 5], 'xji')
+
+        sampleset = dimod.SampleSet.from_samples_cqm(samples, cqm)
+
+        for datum in sampleset.data(['sample', 'is_satisfied', 'is_feasible']):
+            satisfied = [d.violation <= 1e-8 + 1e-6*abs(d.rhs_energy)
+                         for d in cqm.iter_constraint_data(datum.sample)]
+            np.testing.assert_array_equal(datum.is_satisfied, satisfied)
+            self.assertEqual(datum.is_feasible, all(satisfied))
+            self.assertEqual(datum.is_feasible, cqm.check_feasible(datum.sample))
+
 
 class TestDiscreteSampleSet(unittest.TestCase):
     def test_aggregate(self):
@@ -575,6 +598,52 @@ class TestAggregate(unittest.TestCase):
 
         self.assertEqual(sampleset.aggregate(), aggregated)
 
+    def test_many_variables(self):
+        rng = np.random.default_rng(42)
+        distinct = rng.choice([-1, 1], size=(20, 150)).astype(np.int8)
+        choice = rng.integers(20, size=500)
+        num_occurrences = rng.integers(1, 5, size=500)
+
+        sampleset = dimod.SampleSet.from_samples(distinct[choice], dimod.SPIN, energy=0,
+                                                 num_occurrences=num_occurrences)
+        aggregated = sampleset.aggregate()
+
+        # in the order they first occur
+        _, first = np.unique(choice, return_index=True)
+        first.sort()
+        np.testing.assert_array_equal(aggregated.record.sample, distinct[choice[first]])
+
+        for sample, count in zip(aggregated.record.sample, aggregated.record.num_occurrences):
+            self.assertEqual(count, num_occurrences[(sampleset.record.sample == sample).all(axis=1)].sum())
+        self.assertEqual(aggregated.record.num_occurrences.sum(), num_occurrences.sum())
+
+    def test_other_dtypes(self):
+        for dtype in [np.int8, np.int16, np.int64, np.float32, np.float64, np.uint8]:
+            with self.subTest(dtype=dtype):
+                samples = np.asarray([[0, 1], [1, 1], [0, 1]], dtype=dtype)
+                sampleset = dimod.SampleSet.from_samples((samples, 'ab'), dimod.BINARY, energy=0)
+
+                aggregated = sampleset.aggregate()
+                np.testing.assert_array_equal(aggregated.record.sample, [[0, 1], [1, 1]])
+                np.testing.assert_array_equal(aggregated.record.num_occurrences, [2, 1])
+
+    def test_integer(self):
+        samples = [[0, 3], [2, 1], [0, 3]]
+        sampleset = dimod.SampleSet.from_samples((samples, 'ab'), 'INTEGER', energy=0)
+
+        aggregated = sampleset.aggregate()
+        np.testing.assert_array_equal(aggregated.record.sample, [[0, 3], [2, 1]])
+        np.testing.assert_array_equal(aggregated.record.num_occurrences, [2, 1])
+
+    def test_empty(self):
+        sampleset = dimod.SampleSet.from_samples((np.empty((0, 2)), 'ab'), dimod.SPIN, energy=[])
+        self.assertEqual(len(sampleset.aggregate()), 0)
+
+        sampleset = dimod.SampleSet.from_samples(np.empty((3, 0)), dimod.SPIN, energy=[0, 0, 0])
+        aggregated = sampleset.aggregate()
+        self.assertEqual(len(aggregated), 1)
+        self.assertEqual(aggregated.record.num_occurrences[0], 3)
+
 
 class TestAppend(unittest.TestCase):
     def test_sampleset1_append1(self):
@@ -886,6 +955,33 @@ class TestTruncate(unittest.TestCase):
                 else:
                     self.assertEqual(val, 1)
 
+    def test_ties(self):
+        energies = [3, 1, 2, 1, 0, 1, 2, 1]
+        sampleset = dimod.SampleSet.from_samples(np.arange(8).reshape(-1, 1), 'INTEGER',
+                                                 energy=energies)
+
+        # ties are kept in the order of the sample set
+        for n in range(1, 9):
+            with self.subTest(n=n):
+                np.testing.assert_array_equal(sampleset.truncate(n).record.sample.ravel(),
+                                              np.argsort(energies, kind='stable')[:n])
+
+    def test_random(self):
+        rng = np.random.default_rng(5)
+        energies = rng.integers(-20, 20, size=1000).astype(float)
+        sampleset = dimod.SampleSet.from_samples(np.arange(1000).reshape(-1, 1), 'INTEGER',
+                                                 energy=energies)
+
+        np.testing.assert_array_equal(sampleset.truncate(50).record.sample.ravel(),
+                                      np.argsort(energies, kind='stable')[:50])
+
+    def test_nan(self):
+        sampleset = dimod.SampleSet.from_samples(np.ones((4, 1)), dimod.SPIN,
+                                                 energy=[np.nan, 1, np.nan, 0])
+
+        np.testing.assert_array_equal(sampleset.truncate(2).record.energy, [0, 1])
+        self.assertTrue(np.isnan(sampleset.truncate(3).record.energy[2]))
+
 
 class TestSlice(unittest.TestCase):
     def test_typical(self):
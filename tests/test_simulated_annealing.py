@@ -95,6 +95,28 @@ class TestSASampler(unittest.TestCase):
         with self.assertRaises(ValueError):
             sampler.sample_ising({}, {}, beta_range=[7, 1, 6])
 
+    def test_seeded(self):
+        bqm = dimod.generators.gnp_random_bqm(20, .5, 'BINARY', random_state=3)
+
+        random.seed(11)
+        sampleset0 = self.sampler.sample(bqm, num_reads=5, num_sweeps=100)
+        random.seed(11)
+        sampleset1 = self.sampler.sample(bqm, num_reads=5, num_sweeps=100)
+
+        self.assertIs(sampleset0.vartype, dimod.BINARY)
+        self.assertEqual(sampleset0.record.sample.tolist(), sampleset1.record.sample.tolist())
+        dimod.testing.assert_response_energies(sampleset0, bqm)
+
+    def test_sample_quality(self):
+        # a ferromagnetic chain with one end pinned, the ground state is unique
+        bqm = dimod.BQM({0: -1}, {(v, v + 1): -1 for v in range(49)}, 0, 'SPIN')
+
+        sampleset = self.sampler.sample(bqm, num_reads=10)
+
+        self.assertEqual(len(sampleset), 10)
+        self.assertEqual(sampleset.first.energy, -50)
+        self.assertEqual(sampleset.first.sample, {v: 1 for v in range(50)})
+
     def test_kwargs(self):
         sampler = self.sampler
         bqm = dimod.BinaryQuadraticModel({}, {}, 0.0, dimod.SPIN)
@@ -87,6 +87,65 @@ class TestCopy(unittest.TestCase):
         self.assertIsInstance(new[0], Variables)
 
 
+class TestDenseIntegers(unittest.TestCase):
+    def test_out_of_order(self):
+        variables = Variables([2, 0, 1, 5])
+        self.assertFalse(variables.is_range)
+        self.assertEqual(variables, [2, 0, 1, 5])
+        self.assertEqual(variables[-1], 5)
+        self.assertEqual([variables.index(v) for v in [0, 1, 2, 5]], [1, 2, 0, 3])
+        self.assertEqual([variables.count(v) for v in [0, 3, 4, 5, 6, 'a']], [1, 0, 0, 1, 0, 0])
+        np.testing.assert_array_equal(variables.index_array(np.array([5, 2])), [3, 0])
+        np.testing.assert_array_equal(Variables(range(6)).index_array(variables), [2, 0, 1, 5])
+
+        with self.assertRaises(ValueError):
+            variables.index(3)
+        with self.assertRaises(ValueError):
+            variables.index_array(np.array([3]))
+
+        # a non-integer label falls back to the general case
+        variables._append('a')
+        self.assertEqual(variables, [2, 0, 1, 5, 'a'])
+        self.assertEqual(variables.index(5), 3)
+
+    def test_pop_to_range(self):
+        variables = Variables(range(3))
+        variables._append(7)
+        self.assertFalse(variables.is_range)
+        self.assertEqual(variables._pop(), 7)
+        self.assertTrue(variables.is_range)
+
+    def test_relabel(self):
+        variables = Variables('abc')
+        variables._relabel({'a': 2, 'b': 0, 'c': 1})
+        self.assertEqual(variables, [2, 0, 1])
+        self.assertEqual(variables.index(2), 0)
+
+        variables._relabel({2: 0, 0: 1, 1: 2})
+        self.assertTrue(variables.is_range)
+
+    def test_relabel_as_integers(self):
+        variables = Variables([3, 0, 1])
+        mapping = variables._relabel_as_integers()
+        self.assertTrue(variables.is_range)
+        self.assertEqual(mapping, {0: 3, 1: 0, 2: 1})
+
+    def test_remove(self):
+        variables = Variables(range(5))
+        variables._remove(1)
+        self.assertEqual(variables, [0, 2, 3, 4])
+        self.assertEqual(variables.index(4), 3)
+        self.assertNotIn(1, variables)
+
+        variables._remove(0)
+        variables._remove(2)
+        self.assertEqual(variables, [3, 4])
+        variables._remove(3)
+        variables._remove(4)
+        self.assertTrue(variables.is_range)
+        self.assertEqual(len(variables), 0)
+
+
 class TestDuplicates(unittest.TestCase):
     def test_duplicates(self):
         # should have no duplicates
@@ -149,6 +208,49 @@ class TestIndex(unittest.TestCase):
         self.assertEqual(variables.index('a', permissive=True), 1)
 
 
+class TestIndexArray(unittest.TestCase):
+    def test_empty(self):
+        variables = Variables('abc')
+        indices = variables.index_array([])
+        self.assertEqual(indices.dtype, np.intp)
+        self.assertEqual(indices.shape, (0,))
+
+    def test_labelled(self):
+        variables = Variables('abc')
+        np.testing.assert_array_equal(variables.index_array('cab'), [2, 0, 1])
+        np.testing.assert_array_equal(variables.index_array(iter('bb')), [1, 1])
+
+        with self.assertRaises(ValueError):
+            variables.index_array('ad')
+
+    def test_permissive(self):
+        variables = Variables('ab')
+        np.testing.assert_array_equal(variables.index_array('bcad', permissive=True),
+                                      [1, 2, 0, 3])
+        self.assertEqual(variables, 'abcd')
+
+    def test_range(self):
+        variables = Variables(range(5))
+
+        indices = variables.index_array(range(4, 0, -2))
+        self.assertEqual(indices.dtype, np.intp)
+        np.testing.assert_array_equal(indices, [4, 2])
+
+        np.testing.assert_array_equal(variables.index_array(Variables(range(3))), [0, 1, 2])
+
+        arr = np.array([3, 0, 3], dtype=np.uint8)
+        np.testing.assert_array_equal(variables.index_array(arr), arr)
+
+        with self.assertRaises(ValueError):
+            variables.index_array(np.array([0, 5]))
+        with self.assertRaises(ValueError):
+            variables.index_array(np.array([-1]))
+
+        np.testing.assert_array_equal(variables.index_array([4, 6, 5], permissive=True),
+                                      [4, 6, 5])
+        self.assertEqual(variables, [0, 1, 2, 3, 4, 6, 5])
+
+
 class TestPop(unittest.TestCase):
     def test_empty(self):
         with self.assertRaises(IndexError):
@@ -0,0 +1,22 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+#include "catch2/catch.hpp"
+
+/*
+The purpose of this file is to include Catch's main() with benchmarking enabled.
+Benchmarks can be found inside the benchmarks directory.
+
+Benchmarks must be built with CATCH_CONFIG_ENABLE_BENCHMARKING defined, and should be built
+with optimizations. The Makefile does both.
+
+eg) Build and run all benchmarks
+>>> make benchmarks
+
+eg) Run all benchmarks with the tag [energy]
+>>> ./bench_main [energy]
+
+eg) Build and run all benchmarks, writing the results to benchmarks.xml for tracking
+>>> make benchmarks.xml
+
+For more command line options, see: https://github.com/catchorg/Catch2/blob/devel/docs/benchmarks.md
+
+*/
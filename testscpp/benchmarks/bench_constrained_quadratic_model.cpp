@@ -0,0 +1,122 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/lp.h"
+
+namespace dimod {
+
+// A CQM over `num_variables` INTEGER variables with `num_constraints` linear
+// constraints, each over `constraint_size` random variables.
+ConstrainedQuadraticModel<double> random_cqm(int num_variables, int num_constraints,
+                                             int constraint_size, std::mt19937& rng) {
+    std::uniform_int_distribution<int> variable(0, num_variables - 1);
+    std::uniform_int_distribution<int> coefficient(-5, 5);
+
+    auto cqm = ConstrainedQuadraticModel<double>();
+    cqm.add_variables(Vartype::INTEGER, num_variables, 0, 10);
+
+    for (int v = 0; v < num_variables; ++v) {
+        cqm.objective.add_linear(v, coefficient(rng));
+        cqm.objective.add_quadratic(v, variable(rng), coefficient(rng));
+    }
+
+    for (int c = 0; c < num_constraints; ++c) {
+        auto& constraint = cqm.constraint_ref(cqm.add_constraint());
+        for (int i = 0; i < constraint_size; ++i) {
+            constraint.add_linear(variable(rng), coefficient(rng));
+        }
+        constraint.set_sense(Sense::LE);
+        constraint.set_rhs(coefficient(rng) + 20);
+    }
+
+    return cqm;
+}
+
+TEST_CASE("Benchmark: constrained quadratic models", "[cqm][benchmark]") {
+    std::mt19937 rng(42);
+
+    for (int num_constraints : {1000, 100000}) {
+        for (int constraint_size : {4, 64}) {
+            const auto label = "constraints=" + std::to_string(num_constraints) +
+                               " size=" + std::to_string(constraint_size);
+            const int num_variables = 2000;
+
+            // the left-hand sides to add, as BQMs with a mapping to the CQM's variables
+            std::vector<BinaryQuadraticModel<double>> lhs;
+            std::vector<std::vector<int>> mappings;
+            if (num_constraints * constraint_size <= 1000000) {
+                std::uniform_int_distribution<int> variable(0, num_variables - 1);
+                for (int c = 0; c < num_constraints; ++c) {
+                    lhs.emplace_back(constraint_size, Vartype::BINARY);
+                    mappings.emplace_back();
+                    for (int i = 0; i < constraint_size; ++i) {
+                        lhs.back().set_linear(i, i + 1);
+                        mappings.back().push_back(variable(rng));
+                    }
+                }
+
+                BENCHMARK("add_constraint() " + label) {
+                    auto cqm = ConstrainedQuadraticModel<double>();
+                    cqm.add_variables(Vartype::BINARY, num_variables);
+                    for (int c = 0; c < num_constraints; ++c) {
+                        cqm.add_constraint(lhs[c], Sense::LE, 1, mappings[c]);
+                    }
+                    return cqm.num_constraints();
+                };
+            }
+
+            auto cqm = random_cqm(num_variables, num_constraints, constraint_size, rng);
+
+            std::vector<int> fixed{17, 1500};
+            std::vector<double> values{3, 0};
+
+            BENCHMARK("fix_variables() of two variables " + label) {
+                return cqm.fix_variables(fixed.begin(), fixed.end(), values.begin())
+                        .num_variables();
+            };
+
+            BENCHMARK("copy " + label) {
+                auto copy = cqm;
+                return copy.num_constraints();
+            };
+        }
+    }
+}
+
+TEST_CASE("Benchmark: reading LP files", "[lp][benchmark]") {
+    std::mt19937 rng(42);
+
+    for (int num_constraints : {1000, 50000}) {
+        for (int constraint_size : {4, 64}) {
+            const auto label = "constraints=" + std::to_string(num_constraints) +
+                               " size=" + std::to_string(constraint_size);
+
+            const std::string data =
+                    lp::dumps(random_cqm(2000, num_constraints, constraint_size, rng));
+
+            BENCHMARK("lp::read() " + label) {
+                return lp::read<double, int>(data.data(), data.size()).model.num_constraints();
+            };
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,76 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <random>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+
+namespace dimod {
+
+// The energy calculation as it is done by a one-term-at-a-time loop over the
+// neighborhoods. Used as the baseline.
+template <class Bias>
+Bias scalar_energy(const BinaryQuadraticModel<Bias>& bqm, const std::int8_t* sample) {
+    Bias en = bqm.offset();
+    for (int u = 0; static_cast<std::size_t>(u) < bqm.num_variables(); ++u) {
+        en += sample[u] * bqm.linear(u);
+        for (auto it = bqm.cbegin_neighborhood(u); it != bqm.cend_neighborhood(u); ++it) {
+            if (it->v > u) break;
+            en += it->bias * sample[u] * sample[it->v];
+        }
+    }
+    return en;
+}
+
+TEMPLATE_TEST_CASE("Benchmark: energy of a dense binary quadratic model", "[energy][benchmark]",
+                   float, double) {
+    const int num_variables = 1000;
+    const int num_samples = 100;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<TestType> bias(-1, 1);
+    std::uniform_int_distribution<int> spin(0, 1);
+
+    std::vector<TestType> dense(num_variables * num_variables);
+    for (auto& b : dense) b = bias(rng);
+
+    auto bqm = BinaryQuadraticModel<TestType>(dense.data(), num_variables, Vartype::SPIN);
+
+    std::vector<std::int8_t> samples(num_samples * num_variables);
+    for (auto& s : samples) s = 2 * spin(rng) - 1;
+
+    std::vector<TestType> energies(num_samples);
+
+    BENCHMARK("scalar loop") { return scalar_energy(bqm, samples.data()); };
+
+    BENCHMARK("energy()") { return bqm.energy(samples.data()); };
+
+    BENCHMARK("energies() of 100 samples") {
+        bqm.energies(samples.data(), num_samples, num_variables, energies.data());
+        return energies[0];
+    };
+
+    bqm.freeze();
+
+    BENCHMARK("energy() of a frozen model") { return bqm.energy(samples.data()); };
+
+    BENCHMARK("energies() of 100 samples with a frozen model") {
+        bqm.energies(samples.data(), num_samples, num_variables, energies.data());
+        return energies[0];
+    };
+}
+
+}  // namespace dimod
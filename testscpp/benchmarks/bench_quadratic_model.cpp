@@ -0,0 +1,149 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+
+namespace dimod {
+
+// The (u, v, bias) terms of a random model with `num_variables` variables
+// where each pair of variables interacts with probability `density`, sorted
+// by (u, v).
+std::vector<std::tuple<int, int, double>> random_terms(int num_variables, double density,
+                                                       std::mt19937& rng) {
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::uniform_real_distribution<double> bias(-1, 1);
+
+    std::vector<std::tuple<int, int, double>> terms;
+    for (int u = 0; u < num_variables; ++u) {
+        for (int v = u + 1; v < num_variables; ++v) {
+            if (uniform(rng) < density) terms.emplace_back(u, v, bias(rng));
+        }
+    }
+    return terms;
+}
+
+std::string label(int num_variables, double density) {
+    std::ostringstream os;
+    os << "n=" << num_variables << " density=" << density;
+    return os.str();
+}
+
+TEST_CASE("Benchmark: building binary quadratic models", "[bqm][construction][benchmark]") {
+    std::mt19937 rng(42);
+
+    for (int num_variables : {100, 1000}) {
+        for (double density : {.01, .1, 1.}) {
+            auto terms = random_terms(num_variables, density, rng);
+
+            auto shuffled = terms;
+            std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+            BENCHMARK("add_quadratic() in order " + label(num_variables, density)) {
+                auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::BINARY);
+                for (const auto& term : terms) {
+                    bqm.add_quadratic(std::get<0>(term), std::get<1>(term), std::get<2>(term));
+                }
+                return bqm.num_interactions();
+            };
+
+            BENCHMARK("add_quadratic() in random order " + label(num_variables, density)) {
+                auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::BINARY);
+                for (const auto& term : shuffled) {
+                    bqm.add_quadratic(std::get<0>(term), std::get<1>(term), std::get<2>(term));
+                }
+                return bqm.num_interactions();
+            };
+
+            std::vector<int> row;
+            std::vector<int> col;
+            std::vector<double> biases;
+            for (const auto& term : shuffled) {
+                row.push_back(std::get<0>(term));
+                col.push_back(std::get<1>(term));
+                biases.push_back(std::get<2>(term));
+            }
+
+            BENCHMARK("add_quadratic_coo() in random order " + label(num_variables, density)) {
+                auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::BINARY);
+                bqm.add_quadratic_coo(row.begin(), col.begin(), biases.begin(), row.size());
+                return bqm.num_interactions();
+            };
+        }
+
+        std::vector<double> dense(num_variables * num_variables);
+        std::uniform_real_distribution<double> bias(-1, 1);
+        for (auto& b : dense) b = bias(rng);
+
+        BENCHMARK("add_quadratic_from_dense() n=" + std::to_string(num_variables)) {
+            auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::BINARY);
+            bqm.add_quadratic_from_dense(dense.data(), num_variables);
+            return bqm.num_interactions();
+        };
+    }
+}
+
+TEST_CASE("Benchmark: energy and variable removal across sizes and densities",
+          "[bqm][energy][benchmark]") {
+    std::mt19937 rng(42);
+
+    for (int num_variables : {100, 1000, 5000}) {
+        for (double density : {.001, .01, .1}) {
+            auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::BINARY);
+            for (const auto& term : random_terms(num_variables, density, rng)) {
+                bqm.add_quadratic(std::get<0>(term), std::get<1>(term), std::get<2>(term));
+            }
+
+            std::vector<std::int8_t> sample(num_variables);
+            for (auto& value : sample) value = rng() & 1;
+
+            BENCHMARK("energy() " + label(num_variables, density)) {
+                return bqm.energy(sample.data());
+            };
+
+            BENCHMARK("energy<BINARY>() " + label(num_variables, density)) {
+                return bqm.energy<Vartype::BINARY>(sample.data());
+            };
+
+            BENCHMARK_ADVANCED("remove_variable() of the first variable " +
+                               label(num_variables, density))
+            (Catch::Benchmark::Chronometer meter) {
+                std::vector<BinaryQuadraticModel<double>> copies(meter.runs(), bqm);
+                meter.measure([&copies](int i) {
+                    copies[i].remove_variable(0);
+                    return copies[i].num_variables();
+                });
+            };
+
+            BENCHMARK_ADVANCED("fix_variable() of the first variable " +
+                               label(num_variables, density))
+            (Catch::Benchmark::Chronometer meter) {
+                std::vector<BinaryQuadraticModel<double>> copies(meter.runs(), bqm);
+                meter.measure([&copies](int i) {
+                    copies[i].fix_variable(0, 1);
+                    return copies[i].num_variables();
+                });
+            };
+        }
+    }
+}
+
+}  // namespace dimod
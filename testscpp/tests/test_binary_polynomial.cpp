@@ -0,0 +1,213 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_polynomial.h"
+
+namespace dimod {
+
+// Check that the minimum energy of `bqm` over the reduction variables matches
+// the energy of `poly` for every assignment of the polynomial's variables.
+template <class Bias, class Index>
+void check_ground_states(const BinaryPolynomial<Bias, Index>& poly,
+                         const BinaryQuadraticModel<Bias, Index>& bqm) {
+    const std::size_t n = poly.num_variables();
+    const std::size_t num_aux = bqm.num_variables() - n;
+    const Bias low = (poly.vartype() == Vartype::SPIN) ? -1 : 0;
+
+    std::vector<Bias> sample(bqm.num_variables());
+    for (std::size_t state = 0; state < (1u << n); ++state) {
+        for (std::size_t v = 0; v < n; ++v) sample[v] = (state >> v) & 1 ? 1 : low;
+
+        Bias best = std::numeric_limits<Bias>::max();
+        for (std::size_t aux = 0; aux < (1u << num_aux); ++aux) {
+            for (std::size_t a = 0; a < num_aux; ++a) sample[n + a] = (aux >> a) & 1 ? 1 : low;
+            best = std::min(best, bqm.energy(sample.begin()));
+        }
+
+        CHECK(best == Approx(poly.energy(sample.data())));
+    }
+}
+
+SCENARIO("binary polynomials store terms as sorted index tuples", "[polynomial]") {
+    GIVEN("an empty BINARY polynomial") {
+        auto poly = BinaryPolynomial<double>(Vartype::BINARY);
+
+        WHEN("we add terms with repeated and unsorted variables") {
+            poly.add_term({2, 0, 1}, 1.5);
+            poly.add_term({1, 2, 0}, .5);  // same term
+            poly.add_term({3, 3}, -1);     // x*x == x
+            poly.add_term({}, 2);
+
+            THEN("the terms are combined and normalized") {
+                CHECK(poly.num_variables() == 4);
+                CHECK(poly.num_terms() == 2);
+                CHECK(poly.degree() == 3);
+                CHECK(poly.offset() == 2);
+
+                std::vector<int> x012{2, 1, 0};
+                auto t = poly.find_term(x012.begin(), x012.end());
+                REQUIRE(t < poly.num_terms());
+                CHECK(poly.bias(t) == 2);
+                CHECK(std::vector<int>(poly.term_begin(t), poly.term_end(t)) ==
+                      std::vector<int>{0, 1, 2});
+
+                std::vector<int> x3{3};
+                REQUIRE(poly.find_term(x3.begin(), x3.end()) < poly.num_terms());
+                CHECK(poly.bias(poly.find_term(x3.begin(), x3.end())) == -1);
+
+                std::vector<int> missing{0, 3};
+                CHECK(poly.find_term(missing.begin(), missing.end()) == poly.num_terms());
+            }
+
+            THEN("the energies can be calculated") {
+                std::vector<int> samples{1, 1, 1, 1,  //
+                                         1, 1, 1, 0,  //
+                                         0, 1, 1, 1};
+                std::vector<double> energies(3);
+                poly.energies(samples.data(), 3, 4, energies.data());
+                CHECK(energies == std::vector<double>{3, 4, 1});
+                CHECK(poly.energy(samples.data() + 4) == 4);
+            }
+        }
+    }
+
+    GIVEN("an empty SPIN polynomial") {
+        auto poly = BinaryPolynomial<float, std::int64_t>(Vartype::SPIN);
+
+        WHEN("we add terms with repeated variables") {
+            poly.add_term({0, 1, 0}, 2);   // s*s == 1 so this is s1
+            poly.add_term({2, 2}, 3);      // the offset
+            poly.add_term({1, 1, 1}, -1);  // also s1
+
+            THEN("repeated pairs cancel") {
+                CHECK(poly.num_variables() == 3);
+                CHECK(poly.num_terms() == 1);
+                CHECK(poly.degree() == 1);
+                CHECK(poly.offset() == 3);
+                CHECK(*poly.term_begin(0) == 1);
+                CHECK(poly.bias(0) == 1);
+            }
+        }
+    }
+
+    GIVEN("a random polynomial and more samples than fit in one block") {
+        auto poly = BinaryPolynomial<double>(Vartype::SPIN);
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> var(0, 19);
+        std::uniform_int_distribution<int> len(1, 5);
+        std::uniform_real_distribution<double> bias(-1, 1);
+        for (int t = 0; t < 100; ++t) {
+            std::vector<int> term(len(gen));
+            for (auto& v : term) v = var(gen);
+            poly.add_term(term.begin(), term.end(), bias(gen));
+        }
+        poly.resize(20);
+
+        const std::size_t num_samples = 150;
+        const std::size_t stride = 21;
+        std::vector<signed char> samples(num_samples * stride);
+        for (auto& s : samples) s = 2 * (gen() % 2) - 1;
+
+        THEN("the batch energies match the sample-by-sample ones") {
+            for (int num_threads : {1, 3}) {
+                std::vector<double> energies(num_samples);
+                poly.energies(samples.data(), num_samples, stride, energies.data(), num_threads);
+                for (std::size_t si = 0; si < num_samples; ++si) {
+                    CHECK(energies[si] == Approx(poly.energy(samples.data() + si * stride)));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("binary polynomials can be reduced to binary quadratic models", "[polynomial]") {
+    GIVEN("a BINARY polynomial with overlapping cubic and quartic terms") {
+        auto poly = BinaryPolynomial<double>(Vartype::BINARY);
+        poly.add_term({0, 1, 2}, -1);
+        poly.add_term({0, 1, 3}, 2);
+        poly.add_term({0, 1, 2, 3}, 1.5);
+        poly.add_term({1, 2}, .5);
+        poly.add_term({4}, -2);
+        poly.add_offset(1);
+
+        WHEN("we make it quadratic") {
+            auto bqm = BinaryQuadraticModel<double>(Vartype::BINARY);
+            auto reductions = poly.make_quadratic(bqm, 10);
+
+            THEN("the most common pair is reduced first") {
+                REQUIRE(reductions.size() >= 1);
+                CHECK(reductions[0].u == 0);
+                CHECK(reductions[0].v == 1);
+                CHECK(reductions[0].product == 5);
+                CHECK(reductions[0].auxiliary == -1);
+                CHECK(bqm.num_variables() == 5 + reductions.size());
+            }
+
+            THEN("the ground states match") { check_ground_states(poly, bqm); }
+        }
+
+        WHEN("we try to reduce it into a SPIN BQM") {
+            auto bqm = BinaryQuadraticModel<double>(Vartype::SPIN);
+
+            THEN("an exception is thrown") {
+                CHECK_THROWS_AS(poly.make_quadratic(bqm, 10), std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("a SPIN polynomial") {
+        auto poly = BinaryPolynomial<double>(Vartype::SPIN);
+        poly.add_term({0, 1, 2}, 1);
+        poly.add_term({1, 2, 3}, -1);
+        poly.add_term({0, 3}, .5);
+
+        WHEN("we make it quadratic") {
+            auto bqm = BinaryQuadraticModel<double>(Vartype::SPIN);
+            auto reductions = poly.make_quadratic(bqm, 5);
+
+            THEN("each product has an auxiliary variable and the ground states match") {
+                REQUIRE(reductions.size() == 1);
+                CHECK(reductions[0].u == 1);
+                CHECK(reductions[0].v == 2);
+                CHECK(reductions[0].product == 4);
+                CHECK(reductions[0].auxiliary == 5);
+                check_ground_states(poly, bqm);
+            }
+        }
+    }
+
+    GIVEN("a quadratic polynomial") {
+        auto poly = BinaryPolynomial<double>(Vartype::BINARY);
+        poly.add_term({0, 1}, 1);
+        poly.add_term({2}, -1);
+
+        THEN("it is copied without any reductions") {
+            auto bqm = BinaryQuadraticModel<double>(Vartype::BINARY);
+            CHECK(poly.make_quadratic(bqm, 1).empty());
+            CHECK(bqm.num_variables() == 3);
+            CHECK(bqm.quadratic(0, 1) == 1);
+            CHECK(bqm.linear(2) == -1);
+        }
+    }
+}
+
+}  // namespace dimod
@@ -434,6 +434,133 @@ TEST_CASE("BinaryQuadraticModel swap") {
     }
 }
 
+TEST_CASE("BinaryQuadraticModel freeze() and thaw()") {
+    GIVEN("a BQM with several interactions") {
+        auto bqm = BinaryQuadraticModel<double>(5, Vartype::BINARY);
+        bqm.set_offset(5);
+        bqm.set_linear(0, {0, -1, +2, -3, +4});
+        bqm.add_quadratic(0, 1, 1);
+        bqm.add_quadratic(0, 3, 3);
+        bqm.add_quadratic(2, 4, 24);
+        bqm.add_quadratic(3, 4, 34);
+
+        auto original = bqm;
+
+        WHEN("we freeze it") {
+            bqm.freeze();
+
+            THEN("it can be read the same as before") {
+                CHECK(bqm.is_frozen());
+                CHECK(!original.is_frozen());
+                CHECK(bqm.num_variables() == 5);
+                CHECK(bqm.num_interactions() == 4);
+                CHECK(bqm.num_interactions(4) == 2);
+                CHECK(bqm.quadratic(0, 3) == 3);
+                CHECK(bqm.quadratic(4, 3) == 34);
+                CHECK(bqm.quadratic(1, 2) == 0);
+                CHECK(bqm.quadratic_at(2, 4) == 24);
+                CHECK_THROWS_AS(bqm.quadratic_at(1, 2), std::out_of_range);
+                CHECK(bqm.has_interaction(1, 0));
+                CHECK(!bqm.has_interaction(1, 4));
+                CHECK(!bqm.is_linear());
+                CHECK(bqm.is_equal(original));
+
+                std::vector<int> sample = {1, 1, 0, 1, 1};
+                CHECK(bqm.energy(sample.begin()) == original.energy(sample.begin()));
+
+                auto it = bqm.cbegin_neighborhood(4);
+                CHECK(it->v == 2);
+                CHECK(it->bias == 24);
+                ++it;
+                CHECK(it->v == 3);
+                CHECK(it->bias == 34);
+                ++it;
+                CHECK(it == bqm.cend_neighborhood(4));
+            }
+
+            THEN("copies are also frozen") {
+                auto bqm2 = bqm;
+                CHECK(bqm2.is_frozen());
+                CHECK(bqm2.is_equal(original));
+            }
+
+            AND_WHEN("we change the linear biases, scale it and add a variable") {
+                bqm.add_linear(1, 1.5);
+                bqm.scale(2);
+                bqm.add_variable();
+
+                original.add_linear(1, 1.5);
+                original.scale(2);
+                original.add_variable();
+
+                THEN("it stays frozen") {
+                    CHECK(bqm.is_frozen());
+                    CHECK(bqm.num_variables() == 6);
+                    CHECK(bqm.num_interactions(5) == 0);
+                    CHECK(bqm.is_equal(original));
+                }
+            }
+
+            AND_WHEN("we change the vartype") {
+                bqm.change_vartype(Vartype::SPIN);
+                original.change_vartype(Vartype::SPIN);
+
+                THEN("it stays frozen and is unchanged otherwise") {
+                    CHECK(bqm.is_frozen());
+                    CHECK(bqm.is_equal(original));
+                }
+            }
+
+            AND_WHEN("we add an interaction") {
+                bqm.add_quadratic(1, 2, 12);
+
+                THEN("it is thawed") {
+                    CHECK(!bqm.is_frozen());
+                    CHECK(bqm.num_interactions() == 5);
+                    CHECK(bqm.quadratic(2, 1) == 12);
+                    CHECK(bqm.quadratic(4, 3) == 34);
+                }
+            }
+
+            AND_WHEN("we remove a variable") {
+                bqm.remove_variable(3);
+                original.remove_variable(3);
+
+                THEN("it is thawed") {
+                    CHECK(!bqm.is_frozen());
+                    CHECK(bqm.is_equal(original));
+                }
+            }
+
+            AND_WHEN("we thaw it") {
+                bqm.thaw();
+
+                THEN("it is unchanged") {
+                    CHECK(!bqm.is_frozen());
+                    CHECK(bqm.is_equal(original));
+                }
+            }
+        }
+    }
+
+    GIVEN("a linear BQM") {
+        auto bqm = BinaryQuadraticModel<float>(3, Vartype::SPIN);
+        bqm.set_linear(0, {1, 2, 3});
+
+        WHEN("we freeze it") {
+            bqm.freeze();
+
+            THEN("it is still linear") {
+                CHECK(bqm.is_frozen());
+                CHECK(bqm.is_linear());
+                CHECK(bqm.num_interactions() == 0);
+                CHECK(bqm.cbegin_quadratic() == bqm.cend_quadratic());
+                CHECK(bqm.cbegin_neighborhood(1) == bqm.cend_neighborhood(1));
+            }
+        }
+    }
+}
+
 TEMPLATE_TEST_CASE_SIG("Scenario: BinaryQuadraticModel tests", "[qmbase][bqm]",
                        ((typename Bias, Vartype vartype), Bias, vartype), (double, Vartype::BINARY),
                        (double, Vartype::SPIN), (float, Vartype::BINARY), (float, Vartype::SPIN)) {
@@ -674,4 +801,57 @@ TEMPLATE_TEST_CASE_SIG("Scenario: BinaryQuadraticModel tests", "[qmbase][bqm]",
         }
     }
 }
+
+SCENARIO("BQM energies can be specialized by vartype") {
+    GIVEN("a dense BINARY BQM and some samples") {
+        const int n = 80;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+        for (int u = 0; u < n; ++u) {
+            bqm.set_linear(u, u % 7 - 3);
+            for (int v = u + 1; v < n; ++v) bqm.set_quadratic(u, v, (u * v) % 5 - 2.5);
+        }
+        bqm.set_offset(1.25);
+
+        std::vector<std::vector<int>> samples;
+        for (int si = 0; si < 10; ++si) {
+            std::vector<int> sample(n);
+            for (int v = 0; v < n; ++v) sample[v] = ((v * 31 + si * 17) % 11) < si;
+            samples.push_back(sample);
+        }
+
+        THEN("the specialized energies match the generic ones") {
+            for (const auto& sample : samples) {
+                CHECK(bqm.energy<Vartype::BINARY>(sample.begin()) ==
+                      Approx(bqm.energy(sample.begin())));
+            }
+        }
+
+        WHEN("the BQM is frozen") {
+            std::vector<double> energies;
+            for (const auto& sample : samples) energies.push_back(bqm.energy(sample.begin()));
+
+            bqm.freeze();
+
+            THEN("the specialized energies still match") {
+                for (std::size_t si = 0; si < samples.size(); ++si) {
+                    CHECK(bqm.energy<Vartype::BINARY>(samples[si].begin()) ==
+                          Approx(energies[si]));
+                }
+            }
+        }
+
+        WHEN("the BQM is changed to SPIN") {
+            bqm.change_vartype(Vartype::SPIN);
+
+            THEN("the SPIN specialization matches the generic energies") {
+                for (auto sample : samples) {
+                    for (auto& value : sample) value = 2 * value - 1;
+                    CHECK(bqm.energy<Vartype::SPIN>(sample.begin()) ==
+                          bqm.energy(sample.begin()));
+                }
+            }
+        }
+    }
+}
+
 }  // namespace dimod
@@ -12,6 +12,9 @@
 //    See the License for the specific language governing permissions and
 //    limitations under the License.
 
+#include <algorithm>
+#include <vector>
+
 #include "catch2/catch.hpp"
 #include "dimod/constrained_quadratic_model.h"
 #include "dimod/quadratic_model.h"
@@ -903,6 +906,74 @@ TEST_CASE("Test ConstrainedQuadraticModel::fix_variables()") {
             }
         }
     }
+
+    GIVEN("A CQM with constraints that do and do not have the fixed variables") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, 40, -3, 3);
+        cqm.set_lower_bound(30, -1);
+
+        cqm.objective.add_linear(1, 2);
+        cqm.objective.add_quadratic(35, 30, -1);
+
+        for (int c = 0; c < 20; ++c) {
+            // constraints over more than 16 variables also have a map of their variables
+            const int size = c % 2 ? 3 : 20;
+            auto& constraint = cqm.constraint_ref(cqm.add_constraint());
+            for (int i = 0; i < size; ++i) constraint.add_linear((c + 7 * i) % 40, i + 1);
+            constraint.add_quadratic(c, (c + 13) % 40, c - 10.5);
+            constraint.set_rhs(c);
+            constraint.set_sense(Sense::GE);
+            constraint.set_weight(2 * c);
+        }
+
+        WHEN("we fix some of the variables") {
+            std::vector<int> variables{0, 5, 21};
+            std::vector<double> values{2, -1, 3};
+
+            auto fixed = cqm.fix_variables(variables.begin(), variables.end(), values.begin(), 3);
+
+            auto expected = cqm;
+            expected.fix_variable(21, 3);
+            expected.fix_variable(5, -1);
+            expected.fix_variable(0, 2);
+
+            THEN("it matches fixing them one at a time") {
+                REQUIRE(fixed.num_variables() == expected.num_variables());
+                REQUIRE(fixed.num_constraints() == expected.num_constraints());
+
+                auto check_same = [&](const Expression<double>& a, const Expression<double>& b) {
+                    CHECK(a.variables() == b.variables());
+                    CHECK(a.num_interactions() == b.num_interactions());
+                    CHECK(a.offset() == b.offset());
+                    for (int u = 0; u < static_cast<int>(fixed.num_variables()); ++u) {
+                        CHECK(a.has_variable(u) == b.has_variable(u));
+                        CHECK(a.linear(u) == b.linear(u));
+                        for (int v = u; v < static_cast<int>(fixed.num_variables()); ++v) {
+                            CHECK(a.quadratic(u, v) == b.quadratic(u, v));
+                        }
+                    }
+                };
+
+                check_same(fixed.objective, expected.objective);
+                for (std::size_t c = 0; c < fixed.num_constraints(); ++c) {
+                    const auto& constraint = fixed.constraint_ref(c);
+                    check_same(constraint, expected.constraint_ref(c));
+                    CHECK(constraint.rhs() == expected.constraint_ref(c).rhs());
+                    CHECK(constraint.sense() == expected.constraint_ref(c).sense());
+                    CHECK(constraint.weight() == expected.constraint_ref(c).weight());
+                }
+            }
+
+            THEN("the copied constraints refer to the new model") {
+                cqm.clear();
+                // variable 30 is now 27
+                for (std::size_t c = 0; c < fixed.num_constraints(); ++c) {
+                    CHECK(fixed.constraint_ref(c).lower_bound(27) == -1);
+                }
+                CHECK(fixed.objective.lower_bound(27) == -1);
+            }
+        }
+    }
 }
 
 TEST_CASE("Test Expression::add_quadratic()") {
@@ -1016,4 +1087,436 @@ TEST_CASE("Test Expression::remove_variables()") {
     }
 }
 
+TEST_CASE("Test Expression::nbytes()") {
+    GIVEN("A CQM with a linear constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 10);
+        auto c = cqm.add_linear_constraint({2, 3, 5, 8}, {1, 2, 3, 4}, Sense::EQ, 1);
+
+        THEN("nbytes() counts the biases and the variables but there is no map") {
+            const auto& constraint = cqm.constraint_ref(c);
+
+            CHECK(constraint.nbytes() >= 4 * sizeof(double)  // linear
+                                                 + 4 * sizeof(int)  // variables
+            );
+            CHECK(constraint.nbytes() < 4 * sizeof(double)       // linear
+                                                + 4 * sizeof(int)      // variables
+                                                + 4 * 2 * sizeof(int)  // indices
+            );
+            CHECK(constraint.nbytes(true) >= constraint.nbytes());
+        }
+    }
+
+    GIVEN("A CQM with a large linear constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 100);
+        auto c = cqm.add_constraint();
+        for (int v = 0; v < 50; ++v) cqm.constraint_ref(c).add_linear(v, 1);
+
+        THEN("nbytes() also counts the map to the variables") {
+            CHECK(cqm.constraint_ref(c).nbytes() >= 50 * sizeof(double)       // linear
+                                                            + 50 * sizeof(int)      // variables
+                                                            + 50 * 2 * sizeof(int)  // indices
+            );
+        }
+    }
+}
+
+TEST_CASE("Test Expression lookups with and without the index map") {
+    GIVEN("A CQM with many variables") {
+        const int num_variables = 60;
+
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, num_variables, -5, 5);
+
+        auto c = cqm.add_constraint();
+        auto& constraint = cqm.constraint_ref(c);
+
+        // add variables in a scrambled order, crossing the size at which the
+        // expression starts tracking its variables with a map
+        std::vector<int> order;
+        for (int i = 0; i < 40; ++i) order.push_back((7 * i + 3) % num_variables);
+        for (int i = 0; i < 40; ++i) constraint.add_linear(order[i], i + 1);
+        constraint.set_offset(-2);
+
+        auto check_biases = [&]() {
+            for (int v = 0; v < num_variables; ++v) {
+                auto it = std::find(order.begin(), order.end(), v);
+                if (it == order.end()) {
+                    CHECK(!constraint.has_variable(v));
+                    CHECK(constraint.linear(v) == 0);
+                } else {
+                    CHECK(constraint.has_variable(v));
+                    CHECK(constraint.linear(v) == (it - order.begin()) + 1);
+                }
+            }
+            CHECK(constraint.variables() == order);
+        };
+
+        THEN("the biases can be found") { check_biases(); }
+
+        WHEN("we remove most of the variables one at a time") {
+            while (order.size() > 5) {
+                constraint.remove_variable(order[1]);
+                order.erase(order.begin() + 1);
+            }
+            // the linear biases are shifted, so we fix up our expectations
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                constraint.set_linear(order[i], i + 1);
+            }
+
+            THEN("the remaining biases can still be found") { check_biases(); }
+
+            AND_WHEN("we add them back") {
+                for (int i = 1; i < 36; ++i) {
+                    order.push_back((7 * i + 3) % num_variables);
+                    constraint.add_linear(order.back(), order.size());
+                }
+
+                THEN("the biases can be found") { check_biases(); }
+            }
+        }
+
+        WHEN("we remove a variable from the CQM") {
+            cqm.remove_variable(order[0]);
+
+            THEN("the labels are shifted down") {
+                const auto& constraint = cqm.constraint_ref(c);
+                REQUIRE(constraint.num_variables() == 39);
+                for (int i = 1; i < 40; ++i) {
+                    int v = order[i] > order[0] ? order[i] - 1 : order[i];
+                    CHECK(constraint.variables()[i - 1] == v);
+                    CHECK(constraint.linear(v) == i + 1);
+                }
+            }
+        }
+
+        WHEN("we calculate the energies of some samples") {
+            std::vector<int> samples;
+            for (int i = 0; i < 3 * num_variables; ++i) samples.push_back(i % 11 - 5);
+
+            std::vector<double> energies(3);
+            constraint.energies(samples.data(), 3, num_variables, energies.data());
+
+            THEN("they match the ones calculated by hand") {
+                for (int si = 0; si < 3; ++si) {
+                    double en = -2;
+                    for (int i = 0; i < 40; ++i) {
+                        en += (i + 1) * samples[si * num_variables + order[i]];
+                    }
+                    CHECK(energies[si] == Approx(en));
+                    CHECK(constraint.energy(samples.begin() + si * num_variables) == Approx(en));
+                }
+            }
+
+            AND_WHEN("we add an interaction") {
+                constraint.add_quadratic(order[0], order[1], 3);
+                constraint.energies(samples.data(), 3, num_variables, energies.data());
+
+                THEN("the energies include it") {
+                    for (int si = 0; si < 3; ++si) {
+                        const int* sample = samples.data() + si * num_variables;
+                        double en = -2 + 3 * sample[order[0]] * sample[order[1]];
+                        for (int i = 0; i < 40; ++i) en += (i + 1) * sample[order[i]];
+                        CHECK(energies[si] == Approx(en));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test ConstrainedQuadraticModel::remove_variables()") {
+    GIVEN("A CQM with an objective and several constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, 4, -5, 5);
+        cqm.add_variable(Vartype::BINARY);
+        cqm.add_variables(Vartype::INTEGER, 5, -5, 5);
+
+        for (int v = 0; v < 10; ++v) {
+            cqm.objective.set_linear(v, v);
+            if (v) cqm.objective.set_quadratic(v - 1, v, -v);
+        }
+        cqm.objective.set_offset(1.5);
+
+        auto c0 = cqm.add_linear_constraint({8, 2, 5, 3}, {1, 2, 3, 4}, Sense::LE, 1);
+        auto c1 = cqm.add_linear_constraint({3, 8}, {5, 6}, Sense::GE, 2);
+        auto c2 = cqm.add_linear_constraint({0, 1}, {7, 8}, Sense::EQ, 3);
+        cqm.constraint_ref(c0).set_quadratic(2, 5, 9);
+        cqm.constraint_ref(c0).set_quadratic(8, 3, 10);
+        cqm.constraint_ref(c0).set_quadratic(5, 5, 11);
+
+        WHEN("we remove several variables at once") {
+            auto expected = cqm;
+            for (int v : {8, 5, 3}) expected.remove_variable(v);
+
+            cqm.remove_variables({3, 8, 5, 8});  // duplicates are ignored
+
+            THEN("the result matches removing them one at a time") {
+                REQUIRE(cqm.num_variables() == 7);
+                REQUIRE(cqm.num_constraints() == 3);
+
+                for (int v = 0; v < 7; ++v) {
+                    CHECK(cqm.vartype(v) == expected.vartype(v));
+                    CHECK(cqm.lower_bound(v) == expected.lower_bound(v));
+                }
+                CHECK(cqm.vartype(3) == Vartype::BINARY);  // was 4
+
+                CHECK(cqm.objective.variables() == expected.objective.variables());
+                CHECK(cqm.objective.num_interactions() == expected.objective.num_interactions());
+                CHECK(cqm.objective.offset() == 1.5);
+                for (int u = 0; u < 7; ++u) {
+                    CHECK(cqm.objective.linear(u) == expected.objective.linear(u));
+                    for (int v = 0; v < 7; ++v) {
+                        CHECK(cqm.objective.quadratic(u, v) == expected.objective.quadratic(u, v));
+                    }
+                }
+
+                const auto& const0 = cqm.constraint_ref(c0);
+                CHECK(const0.variables() == std::vector<int>{2});
+                CHECK(const0.linear(2) == 2);
+                CHECK(const0.num_interactions() == 0);
+                CHECK(const0.sense() == Sense::LE);
+
+                CHECK(cqm.constraint_ref(c1).num_variables() == 0);
+
+                const auto& const2 = cqm.constraint_ref(c2);
+                CHECK(const2.variables() == std::vector<int>{0, 1});
+                CHECK(const2.linear(1) == 8);
+            }
+        }
+
+        WHEN("we remove no variables") {
+            cqm.remove_variables({});
+
+            THEN("nothing changes") {
+                CHECK(cqm.num_variables() == 10);
+                CHECK(cqm.constraint_ref(c0).variables() == std::vector<int>{8, 2, 5, 3});
+            }
+        }
+    }
+}
+
+// Check that two expressions over the same variables have the same biases
+template <class Bias, class Index>
+void check_same_expression(const Expression<Bias, Index>& a, const Expression<Bias, Index>& b,
+                           Index num_variables) {
+    CHECK(a.variables() == b.variables());
+    CHECK(a.num_interactions() == b.num_interactions());
+    CHECK(a.offset() == Approx(b.offset()));
+    for (Index u = 0; u < num_variables; ++u) {
+        CHECK(a.linear(u) == Approx(b.linear(u)));
+        for (Index v = u; v < num_variables; ++v) {
+            CHECK(a.quadratic(u, v) == Approx(b.quadratic(u, v)));
+        }
+    }
+}
+
+TEST_CASE("Test ConstrainedQuadraticModel constraint operations with multiple threads") {
+    GIVEN("A CQM with many constraints") {
+        const int num_variables = 12;
+
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::SPIN, 4);
+        cqm.add_variables(Vartype::BINARY, 4);
+        cqm.add_variables(Vartype::INTEGER, 4, -3, 7);
+
+        for (int v = 0; v < num_variables; ++v) {
+            cqm.objective.set_linear(v, v + 1);
+            cqm.objective.add_quadratic(v, (v + 5) % num_variables, -v);
+        }
+
+        for (int c = 0; c < 50; ++c) {
+            auto ci = cqm.add_linear_constraint({c % num_variables, (3 * c + 1) % num_variables},
+                                                {1.0 * c, -2.0}, Sense::LE, c);
+            cqm.constraint_ref(ci).add_quadratic(c % num_variables, (c + 7) % num_variables,
+                                                 .5 * c);
+            cqm.constraint_ref(ci).set_weight(c + 1);
+        }
+
+        auto expected = cqm;
+
+        auto check_same = [&]() {
+            REQUIRE(cqm.num_variables() == expected.num_variables());
+            REQUIRE(cqm.num_constraints() == expected.num_constraints());
+            for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+                CHECK(cqm.vartype(v) == expected.vartype(v));
+            }
+            check_same_expression(cqm.objective, expected.objective,
+                                  static_cast<int>(cqm.num_variables()));
+            for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+                check_same_expression(cqm.constraint_ref(c), expected.constraint_ref(c),
+                                      static_cast<int>(cqm.num_variables()));
+                CHECK(cqm.constraint_ref(c).rhs() == expected.constraint_ref(c).rhs());
+                CHECK(cqm.constraint_ref(c).weight() == expected.constraint_ref(c).weight());
+            }
+        };
+
+        WHEN("we substitute a variable using several threads") {
+            cqm.substitute_variable(9, 2, -1, 4);
+            expected.substitute_variable(9, 2, -1);
+
+            THEN("the result matches the serial one") { check_same(); }
+        }
+
+        WHEN("we change variables' vartypes using several threads") {
+            cqm.change_vartype(Vartype::BINARY, 1, 4);
+            cqm.change_vartype(Vartype::SPIN, 6, 3);
+            expected.change_vartype(Vartype::BINARY, 1);
+            expected.change_vartype(Vartype::SPIN, 6);
+
+            THEN("the result matches the serial one") { check_same(); }
+        }
+
+        WHEN("we remove variables using several threads") {
+            cqm.remove_variable(0, 4);
+            cqm.remove_variables({2, 7, 10}, 4);
+            expected.remove_variable(0);
+            expected.remove_variables({2, 7, 10});
+
+            THEN("the result matches the serial one") { check_same(); }
+        }
+
+        WHEN("we fix variables using several threads") {
+            std::vector<int> variables = {3, 5, 10};
+            std::vector<int> assignments = {-1, 1, 6};
+
+            cqm.fix_variable(8, 2, 4);
+            expected.fix_variable(8, 2);
+
+            cqm = cqm.fix_variables(variables.begin(), variables.end(), assignments.begin(), 4);
+            expected = expected.fix_variables(variables.begin(), variables.end(),
+                                              assignments.begin());
+
+            THEN("the result matches the serial one") {
+                check_same();
+                // the new constraints refer to the new model
+                for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+                    for (int v = 0; v < static_cast<int>(cqm.num_variables()); ++v) {
+                        CHECK(cqm.constraint_ref(c).vartype(v) == cqm.vartype(v));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test Expression::energies()") {
+    GIVEN("A CQM with an objective over a subset of its variables") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, 6, -5, 5);
+
+        cqm.objective.set_linear(4, 1.5);
+        cqm.objective.set_linear(1, -2);
+        cqm.objective.set_quadratic(4, 1, 3);
+        cqm.objective.set_quadratic(3, 4, -.5);
+        cqm.objective.set_quadratic(3, 3, 2);
+        cqm.objective.set_offset(7);
+
+        WHEN("we calculate the energies of many samples at once") {
+            const std::size_t num_samples = 600;  // more than one chunk
+            const std::size_t stride = 8;         // padded past num_variables
+
+            std::vector<int> samples(num_samples * stride);
+            for (std::size_t i = 0; i < samples.size(); ++i) {
+                samples[i] = static_cast<int>((i * 7) % 11) - 5;
+            }
+
+            std::vector<double> energies(num_samples);
+            cqm.objective.energies(samples.data(), num_samples, stride, energies.data(), 3);
+
+            THEN("they match the energies calculated one at a time") {
+                for (std::size_t si = 0; si < num_samples; ++si) {
+                    CHECK(energies[si] ==
+                          Approx(cqm.objective.energy(samples.begin() + si * stride)));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test ConstrainedQuadraticModel::violations()") {
+    GIVEN("A CQM with hard and soft constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, 3, 0, 5);
+
+        cqm.add_linear_constraint({0, 1}, {1, 1}, Sense::EQ, 4);
+        cqm.add_linear_constraint({1, 2}, {2, -1}, Sense::LE, 3);
+        auto ge = cqm.add_linear_constraint({2}, {1}, Sense::GE, 2);
+        cqm.constraint_ref(ge).set_quadratic(0, 2, 1);
+
+        auto soft = cqm.add_linear_constraint({0}, {1}, Sense::LE, 1);
+        cqm.constraint_ref(soft).set_weight(3);
+
+        std::vector<int> samples = {2, 2, 2,   // eq: 0, le: -1, ge: -4, soft: 1
+                                    0, 3, 1,   // eq: 1, le: 2, ge: 1, soft: -1
+                                    5, 0, 0};  // eq: 1, le: -3, ge: 2, soft: 4
+        const std::size_t num_samples = 3;
+
+        WHEN("we calculate the violations") {
+            std::vector<double> violations(num_samples * cqm.num_constraints());
+            cqm.violations(samples.data(), num_samples, 3, violations.data(), 2);
+
+            THEN("they are laid out by sample and then by constraint") {
+                CHECK(violations == std::vector<double>{0, -1, -4, 1,  //
+                                                        1, 2, 1, -1,   //
+                                                        1, -3, 2, 4});
+            }
+
+            THEN("they match the per-constraint calculation") {
+                for (std::size_t si = 0; si < num_samples; ++si) {
+                    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+                        const auto& constraint = cqm.constraint_ref(c);
+                        double lhs = constraint.energy(samples.begin() + si * 3);
+                        CHECK(violations[si * cqm.num_constraints() + c] ==
+                              constraint.violation(lhs));
+                    }
+                }
+            }
+        }
+
+        WHEN("we check the feasibility") {
+            bool feasible[3];
+            cqm.feasible(samples.data(), num_samples, 3, feasible);
+
+            THEN("only the samples satisfying the hard constraints are feasible") {
+                CHECK(feasible[0]);   // the soft constraint is violated
+                CHECK(!feasible[1]);
+                CHECK(!feasible[2]);
+            }
+
+            AND_WHEN("we use a large enough tolerance") {
+                cqm.feasible(samples.data(), num_samples, 3, feasible, 0, 2);
+
+                THEN("all of the samples are feasible") {
+                    CHECK(feasible[0]);
+                    CHECK(feasible[1]);
+                    CHECK(feasible[2]);
+                }
+            }
+        }
+
+        WHEN("we calculate the penalties") {
+            std::vector<double> penalties(num_samples);
+
+            THEN("linear penalties scale with the violation") {
+                cqm.penalties(samples.data(), num_samples, 3, penalties.data());
+                CHECK(penalties == std::vector<double>{3, 0, 12});
+            }
+
+            THEN("quadratic penalties scale with the square of the violation") {
+                cqm.constraint_ref(soft).set_penalty(Penalty::QUADRATIC);
+                cqm.penalties(samples.data(), num_samples, 3, penalties.data());
+                CHECK(penalties == std::vector<double>{3, 0, 48});
+            }
+
+            THEN("constant penalties are the weight") {
+                cqm.constraint_ref(soft).set_penalty(Penalty::CONSTANT);
+                cqm.penalties(samples.data(), num_samples, 3, penalties.data());
+                CHECK(penalties == std::vector<double>{3, 0, 3});
+            }
+        }
+    }
+}
+
 }  // namespace dimod
@@ -0,0 +1,276 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/cqm_fileview.h"
+
+namespace dimod {
+
+template <class Bias, class Index>
+void check_same_expression(const Expression<Bias, Index>& a, const Expression<Bias, Index>& b) {
+    REQUIRE(a.num_variables() == b.num_variables());
+    REQUIRE(a.num_interactions() == b.num_interactions());
+    CHECK(a.offset() == b.offset());
+    CHECK(a.variables() == b.variables());
+    for (auto v : a.variables()) {
+        CHECK(a.linear(v) == b.linear(v));
+        for (auto u : a.variables()) {
+            CHECK(a.quadratic(u, v) == b.quadratic(u, v));
+        }
+    }
+}
+
+template <class Bias, class Index>
+void check_same_constraint(const Constraint<Bias, Index>& a, const Constraint<Bias, Index>& b) {
+    check_same_expression(a, b);
+    CHECK(a.sense() == b.sense());
+    CHECK(a.rhs() == b.rhs());
+    CHECK(a.weight() == b.weight());
+    CHECK(a.penalty() == b.penalty());
+    CHECK(a.marked_discrete() == b.marked_discrete());
+}
+
+SCENARIO("constrained quadratic models can be streamed to and from format version 3.0",
+         "[cqm][fileview]") {
+    GIVEN("a CQM with a few constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 3);
+        cqm.add_variable(Vartype::INTEGER, -5, 10);
+        cqm.add_variable(Vartype::REAL, -1.5, 2.5);
+        cqm.add_variable(Vartype::SPIN);
+
+        cqm.objective.set_offset(3);
+        cqm.objective.add_linear(4, 1.5);
+        cqm.objective.add_linear(0, -1);
+        cqm.objective.add_quadratic(0, 3, 2);
+        cqm.objective.add_quadratic(3, 3, -.5);
+
+        // c0: 5*v0 + v1 - v0*v1 <= 3
+        auto c0 = cqm.add_linear_constraint({0, 1}, {5, 1}, Sense::LE, 3);
+        cqm.constraint_ref(c0).add_quadratic(0, 1, -1);
+
+        // c1: a weighted, discrete, one-hot constraint
+        auto c1 = cqm.add_linear_constraint({2, 1, 0}, {1, 1, 1}, Sense::EQ, 1);
+        cqm.constraint_ref(c1).set_weight(4);
+        cqm.constraint_ref(c1).set_penalty(Penalty::QUADRATIC);
+        cqm.constraint_ref(c1).mark_discrete();
+
+        // c2: an empty constraint
+        auto c2 = cqm.add_constraint();
+        cqm.constraint_ref(c2).set_sense(Sense::GE);
+        cqm.constraint_ref(c2).set_rhs(-1);
+
+        // c3: a constraint with every variable and an offset
+        auto c3 = cqm.add_linear_constraint({5, 4, 3, 2, 1, 0}, {1, 2, 3, 4, 5, 6}, Sense::GE, 0);
+        cqm.constraint_ref(c3).set_offset(-2);
+        cqm.constraint_ref(c3).add_quadratic(5, 4, 7);
+
+        WHEN("we serialize it with labels") {
+            fileview::DumpOptions options;
+            options.variable_labels = "[\"a\", \"b\", \"c\", \"i\", \"x\", \"s\"]";
+            options.constraint_labels = "";
+            options.batch_size = 3;  // more than one batch
+            options.num_threads = 2;
+
+            std::string buffer = fileview::dumps(cqm, options);
+
+            THEN("it has the expected header and footer") {
+                CHECK(buffer.substr(0, 8) == "DIMODCQM");
+                CHECK(buffer[8] == 3);
+                CHECK(buffer[9] == 0);
+                CHECK(buffer.substr(buffer.size() - 8) == "DIMODEND");
+            }
+
+            AND_WHEN("we read it back") {
+                auto reader = fileview::ConstrainedQuadraticModelReader<double>(buffer.data(),
+                                                                                buffer.size());
+                auto loaded = reader.load(2);
+
+                THEN("the models match") {
+                    CHECK(reader.num_variables() == 6);
+                    CHECK(reader.num_constraints() == 4);
+                    CHECK(reader.compression() == "");
+                    CHECK(reader.variable_labels() == options.variable_labels);
+                    CHECK(reader.constraint_labels() == "");
+
+                    REQUIRE(loaded.num_variables() == cqm.num_variables());
+                    REQUIRE(loaded.num_constraints() == cqm.num_constraints());
+                    for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+                        CHECK(loaded.vartype(v) == cqm.vartype(v));
+                        CHECK(loaded.lower_bound(v) == cqm.lower_bound(v));
+                        CHECK(loaded.upper_bound(v) == cqm.upper_bound(v));
+                    }
+
+                    check_same_expression(loaded.objective, cqm.objective);
+                    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+                        check_same_constraint(loaded.constraint_ref(c), cqm.constraint_ref(c));
+                    }
+                }
+            }
+
+            AND_WHEN("we read only one of the constraints") {
+                auto reader = fileview::ConstrainedQuadraticModelReader<double>(buffer.data(),
+                                                                                buffer.size());
+                auto parent = reader.load_objective();
+                auto constraint = reader.load_constraint(c3, parent);
+
+                THEN("it matches the original") {
+                    CHECK(parent.num_constraints() == 0);
+                    check_same_expression(parent.objective, cqm.objective);
+                    check_same_constraint(constraint, cqm.constraint_ref(c3));
+                    CHECK_THROWS_AS(reader.load_constraint(4, parent), std::out_of_range);
+                }
+            }
+
+            AND_WHEN("we try to read a truncated or mistyped buffer") {
+                THEN("an exception is thrown") {
+                    CHECK_THROWS_AS(fileview::ConstrainedQuadraticModelReader<double>(
+                                            buffer.data(), buffer.size() - 1),
+                                    std::invalid_argument);
+                    CHECK_THROWS_AS(fileview::ConstrainedQuadraticModelReader<double>(
+                                            buffer.data(), 20),
+                                    std::invalid_argument);
+                    CHECK_THROWS_AS(fileview::ConstrainedQuadraticModelReader<float>(
+                                            buffer.data(), buffer.size()),
+                                    std::invalid_argument);
+                }
+            }
+        }
+
+        WHEN("we stream it through write and read functions") {
+            // a file that records how it is read and can be made to fail
+            struct File {
+                std::string data;
+                std::size_t max_read = 0;
+                bool fail = false;
+
+                static bool write(void* context, const char* data, std::size_t n) {
+                    File& file = *static_cast<File*>(context);
+                    if (file.fail) return false;
+                    file.data.append(data, n);
+                    return true;
+                }
+
+                static bool read(void* context, std::uint64_t offset, std::size_t n, char* out) {
+                    File& file = *static_cast<File*>(context);
+                    if (file.fail || offset + n > file.data.size()) return false;
+                    file.max_read = std::max(file.max_read, n);
+                    std::copy(file.data.begin() + offset, file.data.begin() + offset + n, out);
+                    return true;
+                }
+            } file;
+
+            fileview::DumpOptions options;
+            options.batch_size = 2;
+            options.num_threads = 2;
+            fileview::dump(cqm, File::write, &file, options);
+
+            THEN("the same bytes are written as by dumps()") {
+                CHECK(file.data == fileview::dumps(cqm, options));
+            }
+
+            AND_WHEN("we read it back one block at a time") {
+                auto reader = fileview::ConstrainedQuadraticModelReader<double>(
+                        File::read, &file, file.data.size());
+                auto loaded = reader.load(3);
+
+                THEN("the models match") {
+                    REQUIRE(loaded.num_constraints() == cqm.num_constraints());
+                    check_same_expression(loaded.objective, cqm.objective);
+                    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+                        check_same_constraint(loaded.constraint_ref(c), cqm.constraint_ref(c));
+                    }
+
+                    // the largest read is the block table or a single block
+                    CHECK(file.max_read < file.data.size() / 2);
+                }
+
+                THEN("failed reads throw") {
+                    file.fail = true;
+                    CHECK_THROWS_AS(reader.load(), std::runtime_error);
+                    CHECK_THROWS_AS(fileview::ConstrainedQuadraticModelReader<double>(
+                                            File::read, &file, file.data.size()),
+                                    std::runtime_error);
+                }
+            }
+
+            THEN("failed writes throw") {
+                File failing;
+                failing.fail = true;
+                CHECK_THROWS_AS(fileview::dump(cqm, File::write, &failing), std::runtime_error);
+            }
+        }
+
+        WHEN("we serialize it with a block codec") {
+            // reversing each block stands in for a real compressor
+            auto reverse = [](const std::string& block) {
+                return std::string(block.rbegin(), block.rend());
+            };
+
+            fileview::DumpOptions options;
+            options.compression = "reversed";
+            options.compress = reverse;
+
+            std::string buffer = fileview::dumps(cqm, options);
+
+            THEN("it can only be read back with the inverse codec") {
+                CHECK_THROWS_AS(fileview::ConstrainedQuadraticModelReader<double>(buffer.data(),
+                                                                                  buffer.size()),
+                                std::invalid_argument);
+
+                auto reader = fileview::ConstrainedQuadraticModelReader<double>(
+                        buffer.data(), buffer.size(), reverse);
+                CHECK(reader.compression() == "reversed");
+
+                auto loaded = reader.load();
+                REQUIRE(loaded.num_constraints() == cqm.num_constraints());
+                check_same_expression(loaded.objective, cqm.objective);
+                for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+                    check_same_constraint(loaded.constraint_ref(c), cqm.constraint_ref(c));
+                }
+            }
+
+            THEN("decoding a corrupted block throws") {
+                auto identity = [](const std::string& block) { return block; };
+                auto reader = fileview::ConstrainedQuadraticModelReader<double>(
+                        buffer.data(), buffer.size(), identity);
+                CHECK_THROWS_AS(reader.load(), std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("an empty CQM") {
+        auto cqm = ConstrainedQuadraticModel<float, std::int64_t>();
+
+        THEN("it survives a round trip") {
+            std::string buffer = fileview::dumps(cqm);
+            auto reader = fileview::ConstrainedQuadraticModelReader<float, std::int64_t>(
+                    buffer.data(), buffer.size());
+            auto loaded = reader.load();
+            CHECK(loaded.num_variables() == 0);
+            CHECK(loaded.num_constraints() == 0);
+            CHECK(loaded.objective.offset() == 0);
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,148 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/discrete_quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("discrete quadratic models store interactions as dense blocks", "[dqm]") {
+    GIVEN("a DQM with three variables") {
+        auto dqm = DiscreteQuadraticModel<double>();
+        auto u = dqm.add_variable(2);
+        auto v = dqm.add_variable(3);
+        auto w = dqm.add_variable(1);
+
+        dqm.add_linear(u, 1, 1.5);
+        dqm.add_linear(v, 2, -1);
+        dqm.add_linear(w, 0, .25);
+        dqm.add_quadratic(u, 0, v, 2, 2);
+        dqm.add_quadratic(v, 1, u, 1, -3);  // same block, the other order
+        dqm.add_quadratic(w, 0, v, 0, 4);
+        dqm.set_offset(10);
+
+        THEN("the cases and biases can be read back") {
+            CHECK(dqm.num_variables() == 3);
+            CHECK(dqm.num_cases() == 6);
+            CHECK(dqm.num_cases(v) == 3);
+            CHECK(dqm.case_start(w) == 5);
+            CHECK(dqm.num_variable_interactions() == 2);
+
+            CHECK(dqm.linear(u, 1) == 1.5);
+            CHECK(dqm.linear(u, 0) == 0);
+            CHECK(dqm.quadratic(u, 0, v, 2) == 2);
+            CHECK(dqm.quadratic(v, 2, u, 0) == 2);
+            CHECK(dqm.quadratic(u, 1, v, 1) == -3);
+            CHECK(dqm.quadratic(u, 1, v, 2) == 0);
+            CHECK(dqm.quadratic(u, 0, w, 0) == 0);  // no block
+        }
+
+        THEN("the energies can be calculated") {
+            std::vector<int> samples{0, 2, 0,  //
+                                     1, 1, 0,  //
+                                     1, 0, 0};
+            std::vector<double> energies(3);
+            dqm.energies(samples.data(), 3, 3, energies.data());
+            CHECK(energies == std::vector<double>{10 + 2 - 1 + .25, 10 + 1.5 - 3 + .25,
+                                                  10 + 1.5 + .25 + 4});
+        }
+
+        THEN("invalid cases are rejected") {
+            std::vector<std::int8_t> samples{0, 0, 0, 0, 3, 0};
+            std::vector<double> energies(2);
+            CHECK_THROWS_AS(dqm.energies(samples.data(), 2, 3, energies.data()),
+                            std::out_of_range);
+
+            samples[4] = -1;
+            CHECK_THROWS_AS(dqm.energies(samples.data(), 2, 3, energies.data()),
+                            std::out_of_range);
+        }
+
+        THEN("cases of the same variable cannot interact") {
+            CHECK_THROWS_AS(dqm.add_quadratic(v, 0, v, 1, 1), std::invalid_argument);
+            CHECK_THROWS_AS(dqm.add_variable(0), std::invalid_argument);
+        }
+    }
+
+    GIVEN("a BQM over the cases of a random DQM") {
+        const int num_variables = 30;
+
+        std::mt19937 gen(5);
+        std::uniform_int_distribution<int> cases(1, 5);
+        std::uniform_real_distribution<double> bias(-1, 1);
+
+        std::vector<int> case_starts{0};
+        for (int v = 0; v < num_variables; ++v) case_starts.push_back(case_starts.back() + cases(gen));
+
+        auto bqm = BinaryQuadraticModel<double>(case_starts.back(), Vartype::BINARY);
+        bqm.set_offset(-2);
+        for (int ci = 0; ci < case_starts.back(); ++ci) bqm.set_linear(ci, bias(gen));
+        for (int u = 0; u < num_variables; ++u) {
+            for (int v = u + 1; v < num_variables; v += 3) {
+                for (int cu = case_starts[u]; cu < case_starts[u + 1]; ++cu) {
+                    for (int cv = case_starts[v]; cv < case_starts[v + 1]; cv += 2) {
+                        bqm.add_quadratic(cu, cv, bias(gen));
+                    }
+                }
+            }
+        }
+
+        WHEN("we make a DQM from it") {
+            auto dqm = DiscreteQuadraticModel<double>(bqm, case_starts);
+
+            THEN("the energies match the BQM's for one-hot samples") {
+                const std::size_t num_samples = 200;
+                std::vector<int> samples(num_samples * num_variables);
+                std::vector<double> expected(num_samples);
+
+                std::vector<double> binary(bqm.num_variables());
+                for (std::size_t si = 0; si < num_samples; ++si) {
+                    std::fill(binary.begin(), binary.end(), 0);
+                    for (int v = 0; v < num_variables; ++v) {
+                        int c = gen() % dqm.num_cases(v);
+                        samples[si * num_variables + v] = c;
+                        binary[case_starts[v] + c] = 1;
+                    }
+                    expected[si] = bqm.energy(binary.begin());
+                }
+
+                for (int num_threads : {1, 4}) {
+                    std::vector<double> energies(num_samples);
+                    dqm.energies(samples.data(), num_samples, num_variables, energies.data(),
+                                 num_threads);
+                    for (std::size_t si = 0; si < num_samples; ++si) {
+                        CHECK(energies[si] == Approx(expected[si]));
+                    }
+                }
+            }
+        }
+
+        WHEN("two cases of the same variable interact") {
+            bqm.add_quadratic(case_starts[4], case_starts[4] + 1, 1);
+
+            THEN("the DQM cannot be constructed") {
+                REQUIRE(case_starts[5] - case_starts[4] > 1);
+                CHECK_THROWS_AS(DiscreteQuadraticModel<double>(bqm, case_starts),
+                                std::invalid_argument);
+            }
+        }
+    }
+}
+
+}  // namespace dimod
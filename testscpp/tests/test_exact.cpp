@@ -0,0 +1,194 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/exact.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("the lowest-energy states of a BQM can be enumerated", "[exact]") {
+    GIVEN("a random SPIN BQM") {
+        const int n = 12;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::SPIN);
+
+        std::mt19937 gen(17);
+        std::uniform_real_distribution<double> bias(-1, 1);
+        for (int u = 0; u < n; ++u) {
+            bqm.set_linear(u, bias(gen));
+            for (int v = u + 1; v < n; ++v) {
+                if (gen() % 3 == 0) bqm.set_quadratic(u, v, bias(gen));
+            }
+        }
+        bqm.set_offset(1.5);
+
+        // every state by brute force, in order of increasing energy
+        std::vector<std::pair<double, std::uint64_t>> expected;
+        std::vector<double> sample(n);
+        for (std::uint64_t bits = 0; bits < (1u << n); ++bits) {
+            for (int v = 0; v < n; ++v) sample[v] = (bits >> v) & 1 ? 1 : -1;
+            expected.emplace_back(bqm.energy(sample.begin()), bits);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        THEN("every state is found, regardless of the number of threads") {
+            for (int num_threads : {1, 3, 8}) {
+                auto states = exact::lowest_states(bqm, 1 << n, num_threads);
+                REQUIRE(states.size() == expected.size());
+                for (std::size_t i = 0; i < states.size(); ++i) {
+                    CHECK(states[i].energy == expected[i].first);
+                    CHECK(states[i].bits == expected[i].second);
+                }
+            }
+        }
+
+        THEN("only the lowest-energy states are kept when asked") {
+            for (int num_threads : {1, 4}) {
+                auto states = exact::lowest_states(bqm, 10, num_threads);
+                REQUIRE(states.size() == 10);
+                for (std::size_t i = 0; i < states.size(); ++i) {
+                    CHECK(states[i].bits == expected[i].second);
+                }
+            }
+            CHECK(exact::lowest_states(bqm, 0).empty());
+        }
+    }
+
+    GIVEN("a quadratic model with both BINARY and SPIN variables") {
+        auto qm = QuadraticModel<double>();
+        auto s = qm.add_variable(Vartype::SPIN);
+        auto x = qm.add_variable(Vartype::BINARY);
+        qm.add_linear(s, 1);
+        qm.add_quadratic(s, x, -3);
+
+        THEN("each variable takes its own values") {
+            auto states = exact::lowest_states(qm, 4);
+            REQUIRE(states.size() == 4);
+            CHECK(states[0].bits == 3);  // s = 1, x = 1
+            CHECK(states[0].energy == -2);
+            CHECK(states[1].bits == 0);  // s = -1, x = 0
+            CHECK(states[1].energy == -1);
+        }
+
+        THEN("models with other vartypes are rejected") {
+            qm.add_variable(Vartype::INTEGER, 0, 2);
+            CHECK_THROWS_AS(exact::lowest_states(qm, 4), std::invalid_argument);
+        }
+    }
+
+    GIVEN("an empty BQM") {
+        auto bqm = BinaryQuadraticModel<double>(Vartype::BINARY);
+        bqm.set_offset(2);
+
+        THEN("the only state is the empty one") {
+            auto states = exact::lowest_states(bqm, 5);
+            REQUIRE(states.size() == 1);
+            CHECK(states[0].bits == 0);
+            CHECK(states[0].energy == 2);
+        }
+    }
+}
+
+SCENARIO("the lowest-energy feasible samples of a CQM can be enumerated", "[exact]") {
+    GIVEN("a CQM with linear, quadratic, one-hot and soft constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        auto i = cqm.add_variable(Vartype::INTEGER, -1, 3);
+        auto j = cqm.add_variable(Vartype::INTEGER, 0, 2.5);  // 0, 1 or 2
+        cqm.add_variables(Vartype::BINARY, 3);                 // 2, 3, 4 are one-hot
+        auto s = cqm.add_variable(Vartype::SPIN);
+
+        cqm.objective.add_linear(i, -1);
+        cqm.objective.add_quadratic(i, j, 1);
+        cqm.objective.add_quadratic(i, i, .5);
+        cqm.objective.add_linear(3, -2);
+        cqm.objective.add_quadratic(4, s, 1.5);
+        cqm.objective.set_offset(3);
+
+        cqm.add_linear_constraint({i, j, 2}, {1, 1, 2}, Sense::LE, 3);
+        cqm.add_linear_constraint({2, 3, 4}, {1, 1, 1}, Sense::EQ, 1);
+        auto q = cqm.add_constraint();
+        cqm.constraint_ref(q).add_quadratic(i, s, 1);
+        cqm.constraint_ref(q).set_sense(Sense::GE);
+        cqm.constraint_ref(q).set_rhs(-1);
+        auto soft = cqm.add_linear_constraint({j, s}, {1, 1}, Sense::GE, 2);
+        cqm.constraint_ref(soft).set_weight(.75);
+
+        // every feasible sample by brute force
+        std::vector<std::pair<double, std::vector<double>>> expected;
+        std::vector<double> sample(cqm.num_variables());
+        for (int vi = -1; vi <= 3; ++vi) {
+            for (int vj = 0; vj <= 2; ++vj) {
+                for (int x = 0; x < 8; ++x) {
+                    for (int vs : {-1, 1}) {
+                        sample = {double(vi), double(vj), double(x & 1), double((x >> 1) & 1),
+                                  double((x >> 2) & 1), double(vs)};
+                        bool feasible;
+                        double penalty;
+                        cqm.feasible(sample.data(), 1, sample.size(), &feasible);
+                        cqm.penalties(sample.data(), 1, sample.size(), &penalty);
+                        if (feasible) {
+                            expected.emplace_back(cqm.objective.energy(sample.begin()) + penalty,
+                                                  sample);
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(expected.size() > 10);
+
+        THEN("every feasible sample is found, regardless of the number of threads") {
+            for (int num_threads : {1, 2, 7}) {
+                auto samples = exact::lowest_feasible(cqm, 1000, 1e-6, 1e-8, num_threads);
+                REQUIRE(samples.size() == expected.size());
+                for (std::size_t si = 0; si < samples.size(); ++si) {
+                    CHECK(samples[si].energy == Approx(expected[si].first));
+                    CHECK(samples[si].values == expected[si].second);
+                }
+            }
+        }
+
+        THEN("only the lowest-energy ones are kept when asked") {
+            auto samples = exact::lowest_feasible(cqm, 3, 1e-6, 1e-8, 4);
+            REQUIRE(samples.size() == 3);
+            for (std::size_t si = 0; si < samples.size(); ++si) {
+                CHECK(samples[si].values == expected[si].second);
+            }
+        }
+
+        WHEN("a constraint cannot be satisfied") {
+            cqm.add_linear_constraint({2, 3, 4}, {1, 1, 1}, Sense::GE, 2);
+
+            THEN("there are no feasible samples") {
+                CHECK(exact::lowest_feasible(cqm, 5).empty());
+            }
+        }
+
+        WHEN("a variable is REAL") {
+            cqm.add_variable(Vartype::REAL, 0, 1);
+
+            THEN("an exception is thrown") {
+                CHECK_THROWS_AS(exact::lowest_feasible(cqm, 5), std::invalid_argument);
+            }
+        }
+    }
+}
+
+}  // namespace dimod
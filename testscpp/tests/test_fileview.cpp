@@ -0,0 +1,157 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/fileview.h"
+
+namespace dimod {
+
+SCENARIO("binary quadratic models can be viewed in their serialized form", "[fileview]") {
+    GIVEN("a BQM serialized with format version 3.0") {
+        auto bqm = BinaryQuadraticModel<double>(5, Vartype::SPIN);
+        bqm.set_offset(1.5);
+        bqm.set_linear(0, {1, -2, 3, -4, 5});
+        bqm.add_quadratic(0, 1, 1);
+        bqm.add_quadratic(1, 2, -2);
+        bqm.add_quadratic(0, 3, 3);
+        bqm.add_quadratic(2, 3, .5);
+        bqm.add_quadratic(4, 0, -6);
+
+        std::ostringstream os;
+        fileview::dump(bqm, os);
+        std::string buffer = os.str();
+
+        THEN("every array in the file is aligned") {
+            CHECK(buffer.substr(0, 8) == "DIMODBQM");
+            CHECK(buffer[8] == 3);
+            CHECK(buffer[9] == 0);
+            CHECK(buffer.size() % fileview::ALIGNMENT == 0);
+        }
+
+        WHEN("we construct a view of the buffer") {
+            auto view = fileview::BinaryQuadraticModelView<double>(buffer.data(), buffer.size());
+
+            THEN("it has the same biases as the BQM") {
+                REQUIRE(view.num_variables() == 5);
+                REQUIRE(view.num_interactions() == 5);
+                CHECK(view.vartype() == Vartype::SPIN);
+                CHECK(view.offset() == 1.5);
+
+                for (int u = 0; u < 5; ++u) {
+                    CHECK(view.linear(u) == bqm.linear(u));
+                    CHECK(view.degree(u) == bqm.num_interactions(u));
+                    for (int v = 0; v < 5; ++v) {
+                        CHECK(view.quadratic(u, v) == bqm.quadratic(u, v));
+                    }
+                }
+
+                CHECK(view.quadratic_at(4, 0) == -6);
+                CHECK_THROWS_AS(view.quadratic_at(1, 4), std::out_of_range);
+            }
+
+            THEN("the neighborhoods are sorted") {
+                auto n = view.neighborhood(0);
+                REQUIRE(n.size == 3);
+                CHECK(n.neighbors[0] == 1);
+                CHECK(n.neighbors[1] == 3);
+                CHECK(n.neighbors[2] == 4);
+                CHECK(n.biases[0] == 1);
+                CHECK(n.biases[1] == 3);
+                CHECK(n.biases[2] == -6);
+            }
+
+            THEN("it calculates the same energies as the BQM") {
+                std::vector<std::vector<int>> samples = {
+                        {+1, +1, +1, +1, +1}, {-1, +1, -1, +1, -1}, {+1, -1, -1, -1, +1}};
+                for (const auto& sample : samples) {
+                    CHECK(view.energy(sample.begin()) == Approx(bqm.energy(sample.begin())));
+                }
+            }
+        }
+
+        WHEN("we try to view the buffer with the wrong types") {
+            THEN("an exception is thrown") {
+                CHECK_THROWS_AS(fileview::BinaryQuadraticModelView<float>(buffer.data(),
+                                                                          buffer.size()),
+                                std::invalid_argument);
+                CHECK_THROWS_AS(
+                        (fileview::BinaryQuadraticModelView<double, std::int64_t>(buffer.data(),
+                                                                                  buffer.size())),
+                        std::invalid_argument);
+            }
+        }
+
+        WHEN("we try to view a truncated buffer") {
+            THEN("an exception is thrown") {
+                CHECK_THROWS_AS(fileview::BinaryQuadraticModelView<double>(buffer.data(),
+                                                                           buffer.size() - 64),
+                                std::invalid_argument);
+                CHECK_THROWS_AS(fileview::BinaryQuadraticModelView<double>(buffer.data(), 10),
+                                std::invalid_argument);
+            }
+        }
+
+        AND_GIVEN("the serialized BQM saved to a file") {
+            std::string filename = "test_fileview.bqm";
+            {
+                std::ofstream file(filename, std::ios::binary);
+                file << buffer;
+            }
+
+            WHEN("we memory-map the file") {
+                fileview::MappedBinaryQuadraticModel<double> mapped(filename);
+
+                THEN("it serves the biases directly from the mapping") {
+                    CHECK(mapped.num_variables() == 5);
+                    CHECK(mapped.offset() == 1.5);
+                    CHECK(mapped.linear(4) == 5);
+                    CHECK(mapped.quadratic(2, 3) == .5);
+
+                    std::vector<int> sample = {-1, +1, -1, +1, -1};
+                    CHECK(mapped.energy(sample.begin()) == Approx(bqm.energy(sample.begin())));
+                }
+            }
+
+            std::remove(filename.c_str());
+        }
+    }
+
+    GIVEN("an empty BINARY-valued BQM serialized with format version 3.0") {
+        auto bqm = BinaryQuadraticModel<float>(Vartype::BINARY);
+        bqm.set_offset(-2);
+
+        std::ostringstream os;
+        fileview::dump(bqm, os);
+        std::string buffer = os.str();
+
+        THEN("it can be viewed") {
+            auto view = fileview::BinaryQuadraticModelView<float>(buffer.data(), buffer.size());
+            CHECK(view.num_variables() == 0);
+            CHECK(view.num_interactions() == 0);
+            CHECK(view.vartype() == Vartype::BINARY);
+
+            std::vector<int> sample;
+            CHECK(view.energy(sample.begin()) == -2);
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,100 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <random>
+#include <unordered_map>
+
+#include "catch2/catch.hpp"
+#include "dimod/flat_index_map.h"
+
+namespace dimod {
+namespace utils {
+
+TEST_CASE("FlatIndexMap") {
+    GIVEN("An empty map") {
+        auto map = FlatIndexMap<int, int>();
+
+        THEN("it has no pairs and allocates nothing") {
+            CHECK(map.empty());
+            CHECK(map.size() == 0);
+            CHECK(map.nbytes() == 0);
+            CHECK(map.find(5) == map.end());
+            CHECK(map.count(-1) == 0);
+            CHECK(map.erase(5) == 0);
+        }
+
+        WHEN("we add some pairs") {
+            map[5] = 0;
+            map[105] = 1;
+            map[3] += 2;
+
+            THEN("they can be found") {
+                CHECK(map.size() == 3);
+                CHECK(map.find(5)->second == 0);
+                CHECK(map.find(105)->second == 1);
+                CHECK(map.find(3)->second == 2);
+                CHECK(map.count(4) == 0);
+                CHECK(map.nbytes() >= 3 * sizeof(std::pair<int, int>));
+            }
+
+            AND_WHEN("we clear the map") {
+                auto nbytes = map.nbytes();
+                map.clear();
+
+                THEN("the pairs are removed but the capacity is kept") {
+                    CHECK(map.empty());
+                    CHECK(map.count(5) == 0);
+                    CHECK(map.nbytes() == nbytes);
+                }
+            }
+        }
+    }
+
+    GIVEN("A map and an std::unordered_map") {
+        auto map = FlatIndexMap<int, int>();
+        auto reference = std::unordered_map<int, int>();
+
+        WHEN("we apply the same random insertions and deletions to both") {
+            std::mt19937 rng(5);
+            std::uniform_int_distribution<int> key(0, 300);
+            std::uniform_int_distribution<int> op(0, 2);
+
+            for (int i = 0; i < 20000; ++i) {
+                int k = key(rng);
+                if (op(rng)) {
+                    map[k] = i;
+                    reference[k] = i;
+                } else {
+                    CHECK(map.erase(k) == reference.erase(k));
+                }
+            }
+
+            THEN("they contain the same pairs") {
+                REQUIRE(map.size() == reference.size());
+                for (int k = 0; k <= 300; ++k) {
+                    auto it = reference.find(k);
+                    if (it == reference.end()) {
+                        CHECK(map.find(k) == map.end());
+                    } else {
+                        REQUIRE(map.find(k) != map.end());
+                        CHECK(map.find(k)->second == it->second);
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace utils
+}  // namespace dimod
@@ -0,0 +1,188 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <cmath>
+#include <stdexcept>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/generators.h"
+
+namespace dimod {
+
+// Every interaction is between distinct variables and has a bias in [low, high).
+bool biases_in_range(const BinaryQuadraticModel<double>& bqm, double low, double high) {
+    for (auto it = bqm.cbegin_quadratic(); it != bqm.cend_quadratic(); ++it) {
+        if (it->u == it->v || it->bias < low || it->bias >= high) return false;
+    }
+    return true;
+}
+
+SCENARIO("random linear biases can be generated", "[generators]") {
+    GIVEN("a BQM with more variables than fit in one chunk") {
+        const int num_variables = 3 * generators::detail::CHUNK_SIZE + 5;
+        auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+
+        WHEN("the linear biases are set with a seed") {
+            generators::set_random_linear(bqm, generators::Uniform<double>(-2, 3), 5);
+
+            THEN("they are in range and not all equal") {
+                bool distinct = false;
+                for (int v = 0; v < num_variables; ++v) {
+                    REQUIRE(bqm.linear(v) >= -2);
+                    REQUIRE(bqm.linear(v) < 3);
+                    distinct = distinct || bqm.linear(v) != bqm.linear(0);
+                }
+                CHECK(distinct);
+                CHECK(bqm.offset() >= -2);
+                CHECK(bqm.offset() < 3);
+            }
+
+            THEN("the same seed gives the same biases for any number of threads") {
+                auto other = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+                generators::set_random_linear(other, generators::Uniform<double>(-2, 3), 5, 3);
+                CHECK(bqm.is_equal(other));
+
+                generators::set_random_linear(other, generators::Uniform<double>(-2, 3), 6, 3);
+                CHECK(!bqm.is_equal(other));
+            }
+        }
+    }
+}
+
+SCENARIO("G(n, m) random interactions can be generated", "[generators]") {
+    GIVEN("a BQM with 10 variables") {
+        auto bqm = BinaryQuadraticModel<double>(10, Vartype::BINARY);
+
+        THEN("any number of interactions up to the number of pairs can be added") {
+            for (int m = 0; m <= 45; ++m) {
+                auto copy = bqm;
+                generators::add_gnm_interactions(copy, m, generators::Uniform<double>(), m);
+                REQUIRE(copy.num_interactions() == static_cast<std::size_t>(m));
+                REQUIRE(biases_in_range(copy, 0, 1));
+            }
+        }
+
+        THEN("more interactions than pairs cannot be added") {
+            CHECK_THROWS_AS(
+                    generators::add_gnm_interactions(bqm, 46, generators::Uniform<double>(), 0),
+                    std::invalid_argument);
+        }
+    }
+
+    GIVEN("a BQM with more interactions than fit in one chunk") {
+        const int num_variables = 1000;
+        const std::size_t num_interactions = 2 * generators::detail::CHUNK_SIZE + 17;
+        auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+
+        generators::add_gnm_interactions(bqm, num_interactions, generators::Uniform<double>(-1, 1),
+                                         42);
+
+        THEN("it has the given number of interactions and no self-loops") {
+            CHECK(bqm.num_interactions() == num_interactions);
+            CHECK(biases_in_range(bqm, -1, 1));
+        }
+
+        THEN("the same seed gives the same model for any number of threads") {
+            auto other = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+            generators::add_gnm_interactions(other, num_interactions,
+                                             generators::Uniform<double>(-1, 1), 42, 4);
+            CHECK(bqm.is_equal(other));
+        }
+
+        THEN("a different seed gives a different model") {
+            auto other = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+            generators::add_gnm_interactions(other, num_interactions,
+                                             generators::Uniform<double>(-1, 1), 43);
+            CHECK(!bqm.is_equal(other));
+        }
+    }
+
+    GIVEN("a BQM where most of the pairs are chosen") {
+        auto bqm = BinaryQuadraticModel<double>(500, Vartype::SPIN);
+        const std::size_t num_pairs = 500 * 499 / 2;
+
+        generators::add_gnm_interactions(bqm, num_pairs - 100, generators::Uniform<double>(), 7);
+
+        THEN("the pairs that are left out are chosen instead") {
+            CHECK(bqm.num_interactions() == num_pairs - 100);
+            CHECK(biases_in_range(bqm, 0, 1));
+
+            auto other = BinaryQuadraticModel<double>(500, Vartype::SPIN);
+            generators::add_gnm_interactions(other, num_pairs - 100, generators::Uniform<double>(),
+                                             7, 2);
+            CHECK(bqm.is_equal(other));
+        }
+
+        THEN("every variable interacts with most of the others") {
+            for (int v = 0; v < 500; ++v) REQUIRE(bqm.num_interactions(v) >= 400);
+        }
+    }
+}
+
+SCENARIO("G(n, p) random interactions can be generated", "[generators]") {
+    GIVEN("a BQM with 20 variables") {
+        auto bqm = BinaryQuadraticModel<double>(20, Vartype::BINARY);
+
+        THEN("p of 0 or less adds no interactions") {
+            generators::add_gnp_interactions(bqm, 0, generators::Uniform<double>(), 1);
+            CHECK(bqm.num_interactions() == 0);
+            generators::add_gnp_interactions(bqm, -100, generators::Uniform<double>(), 1);
+            CHECK(bqm.num_interactions() == 0);
+        }
+
+        THEN("p of 1 or more adds every interaction") {
+            generators::add_gnp_interactions(bqm, 1, generators::Uniform<double>(), 1);
+            CHECK(bqm.num_interactions() == 190);
+            CHECK(biases_in_range(bqm, 0, 1));
+
+            auto other = BinaryQuadraticModel<double>(20, Vartype::BINARY);
+            generators::add_gnp_interactions(other, 100, generators::Uniform<double>(), 1);
+            CHECK(bqm.is_equal(other));
+        }
+    }
+
+    GIVEN("a BQM with more pairs than fit in one block") {
+        const int num_variables = 2000;
+        const double p = .05;
+        const double num_pairs = num_variables * (num_variables - 1) / 2;
+        REQUIRE(num_pairs > 1.5 * generators::detail::PAIRS_PER_BLOCK);
+
+        auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+        generators::add_gnp_interactions(bqm, p, generators::Uniform<double>(-1, 1), 3);
+
+        THEN("the number of interactions is within a few standard deviations of its mean") {
+            const double mean = p * num_pairs;
+            const double sd = std::sqrt(num_pairs * p * (1 - p));
+            CHECK(std::abs(bqm.num_interactions() - mean) < 5 * sd);
+            CHECK(biases_in_range(bqm, -1, 1));
+        }
+
+        THEN("the same seed gives the same model for any number of threads") {
+            auto other = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+            generators::add_gnp_interactions(other, p, generators::Uniform<double>(-1, 1), 3, 5);
+            CHECK(bqm.is_equal(other));
+        }
+
+        THEN("the pairs in the last row can be chosen") {
+            bool found = false;
+            for (int v = 0; v < num_variables - 1; ++v) {
+                found = found || bqm.has_interaction(v, num_variables - 1);
+            }
+            CHECK(found);
+        }
+    }
+}
+
+}  // namespace dimod
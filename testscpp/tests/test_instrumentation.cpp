@@ -0,0 +1,166 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <memory>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/discrete_quadratic_model.h"
+#include "dimod/instrumentation.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("the memory used by models can be broken down", "[memory_usage]") {
+    using term_type = abc::OneVarTerm<double, int>;
+    using neighborhood_type = std::vector<term_type>;
+
+    GIVEN("a linear BQM") {
+        auto bqm = BinaryQuadraticModel<double>(10, Vartype::BINARY);
+
+        THEN("only the linear biases and the offset are counted") {
+            auto usage = bqm.memory_usage();
+            CHECK(usage.linear == 11 * sizeof(double));
+            CHECK(usage.quadratic == 0);
+            CHECK(usage.variables == 0);
+            CHECK(usage.indices == 0);
+            CHECK(usage.other == 0);
+            CHECK(usage.total() == bqm.nbytes());
+        }
+
+        WHEN("interactions are added") {
+            bqm.add_quadratic(0, 1, 1.5);
+            bqm.add_quadratic(0, 2, -1);
+
+            THEN("the neighborhoods and the vectors that hold them are counted") {
+                auto usage = bqm.memory_usage();
+                CHECK(usage.linear == 11 * sizeof(double));
+                CHECK(usage.quadratic == 10 * sizeof(neighborhood_type) + 4 * sizeof(term_type));
+                CHECK(usage.other == sizeof(std::vector<neighborhood_type>));
+                CHECK(usage.total() == bqm.nbytes() + 10 * sizeof(neighborhood_type) +
+                                               sizeof(std::vector<neighborhood_type>));
+                CHECK(bqm.memory_usage(true).total() >= usage.total());
+            }
+
+            AND_WHEN("the model is frozen") {
+                bqm.freeze();
+
+                THEN("the packed adjacency is counted") {
+                    auto usage = bqm.memory_usage();
+                    CHECK(usage.quadratic == 11 * sizeof(std::size_t) + 4 * sizeof(term_type));
+                    CHECK(usage.other == sizeof(abc::PackedAdjacency<double, int>));
+                }
+            }
+        }
+    }
+
+    GIVEN("a QM") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 5, 0, 10);
+        qm.add_quadratic(0, 4, 2);
+
+        THEN("the vartype info and bounds are counted") {
+            auto usage = qm.memory_usage();
+            CHECK(usage.variables > 0);
+            CHECK(usage.variables + usage.linear + 2 * sizeof(term_type) ==
+                  qm.nbytes());
+        }
+    }
+
+    GIVEN("a CQM") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 50);
+        cqm.objective.add_linear(3, 1);
+
+        auto& small = cqm.constraint_ref(cqm.add_constraint());
+        small.add_linear(0, 1);
+
+        auto& large = cqm.constraint_ref(cqm.add_constraint());
+        for (int v = 0; v < 40; ++v) large.add_linear(v, v);
+
+        THEN("the objective, the constraints and the variables add up to the total") {
+            auto usage = cqm.memory_usage();
+            auto constraints = cqm.constraints_memory_usage();
+
+            CHECK(usage.total() > cqm.objective.memory_usage().total() + constraints.total());
+            CHECK(usage.variables > 0);
+
+            // the constraints' objects and the pointers to them
+            CHECK(constraints.other >= 2 * (sizeof(Constraint<double, int>) +
+                                            sizeof(std::shared_ptr<Constraint<double, int>>)));
+            CHECK(constraints.linear ==
+                  small.memory_usage().linear + large.memory_usage().linear);
+
+            // only the large constraint needs a map from the CQM's variables
+            CHECK(small.memory_usage().indices == sizeof(int));
+            CHECK(large.memory_usage().indices > 40 * sizeof(int));
+            CHECK(large.memory_usage().indices == large.nbytes() - large.memory_usage().linear);
+        }
+
+        THEN("linear constraints stay without an adjacency when variables are fixed") {
+            CHECK(large.memory_usage(true).quadratic == 0);
+
+            std::vector<int> fixed{0, 1};
+            std::vector<double> assignments{1, 0};
+            auto other = cqm.fix_variables(fixed.begin(), fixed.end(), assignments.begin());
+
+            CHECK(other.constraint_ref(1).memory_usage(true).quadratic == 0);
+            CHECK(other.constraint_ref(1).num_variables() == 38);
+        }
+    }
+
+    GIVEN("a DQM with an interaction") {
+        auto dqm = DiscreteQuadraticModel<double>();
+        dqm.add_variable(3);
+        dqm.add_variable(2);
+        dqm.add_quadratic(0, 1, 1, 0, 2);
+
+        THEN("the interaction block and the case starts are counted") {
+            auto usage = dqm.memory_usage();
+            CHECK(usage.linear == 6 * sizeof(double));
+            CHECK(usage.quadratic >= 6 * sizeof(double));
+            CHECK(usage.variables == 3 * sizeof(int));
+        }
+    }
+}
+
+TEST_CASE("events on hot paths can be counted", "[counters]") {
+    auto bqm = BinaryQuadraticModel<double>(5, Vartype::SPIN);
+    std::vector<int> sample(5, 1);
+
+    reset_counters();
+
+    bqm.add_quadratic(0, 1, 1);
+    bqm.add_quadratic(0, 1, 1);
+    bqm.energy(sample.begin());
+
+    if (counters_enabled) {
+        CHECK(counter_value(Counter::QUADRATIC_INSERTS) == 2);
+        CHECK(counter_value(Counter::QUADRATIC_HITS) == 2);
+        CHECK(counter_value(Counter::REALLOCATIONS) == 2);
+        CHECK(counter_value(Counter::ENERGY_CALLS) == 1);
+
+        reset_counters();
+        CHECK(counter_value(Counter::QUADRATIC_INSERTS) == 0);
+    } else {
+        CHECK(counter_value(Counter::QUADRATIC_INSERTS) == 0);
+        CHECK(counter_value(Counter::QUADRATIC_HITS) == 0);
+        CHECK(counter_value(Counter::REALLOCATIONS) == 0);
+        CHECK(counter_value(Counter::ENERGY_CALLS) == 0);
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,147 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/local_field_state.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("LocalFieldState tracks the energy of single-variable changes", "[lfs]") {
+    GIVEN("a SPIN-valued BQM and a sample") {
+        auto bqm = BinaryQuadraticModel<double>(4, Vartype::SPIN);
+        bqm.set_offset(1.5);
+        bqm.set_linear(0, {1, -2, 3, -4});
+        bqm.add_quadratic(0, 1, 1);
+        bqm.add_quadratic(1, 2, -2);
+        bqm.add_quadratic(0, 3, 3);
+        bqm.add_quadratic(2, 3, .5);
+
+        std::vector<int> sample = {+1, -1, -1, +1};
+
+        auto state = LocalFieldState<double>(bqm, sample.begin());
+
+        THEN("the energy and local fields are calculated") {
+            CHECK(state.energy() == bqm.energy(sample.begin()));
+            CHECK(state.local_field(0) == 1 + 1 * -1 + 3 * +1);
+            CHECK(state.local_field(3) == -4 + 3 * +1 + .5 * -1);
+        }
+
+        WHEN("we flip every variable in turn") {
+            for (int v = 0; v < 4; ++v) {
+                double delta = state.delta_flip(v);
+                double before = state.energy();
+
+                CHECK(state.flip(v) == -sample[v]);
+                sample[v] *= -1;
+
+                CHECK(state.energy() == Approx(before + delta));
+                CHECK(state.energy() == Approx(bqm.energy(sample.begin())));
+            }
+
+            THEN("the state matches a freshly constructed one") {
+                auto fresh = LocalFieldState<double>(bqm, sample.begin());
+                for (int v = 0; v < 4; ++v) {
+                    CHECK(state.value(v) == fresh.value(v));
+                    CHECK(state.local_field(v) == Approx(fresh.local_field(v)));
+                }
+            }
+        }
+
+        WHEN("we try to set a variable outside of its bounds") {
+            THEN("an exception is thrown and the state is unchanged") {
+                CHECK_THROWS_AS(state.apply(0, 2), std::out_of_range);
+                CHECK(state.value(0) == 1);
+                CHECK(state.energy() == bqm.energy(sample.begin()));
+            }
+        }
+    }
+
+    GIVEN("a frozen BINARY-valued BQM") {
+        auto bqm = BinaryQuadraticModel<float>(3, Vartype::BINARY);
+        bqm.set_linear(0, {-1, 1, -1});
+        bqm.add_quadratic(0, 1, 2);
+        bqm.add_quadratic(1, 2, 2);
+        bqm.freeze();
+
+        std::vector<float> sample = {0, 0, 0};
+        auto state = LocalFieldState<float>(bqm, sample.begin());
+
+        THEN("flipping changes the values between 0 and 1") {
+            CHECK(state.delta_flip(1) == 1);
+            CHECK(state.flip(0) == 1);
+            CHECK(state.delta_flip(1) == 3);
+            CHECK(state.flip(0) == 0);
+            CHECK(state.energy() == 0);
+        }
+    }
+
+    GIVEN("a dense BINARY-valued BQM and a sample with many 0s") {
+        const int n = 50;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+        for (int u = 0; u < n; ++u) {
+            bqm.set_linear(u, u % 7 - 3);
+            for (int v = u + 1; v < n; ++v) bqm.set_quadratic(u, v, (u * v) % 5 - 2);
+        }
+
+        std::vector<double> sample(n);
+        for (int v = 0; v < n; ++v) sample[v] = v % 3 == 0;
+
+        auto state = LocalFieldState<double>(bqm, sample.begin());
+
+        THEN("the energy skips nothing that contributes") {
+            CHECK(state.energy() == bqm.energy(sample.begin()));
+            CHECK(state.flip(1) == 1);
+            CHECK(state.energy() == Approx(bqm.energy(state.sample().begin())));
+        }
+    }
+
+    GIVEN("a QM with INTEGER variables and square terms") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 3, -5, 5);
+        qm.set_linear(0, {1, 2, 3});
+        qm.add_quadratic(0, 0, 1.5);
+        qm.add_quadratic(0, 1, -1);
+        qm.add_quadratic(1, 2, 2);
+        qm.add_quadratic(2, 2, -.5);
+
+        std::vector<int> sample = {1, 2, 3};
+        auto state = LocalFieldState<double>(qm, sample.begin());
+
+        WHEN("we change the values of the variables") {
+            std::vector<int> values = {-5, 4, 0, 5, -1};
+            for (int value : values) {
+                for (int v = 0; v < 3; ++v) {
+                    double delta = state.delta(v, value);
+                    double before = state.energy();
+
+                    state.apply(v, value);
+                    sample[v] = value;
+
+                    CHECK(state.energy() == Approx(before + delta));
+                    CHECK(state.energy() == Approx(qm.energy(sample.begin())));
+                }
+            }
+        }
+
+        THEN("INTEGER variables cannot be flipped") {
+            CHECK_THROWS_AS(state.flip(0), std::logic_error);
+            CHECK_THROWS_AS(state.delta_flip(0), std::logic_error);
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,408 @@
+// Copyright 2022 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/lp.h"
+
+namespace dimod {
+
+template <class Bias, class Index>
+lp::LPModel<Bias, Index> read_string(const std::string& data, int num_threads = 1,
+                                     std::size_t chunk_size = 1 << 20) {
+    return lp::read<Bias, Index>(data.data(), data.size(), num_threads, chunk_size);
+}
+
+SCENARIO("LP files can be read into constrained quadratic models", "[lp]") {
+    GIVEN("an LP file with every kind of section") {
+        std::string data =
+                "\\ a comment\n"
+                "Minimize\n"
+                " obj: x + 2 y - 3 z + [ 4 x * y + 2 z ^ 2 ] / 2 + 5\n"
+                "Subject To\n"
+                " c1: x + y + [ x * z ] <= 3\n"
+                " -x + 2.5 z >= -1\n"
+                " c3 : i + x = 1 /* a block comment */\n"
+                "Bounds\n"
+                " -2 <= i <= 10\n"
+                " z <= 4\n"
+                " w free\n"
+                "Binary\n"
+                " x y\n"
+                "General\n"
+                " i\n"
+                "End\n";
+
+        WHEN("we read it") {
+            auto lp = read_string<double, int>(data);
+            const auto& cqm = lp.model;
+
+            THEN("the variables are in the order they first appear") {
+                CHECK(lp.variable_labels == std::vector<std::string>{"x", "y", "z", "i", "w"});
+                REQUIRE(cqm.num_variables() == 5);
+
+                CHECK(cqm.vartype(0) == Vartype::BINARY);
+                CHECK(cqm.vartype(1) == Vartype::BINARY);
+                CHECK(cqm.vartype(2) == Vartype::REAL);
+                CHECK(cqm.vartype(3) == Vartype::INTEGER);
+                CHECK(cqm.vartype(4) == Vartype::REAL);
+
+                CHECK(cqm.lower_bound(2) == 0);
+                CHECK(cqm.upper_bound(2) == 4);
+                CHECK(cqm.lower_bound(3) == -2);
+                CHECK(cqm.upper_bound(3) == 10);
+                CHECK(cqm.lower_bound(4) == vartype_info<double>::min(Vartype::REAL));
+                CHECK(cqm.upper_bound(4) == vartype_info<double>::max(Vartype::REAL));
+            }
+
+            THEN("the objective's quadratic terms are halved") {
+                CHECK(cqm.objective.linear(0) == 1);
+                CHECK(cqm.objective.linear(1) == 2);
+                CHECK(cqm.objective.linear(2) == -3);
+                CHECK(cqm.objective.quadratic(0, 1) == 2);
+                CHECK(cqm.objective.quadratic(2, 2) == 1);
+                CHECK(cqm.objective.offset() == 5);
+            }
+
+            THEN("the constraints are read, with their labels") {
+                REQUIRE(cqm.num_constraints() == 3);
+                CHECK(lp.constraint_labels == std::vector<std::string>{"c1", "", "c3"});
+
+                const auto& c1 = cqm.constraint_ref(0);
+                CHECK(c1.sense() == Sense::LE);
+                CHECK(c1.rhs() == 3);
+                CHECK(c1.linear(0) == 1);
+                CHECK(c1.linear(1) == 1);
+                CHECK(c1.quadratic(0, 2) == 1);
+
+                const auto& c2 = cqm.constraint_ref(1);
+                CHECK(c2.sense() == Sense::GE);
+                CHECK(c2.rhs() == -1);
+                CHECK(c2.linear(0) == -1);
+                CHECK(c2.linear(2) == 2.5);
+
+                const auto& c3 = cqm.constraint_ref(2);
+                CHECK(c3.sense() == Sense::EQ);
+                CHECK(c3.rhs() == 1);
+                CHECK(c3.variables() == std::vector<int>{3, 0});
+            }
+        }
+    }
+
+    GIVEN("an LP file whose objective starts with quadratic terms") {
+        std::string data =
+                "Minimize\n"
+                " obj: [ x0 * x1 + x0 * x2 + x1 * x2 ] / 2 + x3\n"
+                "Subject To\n"
+                " c1: x2 + x1 >= 1\n"
+                "Binary\n"
+                " x0 x1 x2 x3\n"
+                "End\n";
+
+        WHEN("we read it") {
+            auto lp = read_string<double, int>(data);
+
+            THEN("the variables are in the order they first appear") {
+                CHECK(lp.variable_labels ==
+                      std::vector<std::string>{"x0", "x1", "x2", "x3"});
+                CHECK(lp.model.objective.quadratic(0, 1) == .5);
+                CHECK(lp.model.objective.linear(3) == 1);
+            }
+        }
+    }
+
+    GIVEN("a maximization problem with repeated section keywords") {
+        std::string data =
+                "maximize\n"
+                " x + [ 2 x ^ 2 ] / 2\n"
+                "st\n"
+                " x + y <= 1\n"
+                "st\n"
+                " y - x >= 0\n"
+                "general\n"
+                " x\n"
+                "general\n"
+                " y\n"
+                "end\n";
+
+        auto lp = read_string<double, int>(data);
+
+        THEN("the objective is negated and the sections are merged") {
+            CHECK(lp.model.objective.linear(0) == -1);
+            CHECK(lp.model.objective.quadratic(0, 0) == -1);
+            CHECK(lp.model.num_constraints() == 2);
+            CHECK(lp.model.vartype(0) == Vartype::INTEGER);
+            CHECK(lp.model.vartype(1) == Vartype::INTEGER);
+        }
+    }
+
+    GIVEN("an LP file with many constraints") {
+        std::ostringstream os;
+        os << "minimize\n obj: x0\nsubject to\n";
+        for (int i = 0; i < 500; ++i) {
+            os << " c" << i << ": " << i << " x" << i << " + x" << i + 1 << " - 3 x" << (7 * i) % 500
+               << " <= " << i << "\n";
+        }
+        os << "bounds\n";
+        for (int i = 0; i < 501; ++i) os << " x" << i << " <= " << i + 1 << "\n";
+        os << "end\n";
+        std::string data = os.str();
+
+        auto expected = read_string<double, int>(data, 1);
+
+        WHEN("we read it in small chunks with several threads") {
+            auto lp = read_string<double, int>(data, 3, 256);
+
+            THEN("we get the same model as reading it all at once") {
+                REQUIRE(lp.variable_labels == expected.variable_labels);
+                REQUIRE(lp.constraint_labels == expected.constraint_labels);
+                REQUIRE(lp.model.num_constraints() == 500);
+
+                for (std::size_t v = 0; v < lp.model.num_variables(); ++v) {
+                    CHECK(lp.model.lower_bound(v) == expected.model.lower_bound(v));
+                    CHECK(lp.model.upper_bound(v) == expected.model.upper_bound(v));
+                }
+                for (std::size_t c = 0; c < lp.model.num_constraints(); ++c) {
+                    const auto& lhs = lp.model.constraint_ref(c);
+                    const auto& rhs = expected.model.constraint_ref(c);
+                    REQUIRE(lhs.variables() == rhs.variables());
+                    for (auto v : lhs.variables()) CHECK(lhs.linear(v) == rhs.linear(v));
+                    CHECK(lhs.rhs() == rhs.rhs());
+                    CHECK(lhs.sense() == rhs.sense());
+                }
+
+                CHECK(lp.constraint_labels[123] == "c123");
+                auto it = std::find(lp.variable_labels.begin(), lp.variable_labels.end(), "x123");
+                REQUIRE(it != lp.variable_labels.end());
+                CHECK(lp.model.constraint_ref(123).linear(it - lp.variable_labels.begin()) == 123);
+            }
+        }
+
+        WHEN("the file has a block comment spanning several chunks") {
+            std::string commented = data;
+            commented.insert(commented.find("subject to"), "/* subject to \n\n c0: x <= 1\n*/\n");
+            commented.insert(commented.find(" c250:"), "\n/*\n c1000: x0 <= 1\n\n*/\n");
+
+            auto lp = read_string<double, int>(commented, 3, 16);
+
+            THEN("the commented constraints are ignored") {
+                CHECK(lp.constraint_labels == expected.constraint_labels);
+                CHECK(lp.variable_labels == expected.variable_labels);
+            }
+        }
+    }
+
+    GIVEN("an empty LP file") {
+        auto lp = lp::read<float, std::int64_t>(nullptr, 0);
+
+        THEN("we get an empty model") {
+            CHECK(lp.model.num_variables() == 0);
+            CHECK(lp.model.num_constraints() == 0);
+        }
+    }
+
+    GIVEN("invalid LP files") {
+        THEN("reading them throws") {
+            // tokens before the first section
+            CHECK_THROWS_AS((read_string<double, int>("x\nminimize x\n")), std::invalid_argument);
+            // constraints without a right-hand side
+            CHECK_THROWS_AS((read_string<double, int>("minimize x\nst\n x + y\n")),
+                            std::invalid_argument);
+            // strict inequalities
+            CHECK_THROWS_AS((read_string<double, int>("minimize x\nst\n x < 1\n")),
+                            std::invalid_argument);
+            // quadratic objective terms must be halved
+            CHECK_THROWS_AS((read_string<double, int>("minimize [ x * y ]\n")),
+                            std::invalid_argument);
+            // sections cannot be split
+            CHECK_THROWS_AS((read_string<double, int>("minimize x\nst\n x <= 1\nbounds\n x <= 1\n"
+                                                      "st\n x >= 0\n")),
+                            std::invalid_argument);
+            // semi-continuous variables are not supported
+            CHECK_THROWS_AS((read_string<double, int>("minimize x\nsemi-continuous\n x\n")),
+                            std::domain_error);
+        }
+    }
+
+    GIVEN("an LP file on disk") {
+        std::string filename = "test_lp.lp";
+        {
+            std::ofstream file(filename);
+            file << "minimize\n x + y\nsubject to\n x + y >= 1\nbinary\n x y\nend\n";
+        }
+
+        THEN("it can be read") {
+            auto lp = lp::read_file<double, int>(filename);
+            CHECK(lp.variable_labels == std::vector<std::string>{"x", "y"});
+            CHECK(lp.model.num_constraints() == 1);
+            CHECK(lp.model.vartype(1) == Vartype::BINARY);
+        }
+
+        std::remove(filename.c_str());
+
+        THEN("reading a missing file throws") {
+            CHECK_THROWS_AS((lp::read_file<double, int>("missing.lp")), std::runtime_error);
+        }
+    }
+}
+
+SCENARIO("constrained quadratic models can be written as LP and MPS files", "[lp]") {
+    GIVEN("a CQM with every kind of variable and constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 2);
+        cqm.add_variable(Vartype::INTEGER, -5, 10);
+        cqm.add_variable(Vartype::REAL, -1.5, 2.25);
+
+        cqm.objective.add_linear(0, 1);
+        cqm.objective.add_linear(3, -0.1);
+        cqm.objective.add_quadratic(0, 1, 3);
+        cqm.objective.add_quadratic(2, 2, 1.5);
+        cqm.objective.set_offset(-4);
+
+        auto c0 = cqm.add_linear_constraint({0, 1, 2}, {1, 2, 3}, Sense::LE, 5);
+        cqm.constraint_ref(c0).add_quadratic(2, 3, 1e30);
+        cqm.constraint_ref(c0).set_offset(1);
+        cqm.add_linear_constraint({3, 2}, {-1, 1}, Sense::GE, -1.5);
+        cqm.add_linear_constraint({1, 0}, {1, 1}, Sense::EQ, 1);
+
+        std::vector<std::string> variable_labels = {"x", "y", "i", "z"};
+        std::vector<std::string> constraint_labels = {"c0", "c1", "c2"};
+
+        WHEN("we write it as an LP file and read it back") {
+            std::string data = lp::dumps(cqm, variable_labels, constraint_labels);
+            auto lp = read_string<double, int>(data);
+
+            THEN("we get the same model, with the variables in the order they appear") {
+                CHECK(lp.variable_labels == std::vector<std::string>{"x", "z", "y", "i"});
+                CHECK(lp.constraint_labels == constraint_labels);
+
+                // the loaded index of each of the original variables
+                std::vector<int> index = {0, 2, 3, 1};
+
+                const auto& loaded = lp.model;
+                REQUIRE(loaded.num_variables() == cqm.num_variables());
+                REQUIRE(loaded.num_constraints() == cqm.num_constraints());
+                for (std::size_t v = 0; v < cqm.num_variables(); ++v) {
+                    CHECK(loaded.vartype(index[v]) == cqm.vartype(v));
+                    CHECK(loaded.lower_bound(index[v]) == cqm.lower_bound(v));
+                    CHECK(loaded.upper_bound(index[v]) == cqm.upper_bound(v));
+                }
+
+                CHECK(loaded.objective.offset() == -4);
+                CHECK(loaded.objective.linear(index[3]) == -0.1);
+                CHECK(loaded.objective.quadratic(index[0], index[1]) == 3);
+                CHECK(loaded.objective.quadratic(index[2], index[2]) == 1.5);
+
+                for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+                    const auto& a = loaded.constraint_ref(c);
+                    const auto& b = cqm.constraint_ref(c);
+                    CHECK(a.sense() == b.sense());
+                    CHECK(a.rhs() - a.offset() == b.rhs() - b.offset());
+                    for (auto v : b.variables()) {
+                        CHECK(a.linear(index[v]) == b.linear(v));
+                        for (auto u : b.variables()) {
+                            CHECK(a.quadratic(index[u], index[v]) == b.quadratic(u, v));
+                        }
+                    }
+                }
+            }
+        }
+
+        WHEN("we write it without labels") {
+            std::string data = lp::dumps(cqm);
+
+            THEN("default names are used") {
+                auto lp = read_string<double, int>(data);
+                CHECK(lp.variable_labels == std::vector<std::string>{"v0", "v3", "v1", "v2"});
+                CHECK(lp.constraint_labels == std::vector<std::string>{"c0", "c1", "c2"});
+            }
+        }
+
+        WHEN("we write it as an MPS file") {
+            std::string data =
+                    lp::dumps(cqm, variable_labels, constraint_labels, lp::Format::MPS);
+
+            THEN("it has the expected sections") {
+                CHECK(data.find("ROWS\n N  obj\n L  c0\n G  c1\n E  c2\n") != std::string::npos);
+                CHECK(data.find("    MARKER  'MARKER'  'INTORG'\n    x  obj  1\n    x  c0  1\n"
+                                "    x  c2  1\n") != std::string::npos);
+                CHECK(data.find("'INTEND'\n    z  obj  -0.1\n") != std::string::npos);
+                CHECK(data.find("RHS\n    RHS  obj  4\n    RHS  c0  4\n") != std::string::npos);
+                CHECK(data.find(" BV BND  x\n") != std::string::npos);
+                CHECK(data.find(" LO BND  z  -1.5\n UP BND  z  2.25\n") != std::string::npos);
+                CHECK(data.find("QUADOBJ\n    x  y  3\n    i  i  3\n") != std::string::npos);
+                CHECK(data.find("QCMATRIX  c0\n    z  i  5e+29\n    i  z  5e+29\n") !=
+                      std::string::npos);
+                CHECK(data.substr(data.size() - 7) == "ENDATA\n");
+            }
+        }
+
+        WHEN("the model cannot be represented") {
+            THEN("writing it throws") {
+                CHECK_THROWS_AS(lp::dumps(cqm, {"x"}), std::invalid_argument);
+
+                cqm.constraint_ref(c0).set_weight(5);
+                CHECK_THROWS_AS(lp::dumps(cqm), std::invalid_argument);
+
+                cqm.constraint_ref(c0).set_weight(std::numeric_limits<double>::infinity());
+                cqm.add_variable(Vartype::SPIN);
+                CHECK_THROWS_AS(lp::dumps(cqm), std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("a CQM with unbounded variables") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variable(Vartype::REAL, vartype_info<double>::min(Vartype::REAL),
+                         vartype_info<double>::max(Vartype::REAL));
+        cqm.add_variable(Vartype::REAL, vartype_info<double>::min(Vartype::REAL), 3);
+        cqm.add_variable(Vartype::INTEGER, -2, vartype_info<double>::max(Vartype::INTEGER));
+        for (int v = 0; v < 3; ++v) cqm.objective.set_linear(v, v + 1);
+
+        WHEN("we write it as an MPS file") {
+            std::string data = lp::dumps(cqm, {"a", "b", "i"}, {}, lp::Format::MPS);
+
+            THEN("the infinite bounds are written as bound types") {
+                CHECK(data.find("BOUNDS\n FR BND  a\n MI BND  b\n UP BND  b  3\n"
+                                " LO BND  i  -2\n PL BND  i\n") != std::string::npos);
+                CHECK(data.find("inf") == std::string::npos);
+            }
+        }
+    }
+
+    GIVEN("an LP file with long labels") {
+        auto cqm = ConstrainedQuadraticModel<float>();
+        cqm.add_variables(Vartype::BINARY, 3);
+        for (int u = 0; u < 3; ++u) {
+            cqm.objective.add_linear(u, 1e30);
+            for (int v = u + 1; v < 3; ++v) cqm.objective.add_quadratic(u, v, -1e30);
+        }
+        std::vector<std::string> labels = {std::string(255, 'x'), std::string(255, 'y'),
+                                           std::string(255, 'z')};
+
+        THEN("the lines are wrapped") {
+            std::istringstream data(lp::dumps(cqm, labels));
+            for (std::string line; std::getline(data, line);) CHECK(line.size() < 560);
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,230 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/packed_samples.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("samples can be packed and unpacked", "[packed_samples]") {
+    GIVEN("a batch of SPIN samples spanning several words") {
+        const std::size_t num_samples = 7;
+        const std::size_t num_variables = 130;
+
+        auto rng = std::mt19937(42);
+        std::vector<std::int8_t> samples(num_samples * num_variables);
+        for (auto& value : samples) value = (rng() & 1) ? 1 : -1;
+
+        auto packed = PackedSamples(samples.data(), num_samples, num_variables, num_variables);
+
+        THEN("each sample uses one bit per variable") {
+            CHECK(packed.num_samples() == num_samples);
+            CHECK(packed.num_variables() == num_variables);
+            CHECK(packed.num_words() == 3);
+            CHECK(packed.nbytes() == num_samples * 3 * 8);
+        }
+
+        THEN("the samples can be unpacked") {
+            std::vector<std::int8_t> sample(num_variables);
+            for (std::size_t i = 0; i < num_samples; ++i) {
+                packed.unpack<std::int8_t>(i, -1, 1, sample.data());
+                CHECK(std::equal(sample.begin(), sample.end(),
+                                 samples.begin() + i * num_variables));
+            }
+        }
+
+        WHEN("the samples are added one at a time") {
+            auto other = PackedSamples(num_variables);
+            for (std::size_t i = 0; i < num_samples; ++i) {
+                other.push_back(samples.data() + i * num_variables);
+            }
+
+            THEN("the packed words match") {
+                REQUIRE(other.num_samples() == num_samples);
+                for (std::size_t i = 0; i < num_samples; ++i) {
+                    CHECK(std::equal(other.row(i), other.row(i) + 3, packed.row(i)));
+                }
+            }
+
+            AND_WHEN("they are cleared") {
+                other.clear();
+
+                THEN("the store is empty") {
+                    CHECK(other.num_samples() == 0);
+                    CHECK(other.nbytes() == 0);
+                }
+            }
+        }
+    }
+
+    GIVEN("BINARY samples with a stride") {
+        std::vector<double> samples{0, 1, 1, 99,  //
+                                    1, 0, 1, 99};
+        auto packed = PackedSamples(samples.data(), 2, 4, 3);
+
+        THEN("the padding is ignored") {
+            CHECK(!packed.bit(0, 0));
+            CHECK(packed.bit(0, 1));
+            CHECK(packed.bit(0, 2));
+            CHECK(packed.bit(1, 0));
+            CHECK(!packed.bit(1, 1));
+            CHECK(packed.bit(1, 2));
+        }
+    }
+}
+
+SCENARIO("packed samples can be aggregated", "[packed_samples]") {
+    GIVEN("samples with repeats") {
+        std::vector<int> samples{0, 1, 0,  //
+                                 1, 1, 1,  //
+                                 0, 1, 0,  //
+                                 0, 0, 0,  //
+                                 1, 1, 1,  //
+                                 0, 1, 0};
+
+        THEN("the distinct samples are found in the order they first occur") {
+            std::vector<std::size_t> inverse(6);
+            auto first = aggregate_samples(samples.data(), 6, 3, 3, inverse.data());
+            CHECK(first == std::vector<std::size_t>{0, 1, 3});
+            CHECK(inverse == std::vector<std::size_t>{0, 1, 0, 2, 1, 0});
+
+            auto packed = PackedSamples(samples.data(), 6, 3, 3);
+            std::vector<std::size_t> packed_inverse(6);
+            CHECK(packed.aggregate(packed_inverse.data()) == first);
+            CHECK(packed_inverse == inverse);
+        }
+    }
+
+    GIVEN("many random samples, most of them repeated") {
+        const std::size_t num_samples = 5000;
+        const std::size_t num_variables = 70;
+
+        auto rng = std::mt19937(7);
+        std::vector<std::int8_t> distinct(100 * num_variables);
+        for (auto& value : distinct) value = rng() & 1;
+
+        std::vector<std::int8_t> samples(num_samples * num_variables);
+        std::vector<std::size_t> source(num_samples);
+        for (std::size_t i = 0; i < num_samples; ++i) {
+            source[i] = rng() % 100;
+            std::copy(distinct.begin() + source[i] * num_variables,
+                      distinct.begin() + (source[i] + 1) * num_variables,
+                      samples.begin() + i * num_variables);
+        }
+
+        THEN("each sample maps to a distinct sample equal to it") {
+            std::vector<std::size_t> inverse(num_samples);
+            auto first = aggregate_samples(samples.data(), num_samples, num_variables,
+                                           num_variables, inverse.data());
+
+            CHECK(first.size() <= 100);
+            for (std::size_t i = 0; i < num_samples; ++i) {
+                REQUIRE(inverse[i] < first.size());
+                CHECK(source[first[inverse[i]]] == source[i]);
+            }
+            for (std::size_t u = 0; u < first.size(); ++u) CHECK(inverse[first[u]] == u);
+        }
+    }
+
+    GIVEN("samples with no variables") {
+        std::vector<std::size_t> inverse(3, 5);
+        auto first = aggregate_samples<double>(nullptr, 3, 0, 0, inverse.data());
+
+        THEN("they are all the same sample") {
+            CHECK(first == std::vector<std::size_t>{0});
+            CHECK(inverse == std::vector<std::size_t>{0, 0, 0});
+            CHECK(aggregate_samples<double>(nullptr, 0, 0, 0).empty());
+        }
+    }
+}
+
+SCENARIO("the energies of packed samples can be calculated", "[packed_samples]") {
+    GIVEN("a model with BINARY and SPIN variables and random samples") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::SPIN, 40);
+        qm.add_variables(Vartype::BINARY, 40);
+
+        auto rng = std::mt19937(11);
+        auto bias = std::uniform_real_distribution<double>(-1, 1);
+        for (std::size_t v = 0; v < 80; ++v) {
+            qm.set_linear(v, bias(rng));
+            qm.add_quadratic(v, (v + 7) % 80, bias(rng));
+        }
+        qm.set_offset(1.5);
+
+        const std::size_t num_samples = 200;
+        std::vector<double> samples(num_samples * 80);
+        for (std::size_t i = 0; i < num_samples; ++i) {
+            for (std::size_t v = 0; v < 80; ++v) {
+                const bool bit = rng() & 1;
+                samples[i * 80 + v] = bit ? 1 : (v < 40 ? -1 : 0);
+            }
+        }
+        auto packed = PackedSamples(samples.data(), num_samples, 80, 80);
+
+        THEN("they match the energies of the unpacked samples") {
+            std::vector<double> expected(num_samples);
+            qm.energies(samples.data(), num_samples, 80, expected.data());
+
+            std::vector<double> energies(num_samples);
+            packed.energies(qm, energies.data(), 3);
+            for (std::size_t i = 0; i < num_samples; ++i) {
+                CHECK(energies[i] == Approx(expected[i]));
+            }
+        }
+
+        THEN("the homogeneous models unpack the same values") {
+            for (auto vartype : {Vartype::BINARY, Vartype::SPIN}) {
+                auto bqm = BinaryQuadraticModel<double>(80, vartype);
+                for (std::size_t v = 0; v < 80; ++v) {
+                    bqm.set_linear(v, qm.linear(v));
+                    bqm.set_quadratic(v, (v + 7) % 80, qm.quadratic(v, (v + 7) % 80));
+                }
+
+                std::vector<double> unpacked(num_samples * 80);
+                for (std::size_t i = 0; i < num_samples; ++i) {
+                    packed.unpack(i, vartype_info<double>::min(vartype), 1.,
+                                  unpacked.data() + i * 80);
+                }
+
+                std::vector<double> expected(num_samples);
+                bqm.energies(unpacked.data(), num_samples, 80, expected.data());
+
+                std::vector<double> energies(num_samples);
+                packed.energies(bqm, energies.data());
+                for (std::size_t i = 0; i < num_samples; ++i) {
+                    CHECK(energies[i] == Approx(expected[i]));
+                }
+            }
+        }
+
+        THEN("models of a different size or vartype are rejected") {
+            std::vector<double> energies(num_samples);
+
+            auto bqm = BinaryQuadraticModel<double>(79, Vartype::SPIN);
+            CHECK_THROWS_AS(packed.energies(bqm, energies.data()), std::invalid_argument);
+
+            qm.change_vartype(Vartype::INTEGER, 0);
+            CHECK_THROWS_AS(packed.energies(qm, energies.data()), std::invalid_argument);
+        }
+    }
+}
+
+}  // namespace dimod
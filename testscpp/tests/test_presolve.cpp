@@ -0,0 +1,198 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/presolve.h"
+
+namespace dimod {
+
+SCENARIO("constrained quadratic models can be presolved", "[presolve]") {
+    GIVEN("a CQM with fixed, unused and bounded variables") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        auto x = cqm.add_variable(Vartype::INTEGER, 0, 10);
+        auto y = cqm.add_variable(Vartype::INTEGER, 3, 3);  // fixed
+        auto z = cqm.add_variable(Vartype::REAL, -5, 5);
+        cqm.add_variable(Vartype::BINARY);  // unused
+        auto b = cqm.add_variable(Vartype::BINARY);
+
+        cqm.objective.add_linear(x, 1);
+        cqm.objective.add_quadratic(x, y, 2);
+        cqm.objective.add_linear(z, -1);
+        cqm.objective.add_linear(b, 1);
+
+        // 2x <= 7 is a bound, x <= 3
+        cqm.add_linear_constraint({x}, {2}, Sense::LE, 7);
+
+        // x + z >= 6 so z >= 3
+        cqm.add_linear_constraint({x, z}, {1, 1}, Sense::GE, 6);
+
+        // a duplicate of the above, but looser
+        cqm.add_linear_constraint({z, x}, {2, 2}, Sense::GE, 8);
+
+        // b >= .5
+        cqm.add_linear_constraint({b, x}, {1, 0}, Sense::GE, .5);
+
+        // and an empty one we can satisfy
+        auto c = cqm.add_constraint();
+        cqm.constraint_ref(c).set_offset(1);
+        cqm.constraint_ref(c).set_sense(Sense::LE);
+        cqm.constraint_ref(c).set_rhs(2);
+
+        // and a soft constraint that should be kept
+        auto s = cqm.add_linear_constraint({x}, {1}, Sense::EQ, 1);
+        cqm.constraint_ref(s).set_weight(5);
+
+        WHEN("we presolve it") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply() == presolve::Feasibility::UNKNOWN);
+
+            const auto& model = presolver.model();
+
+            THEN("the fixed and unused variables are removed and the bounds are tightened") {
+                // x and z remain, y, the unused variable and b are fixed
+                REQUIRE(model.num_variables() == 2);
+                CHECK(presolver.postsolver().variables() == std::vector<int>{0, 2});
+
+                CHECK(model.vartype(0) == Vartype::INTEGER);
+                CHECK(model.lower_bound(0) == 1);  // from x + z >= 6 with z <= 5
+                CHECK(model.upper_bound(0) == 3);
+                CHECK(model.vartype(1) == Vartype::REAL);
+                CHECK(model.lower_bound(1) == 3);
+                CHECK(model.upper_bound(1) == 5);
+
+                // x + 2*3*x - z + 1
+                CHECK(model.objective.offset() == 1);
+                CHECK(model.objective.linear(0) == 7);
+                CHECK(model.objective.linear(1) == -1);
+                CHECK(model.objective.num_interactions() == 0);
+
+                // only x + z >= 6 and the soft constraint are left
+                REQUIRE(model.num_constraints() == 2);
+                CHECK(model.constraint_ref(0).sense() == Sense::GE);
+                CHECK(model.constraint_ref(0).linear(0) == 1);
+                CHECK(model.constraint_ref(0).linear(1) == 1);
+                CHECK(model.constraint_ref(1).is_soft());
+            }
+
+            THEN("the samples can be restored") {
+                auto sample = presolver.postsolver().apply(std::vector<double>{2, 4.5});
+                CHECK(sample == std::vector<double>{2, 3, 4.5, 0, 1});
+
+                std::vector<int> samples{1, 3, 2, 4};
+                std::vector<int> restored(2 * 5);
+                presolver.postsolver().apply(samples.data(), 2, restored.data());
+                CHECK(restored == std::vector<int>{1, 3, 3, 0, 1, 2, 3, 4, 0, 1});
+            }
+
+            AND_WHEN("we detach the model") {
+                auto reduced = presolver.detach_model();
+
+                THEN("the presolver cannot be applied again") {
+                    CHECK(reduced.num_variables() == 2);
+                    CHECK_THROWS_AS(presolver.apply(), std::logic_error);
+                }
+            }
+        }
+
+        WHEN("we presolve it using only some of the techniques") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            presolver.set_techniques(presolve::TechniqueFlags::REMOVE_FIXED_VARIABLES);
+            presolver.apply();
+
+            THEN("only y is removed") {
+                CHECK(presolver.model().num_variables() == 4);
+                CHECK(presolver.model().num_constraints() == 6);
+                CHECK(presolver.model().objective.linear(0) == 7);
+            }
+        }
+    }
+
+    GIVEN("an infeasible CQM") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 3);
+
+        // x0 + x1 + x2 >= 4
+        cqm.add_linear_constraint({0, 1, 2}, {1, 1, 1}, Sense::GE, 4);
+
+        THEN("presolve detects it") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            CHECK(presolver.apply() == presolve::Feasibility::INFEASIBLE);
+            CHECK(presolver.feasibility() == presolve::Feasibility::INFEASIBLE);
+        }
+    }
+
+    GIVEN("a CQM with contradictory duplicate constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, 2, -100, 100);
+
+        cqm.add_linear_constraint({0, 1}, {1, 2}, Sense::EQ, 4);
+        cqm.add_linear_constraint({1, 0}, {-4, -2}, Sense::GE, -6);  // x0 + 2x1 <= 3
+
+        THEN("presolve detects it") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            CHECK(presolver.apply() == presolve::Feasibility::INFEASIBLE);
+        }
+    }
+
+    GIVEN("a CQM with an equality and a looser duplicate inequality") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, 2, -100, 100);
+        cqm.objective.add_quadratic(0, 1, 1);
+
+        cqm.add_linear_constraint({0, 1}, {1, 2}, Sense::LE, 5);
+        cqm.add_linear_constraint({0, 1}, {-1, -2}, Sense::EQ, -4);
+
+        THEN("only the equality is kept") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            presolver.set_techniques(presolve::TechniqueFlags::REMOVE_DUPLICATE_CONSTRAINTS);
+            CHECK(presolver.apply() == presolve::Feasibility::UNKNOWN);
+            REQUIRE(presolver.model().num_constraints() == 1);
+            CHECK(presolver.model().constraint_ref(0).sense() == Sense::EQ);
+            CHECK(presolver.model().constraint_ref(0).rhs() == -4);
+        }
+    }
+
+    GIVEN("a CQM with a spin variable and an unbounded sum") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        auto s = cqm.add_variable(Vartype::SPIN);
+        auto r = cqm.add_variable(Vartype::REAL, vartype_limits<double, Vartype::REAL>::min(),
+                                  vartype_limits<double, Vartype::REAL>::max());
+        cqm.objective.add_linear(s, 1);
+        cqm.objective.add_linear(r, 1);
+
+        // s >= 0 means s == 1
+        cqm.add_linear_constraint({s}, {1}, Sense::GE, 0);
+
+        // r + s <= 10 means r <= 9 once s is fixed
+        cqm.add_linear_constraint({r, s}, {1, 1}, Sense::LE, 10);
+
+        THEN("s is fixed and r is bounded above but not below") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            presolver.apply();
+
+            const auto& model = presolver.model();
+            REQUIRE(model.num_variables() == 1);
+            CHECK(model.upper_bound(0) == 9);
+            CHECK(model.lower_bound(0) == vartype_limits<double, Vartype::REAL>::min());
+            CHECK(model.num_constraints() == 0);
+            CHECK(presolver.postsolver().apply(std::vector<double>{-2}) ==
+                  std::vector<double>{1, -2});
+        }
+    }
+}
+
+}  // namespace dimod
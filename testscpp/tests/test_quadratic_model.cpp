@@ -12,7 +12,10 @@
 //    See the License for the specific language governing permissions and
 //    limitations under the License.
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
 #include "catch2/catch.hpp"
 #include "dimod/quadratic_model.h"
@@ -498,6 +501,113 @@ SCENARIO("quadratic models with square terms") {
     }
 }
 
+SCENARIO("the energies of many samples can be calculated at once", "[qm]") {
+    GIVEN("a quadratic model with square terms and a batch of samples") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 5, -5, 5);
+        qm.set_offset(-1.5);
+        for (int v = 0; v < 5; ++v) {
+            qm.set_linear(v, v - 2);
+            qm.add_quadratic(v, v, .25 * v);
+            for (int u = 0; u < v; ++u) {
+                qm.add_quadratic(u, v, u + v - 3.5);
+            }
+        }
+
+        // more samples than fit in one block, and padded to check the stride
+        int num_samples = 130;
+        int stride = 7;
+        std::vector<int> samples(num_samples * stride, 100);
+        for (int si = 0; si < num_samples; ++si) {
+            for (int v = 0; v < 5; ++v) {
+                samples[si * stride + v] = (si * 7 + v * 3) % 11 - 5;
+            }
+        }
+
+        std::vector<double> expected;
+        for (int si = 0; si < num_samples; ++si) {
+            expected.push_back(qm.energy(samples.begin() + si * stride));
+        }
+
+        WHEN("we use energies() with one thread") {
+            std::vector<double> energies(num_samples);
+            qm.energies(samples.data(), num_samples, stride, energies.data());
+
+            THEN("they match energy()") {
+                for (int si = 0; si < num_samples; ++si) {
+                    CHECK(energies[si] == Approx(expected[si]));
+                }
+            }
+        }
+
+        WHEN("we use energies() with several threads on a frozen model") {
+            qm.freeze();
+
+            std::vector<double> energies(num_samples);
+            qm.energies(samples.data(), num_samples, stride, energies.data(), 3);
+
+            THEN("they match energy()") {
+                for (int si = 0; si < num_samples; ++si) {
+                    CHECK(energies[si] == Approx(expected[si]));
+                }
+            }
+        }
+
+        WHEN("we use energies() on fewer samples than fit in a block") {
+            std::vector<double> energies(3);
+            qm.energies(samples.data() + 5 * stride, 3, stride, energies.data(), 0);
+
+            THEN("they match energy()") {
+                for (int si = 0; si < 3; ++si) {
+                    CHECK(energies[si] == Approx(expected[si + 5]));
+                }
+            }
+        }
+
+        WHEN("we use energies() with a different output type") {
+            std::vector<float> energies(num_samples);
+            qm.energies(samples.data(), num_samples, stride, energies.data(), 0);
+
+            THEN("they match energy()") {
+                for (int si = 0; si < num_samples; ++si) {
+                    CHECK(energies[si] == Approx(expected[si]));
+                }
+            }
+        }
+    }
+
+    GIVEN("a linear binary quadratic model") {
+        auto bqm = BinaryQuadraticModel<float>(3, Vartype::SPIN);
+        bqm.set_offset(2);
+        bqm.set_linear(0, {1, -2, 3});
+
+        WHEN("we use energies()") {
+            std::vector<std::int8_t> samples = {-1, -1, -1, +1, +1, +1};
+            std::vector<double> energies(2);
+            bqm.energies(samples.data(), 2, 3, energies.data(), 2);
+
+            THEN("they are calculated appropriately") {
+                CHECK(energies[0] == 0);
+                CHECK(energies[1] == 4);
+            }
+        }
+    }
+
+    GIVEN("an empty quadratic model") {
+        auto qm = QuadraticModel<double>();
+        qm.set_offset(3);
+
+        WHEN("we use energies()") {
+            std::vector<double> energies(4);
+            qm.energies(static_cast<const double*>(nullptr), 4, 0, energies.data());
+
+            THEN("the energies are all the offset") {
+                CHECK(energies == std::vector<double>(4, 3));
+            }
+        }
+    }
+}
+
 SCENARIO("quadratic models can be swapped", "[qm]") {
     GIVEN("two quadratic models") {
         auto qm0 = dimod::QuadraticModel<double>();
@@ -568,4 +678,219 @@ SCENARIO("quadratic models can have their interactions filtered") {
         }
     }
 }
+SCENARIO("quadratic models can reserve room for their variables and interactions", "[qm]") {
+    GIVEN("an empty binary quadratic model") {
+        auto bqm = dimod::BinaryQuadraticModel<double>(5, dimod::Vartype::SPIN);
+
+        WHEN("we reserve room for the interactions of a variable") {
+            bqm.reserve_interactions(2, 4);
+            auto nbytes = bqm.nbytes(true);
+
+            AND_WHEN("we add that many interactions") {
+                for (int v : {0, 1, 3, 4}) bqm.add_quadratic(2, v, v + 1);
+
+                THEN("the neighborhood was not reallocated") {
+                    CHECK(bqm.num_interactions() == 4);
+                    CHECK(bqm.quadratic(2, 4) == 5);
+
+                    // each of the other neighborhoods grew by one
+                    CHECK(bqm.nbytes(true) ==
+                          nbytes + 4 * sizeof(dimod::abc::OneVarTerm<double, int>));
+                }
+            }
+        }
+
+        WHEN("we reserve room for more variables") {
+            bqm.reserve(100);
+
+            THEN("the model is unchanged") {
+                CHECK(bqm.num_variables() == 5);
+                CHECK(bqm.nbytes(true) >= 100 * sizeof(double));
+            }
+        }
+    }
+
+    GIVEN("a binary quadratic model constructed from a dense matrix") {
+        float Q[9] = {1, 0, 3, 2, 1, 0, 1, 0, 0};
+        auto bqm = dimod::BinaryQuadraticModel<double>(Q, 3, dimod::Vartype::BINARY);
+
+        THEN("every neighborhood was allocated with room for at most one more term") {
+            CHECK(bqm.num_interactions() == 2);
+            CHECK(bqm.nbytes(true) - bqm.nbytes() ==
+                  3 * sizeof(dimod::abc::OneVarTerm<double, int>));
+        }
+    }
+}
+
+SCENARIO("quadratic models can add many interactions from COO arrays at once", "[qm]") {
+    GIVEN("two identical quadratic models with mixed vartypes and some existing interactions") {
+        auto qm0 = QuadraticModel<double>();
+        qm0.add_variables(Vartype::INTEGER, 2);
+        qm0.add_variables(Vartype::BINARY, 2);
+        qm0.add_variables(Vartype::SPIN, 2);
+        qm0.add_quadratic(0, 3, 1);
+        qm0.add_quadratic(0, 0, 2);
+        qm0.add_quadratic(5, 1, -1);
+        auto qm1 = qm0;
+
+        AND_GIVEN("unsorted COO arrays with duplicates and terms on the diagonal") {
+            std::vector<int> irow = {5, 0, 3, 1, 0, 2, 4, 5, 3, 1, 2, 4};
+            std::vector<int> icol = {1, 3, 0, 1, 0, 2, 4, 1, 2, 0, 3, 0};
+            std::vector<double> bias = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+
+            WHEN("we add them all at once and one at a time") {
+                qm0.add_quadratic_coo(irow.begin(), icol.begin(), bias.begin(), irow.size());
+                for (std::size_t i = 0; i < irow.size(); ++i) {
+                    qm1.add_quadratic(irow[i], icol[i], bias[i]);
+                }
+
+                THEN("the models are the same") {
+                    CHECK(qm0.is_equal(qm1));
+                    CHECK(qm0.num_interactions() == qm1.num_interactions());
+                    CHECK(qm0.quadratic(0, 3) == 6);
+                    CHECK(qm0.quadratic(1, 5) == 8);
+                    CHECK(qm0.quadratic(0, 0) == 7);
+                    CHECK(qm0.quadratic(1, 1) == 4);
+                    CHECK(qm0.linear(2) == 6);
+                    CHECK(qm0.offset() == 7);
+                }
+
+                THEN("every neighborhood is sorted") {
+                    for (std::size_t v = 0; v < qm0.num_variables(); ++v) {
+                        CHECK(std::is_sorted(qm0.cbegin_neighborhood(v),
+                                             qm0.cend_neighborhood(v)));
+                    }
+                }
+            }
+        }
+
+        AND_GIVEN("COO arrays sorted by row and column in the upper triangle") {
+            std::vector<int> irow = {0, 0, 0, 1, 1, 2, 3, 3};
+            std::vector<int> icol = {0, 3, 3, 4, 5, 2, 4, 5};
+            std::vector<double> bias = {1, 2, 3, 4, 5, 6, 7, 8};
+
+            WHEN("we add them all at once, assuming they are sorted, and one at a time") {
+                qm0.add_quadratic_coo(irow.begin(), icol.begin(), bias.begin(), irow.size(), true);
+                for (std::size_t i = 0; i < irow.size(); ++i) {
+                    qm1.add_quadratic(irow[i], icol[i], bias[i]);
+                }
+
+                THEN("the models are the same") {
+                    CHECK(qm0.is_equal(qm1));
+                    CHECK(qm0.quadratic(0, 3) == 6);
+                    CHECK(qm0.quadratic(1, 5) == 4);
+                    CHECK(qm0.quadratic(0, 0) == 3);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("quadratic models can be exported to and imported from CSR arrays", "[qm]") {
+    GIVEN("a quadratic model with a self-loop") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 2);
+        qm.add_variables(Vartype::BINARY, 2);
+        qm.add_quadratic(0, 3, 1);
+        qm.add_quadratic(0, 0, 2);
+        qm.add_quadratic(2, 1, -1);
+        qm.add_quadratic(3, 1, 1.5);
+
+        WHEN("we export the upper triangle") {
+            std::vector<int> row_ptr(qm.num_variables() + 1);
+            std::vector<int> col(qm.num_interactions());
+            std::vector<float> data(qm.num_interactions());
+
+            auto nnz = qm.to_csr(row_ptr.data(), col.data(), data.data());
+
+            THEN("each interaction appears once, in row order") {
+                CHECK(nnz == 4);
+                CHECK(row_ptr == std::vector<int>{0, 2, 4, 4, 4});
+                CHECK(col == std::vector<int>{0, 3, 2, 3});
+                CHECK(data == std::vector<float>{2, 1, -1, 1.5});
+            }
+
+            AND_WHEN("we import them into an empty model with the same variables") {
+                auto other = QuadraticModel<double>();
+                other.add_variables(Vartype::INTEGER, 2);
+                other.add_variables(Vartype::BINARY, 2);
+                other.add_quadratic_csr(row_ptr.begin(), col.begin(), data.begin(), 4, true);
+
+                THEN("the models are the same") { CHECK(other.is_equal(qm)); }
+            }
+        }
+
+        WHEN("we export the upper triangle with offsets wider than the columns") {
+            std::vector<std::int64_t> row_ptr(qm.num_variables() + 1);
+            std::vector<std::int32_t> col(qm.num_interactions());
+            std::vector<float> data(qm.num_interactions());
+
+            qm.to_csr(row_ptr.data(), col.data(), data.data());
+
+            THEN("we get the same result") {
+                CHECK(row_ptr == std::vector<std::int64_t>{0, 2, 4, 4, 4});
+                CHECK(col == std::vector<std::int32_t>{0, 3, 2, 3});
+            }
+        }
+
+        WHEN("we export the full symmetric matrix") {
+            std::vector<std::int64_t> row_ptr(qm.num_variables() + 1);
+            std::vector<std::int64_t> col(2 * qm.num_interactions());
+            std::vector<double> data(2 * qm.num_interactions());
+
+            auto nnz = qm.to_csr(row_ptr.data(), col.data(), data.data(), false);
+
+            THEN("each off-diagonal interaction appears twice") {
+                CHECK(nnz == 7);
+                CHECK(row_ptr == std::vector<std::int64_t>{0, 2, 4, 5, 7});
+                col.resize(nnz);
+                data.resize(nnz);
+                CHECK(col == std::vector<std::int64_t>{0, 3, 2, 3, 1, 0, 1});
+                CHECK(data == std::vector<double>{2, 1, -1, 1.5, -1, 1, 1.5});
+            }
+
+            AND_WHEN("we import it into a model with the same variables") {
+                auto other = QuadraticModel<double>();
+                other.add_variables(Vartype::INTEGER, 2);
+                other.add_variables(Vartype::BINARY, 2);
+                other.add_quadratic_csr(row_ptr.begin(), col.begin(), data.begin(), 4);
+
+                THEN("the off-diagonal interactions are doubled") {
+                    CHECK(other.num_interactions() == 4);
+                    CHECK(other.quadratic(0, 0) == 2);
+                    CHECK(other.quadratic(0, 3) == 2);
+                    CHECK(other.quadratic(1, 2) == -2);
+                    CHECK(other.quadratic(1, 3) == 3);
+                }
+            }
+        }
+
+        WHEN("we freeze it and export the upper triangle") {
+            qm.freeze();
+
+            std::vector<int> row_ptr(qm.num_variables() + 1);
+            std::vector<int> col(qm.num_interactions());
+            std::vector<double> data(qm.num_interactions());
+            qm.to_csr(row_ptr.data(), col.data(), data.data());
+
+            THEN("we get the same result") {
+                CHECK(row_ptr == std::vector<int>{0, 2, 4, 4, 4});
+                CHECK(col == std::vector<int>{0, 3, 2, 3});
+            }
+        }
+    }
+
+    GIVEN("a model with no interactions") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::REAL, 3);
+
+        THEN("the CSR matrix is empty") {
+            std::vector<int> row_ptr(4, -1);
+            CHECK(qm.to_csr(row_ptr.data(), static_cast<int*>(nullptr),
+                            static_cast<double*>(nullptr)) == 0);
+            CHECK(row_ptr == std::vector<int>{0, 0, 0, 0});
+        }
+    }
+}
+
 }  // namespace dimod
@@ -0,0 +1,164 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/quadratic_model.h"
+#include "dimod/simulated_annealing.h"
+
+namespace dimod {
+
+SCENARIO("beta schedules follow the reference sampler", "[simulated_annealing]") {
+    GIVEN("a SPIN BQM and the same model as a BINARY BQM") {
+        auto spin = BinaryQuadraticModel<double>(3, Vartype::SPIN);
+        spin.set_linear(0, {1, -2, .5});
+        spin.set_quadratic(0, 1, -1.5);
+        spin.set_quadratic(1, 2, 1);
+
+        auto binary = BinaryQuadraticModel<double>(spin);
+        binary.change_vartype(Vartype::BINARY);
+
+        THEN("the default beta ranges match") {
+            auto range = simulated_annealing::default_beta_range(spin);
+            CHECK(range.first == .1);
+            CHECK(range.second == 2 * (2 + 1.5 + 1));  // variable 1
+
+            auto binary_range = simulated_annealing::default_beta_range(binary);
+            CHECK(binary_range.first == .1);
+            CHECK(binary_range.second == Approx(range.second));
+        }
+    }
+
+    GIVEN("an empty BQM") {
+        auto bqm = BinaryQuadraticModel<double>(Vartype::SPIN);
+
+        THEN("the final beta is 0") {
+            CHECK(simulated_annealing::default_beta_range(bqm).second == 0);
+        }
+    }
+
+    THEN("the schedules are linear in beta") {
+        CHECK(simulated_annealing::linear_beta_schedule(1, 2, 5) ==
+              std::vector<double>{1, 1.25, 1.5, 1.75, 2});
+        CHECK(simulated_annealing::linear_beta_schedule(1, 2, 1) == std::vector<double>{2});
+        CHECK(simulated_annealing::linear_beta_schedule(1, 2, 0).empty());
+    }
+}
+
+SCENARIO("models can be sampled with simulated annealing", "[simulated_annealing]") {
+    GIVEN("a frustrated ring of spins with a unique ground state") {
+        const int n = 30;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::SPIN);
+        for (int v = 0; v < n; ++v) bqm.set_quadratic(v, (v + 1) % n, -1);
+        bqm.set_quadratic(0, n - 1, 1);
+        bqm.set_linear(0, -.25);
+        bqm.set_linear(1, -.25);
+
+        auto range = simulated_annealing::default_beta_range(bqm);
+        auto betas = simulated_annealing::linear_beta_schedule(range.first, range.second, 1000);
+
+        WHEN("we anneal it") {
+            const std::size_t num_reads = 20;
+            std::vector<std::int8_t> samples(num_reads * n);
+            std::vector<double> energies(num_reads);
+            simulated_annealing::sample(bqm, betas, num_reads, 5, samples.data(),
+                                        energies.data(), 4);
+
+            THEN("the energies are those of the samples and most are ground states") {
+                std::size_t num_ground = 0;
+                for (std::size_t r = 0; r < num_reads; ++r) {
+                    const std::int8_t* sample = samples.data() + r * n;
+                    for (int v = 0; v < n; ++v) REQUIRE((sample[v] == 1 || sample[v] == -1));
+                    CHECK(energies[r] == bqm.energy(sample));
+                    num_ground += energies[r] == -(n - 2) - .5;
+                }
+                CHECK(num_ground >= num_reads / 2);
+            }
+
+            THEN("the results do not depend on the number of threads") {
+                std::vector<std::int8_t> other(num_reads * n);
+                std::vector<double> other_energies(num_reads);
+                simulated_annealing::sample(bqm, betas, num_reads, 5, other.data(),
+                                            other_energies.data(), 1);
+                CHECK(other == samples);
+                CHECK(other_energies == energies);
+            }
+
+            THEN("a different seed gives different samples") {
+                std::vector<std::int8_t> other(num_reads * n);
+                std::vector<double> other_energies(num_reads);
+                simulated_annealing::sample(bqm, betas, num_reads, 6, other.data(),
+                                            other_energies.data(), 4);
+                CHECK(other != samples);
+            }
+        }
+    }
+
+    GIVEN("a dense BINARY-valued BQM") {
+        const int n = 40;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+        for (int u = 0; u < n; ++u) {
+            bqm.set_linear(u, u % 5 - 2);
+            for (int v = u + 1; v < n; ++v) bqm.set_quadratic(u, v, (u + v) % 3 - 1);
+        }
+
+        WHEN("we anneal it") {
+            const std::size_t num_reads = 10;
+            std::vector<std::int8_t> samples(num_reads * n);
+            std::vector<double> energies(num_reads);
+            simulated_annealing::sample(bqm, std::vector<double>(20, 1.), num_reads, 3,
+                                        samples.data(), energies.data());
+
+            THEN("the energies are those of the samples") {
+                for (std::size_t r = 0; r < num_reads; ++r) {
+                    CHECK(energies[r] == bqm.energy(samples.data() + r * n));
+                }
+            }
+        }
+    }
+
+    GIVEN("a model with BINARY and SPIN variables") {
+        auto qm = QuadraticModel<double>();
+        auto x = qm.add_variable(Vartype::BINARY);
+        auto s = qm.add_variable(Vartype::SPIN);
+        qm.add_linear(x, -1);
+        qm.add_quadratic(x, s, 2);
+        qm.set_offset(1);
+
+        THEN("each variable takes its own values") {
+            std::vector<double> samples(2 * 5);
+            std::vector<double> energies(5);
+            simulated_annealing::sample(qm, std::vector<double>(100, 10.), 5, 1, samples.data(),
+                                        energies.data());
+            for (std::size_t r = 0; r < 5; ++r) {
+                CHECK(samples[2 * r] == 1);
+                CHECK(samples[2 * r + 1] == -1);
+                CHECK(energies[r] == -2);
+            }
+        }
+
+        THEN("models with other vartypes are rejected") {
+            qm.add_variable(Vartype::INTEGER, 0, 5);
+            std::vector<double> samples(3);
+            double energy;
+            CHECK_THROWS_AS(simulated_annealing::sample(qm, {1.}, 1, 1, samples.data(), &energy),
+                            std::invalid_argument);
+        }
+    }
+}
+
+}  // namespace dimod
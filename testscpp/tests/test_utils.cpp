@@ -22,6 +22,47 @@
 namespace dimod {
 namespace utils {
 
+TEST_CASE("parallel_for()") {
+    GIVEN("A vector of zeros") {
+        auto v = std::vector<int>(103, 0);
+
+        WHEN("We use parallel_for() to increment every element") {
+            int num_threads = GENERATE(0, 1, 4, 200);
+
+            parallel_for(v.size(), num_threads, [&v](std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) ++v[i];
+            });
+
+            THEN("Every element is visited exactly once") {
+                REQUIRE_THAT(v, Catch::Approx(std::vector<int>(103, 1)));
+            }
+        }
+    }
+
+    GIVEN("An empty range") {
+        THEN("The function is never called") {
+            int count = 0;
+            parallel_for(0, 4, [&count](std::size_t, std::size_t) { ++count; });
+            CHECK(count == 0);
+        }
+    }
+}
+
+TEST_CASE("transpose_samples()") {
+    GIVEN("two samples of three variables, padded to a stride of four") {
+        auto samples = std::vector<int>{1, 2, 3, -1, 4, 5, 6, -1};
+
+        WHEN("We transpose them into a buffer three samples wide") {
+            auto buffer = std::vector<double>(9, 100);
+            transpose_samples(samples.data(), 2, 4, 3, 3, buffer.data());
+
+            THEN("The buffer is variable-major and the unused lane is zeroed") {
+                REQUIRE_THAT(buffer, Catch::Approx(std::vector<double>{1, 4, 0, 2, 5, 0, 3, 6, 0}));
+            }
+        }
+    }
+}
+
 TEST_CASE("remove_by_index()") {
     GIVEN("A vector") {
         auto v = std::vector<int>{0, 1, 2, 3, 4, 5, 6};
@@ -0,0 +1,234 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/quadratic_model.h"
+#include "dimod/views.h"
+
+namespace dimod {
+
+// Check that `view` has the same biases as `expected`. The vartypes and bounds
+// of expressions are looked up by their parent's variables.
+template <class View>
+void check_biases(const View& view, const abc::QuadraticModelBase<double, int>& expected,
+                  const std::vector<int>* parent_variables = nullptr) {
+    REQUIRE(view.num_variables() == expected.num_variables());
+    REQUIRE(view.num_interactions() == expected.num_interactions());
+
+    for (int u = 0; u < static_cast<int>(expected.num_variables()); ++u) {
+        int p = parent_variables ? (*parent_variables)[u] : u;
+        CHECK(view.vartype(u) == expected.vartype(p));
+        CHECK(view.lower_bound(u) == expected.lower_bound(p));
+        CHECK(view.upper_bound(u) == expected.upper_bound(p));
+        CHECK(view.linear(u) == Approx(expected.linear(u)));
+
+        auto neighborhood = view.neighborhood(u);
+        REQUIRE(neighborhood.size() == expected.num_interactions(u));
+        auto it = expected.cbegin_neighborhood(u);
+        for (const auto& term : neighborhood) {
+            CHECK(term.v == it->v);
+            CHECK(term.bias == Approx(it->bias));
+            CHECK(view.quadratic(u, term.v) == Approx(it->bias));
+            ++it;
+        }
+    }
+    CHECK(view.offset() == Approx(expected.offset()));
+}
+
+SCENARIO("vartype views present converted biases without copying them", "[views]") {
+    GIVEN("a random SPIN BQM") {
+        auto rng = std::mt19937(42);
+        auto bias = std::uniform_real_distribution<double>(-1, 1);
+
+        auto bqm = BinaryQuadraticModel<double>(8, Vartype::SPIN);
+        for (int u = 0; u < 8; ++u) {
+            bqm.set_linear(u, bias(rng));
+            for (int v = u + 1; v < 8; v += 2) bqm.add_quadratic(u, v, bias(rng));
+        }
+        bqm.set_offset(1.5);
+
+        WHEN("it is viewed as BINARY") {
+            auto view = VartypeView<double>(bqm, Vartype::SPIN, Vartype::BINARY);
+
+            THEN("the biases match those of a converted copy") {
+                auto expected = bqm;
+                expected.change_vartype(Vartype::BINARY);
+                check_biases(view, expected);
+            }
+
+            THEN("the energies match those of the model at the same states") {
+                for (int state = 0; state < (1 << 8); ++state) {
+                    std::vector<int> binary(8);
+                    std::vector<int> spin(8);
+                    for (int v = 0; v < 8; ++v) {
+                        binary[v] = (state >> v) & 1;
+                        spin[v] = 2 * binary[v] - 1;
+                    }
+                    REQUIRE(view.energy(binary.begin()) == Approx(bqm.energy(spin.begin())));
+                }
+            }
+
+            THEN("it can be materialized") {
+                auto expected = bqm;
+                expected.change_vartype(Vartype::BINARY);
+                auto qm = view.materialize();
+                check_biases(view, qm);
+                check_biases(VartypeView<double>(qm, Vartype::SPIN, Vartype::SPIN), expected);
+            }
+
+            AND_WHEN("the view is viewed as SPIN again") {
+                auto binary = view.materialize();
+                auto back = VartypeView<double>(binary, Vartype::BINARY, Vartype::SPIN);
+
+                THEN("the original biases are recovered") { check_biases(back, bqm); }
+            }
+        }
+
+        THEN("a view between the same vartypes has the same biases") {
+            check_biases(VartypeView<double>(bqm, Vartype::SPIN, Vartype::SPIN), bqm);
+            check_biases(VartypeView<double>(bqm, Vartype::BINARY, Vartype::SPIN), bqm);
+        }
+
+        THEN("only BINARY and SPIN variables can be converted") {
+            CHECK_THROWS_AS(VartypeView<double>(bqm, Vartype::INTEGER, Vartype::BINARY),
+                            std::invalid_argument);
+            CHECK_THROWS_AS(VartypeView<double>(bqm, Vartype::SPIN, Vartype::REAL),
+                            std::invalid_argument);
+        }
+    }
+
+    GIVEN("a QM with SPIN, BINARY and INTEGER variables") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::SPIN, 3);
+        qm.add_variables(Vartype::BINARY, 2);
+        qm.add_variable(Vartype::INTEGER, -2, 5);
+        for (int v = 0; v < 6; ++v) qm.set_linear(v, v - 2.5);
+        qm.add_quadratic(0, 1, 1.5);
+        qm.add_quadratic(0, 3, -2);
+        qm.add_quadratic(1, 5, 3);
+        qm.add_quadratic(2, 4, .5);
+        qm.add_quadratic(4, 5, -1);
+        qm.add_quadratic(5, 5, 4);
+        qm.set_offset(-3);
+
+        WHEN("its SPIN variables are viewed as BINARY") {
+            auto view = VartypeView<double>(qm, Vartype::SPIN, Vartype::BINARY);
+
+            THEN("the biases match those of a model with its SPIN variables converted") {
+                auto expected = qm;
+                for (int v = 0; v < 3; ++v) expected.change_vartype(Vartype::BINARY, v);
+                check_biases(view, expected);
+                CHECK(view.materialize().is_equal(expected));
+            }
+        }
+
+        WHEN("its BINARY variables are viewed as SPIN") {
+            auto view = VartypeView<double>(qm, Vartype::BINARY, Vartype::SPIN);
+
+            THEN("the biases match those of a model with its BINARY variables converted") {
+                auto expected = qm;
+                for (int v = 3; v < 5; ++v) expected.change_vartype(Vartype::SPIN, v);
+                check_biases(view, expected);
+            }
+
+            THEN("the energies match those of the model at the same states") {
+                std::vector<double> sample{-1, 1, 1, -1, 1, 4};
+                std::vector<double> original{-1, 1, 1, 0, 1, 4};
+                CHECK(view.energy(sample.begin()) == Approx(qm.energy(original.begin())));
+            }
+        }
+    }
+
+    GIVEN("a CQM with SPIN variables in its constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::SPIN, 4);
+        cqm.add_variable(Vartype::INTEGER, 0, 3);
+
+        auto& constraint = cqm.constraint_ref(cqm.add_constraint());
+        constraint.add_linear(3, 1);
+        constraint.add_linear(4, 2);
+        constraint.add_quadratic(1, 3, -1.5);
+        constraint.add_quadratic(3, 4, 2);
+        constraint.set_offset(.5);
+
+        WHEN("a constraint is viewed with its SPIN variables as BINARY") {
+            auto view = VartypeView<double>(constraint, Vartype::SPIN, Vartype::BINARY);
+
+            THEN("it matches the constraint of a converted CQM") {
+                auto expected = cqm;
+                for (int v = 0; v < 4; ++v) expected.change_vartype(Vartype::BINARY, v);
+
+                auto& converted = expected.constraint_ref(0);
+                REQUIRE(converted.variables() == constraint.variables());
+                check_biases(view, converted, &converted.variables());
+                CHECK(view.materialize().num_variables() == 3);
+            }
+        }
+    }
+}
+
+SCENARIO("relabel views present the variables in a different order", "[views]") {
+    GIVEN("a QM and a mapping that reverses its variables") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::SPIN, 2);
+        qm.add_variable(Vartype::INTEGER, -1, 7);
+        qm.add_variable(Vartype::BINARY);
+        qm.set_linear(0, {1, 2, 3, 4});
+        qm.add_quadratic(0, 1, -1);
+        qm.add_quadratic(0, 3, 5);
+        qm.add_quadratic(2, 2, 1.5);
+        qm.add_quadratic(1, 2, 2);
+        qm.set_offset(6);
+
+        auto view = RelabelView<double>(qm, {3, 2, 1, 0});
+
+        THEN("the biases are relabelled") {
+            auto expected = QuadraticModel<double>();
+            expected.add_variable(Vartype::BINARY);
+            expected.add_variable(Vartype::INTEGER, -1, 7);
+            expected.add_variables(Vartype::SPIN, 2);
+            expected.set_linear(0, {4, 3, 2, 1});
+            expected.add_quadratic(3, 2, -1);
+            expected.add_quadratic(3, 0, 5);
+            expected.add_quadratic(1, 1, 1.5);
+            expected.add_quadratic(2, 1, 2);
+            expected.set_offset(6);
+
+            check_biases(view, expected);
+            CHECK(view.materialize().is_equal(expected));
+            CHECK(view.label_of(0) == 3);
+            CHECK(view.mapping(0) == 3);
+        }
+
+        THEN("the energies are of the relabelled samples") {
+            std::vector<double> sample{1, 4, -1, 1};
+            std::vector<double> original{1, -1, 4, 1};
+            CHECK(view.energy(sample.begin()) == Approx(qm.energy(original.begin())));
+        }
+
+        THEN("mappings that are not permutations are rejected") {
+            CHECK_THROWS_AS(RelabelView<double>(qm, {0, 1, 2}), std::invalid_argument);
+            CHECK_THROWS_AS(RelabelView<double>(qm, {0, 1, 1, 2}), std::invalid_argument);
+            CHECK_THROWS_AS(RelabelView<double>(qm, {0, 1, 2, 4}), std::invalid_argument);
+        }
+    }
+}
+
+}  // namespace dimod